@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "benchBaseline.hpp"
+
+using namespace AQNWB::Benchmarks;
+
+namespace
+{
+/**
+ * @brief Minimum number of operations of a result to be written to a
+ * baseline. Timings of fewer operations are too noisy to compare.
+ */
+constexpr SizeType MinBaselineOperations = 10;
+
+/**
+ * @brief Mean operation times below this are compared as if they were this
+ * long, such that timer noise in very short operations does not fail checks
+ */
+constexpr double MinComparedMicroseconds = 100.0;
+}  // namespace
+
+Baseline AQNWB::Benchmarks::readBaseline(const std::string& filename)
+{
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::runtime_error("could not open baseline " + filename);
+  }
+  Baseline baseline;
+  std::string line;
+  SizeType lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    std::istringstream stream(line);
+    std::string name;
+    if (!(stream >> name) || name[0] == '#') {
+      continue;
+    }
+    if (name == "build_config") {
+      stream >> baseline.buildConfig;
+      continue;
+    }
+    BaselineEntry entry;
+    if (!(stream >> entry.meanOperationMicroseconds
+          >> entry.allocationsPerOperation))
+    {
+      throw std::runtime_error(filename + ":" + std::to_string(lineNumber)
+                               + ": malformed baseline entry");
+    }
+    baseline.entries[name] = entry;
+  }
+  return baseline;
+}
+
+void AQNWB::Benchmarks::writeBaseline(
+    const std::vector<BenchmarkResult>& results, std::ostream& out)
+{
+  out << "# aqnwb_bench baseline (aqnwb " << AQNWB_VERSION << ")\n"
+      << "# <scenario> <mean operation time [us]> <allocations per operation>\n"
+      << "build_config " << BUILD_CONFIG << "\n";
+  for (const auto& result : results) {
+    if (result.failures == 0 && !result.truncated
+        && result.operations >= MinBaselineOperations)
+    {
+      out << result.name << " "
+          << jsonNumber(result.meanOperationMicroseconds()) << " "
+          << jsonNumber(result.allocationsPerOperation) << "\n";
+    }
+  }
+}
+
+SizeType AQNWB::Benchmarks::checkBaseline(
+    const std::vector<BenchmarkResult>& results,
+    const Baseline& baseline,
+    double timeTolerance,
+    double allocationTolerance,
+    std::ostream& out)
+{
+  const bool compareTimes = (baseline.buildConfig == BUILD_CONFIG);
+  if (!compareTimes) {
+    out << "baseline: measured with build configuration '"
+        << baseline.buildConfig << "' but running '" << BUILD_CONFIG
+        << "', only comparing allocations" << std::endl;
+  }
+
+  std::map<std::string, const BenchmarkResult*> resultsByName;
+  for (const auto& result : results) {
+    resultsByName[result.name] = &result;
+  }
+
+  SizeType regressions = 0;
+  for (const auto& [name, entry] : baseline.entries) {
+    auto found = resultsByName.find(name);
+    if (found == resultsByName.end()) {
+      out << "REGRESSION " << name << ": scenario did not run" << std::endl;
+      ++regressions;
+      continue;
+    }
+    const BenchmarkResult& result = *found->second;
+    if (result.failures > 0 || result.truncated) {
+      out << "REGRESSION " << name << ": scenario "
+          << (result.failures > 0 ? "failed" : "was truncated") << std::endl;
+      ++regressions;
+      continue;
+    }
+    // Non-zero allocation counts depend on the standard library, e.g., on
+    // its small string size, so only allocation-free scenarios are compared
+    bool regressed = false;
+    if (entry.allocationsPerOperation <= 0.0
+        && result.allocationsPerOperation > allocationTolerance)
+    {
+      out << "REGRESSION " << name << ": " << result.allocationsPerOperation
+          << " allocations per operation, baseline "
+          << entry.allocationsPerOperation << std::endl;
+      regressed = true;
+    }
+    const double maxTime =
+        std::max(entry.meanOperationMicroseconds, MinComparedMicroseconds)
+        * (1.0 + timeTolerance);
+    if (compareTimes && result.meanOperationMicroseconds() > maxTime) {
+      out << "REGRESSION " << name << ": "
+          << result.meanOperationMicroseconds()
+          << " us per operation, baseline "
+          << entry.meanOperationMicroseconds << " us" << std::endl;
+      regressed = true;
+    }
+    if (regressed) {
+      ++regressions;
+    }
+  }
+  out << "baseline: " << baseline.entries.size() << " scenarios checked, "
+      << regressions << " regressions" << std::endl;
+  return regressions;
+}
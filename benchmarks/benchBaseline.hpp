@@ -0,0 +1,94 @@
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "benchUtils.hpp"
+
+namespace AQNWB::Benchmarks
+{
+
+/**
+ * @brief The reference metrics of a scenario in a baseline
+ */
+struct BaselineEntry
+{
+  /**
+   * @brief Mean wall time of a timed operation in microseconds
+   */
+  double meanOperationMicroseconds = 0.0;
+
+  /**
+   * @brief Mean number of heap allocations per timed operation
+   */
+  double allocationsPerOperation = 0.0;
+};
+
+/**
+ * @brief Reference results to detect performance regressions.
+ *
+ * Baselines are stored as text files with one scenario per line:
+ * `<scenario name> <mean operation time [us]> <allocations per operation>`.
+ * A line `build_config <config>` records the build configuration the timings
+ * were measured with. Empty lines and lines starting with `#` are ignored.
+ */
+struct Baseline
+{
+  /**
+   * @brief The build configuration of the baseline, e.g., "Release"
+   */
+  std::string buildConfig;
+
+  /**
+   * @brief The reference metrics by scenario name
+   */
+  std::map<std::string, BaselineEntry> entries;
+};
+
+/**
+ * @brief Read a baseline file
+ * @param filename The path of the file
+ * @return The baseline
+ * @throws std::runtime_error If the file cannot be read or is malformed
+ */
+Baseline readBaseline(const std::string& filename);
+
+/**
+ * @brief Write the results that completed without failures and with at least
+ * 10 operations as a baseline
+ * @param results The results to write
+ * @param out The stream to write to
+ */
+void writeBaseline(const std::vector<BenchmarkResult>& results,
+                   std::ostream& out);
+
+/**
+ * @brief Compare results against a baseline.
+ *
+ * A scenario of the baseline regresses if it is missing from the results,
+ * failed, or was truncated, if it allocates more than `allocationTolerance`
+ * times per operation although the baseline does not allocate, or if its
+ * mean operation time exceeds the baseline by more than a factor of
+ * `1 + timeTolerance`. Allocations are not compared for scenarios that
+ * allocate in the baseline, since their number depends on the standard
+ * library. Mean operation times below 100 microseconds are compared as 100
+ * microseconds to tolerate timer noise. Timings are only compared if the
+ * baseline was measured with the same build configuration. Results of
+ * scenarios not in the baseline are ignored.
+ *
+ * @param results The results to check
+ * @param baseline The baseline to compare against
+ * @param timeTolerance Relative tolerance of the mean operation time
+ * @param allocationTolerance Absolute tolerance of allocations per operation
+ * @param out The stream to report regressions to
+ * @return The number of regressed scenarios
+ */
+SizeType checkBaseline(const std::vector<BenchmarkResult>& results,
+                       const Baseline& baseline,
+                       double timeTolerance,
+                       double allocationTolerance,
+                       std::ostream& out);
+
+}  // namespace AQNWB::Benchmarks
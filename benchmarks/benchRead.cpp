@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "benchRead.hpp"
+
+#include "testAllocationCounter.hpp"
+
+#include "Channel.hpp"
+#include "Utils.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/RegisteredType.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "nwb/file/ElectrodesTable.hpp"
+
+using namespace AQNWB;
+using namespace AQNWB::Benchmarks;
+
+namespace
+{
+/**
+ * @brief Path of the ElectricalSeries in the generated file
+ */
+const std::string SeriesPath = "/acquisition/esdata0";
+
+/**
+ * @brief Number of samples per channel written per call when generating
+ */
+constexpr SizeType GenerateBlockSize = 8192;
+
+/**
+ * @brief The types searched by the type discovery patterns
+ */
+const std::unordered_set<std::string> SearchTypes = {
+    "core::ElectricalSeries", "core::AnnotationSeries"};
+
+/**
+ * @brief Generate the file of a read scenario
+ * @return The number of samples per channel in the file
+ */
+SizeType generateFile(const ReadScenario& scenario, const std::string& path)
+{
+  const auto numSamples = static_cast<SizeType>(
+      std::ceil(scenario.duration * scenario.samplingRate));
+  std::shared_ptr<IO::BaseIO> io = std::make_shared<IO::HDF5::HDF5IO>(path);
+  io->open();
+  auto nwbFile = NWB::NWBFile::create(io);
+  nwbFile->initialize(generateUuid());
+
+  Types::ChannelVector channels;
+  for (SizeType c = 0; c < scenario.numChannels; ++c) {
+    channels.emplace_back("ch" + std::to_string(c), "array0", 0, c, c);
+  }
+  auto electrodesTable = nwbFile->createElectrodesTable({channels});
+  std::vector<SizeType> containerIndexes;
+  nwbFile->createElectricalSeries(
+      {channels}, {"esdata0"}, IO::BaseDataType::I16, containerIndexes);
+  auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+      io->getRecordingObjects()->getRecordingObject(containerIndexes[0]));
+
+  std::vector<std::string> annotationNames;
+  for (SizeType i = 0; i < scenario.numObjects; ++i) {
+    annotationNames.push_back("annotations" + std::to_string(i));
+  }
+  std::vector<SizeType> annotationIndexes;
+  nwbFile->createAnnotationSeries(annotationNames, annotationIndexes);
+  io->startRecording();
+
+  std::vector<std::int16_t> block(GenerateBlockSize * scenario.numChannels);
+  std::vector<double> timestamps(GenerateBlockSize);
+  for (SizeType offset = 0; offset < numSamples; offset += GenerateBlockSize) {
+    SizeType blockSize = std::min(GenerateBlockSize, numSamples - offset);
+    for (SizeType s = 0; s < blockSize; ++s) {
+      timestamps[s] = static_cast<double>(offset + s) / scenario.samplingRate;
+      for (SizeType c = 0; c < scenario.numChannels; ++c) {
+        block[s * scenario.numChannels + c] =
+            static_cast<std::int16_t>((offset + s + c) % 2048);
+      }
+    }
+    series->writeAllChannels(blockSize,
+                             static_cast<const void*>(block.data()),
+                             static_cast<const void*>(timestamps.data()));
+  }
+  io->stopRecording();
+  io->close();
+  return numSamples;
+}
+
+/**
+ * @brief Open the generated file read-only
+ */
+std::shared_ptr<IO::BaseIO> openFile(const std::string& path)
+{
+  std::shared_ptr<IO::BaseIO> io = std::make_shared<IO::HDF5::HDF5IO>(path);
+  io->open(IO::FileMode::ReadOnly);
+  return io;
+}
+
+/**
+ * @brief Create a result for a pattern of a scenario
+ */
+BenchmarkResult makeResult(const ReadScenario& scenario,
+                           const std::string& pattern)
+{
+  BenchmarkResult result;
+  result.name = scenario.getName() + "/" + pattern;
+  result.suite = "read";
+  result.parameters = {{"channels", jsonNumber(scenario.numChannels)},
+                       {"objects", jsonNumber(scenario.numObjects)},
+                       {"sampling_rate", jsonNumber(scenario.samplingRate)},
+                       {"duration_s", jsonNumber(scenario.duration)},
+                       {"window_size", jsonNumber(scenario.windowSize)},
+                       {"subset_channels", jsonNumber(scenario.subsetChannels)},
+                       {"repeats", jsonNumber(scenario.repeats)},
+                       {"pattern", jsonString(pattern)}};
+  return result;
+}
+
+/**
+ * @brief Time an operation and add it to a result
+ * @param result The result to add the operation to
+ * @param operation The operation. Returns the number of bytes read.
+ */
+template<typename Operation>
+void timeOperation(BenchmarkResult& result, Operation&& operation)
+{
+  AllocationCounter counter;
+  auto start = Clock::now();
+  SizeType bytes = 0;
+  try {
+    bytes = operation();
+  } catch (const std::exception& e) {
+    std::cerr << result.name << ": " << e.what() << std::endl;
+    ++result.failures;
+  }
+  std::uint64_t nanoseconds = elapsedNanoseconds(start);
+  std::uint64_t allocations = counter.getCount();
+  result.latency.record(nanoseconds);
+  result.allocationsPerOperation =
+      (result.allocationsPerOperation * static_cast<double>(result.operations)
+       + static_cast<double>(allocations))
+      / static_cast<double>(result.operations + 1);
+  result.seconds += static_cast<double>(nanoseconds) / 1e9;
+  result.bytes += bytes;
+  ++result.operations;
+}
+}  // namespace
+
+std::string ReadScenario::getName() const
+{
+  std::ostringstream name;
+  name << "read/ch=" << numChannels << "/objects=" << numObjects
+       << "/rate=" << samplingRate << "/duration=" << duration;
+  return name.str();
+}
+
+std::vector<BenchmarkResult> AQNWB::Benchmarks::runReadScenario(
+    const ReadScenario& scenario, const std::string& directory)
+{
+  std::vector<BenchmarkResult> results;
+  if (scenario.numChannels == 0 || scenario.repeats == 0
+      || scenario.subsetChannels == 0
+      || scenario.subsetChannels > scenario.numChannels)
+  {
+    std::cerr << "runReadScenario: invalid scenario " << scenario.getName()
+              << std::endl;
+    BenchmarkResult result = makeResult(scenario, "invalid");
+    result.failures = 1;
+    results.push_back(result);
+    return results;
+  }
+
+  std::string path = getBenchmarkFilePath(
+      directory, "aqnwb_bench_read_" + generateUuid() + ".nwb");
+  const SizeType numSamples = generateFile(scenario, path);
+  const SizeType numChannels = scenario.numChannels;
+  const SizeType windowSize = std::min(scenario.windowSize, numSamples);
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<SizeType> windowStart(0,
+                                                      numSamples - windowSize);
+
+  // open
+  BenchmarkResult openCold = makeResult(scenario, "open_cold");
+  BenchmarkResult openWarm = makeResult(scenario, "open_warm");
+  for (SizeType i = 0; i <= scenario.repeats; ++i) {
+    timeOperation(i == 0 ? openCold : openWarm,
+                  [&]()
+                  {
+                    auto io = openFile(path);
+                    auto nwbFile =
+                        NWB::RegisteredType::create<NWB::NWBFile>("/", io);
+                    io->close();
+                    return SizeType {0};
+                  });
+  }
+  results.push_back(openCold);
+  results.push_back(openWarm);
+
+  // type discovery
+  BenchmarkResult findCold = makeResult(scenario, "find_types_cold");
+  for (SizeType i = 0; i < scenario.repeats; ++i) {
+    auto io = openFile(path);
+    timeOperation(findCold,
+                  [&]()
+                  {
+                    io->findTypes("/",
+                                  SearchTypes,
+                                  IO::SearchMode::CONTINUE_ON_TYPE);
+                    return SizeType {0};
+                  });
+    io->close();
+  }
+  results.push_back(findCold);
+
+  auto io = openFile(path);
+  std::unordered_map<std::string, std::string> found =
+      io->findTypes("/", SearchTypes, IO::SearchMode::CONTINUE_ON_TYPE);
+  BenchmarkResult findWarm = makeResult(scenario, "find_types_warm");
+  for (SizeType i = 0; i < scenario.repeats; ++i) {
+    timeOperation(findWarm,
+                  [&]()
+                  {
+                    found = io->findTypes(
+                        "/", SearchTypes, IO::SearchMode::CONTINUE_ON_TYPE);
+                    return SizeType {0};
+                  });
+  }
+  if (found.size() != scenario.numObjects + 1) {
+    ++findWarm.failures;
+  }
+  results.push_back(findWarm);
+
+  BenchmarkResult create = makeResult(scenario, "create");
+  for (const auto& object : found) {
+    timeOperation(create,
+                  [&]()
+                  {
+                    if (NWB::RegisteredType::create(object.first, io)
+                        == nullptr)
+                    {
+                      ++create.failures;
+                    }
+                    return SizeType {0};
+                  });
+  }
+  results.push_back(create);
+
+  // data reads
+  auto series =
+      NWB::RegisteredType::create<NWB::ElectricalSeries>(SeriesPath, io);
+  auto data = series->readData<std::int16_t>();
+
+  BenchmarkResult window = makeResult(scenario, "window");
+  for (SizeType i = 0; i < scenario.repeats; ++i) {
+    SizeType start = windowStart(generator);
+    timeOperation(window,
+                  [&]()
+                  {
+                    auto values =
+                        data->values(SizeArray {start, 0},
+                                     SizeArray {windowSize, numChannels});
+                    return values.data.size() * sizeof(std::int16_t);
+                  });
+  }
+  window.signalSeconds = static_cast<double>(scenario.repeats * windowSize)
+      / scenario.samplingRate;
+  results.push_back(window);
+
+  BenchmarkResult subset = makeResult(scenario, "channel_subset");
+  SizeArray subsetIndices(scenario.subsetChannels);
+  for (SizeType c = 0; c < scenario.subsetChannels; ++c) {
+    subsetIndices[c] = c * numChannels / scenario.subsetChannels;
+  }
+  for (SizeType i = 0; i < scenario.repeats; ++i) {
+    SizeType start = windowStart(generator);
+    SizeArray sampleIndices(windowSize);
+    for (SizeType s = 0; s < windowSize; ++s) {
+      sampleIndices[s] = start + s;
+    }
+    std::vector<SizeArray> selection = {sampleIndices, subsetIndices};
+    timeOperation(subset,
+                  [&]()
+                  {
+                    auto values = data->valuesSelection(selection);
+                    return values.data.size() * sizeof(std::int16_t);
+                  });
+  }
+  subset.signalSeconds = static_cast<double>(scenario.repeats * windowSize)
+      / scenario.samplingRate;
+  results.push_back(subset);
+
+  BenchmarkResult scan = makeResult(scenario, "scan");
+  const auto scanBlock = std::max<SizeType>(
+      1, static_cast<SizeType>(scenario.samplingRate));
+  for (SizeType offset = 0; offset < numSamples; offset += scanBlock) {
+    SizeType count = std::min(scanBlock, numSamples - offset);
+    timeOperation(scan,
+                  [&]()
+                  {
+                    auto values = data->values(SizeArray {offset, 0},
+                                               SizeArray {count, numChannels});
+                    return values.data.size() * sizeof(std::int16_t);
+                  });
+  }
+  scan.signalSeconds =
+      static_cast<double>(numSamples) / scenario.samplingRate;
+  results.push_back(scan);
+
+  // table columns
+  BenchmarkResult columns = makeResult(scenario, "table_columns");
+  auto nwbFile = NWB::RegisteredType::create<NWB::NWBFile>("/", io);
+  for (SizeType i = 0; i < scenario.repeats; ++i) {
+    timeOperation(
+        columns,
+        [&]()
+        {
+          auto table = nwbFile->readElectrodesTable();
+          auto ids = table->readIdColumn()->readData()->values();
+          auto locations = table->readColumn<std::string>("location")
+                               ->readData()
+                               ->values();
+          auto groupNames = table->readColumn<std::string>("group_name")
+                                ->readData()
+                                ->values();
+          if (ids.data.size() != numChannels
+              || locations.data.size() != numChannels
+              || groupNames.data.size() != numChannels)
+          {
+            ++columns.failures;
+          }
+          return ids.data.size() * sizeof(int);
+        });
+  }
+  results.push_back(columns);
+
+  io->close();
+  std::filesystem::remove(path);
+  return results;
+}
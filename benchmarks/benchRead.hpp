@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "benchUtils.hpp"
+
+namespace AQNWB::Benchmarks
+{
+
+/**
+ * @brief Parameters of a read scenario.
+ *
+ * A read scenario generates a synthetic NWB file with an int16
+ * ElectricalSeries of `numChannels` channels and `duration` seconds sampled at
+ * `samplingRate`, plus `numObjects` small AnnotationSeries that make type
+ * discovery more expensive. It then times several read patterns on the file.
+ */
+struct ReadScenario
+{
+  /**
+   * @brief Number of channels of the ElectricalSeries
+   */
+  SizeType numChannels = 64;
+
+  /**
+   * @brief Number of additional typed objects in the file
+   */
+  SizeType numObjects = 16;
+
+  /**
+   * @brief Sampling rate in Hz
+   */
+  double samplingRate = 30000.0;
+
+  /**
+   * @brief Seconds of signal in the file
+   */
+  double duration = 10.0;
+
+  /**
+   * @brief Number of samples per channel of the random window reads
+   */
+  SizeType windowSize = 1000;
+
+  /**
+   * @brief Number of channels of the channel-subset reads. The channels are
+   * spread evenly over all channels.
+   */
+  SizeType subsetChannels = 8;
+
+  /**
+   * @brief Number of repetitions of the open, type discovery, random read,
+   * and column load patterns
+   */
+  SizeType repeats = 100;
+
+  /**
+   * @brief Get the unique name of the scenario
+   */
+  std::string getName() const;
+};
+
+/**
+ * @brief Run a read scenario.
+ *
+ * Generating the file is not timed. The following patterns are timed, each
+ * reported as a separate result named `<scenario name>/<pattern>`:
+ *  - `open_cold`: the first open of the file (read-only) in this process,
+ *    including reading the NWBFile. The file was just written, so the
+ *    operating system cache is not cold.
+ *  - `open_warm`: subsequent opens of the file
+ *  - `find_types_cold`: findTypes for all ElectricalSeries and
+ *    AnnotationSeries on a newly opened I/O object
+ *  - `find_types_warm`: repeated findTypes on the same I/O object after an
+ *    untimed first call
+ *  - `create`: RegisteredType::create for every typed object found
+ *  - `window`: reads of randomly placed windows of all channels via
+ *    ReadDataWrapper::values
+ *  - `channel_subset`: reads of randomly placed windows of a subset of the
+ *    channels via ReadDataWrapper::valuesSelection
+ *  - `scan`: a sequential read of the full data in blocks of one second
+ *  - `table_columns`: loading the id, location, and group_name columns of
+ *    the electrodes table via DynamicTable::readColumn
+ *
+ * Heap allocations are counted for all timed operations.
+ *
+ * @param scenario The scenario to run
+ * @param directory The directory for the generated file
+ * @return The measured results, one per pattern
+ */
+std::vector<BenchmarkResult> runReadScenario(const ReadScenario& scenario,
+                                             const std::string& directory);
+
+}  // namespace AQNWB::Benchmarks
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/WriteStatistics.hpp"
+
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB::Benchmarks
+{
+
+/**
+ * @brief Clock used to measure all benchmarks
+ */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Get the nanoseconds elapsed since a given time point
+ */
+inline std::uint64_t elapsedNanoseconds(Clock::time_point start)
+{
+  return AQNWB::IO::WriteStatistics::elapsedNanoseconds(start);
+}
+
+/**
+ * @brief The result of running a single benchmark scenario
+ */
+struct BenchmarkResult
+{
+  /**
+   * @brief Unique name of the scenario, e.g.,
+   * "write/ch=32/rate=30000/block=1024/int16/all/filters=off"
+   */
+  std::string name;
+
+  /**
+   * @brief The suite the scenario belongs to, e.g., "write"
+   */
+  std::string suite;
+
+  /**
+   * @brief The parameters of the scenario as pairs of name and JSON value
+   */
+  std::vector<std::pair<std::string, std::string>> parameters;
+
+  /**
+   * @brief Number of payload bytes transferred
+   */
+  SizeType bytes = 0;
+
+  /**
+   * @brief Wall time of the timed section in seconds
+   */
+  double seconds = 0.0;
+
+  /**
+   * @brief Seconds of recorded signal the scenario corresponds to, or 0 if
+   * the scenario has no real-time equivalent
+   */
+  double signalSeconds = 0.0;
+
+  /**
+   * @brief Number of timed operations (e.g., blocks written)
+   */
+  SizeType operations = 0;
+
+  /**
+   * @brief Number of operations that failed
+   */
+  SizeType failures = 0;
+
+  /**
+   * @brief Latency of the individual operations
+   */
+  AQNWB::IO::LatencyHistogram latency;
+
+  /**
+   * @brief Mean number of heap allocations per timed operation (after
+   * warm-up, if the scenario has one) on the benchmark thread. See
+   * AllocationCounter.
+   */
+  double allocationsPerOperation = 0.0;
+
+  /**
+   * @brief Mean wall time of a timed operation in microseconds
+   */
+  inline double meanOperationMicroseconds() const
+  {
+    return operations > 0
+        ? seconds * 1e6 / static_cast<double>(operations)
+        : 0.0;
+  }
+
+  /**
+   * @brief Whether the scenario was stopped early because of its time limit
+   */
+  bool truncated = false;
+
+  /**
+   * @brief Sustained throughput in MB/s (10^6 bytes per second)
+   */
+  inline double throughputMBps() const
+  {
+    return seconds > 0.0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+  }
+
+  /**
+   * @brief Real-time headroom factor, i.e., how many times faster than real
+   * time the data was processed. Values below 1 cannot keep up with the
+   * acquisition. 0 if the scenario has no real-time equivalent.
+   */
+  inline double realtimeFactor() const
+  {
+    return seconds > 0.0 ? signalSeconds / seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Quote a string for use as a JSON value
+ */
+inline std::string jsonString(const std::string& value)
+{
+  std::string result = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+/**
+ * @brief Format a number for use as a JSON value
+ */
+template<typename T>
+inline std::string jsonNumber(T value)
+{
+  std::ostringstream out;
+  out << std::setprecision(10) << value;
+  return out.str();
+}
+
+/**
+ * @brief Serialize benchmark results as JSON
+ * @param results The results to serialize
+ * @param out The stream to write to
+ */
+inline void writeResultsJSON(const std::vector<BenchmarkResult>& results,
+                             std::ostream& out)
+{
+  out << "{\n  \"aqnwb_version\": " << jsonString(AQNWB_VERSION)
+      << ",\n  \"build_config\": " << jsonString(BUILD_CONFIG)
+      << ",\n  \"results\": [";
+  for (SizeType i = 0; i < results.size(); ++i) {
+    const BenchmarkResult& result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": "
+        << jsonString(result.name)
+        << ", \"suite\": " << jsonString(result.suite) << ", \"parameters\": {";
+    for (SizeType j = 0; j < result.parameters.size(); ++j) {
+      out << (j == 0 ? "" : ", ") << jsonString(result.parameters[j].first)
+          << ": " << result.parameters[j].second;
+    }
+    const auto& latency = result.latency;
+    out << "}, \"bytes\": " << result.bytes
+        << ", \"seconds\": " << jsonNumber(result.seconds)
+        << ", \"throughput_mb_s\": " << jsonNumber(result.throughputMBps())
+        << ", \"realtime_factor\": " << jsonNumber(result.realtimeFactor())
+        << ", \"operations\": " << result.operations
+        << ", \"failures\": " << result.failures
+        << ", \"allocations_per_op\": "
+        << jsonNumber(result.allocationsPerOperation)
+        << ", \"truncated\": " << (result.truncated ? "true" : "false")
+        << ", \"latency_ns\": {\"count\": " << latency.count()
+        << ", \"min\": " << latency.min()
+        << ", \"mean\": " << jsonNumber(latency.mean())
+        << ", \"p50\": " << latency.percentile(50.0)
+        << ", \"p99\": " << latency.percentile(99.0)
+        << ", \"p99.9\": " << latency.percentile(99.9)
+        << ", \"max\": " << latency.max() << "}}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/**
+ * @brief Print the header of the result table
+ */
+inline void printResultHeader(std::ostream& out)
+{
+  out << std::left << std::setw(60) << "scenario" << std::right
+      << std::setw(10) << "MB/s" << std::setw(10) << "realtime"
+      << std::setw(10) << "p50[us]" << std::setw(10) << "p99[us]"
+      << std::setw(11) << "p99.9[us]" << std::setw(10) << "max[us]"
+      << std::setw(10) << "allocs/op" << std::endl;
+}
+
+/**
+ * @brief Print a result as a row of the result table
+ */
+inline void printResultRow(const BenchmarkResult& result, std::ostream& out)
+{
+  auto micros = [](std::uint64_t ns) { return static_cast<double>(ns) / 1e3; };
+  const auto& latency = result.latency;
+  out << std::left << std::setw(60) << result.name << std::right << std::fixed
+      << std::setprecision(1) << std::setw(10) << result.throughputMBps()
+      << std::setprecision(2) << std::setw(10) << result.realtimeFactor()
+      << std::setprecision(1) << std::setw(10)
+      << micros(latency.percentile(50.0)) << std::setw(10)
+      << micros(latency.percentile(99.0)) << std::setw(11)
+      << micros(latency.percentile(99.9)) << std::setw(10)
+      << micros(latency.max()) << std::setw(10)
+      << result.allocationsPerOperation;
+  if (result.truncated) {
+    out << "  (truncated)";
+  }
+  if (result.failures > 0) {
+    out << "  (" << result.failures << " failures)";
+  }
+  out << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Get the path of a scratch file of a benchmark and remove any old
+ * file at the path
+ * @param directory The directory for scratch files (created if missing)
+ * @param filename The name of the file
+ */
+inline std::string getBenchmarkFilePath(const std::string& directory,
+                                        const std::string& filename)
+{
+  std::filesystem::path dirPath(directory);
+  std::filesystem::create_directories(dirPath);
+  std::filesystem::path filePath = dirPath / filename;
+  std::filesystem::remove(filePath);
+  return filePath.generic_string();
+}
+
+}  // namespace AQNWB::Benchmarks
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "benchWrite.hpp"
+
+#include "testAllocationCounter.hpp"
+
+#include "Channel.hpp"
+#include "Utils.hpp"
+#include "io/hdf5/HDF5ArrayDataSetConfig.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "io/zarr/ZarrIO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+
+using namespace AQNWB;
+using namespace AQNWB::Benchmarks;
+
+namespace
+{
+/**
+ * @brief Number of distinct data blocks cycled through while writing
+ */
+constexpr SizeType NumDistinctBlocks = 2;
+
+/**
+ * @brief Number of blocks written before allocations are counted
+ */
+constexpr SizeType WarmUpBlocks = 1;
+
+/**
+ * @brief Chunk size along time, matching NWBFile::createElectricalSeries
+ */
+constexpr SizeType ChunkSize = 2048;
+
+/**
+ * @brief Maximum number of channels per chunk of the Zarr backend, such that
+ * each block of samples spans several chunk files that are written in
+ * parallel
+ */
+constexpr SizeType ZarrChannelChunkSize = 64;
+
+/**
+ * @brief The constant pi
+ */
+constexpr double Pi = 3.14159265358979323846;
+
+/**
+ * @brief Generate blocks of synthetic extracellular signals, i.e., a sine
+ * with a per-channel phase plus Gaussian noise, in the given layout.
+ * @param scenario The scenario to generate data for
+ * @param interleaved True for [sample][channel], false for [channel][sample]
+ * @return NumDistinctBlocks blocks of blockSize * numChannels samples
+ */
+template<typename T>
+std::vector<std::vector<T>> generateBlocks(const WriteScenario& scenario,
+                                           bool interleaved)
+{
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0.0, 50.0);
+  const SizeType numChannels = scenario.numChannels;
+  const SizeType blockSize = scenario.blockSize;
+
+  std::vector<std::vector<T>> blocks(NumDistinctBlocks);
+  for (SizeType b = 0; b < NumDistinctBlocks; ++b) {
+    blocks[b].resize(numChannels * blockSize);
+    for (SizeType c = 0; c < numChannels; ++c) {
+      for (SizeType s = 0; s < blockSize; ++s) {
+        double t =
+            static_cast<double>(b * blockSize + s) / scenario.samplingRate;
+        double value =
+            500.0 * std::sin(2.0 * Pi * 10.0 * t + static_cast<double>(c))
+            + noise(generator);
+        SizeType index =
+            interleaved ? s * numChannels + c : c * blockSize + s;
+        blocks[b][index] = static_cast<T>(value);
+      }
+    }
+  }
+  return blocks;
+}
+
+/**
+ * @brief Record the scenario with input samples of type T
+ */
+template<typename T>
+void recordScenario(const WriteScenario& scenario,
+                    NWB::ElectricalSeries& series,
+                    std::shared_ptr<IO::BaseIO> io,
+                    BenchmarkResult& result)
+{
+  const bool writeAll = (scenario.writeMode == "all");
+  const SizeType numChannels = scenario.numChannels;
+  const SizeType blockSize = scenario.blockSize;
+  const auto numBlocks = static_cast<SizeType>(std::ceil(
+      scenario.duration * scenario.samplingRate
+      / static_cast<double>(blockSize)));
+  const std::vector<std::vector<T>> blocks =
+      generateBlocks<T>(scenario, writeAll);
+  std::vector<double> timestamps(blockSize);
+
+  const auto timeLimit =
+      static_cast<std::uint64_t>(scenario.timeLimit * 1e9);
+  auto overTimeLimit = [&](Clock::time_point start)
+  { return timeLimit > 0 && elapsedNanoseconds(start) > timeLimit; };
+
+  // number of samples written, summed over all channels
+  SizeType samplesWritten = 0;
+  // allocations and blocks after warm-up
+  std::uint64_t allocations = 0;
+  SizeType allocationBlocks = 0;
+  auto start = Clock::now();
+  for (SizeType b = 0; b < numBlocks && !result.truncated; ++b) {
+    for (SizeType s = 0; s < blockSize; ++s) {
+      timestamps[s] =
+          static_cast<double>(b * blockSize + s) / scenario.samplingRate;
+    }
+    const T* block = blocks[b % NumDistinctBlocks].data();
+
+    AllocationCounter blockAllocations;
+    auto blockStart = Clock::now();
+    Status status = Status::Success;
+    if (writeAll) {
+      status =
+          series.writeAllChannels(blockSize,
+                                  static_cast<const void*>(block),
+                                  static_cast<const void*>(timestamps.data()));
+      samplesWritten += blockSize * numChannels;
+    } else {
+      for (SizeType c = 0; c < numChannels && !result.truncated; ++c) {
+        status = status
+            && series.writeChannel(
+                c,
+                blockSize,
+                static_cast<const void*>(block + c * blockSize),
+                static_cast<const void*>(timestamps.data()));
+        samplesWritten += blockSize;
+        result.truncated = (c + 1 < numChannels) && overTimeLimit(start);
+      }
+    }
+    if (status != Status::Success) {
+      ++result.failures;
+    }
+    if (!result.truncated) {
+      result.latency.record(elapsedNanoseconds(blockStart));
+      if (b >= WarmUpBlocks) {
+        allocations += blockAllocations.getCount();
+        ++allocationBlocks;
+      }
+      ++result.operations;
+      result.truncated = (b + 1 < numBlocks) && overTimeLimit(start);
+    }
+  }
+  if (io->flush() != Status::Success) {
+    ++result.failures;
+  }
+  result.seconds = static_cast<double>(elapsedNanoseconds(start)) / 1e9;
+  result.bytes = samplesWritten * sizeof(T);
+  if (allocationBlocks > 0) {
+    result.allocationsPerOperation = static_cast<double>(allocations)
+        / static_cast<double>(allocationBlocks);
+  }
+  result.signalSeconds = static_cast<double>(samplesWritten)
+      / static_cast<double>(numChannels) / scenario.samplingRate;
+}
+}  // namespace
+
+std::string WriteScenario::getName() const
+{
+  std::ostringstream name;
+  name << "write/ch=" << numChannels << "/rate=" << samplingRate
+       << "/block=" << blockSize << "/" << dataType << "/" << writeMode
+       << "/filters=" << (filters ? "on" : "off");
+  // HDF5 is the default and keeps the names of existing baselines
+  if (backend != "hdf5") {
+    name << "/" << backend;
+  }
+  return name.str();
+}
+
+BenchmarkResult AQNWB::Benchmarks::runWriteScenario(
+    const WriteScenario& scenario, const std::string& directory)
+{
+  BenchmarkResult result;
+  result.name = scenario.getName();
+  result.suite = "write";
+  result.parameters = {
+      {"channels", jsonNumber(scenario.numChannels)},
+      {"sampling_rate", jsonNumber(scenario.samplingRate)},
+      {"block_size", jsonNumber(scenario.blockSize)},
+      {"dtype", jsonString(scenario.dataType)},
+      {"mode", jsonString(scenario.writeMode)},
+      {"filters", scenario.filters ? "true" : "false"},
+      {"backend", jsonString(scenario.backend)},
+      {"duration_s", jsonNumber(scenario.duration)},
+      {"time_limit_s", jsonNumber(scenario.timeLimit)}};
+
+  const bool isInt16 = (scenario.dataType == "int16");
+  const bool isZarr = (scenario.backend == "zarr");
+  if ((!isInt16 && scenario.dataType != "float32")
+      || (!isZarr && scenario.backend != "hdf5")
+      || (scenario.writeMode != "all" && scenario.writeMode != "channel")
+      || scenario.numChannels == 0 || scenario.blockSize == 0)
+  {
+    std::cerr << "runWriteScenario: invalid scenario " << result.name
+              << std::endl;
+    result.failures = 1;
+    return result;
+  }
+  const IO::BaseDataType dataType =
+      isInt16 ? IO::BaseDataType::I16 : IO::BaseDataType::F32;
+
+  std::string path = getBenchmarkFilePath(
+      directory,
+      "aqnwb_bench_write_" + generateUuid() + (isZarr ? ".nwb.zarr" : ".nwb"));
+  {
+    std::shared_ptr<IO::BaseIO> io;
+    if (isZarr) {
+      io = std::make_shared<IO::Zarr::ZarrIO>(path, scenario.filters ? 1 : 0);
+    } else {
+      io = std::make_shared<IO::HDF5::HDF5IO>(path);
+    }
+    io->open();
+    auto nwbFile = NWB::NWBFile::create(io);
+    nwbFile->initialize(generateUuid());
+
+    Types::ChannelVector channels;
+    for (SizeType c = 0; c < scenario.numChannels; ++c) {
+      channels.emplace_back("ch" + std::to_string(c), "array0", 0, c, c);
+    }
+    auto electrodesTable = nwbFile->createElectrodesTable({channels});
+
+    // HDF5 chunks span all channels, Zarr chunks are split across channels
+    const SizeType channelChunkSize = isZarr
+        ? std::min(scenario.numChannels, ZarrChannelChunkSize)
+        : 0;
+    IO::HDF5::HDF5ArrayDataSetConfig config(
+        dataType,
+        SizeArray {0, scenario.numChannels},
+        SizeArray {ChunkSize, channelChunkSize});
+    if (scenario.filters && !isZarr) {
+      config.addFilter(IO::HDF5::HDF5FilterConfig::createShuffleFilter());
+      config.addFilter(IO::HDF5::HDF5FilterConfig::createGzipFilter(1));
+    }
+    auto series =
+        nwbFile->createAquisitionSeries<NWB::ElectricalSeries>("benchmark");
+    series->initialize(config, channels, "acquisition benchmark");
+    io->startRecording();
+
+    if (isInt16) {
+      recordScenario<std::int16_t>(scenario, *series, io, result);
+    } else {
+      recordScenario<float>(scenario, *series, io, result);
+    }
+
+    io->stopRecording();
+    io->close();
+  }
+  std::filesystem::remove_all(path);
+  return result;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "benchUtils.hpp"
+
+namespace AQNWB::Benchmarks
+{
+
+/**
+ * @brief Parameters of an acquisition (write) scenario.
+ *
+ * A scenario records `duration` seconds of a single ElectricalSeries with
+ * `numChannels` channels sampled at `samplingRate` in blocks of `blockSize`
+ * samples per channel, as an acquisition system would.
+ */
+struct WriteScenario
+{
+  /**
+   * @brief Number of channels of the ElectricalSeries
+   */
+  SizeType numChannels = 32;
+
+  /**
+   * @brief Sampling rate in Hz
+   */
+  double samplingRate = 30000.0;
+
+  /**
+   * @brief Number of samples per channel written per call
+   */
+  SizeType blockSize = 1024;
+
+  /**
+   * @brief The storage (and input) type, "int16" or "float32"
+   */
+  std::string dataType = "int16";
+
+  /**
+   * @brief "all" to write blocks via ElectricalSeries::writeAllChannels,
+   * "channel" to write each channel via ElectricalSeries::writeChannel
+   */
+  std::string writeMode = "all";
+
+  /**
+   * @brief Whether the data is compressed with the shuffle and gzip filters
+   */
+  bool filters = false;
+
+  /**
+   * @brief The I/O backend, "hdf5" or "zarr". Zarr compresses with zlib
+   * instead of shuffle and gzip.
+   */
+  std::string backend = "hdf5";
+
+  /**
+   * @brief Seconds of signal to record
+   */
+  double duration = 1.0;
+
+  /**
+   * @brief Wall time in seconds after which the scenario is stopped early,
+   * or 0 for no limit
+   */
+  double timeLimit = 0.0;
+
+  /**
+   * @brief Get the unique name of the scenario
+   */
+  std::string getName() const;
+};
+
+/**
+ * @brief Run an acquisition scenario.
+ *
+ * Each block written is one timed operation: a single writeAllChannels call,
+ * or one writeChannel call per channel. The final flush is included in the
+ * wall time. If the time limit is exceeded, the scenario stops after the
+ * current write call and the result is marked as truncated; throughput and
+ * real-time factor then refer to the data written until then. Heap
+ * allocations are counted for every block after the first (warm-up) block.
+ * The recorded file is removed afterwards.
+ *
+ * @param scenario The scenario to run
+ * @param directory The directory for the recorded file
+ * @return The measured result
+ */
+BenchmarkResult runWriteScenario(const WriteScenario& scenario,
+                                 const std::string& directory);
+
+}  // namespace AQNWB::Benchmarks
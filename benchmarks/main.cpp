@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "benchBaseline.hpp"
+#include "benchRead.hpp"
+#include "benchUtils.hpp"
+#include "benchWrite.hpp"
+
+using namespace AQNWB::Benchmarks;
+
+namespace
+{
+/**
+ * @brief Command line options of aqnwb_bench
+ */
+struct Options
+{
+  std::vector<std::string> suites = {"write", "read"};
+  std::vector<SizeType> channels = {32, 256, 1024, 4096};
+  std::vector<double> samplingRates = {30000.0};
+  std::vector<SizeType> blockSizes = {1024};
+  std::vector<std::string> dataTypes = {"int16", "float32"};
+  std::vector<std::string> writeModes = {"all", "channel"};
+  std::vector<std::string> filters = {"off", "on"};
+  std::vector<std::string> backends = {"hdf5"};
+  double duration = 1.0;
+  double timeLimit = 10.0;
+  std::vector<SizeType> readChannels = {64, 1024};
+  std::vector<SizeType> readObjects = {16, 1000};
+  double readDuration = 10.0;
+  SizeType windowSize = 1000;
+  SizeType subsetChannels = 8;
+  SizeType repeats = 100;
+  std::string outputDir = "aqnwb_bench_data";
+  std::string jsonFile;
+  std::string baselineFile;
+  std::string writeBaselineFile;
+  double timeTolerance = 3.0;
+  double allocationTolerance = 0.5;
+  bool listOnly = false;
+};
+
+void printUsage(const char* programName)
+{
+  std::cout
+      << "Usage: " << programName << " [options]\n\n"
+      << "Runs the benchmarks of the selected suites for every combination\n"
+      << "of the given parameters. Lists are comma-separated.\n\n"
+      << "Options:\n"
+      << "  --suites LIST       write, read (default write,read)\n\n"
+      << "Write suite:\n"
+      << "  --channels LIST     channel counts (default 32,256,1024,4096)\n"
+      << "  --rates LIST        sampling rates in Hz (default 30000)\n"
+      << "  --block-sizes LIST  samples per channel and write (default 1024)\n"
+      << "  --dtypes LIST       int16, float32 (default int16,float32)\n"
+      << "  --modes LIST        all (writeAllChannels) or channel\n"
+      << "                      (writeChannel) (default all,channel)\n"
+      << "  --filters LIST      off, on (shuffle + gzip) (default off,on)\n"
+      << "  --backends LIST     hdf5, zarr (zlib filter) (default hdf5)\n"
+      << "  --duration SECONDS  seconds of signal per scenario (default 1)\n"
+      << "  --time-limit SECONDS  stop a scenario early after this wall time,\n"
+      << "                      0 for no limit (default 10)\n\n"
+      << "Read suite:\n"
+      << "  --read-channels LIST  channel counts (default 64,1024)\n"
+      << "  --read-objects LIST   additional typed objects (default 16,1000)\n"
+      << "  --read-duration SECONDS  seconds of signal in the file\n"
+      << "                      (default 10)\n"
+      << "  --window SAMPLES    samples of the random window reads\n"
+      << "                      (default 1000)\n"
+      << "  --subset-channels N  channels of the subset reads (default 8)\n"
+      << "  --repeats N         repetitions of the timed patterns\n"
+      << "                      (default 100)\n\n"
+      << "General:\n"
+      << "  --output-dir DIR    directory for scratch files\n"
+      << "                      (default aqnwb_bench_data)\n"
+      << "  --json FILE         also write the results as JSON, - for stdout\n"
+      << "  --baseline FILE     fail on regressions against a baseline file\n"
+      << "  --write-baseline FILE  write the results as a baseline file\n"
+      << "  --time-tolerance X  allowed relative increase of the mean\n"
+      << "                      operation time (default 3, i.e., 4x)\n"
+      << "  --allocation-tolerance X  allowed allocations per operation of\n"
+      << "                      scenarios that do not allocate in the\n"
+      << "                      baseline (default 0.5)\n"
+      << "  --list              only list the scenarios\n"
+      << "  --help              show this message\n";
+}
+
+/**
+ * @brief Split a comma-separated list and convert each item
+ */
+template<typename T>
+std::vector<T> parseList(const std::string& text,
+                         const std::function<T(const std::string&)>& convert)
+{
+  std::vector<T> values;
+  std::istringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      values.push_back(convert(item));
+    }
+  }
+  if (values.empty()) {
+    throw std::invalid_argument("empty list '" + text + "'");
+  }
+  return values;
+}
+
+SizeType toSize(const std::string& text)
+{
+  return static_cast<SizeType>(std::stoull(text));
+}
+
+double toDouble(const std::string& text)
+{
+  return std::stod(text);
+}
+
+std::string toString(const std::string& text)
+{
+  return text;
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+  Options options;
+  std::map<std::string, std::function<void(const std::string&)>> parsers = {
+      {"--suites",
+       [&](const std::string& v)
+       { options.suites = parseList<std::string>(v, toString); }},
+      {"--channels",
+       [&](const std::string& v)
+       { options.channels = parseList<SizeType>(v, toSize); }},
+      {"--rates",
+       [&](const std::string& v)
+       { options.samplingRates = parseList<double>(v, toDouble); }},
+      {"--block-sizes",
+       [&](const std::string& v)
+       { options.blockSizes = parseList<SizeType>(v, toSize); }},
+      {"--dtypes",
+       [&](const std::string& v)
+       { options.dataTypes = parseList<std::string>(v, toString); }},
+      {"--modes",
+       [&](const std::string& v)
+       { options.writeModes = parseList<std::string>(v, toString); }},
+      {"--filters",
+       [&](const std::string& v)
+       { options.filters = parseList<std::string>(v, toString); }},
+      {"--backends",
+       [&](const std::string& v)
+       { options.backends = parseList<std::string>(v, toString); }},
+      {"--duration",
+       [&](const std::string& v) { options.duration = toDouble(v); }},
+      {"--time-limit",
+       [&](const std::string& v) { options.timeLimit = toDouble(v); }},
+      {"--read-channels",
+       [&](const std::string& v)
+       { options.readChannels = parseList<SizeType>(v, toSize); }},
+      {"--read-objects",
+       [&](const std::string& v)
+       { options.readObjects = parseList<SizeType>(v, toSize); }},
+      {"--read-duration",
+       [&](const std::string& v) { options.readDuration = toDouble(v); }},
+      {"--window",
+       [&](const std::string& v) { options.windowSize = toSize(v); }},
+      {"--subset-channels",
+       [&](const std::string& v) { options.subsetChannels = toSize(v); }},
+      {"--repeats", [&](const std::string& v) { options.repeats = toSize(v); }},
+      {"--output-dir",
+       [&](const std::string& v) { options.outputDir = v; }},
+      {"--json", [&](const std::string& v) { options.jsonFile = v; }},
+      {"--baseline",
+       [&](const std::string& v) { options.baselineFile = v; }},
+      {"--write-baseline",
+       [&](const std::string& v) { options.writeBaselineFile = v; }},
+      {"--time-tolerance",
+       [&](const std::string& v) { options.timeTolerance = toDouble(v); }},
+      {"--allocation-tolerance",
+       [&](const std::string& v)
+       { options.allocationTolerance = toDouble(v); }}};
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    }
+    if (arg == "--list") {
+      options.listOnly = true;
+      continue;
+    }
+    auto parser = parsers.find(arg);
+    if (parser == parsers.end()) {
+      throw std::invalid_argument("unknown option '" + arg + "'");
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("missing value for '" + arg + "'");
+    }
+    parser->second(argv[++i]);
+  }
+  for (const std::string& suite : options.suites) {
+    if (suite != "write" && suite != "read") {
+      throw std::invalid_argument("unknown suite '" + suite + "'");
+    }
+  }
+  return options;
+}
+
+bool hasSuite(const Options& options, const std::string& suite)
+{
+  return std::find(options.suites.begin(), options.suites.end(), suite)
+      != options.suites.end();
+}
+
+std::vector<WriteScenario> makeWriteScenarios(const Options& options)
+{
+  std::vector<WriteScenario> scenarios;
+  if (!hasSuite(options, "write")) {
+    return scenarios;
+  }
+  for (SizeType numChannels : options.channels) {
+    for (double samplingRate : options.samplingRates) {
+      for (SizeType blockSize : options.blockSizes) {
+        for (const std::string& dataType : options.dataTypes) {
+          for (const std::string& writeMode : options.writeModes) {
+            for (const std::string& filters : options.filters) {
+              for (const std::string& backend : options.backends) {
+                WriteScenario scenario;
+                scenario.numChannels = numChannels;
+                scenario.samplingRate = samplingRate;
+                scenario.blockSize = blockSize;
+                scenario.dataType = dataType;
+                scenario.writeMode = writeMode;
+                scenario.filters = (filters == "on");
+                scenario.backend = backend;
+                scenario.duration = options.duration;
+                scenario.timeLimit = options.timeLimit;
+                scenarios.push_back(scenario);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return scenarios;
+}
+
+std::vector<ReadScenario> makeReadScenarios(const Options& options)
+{
+  std::vector<ReadScenario> scenarios;
+  if (!hasSuite(options, "read")) {
+    return scenarios;
+  }
+  for (SizeType numChannels : options.readChannels) {
+    for (SizeType numObjects : options.readObjects) {
+      ReadScenario scenario;
+      scenario.numChannels = numChannels;
+      scenario.numObjects = numObjects;
+      scenario.samplingRate = options.samplingRates.front();
+      scenario.duration = options.readDuration;
+      scenario.windowSize = options.windowSize;
+      scenario.subsetChannels = std::min(options.subsetChannels, numChannels);
+      scenario.repeats = options.repeats;
+      scenarios.push_back(scenario);
+    }
+  }
+  return scenarios;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  try {
+    options = parseOptions(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << "aqnwb_bench: " << e.what() << "\n\n";
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  Baseline baseline;
+  if (!options.baselineFile.empty()) {
+    try {
+      baseline = readBaseline(options.baselineFile);
+    } catch (const std::exception& e) {
+      std::cerr << "aqnwb_bench: " << e.what() << std::endl;
+      return 2;
+    }
+  }
+
+  // HDF5 reports expected lookups of missing objects on stderr, which would
+  // clutter the results
+  H5::Exception::dontPrint();
+
+  std::vector<WriteScenario> writeScenarios = makeWriteScenarios(options);
+  std::vector<ReadScenario> readScenarios = makeReadScenarios(options);
+  if (options.listOnly) {
+    for (const auto& scenario : writeScenarios) {
+      std::cout << scenario.getName() << std::endl;
+    }
+    for (const auto& scenario : readScenarios) {
+      std::cout << scenario.getName() << std::endl;
+    }
+    return 0;
+  }
+
+  // keep stdout clean for the JSON document
+  std::ostream& table = (options.jsonFile == "-") ? std::cerr : std::cout;
+  printResultHeader(table);
+  std::vector<BenchmarkResult> results;
+  SizeType failures = 0;
+  for (const auto& scenario : writeScenarios) {
+    results.push_back(runWriteScenario(scenario, options.outputDir));
+    printResultRow(results.back(), table);
+    failures += results.back().failures;
+  }
+  for (const auto& scenario : readScenarios) {
+    for (const auto& result : runReadScenario(scenario, options.outputDir)) {
+      results.push_back(result);
+      printResultRow(result, table);
+      failures += result.failures;
+    }
+  }
+
+  if (options.jsonFile == "-") {
+    writeResultsJSON(results, std::cout);
+  } else if (!options.jsonFile.empty()) {
+    std::ofstream file(options.jsonFile);
+    if (!file) {
+      std::cerr << "aqnwb_bench: could not open " << options.jsonFile
+                << std::endl;
+      return 1;
+    }
+    writeResultsJSON(results, file);
+  }
+  if (!options.writeBaselineFile.empty()) {
+    std::ofstream file(options.writeBaselineFile);
+    if (!file) {
+      std::cerr << "aqnwb_bench: could not open " << options.writeBaselineFile
+                << std::endl;
+      return 1;
+    }
+    writeBaseline(results, file);
+  }
+  if (!options.baselineFile.empty()) {
+    failures += checkBaseline(results,
+                              baseline,
+                              options.timeTolerance,
+                              options.allocationTolerance,
+                              table);
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -1,10 +1,39 @@
 include(cmake/folders.cmake)
 
 include(CTest)
+option(BUILD_BENCHMARKS "Build the aqnwb_bench benchmark executable" ON)
+option(AQNWB_PERF_TESTS
+    "Register the perf-labelled regression tests of aqnwb_bench with CTest" OFF)
+
+# Per-thread heap allocation counter shared by aqnwb_test and aqnwb_bench. It
+# replaces the global allocation functions of the executable it is linked
+# into, so it is an object library rather than part of aqnwb itself.
+if(BUILD_TESTING OR BUILD_BENCHMARKS)
+  add_library(aqnwb_allocation_counter OBJECT
+      tests/testAllocationCounter.cpp
+  )
+  target_include_directories(aqnwb_allocation_counter PUBLIC
+      "${PROJECT_SOURCE_DIR}/tests"
+  )
+  set_target_properties(aqnwb_allocation_counter PROPERTIES
+      CXX_STANDARD ${AQNWB_CXX_STANDARD}
+      CXX_STANDARD_REQUIRED ON
+  )
+endif()
+
 if(BUILD_TESTING)
   add_subdirectory(tests)
 endif()
 
+if(BUILD_BENCHMARKS)
+  add_subdirectory(benchmarks)
+endif()
+
+option(BUILD_TOOLS "Build the aqnwb_pack tool" ON)
+if(BUILD_TOOLS)
+  add_subdirectory(tools)
+endif()
+
 option(BUILD_DOCS "Build documentation using Doxygen" OFF)
 if(BUILD_DOCS)
   include(cmake/docs.cmake)
@@ -1,5 +1,7 @@
 include(CMakeFindDependencyMacro)
 
 find_dependency(HDF5 COMPONENTS CXX)
+# optional, needed to link static builds with zlib support
+find_package(ZLIB QUIET)
 
 include("${CMAKE_CURRENT_LIST_DIR}/aqnwbTargets.cmake")
\ No newline at end of file
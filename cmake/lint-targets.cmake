@@ -3,6 +3,7 @@ set(
     src/*.cpp src/*.hpp
     include/*.hpp
     tests/*.cpp tests/*.hpp
+    benchmarks/*.cpp benchmarks/*.hpp
     CACHE STRING
     "; separated patterns relative to the project source dir to format"
 )
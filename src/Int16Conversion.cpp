@@ -0,0 +1,496 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include "Int16Conversion.hpp"
+
+#include "Utils.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) \
+    || defined(_M_IX86)
+#  define AQNWB_SIMD_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#else
+#  define AQNWB_SIMD_X86 0
+#endif
+
+// GCC and Clang only allow intrinsics of instruction sets that are enabled
+// for the enclosing function. MSVC allows all intrinsics everywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#  define AQNWB_TARGET(isa) __attribute__((target(isa)))
+#else
+#  define AQNWB_TARGET(isa)
+#endif
+
+using namespace AQNWB;
+
+namespace
+{
+constexpr double kMaxInt16 = 32767.0;
+
+/**
+ * @brief Number of scales in the repeated scale pattern of the interleaved
+ * conversion
+ */
+constexpr SizeType kScalePatternSize = 256;
+
+/**
+ * @brief Reference conversion of a single value
+ *
+ * The comparisons are written such that NaN is mapped to -kMaxInt16, which
+ * is what the max/min instructions of the vectorized kernels do.
+ */
+inline int16_t convertValue(float value, float scale)
+{
+  double scaled = kMaxInt16 * static_cast<double>(value * scale);
+  scaled = (scaled > -kMaxInt16) ? scaled : -kMaxInt16;
+  scaled = (scaled < kMaxInt16) ? scaled : kMaxInt16;
+  return static_cast<int16_t>(std::round(scaled));
+}
+
+/**
+ * @brief Scalar conversion of the values [start, stop)
+ */
+void convertScalar(const float* source,
+                   int16_t* dest,
+                   SizeType start,
+                   SizeType stop,
+                   float scale)
+{
+  for (SizeType i = start; i < stop; ++i) {
+    uint16_t bits = detail::to_little_endian_u16(
+        static_cast<uint16_t>(convertValue(source[i], scale)));
+    std::memcpy(dest + i, &bits, sizeof(bits));
+  }
+}
+
+/**
+ * @brief Scalar conversion of the values [start, stop) with a separate scale
+ * for each value
+ */
+void convertScalarScaled(const float* source,
+                         int16_t* dest,
+                         SizeType start,
+                         SizeType stop,
+                         const float* scales)
+{
+  for (SizeType i = start; i < stop; ++i) {
+    uint16_t bits = detail::to_little_endian_u16(
+        static_cast<uint16_t>(convertValue(source[i], scales[i])));
+    std::memcpy(dest + i, &bits, sizeof(bits));
+  }
+}
+
+#if AQNWB_SIMD_X86
+
+// The vectorized kernels round half away from zero like std::round by
+// truncating and correcting by one where the remainder is >= 0.5. Since
+// 32767 * x is exact in double precision for every float x, this gives the
+// same result as the scalar conversion.
+
+AQNWB_TARGET("sse2")
+inline __m128i roundClampSSE2(__m128d value)
+{
+  value = _mm_min_pd(_mm_max_pd(value, _mm_set1_pd(-kMaxInt16)),
+                     _mm_set1_pd(kMaxInt16));
+  __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(value));
+  __m128d remainder = _mm_sub_pd(value, truncated);
+  __m128d one = _mm_set1_pd(1.0);
+  truncated = _mm_add_pd(
+      truncated,
+      _mm_and_pd(_mm_cmpge_pd(remainder, _mm_set1_pd(0.5)), one));
+  truncated = _mm_sub_pd(
+      truncated,
+      _mm_and_pd(_mm_cmple_pd(remainder, _mm_set1_pd(-0.5)), one));
+  return _mm_cvttpd_epi32(truncated);
+}
+
+AQNWB_TARGET("sse2")
+inline void storeSSE2(__m128 values, int16_t* dest)
+{
+  const __m128d maxVec = _mm_set1_pd(kMaxInt16);
+  __m128d low = _mm_mul_pd(_mm_cvtps_pd(values), maxVec);
+  __m128d high =
+      _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(values, values)), maxVec);
+  __m128i packed32 =
+      _mm_unpacklo_epi64(roundClampSSE2(low), roundClampSSE2(high));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dest),
+                   _mm_packs_epi32(packed32, packed32));
+}
+
+AQNWB_TARGET("sse2")
+void convertSSE2(const float* source,
+                 int16_t* dest,
+                 SizeType numSamples,
+                 float scale)
+{
+  const __m128 scaleVec = _mm_set1_ps(scale);
+  SizeType i = 0;
+  for (; i + 4 <= numSamples; i += 4) {
+    storeSSE2(_mm_mul_ps(_mm_loadu_ps(source + i), scaleVec), dest + i);
+  }
+  convertScalar(source, dest, i, numSamples, scale);
+}
+
+AQNWB_TARGET("sse2")
+void convertScaledSSE2(const float* source,
+                       int16_t* dest,
+                       SizeType numSamples,
+                       const float* scales)
+{
+  SizeType i = 0;
+  for (; i + 4 <= numSamples; i += 4) {
+    storeSSE2(_mm_mul_ps(_mm_loadu_ps(source + i), _mm_loadu_ps(scales + i)),
+              dest + i);
+  }
+  convertScalarScaled(source, dest, i, numSamples, scales);
+}
+
+AQNWB_TARGET("avx2")
+inline __m128i roundClampAVX2(__m256d value)
+{
+  value = _mm256_min_pd(_mm256_max_pd(value, _mm256_set1_pd(-kMaxInt16)),
+                        _mm256_set1_pd(kMaxInt16));
+  __m256d truncated =
+      _mm256_round_pd(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  __m256d remainder = _mm256_sub_pd(value, truncated);
+  __m256d one = _mm256_set1_pd(1.0);
+  truncated = _mm256_add_pd(
+      truncated,
+      _mm256_and_pd(_mm256_cmp_pd(remainder, _mm256_set1_pd(0.5), _CMP_GE_OQ),
+                    one));
+  truncated = _mm256_sub_pd(
+      truncated,
+      _mm256_and_pd(
+          _mm256_cmp_pd(remainder, _mm256_set1_pd(-0.5), _CMP_LE_OQ), one));
+  return _mm256_cvttpd_epi32(truncated);
+}
+
+AQNWB_TARGET("avx2")
+inline void storeAVX2(__m256 values, int16_t* dest)
+{
+  const __m256d maxVec = _mm256_set1_pd(kMaxInt16);
+  __m256d low =
+      _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(values)), maxVec);
+  __m256d high =
+      _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)), maxVec);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                   _mm_packs_epi32(roundClampAVX2(low), roundClampAVX2(high)));
+}
+
+AQNWB_TARGET("avx2")
+void convertAVX2(const float* source,
+                 int16_t* dest,
+                 SizeType numSamples,
+                 float scale)
+{
+  const __m256 scaleVec = _mm256_set1_ps(scale);
+  SizeType i = 0;
+  for (; i + 8 <= numSamples; i += 8) {
+    storeAVX2(_mm256_mul_ps(_mm256_loadu_ps(source + i), scaleVec), dest + i);
+  }
+  convertScalar(source, dest, i, numSamples, scale);
+}
+
+AQNWB_TARGET("avx2")
+void convertScaledAVX2(const float* source,
+                       int16_t* dest,
+                       SizeType numSamples,
+                       const float* scales)
+{
+  SizeType i = 0;
+  for (; i + 8 <= numSamples; i += 8) {
+    storeAVX2(
+        _mm256_mul_ps(_mm256_loadu_ps(source + i), _mm256_loadu_ps(scales + i)),
+        dest + i);
+  }
+  convertScalarScaled(source, dest, i, numSamples, scales);
+}
+
+// GCC 12 reports false positives for the AVX-512 intrinsics themselves, and
+// _mm512_roundscale_pd converts its all-ones __mmask8 to char
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wsign-conversion"
+#  endif
+
+AQNWB_TARGET("avx512f")
+inline __m256i roundClampAVX512(__m512d value)
+{
+  value = _mm512_min_pd(_mm512_max_pd(value, _mm512_set1_pd(-kMaxInt16)),
+                        _mm512_set1_pd(kMaxInt16));
+  __m512d truncated =
+      _mm512_roundscale_pd(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  __m512d remainder = _mm512_sub_pd(value, truncated);
+  __m512d one = _mm512_set1_pd(1.0);
+  truncated = _mm512_mask_add_pd(
+      truncated,
+      _mm512_cmp_pd_mask(remainder, _mm512_set1_pd(0.5), _CMP_GE_OQ),
+      truncated,
+      one);
+  truncated = _mm512_mask_sub_pd(
+      truncated,
+      _mm512_cmp_pd_mask(remainder, _mm512_set1_pd(-0.5), _CMP_LE_OQ),
+      truncated,
+      one);
+  return _mm512_cvttpd_epi32(truncated);
+}
+
+AQNWB_TARGET("avx512f")
+inline void storeAVX512(__m512 values, int16_t* dest)
+{
+  const __m512d maxVec = _mm512_set1_pd(kMaxInt16);
+  __m512d low =
+      _mm512_mul_pd(_mm512_cvtps_pd(_mm512_castps512_ps256(values)), maxVec);
+  __m512d high = _mm512_mul_pd(
+      _mm512_cvtps_pd(_mm256_castpd_ps(
+          _mm512_extractf64x4_pd(_mm512_castps_pd(values), 1))),
+      maxVec);
+  __m512i packed32 =
+      _mm512_inserti64x4(_mm512_castsi256_si512(roundClampAVX512(low)),
+                         roundClampAVX512(high),
+                         1);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest),
+                      _mm512_cvtsepi32_epi16(packed32));
+}
+
+AQNWB_TARGET("avx512f")
+void convertAVX512(const float* source,
+                   int16_t* dest,
+                   SizeType numSamples,
+                   float scale)
+{
+  const __m512 scaleVec = _mm512_set1_ps(scale);
+  SizeType i = 0;
+  for (; i + 16 <= numSamples; i += 16) {
+    storeAVX512(_mm512_mul_ps(_mm512_loadu_ps(source + i), scaleVec),
+                dest + i);
+  }
+  convertScalar(source, dest, i, numSamples, scale);
+}
+
+AQNWB_TARGET("avx512f")
+void convertScaledAVX512(const float* source,
+                         int16_t* dest,
+                         SizeType numSamples,
+                         const float* scales)
+{
+  SizeType i = 0;
+  for (; i + 16 <= numSamples; i += 16) {
+    storeAVX512(
+        _mm512_mul_ps(_mm512_loadu_ps(source + i), _mm512_loadu_ps(scales + i)),
+        dest + i);
+  }
+  convertScalarScaled(source, dest, i, numSamples, scales);
+}
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+/**
+ * @brief Detect the highest SimdLevel supported by the CPU and OS
+ */
+SimdLevel detectSimdLevel()
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  int maxLeaf = info[0];
+  __cpuid(info, 1);
+  bool sse2 = (info[3] & (1 << 26)) != 0;
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  if (!sse2) {
+    return SimdLevel::Scalar;
+  }
+  if (!osxsave || maxLeaf < 7) {
+    return SimdLevel::SSE2;
+  }
+  // the OS must save the AVX (and AVX-512) registers on context switches
+  unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+  bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+  if (avx512) {
+    return SimdLevel::AVX512;
+  }
+  return avx2 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#  else
+  // also checks that the OS saves the extended registers
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+  return SimdLevel::Scalar;
+#  endif
+}
+
+#endif  // AQNWB_SIMD_X86
+
+/**
+ * @brief Convert numSamples values where value i is scaled by scales[i]
+ */
+void convertScaled(const float* source,
+                   int16_t* dest,
+                   SizeType numSamples,
+                   const float* scales,
+                   SimdLevel level)
+{
+  switch (level) {
+#if AQNWB_SIMD_X86
+    case SimdLevel::SSE2:
+      convertScaledSSE2(source, dest, numSamples, scales);
+      return;
+    case SimdLevel::AVX2:
+      convertScaledAVX2(source, dest, numSamples, scales);
+      return;
+    case SimdLevel::AVX512:
+      convertScaledAVX512(source, dest, numSamples, scales);
+      return;
+#endif
+    default:
+      convertScalarScaled(source, dest, 0, numSamples, scales);
+      return;
+  }
+}
+}  // namespace
+
+std::string AQNWB::getSimdLevelName(SimdLevel level)
+{
+  switch (level) {
+    case SimdLevel::SSE2:
+      return "SSE2";
+    case SimdLevel::AVX2:
+      return "AVX2";
+    case SimdLevel::AVX512:
+      return "AVX512";
+    default:
+      return "Scalar";
+  }
+}
+
+SimdLevel AQNWB::getSupportedSimdLevel()
+{
+#if AQNWB_SIMD_X86
+  static const SimdLevel supportedLevel = detectSimdLevel();
+  return supportedLevel;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+void AQNWB::convertFloatToInt16(const float* source,
+                                int16_t* dest,
+                                SizeType numSamples,
+                                float scale,
+                                SimdLevel level)
+{
+  if (static_cast<int>(level) > static_cast<int>(getSupportedSimdLevel())) {
+    throw std::invalid_argument("convertFloatToInt16: "
+                                + getSimdLevelName(level)
+                                + " is not supported by this CPU");
+  }
+
+  switch (level) {
+#if AQNWB_SIMD_X86
+    case SimdLevel::SSE2:
+      convertSSE2(source, dest, numSamples, scale);
+      return;
+    case SimdLevel::AVX2:
+      convertAVX2(source, dest, numSamples, scale);
+      return;
+    case SimdLevel::AVX512:
+      convertAVX512(source, dest, numSamples, scale);
+      return;
+#endif
+    default:
+      convertScalar(source, dest, 0, numSamples, scale);
+      return;
+  }
+}
+
+void AQNWB::convertFloatToInt16(const float* source,
+                                int16_t* dest,
+                                SizeType numSamples,
+                                float scale)
+{
+  convertFloatToInt16(
+      source, dest, numSamples, scale, getSupportedSimdLevel());
+}
+
+void AQNWB::convertFloatToInt16Interleaved(const float* source,
+                                           int16_t* dest,
+                                           SizeType numRows,
+                                           SizeType numChannels,
+                                           const float* scales,
+                                           SimdLevel level)
+{
+  if (static_cast<int>(level) > static_cast<int>(getSupportedSimdLevel())) {
+    throw std::invalid_argument("convertFloatToInt16Interleaved: "
+                                + getSimdLevelName(level)
+                                + " is not supported by this CPU");
+  }
+  if (numChannels == 0) {
+    return;
+  }
+  bool uniformScale =
+      std::adjacent_find(
+          scales, scales + numChannels, std::not_equal_to<float>())
+      == scales + numChannels;
+  if (uniformScale) {
+    convertFloatToInt16(
+        source, dest, numRows * numChannels, scales[0], level);
+    return;
+  }
+
+  // Wide rows are converted one at a time with the scales as vector of
+  // per-value scales
+  if (numChannels > kScalePatternSize) {
+    for (SizeType row = 0; row < numRows; ++row) {
+      SizeType rowStart = row * numChannels;
+      convertScaled(
+          source + rowStart, dest + rowStart, numChannels, scales, level);
+    }
+    return;
+  }
+
+  // Narrow rows are converted in blocks of several rows with the scales
+  // repeated once per row, such that the vector kernels are used even if a
+  // row is shorter than a vector
+  float pattern[kScalePatternSize];
+  SizeType rowsPerBlock = kScalePatternSize / numChannels;
+  for (SizeType row = 0; row < rowsPerBlock; ++row) {
+    std::copy(scales, scales + numChannels, pattern + row * numChannels);
+  }
+  for (SizeType row = 0; row < numRows; row += rowsPerBlock) {
+    SizeType blockRows = std::min(rowsPerBlock, numRows - row);
+    SizeType blockStart = row * numChannels;
+    convertScaled(source + blockStart,
+                  dest + blockStart,
+                  blockRows * numChannels,
+                  pattern,
+                  level);
+  }
+}
+
+void AQNWB::convertFloatToInt16Interleaved(const float* source,
+                                           int16_t* dest,
+                                           SizeType numRows,
+                                           SizeType numChannels,
+                                           const float* scales)
+{
+  convertFloatToInt16Interleaved(
+      source, dest, numRows, numChannels, scales, getSupportedSimdLevel());
+}
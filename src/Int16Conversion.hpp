@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Types.hpp"
+
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB
+{
+
+/**
+ * @brief Instruction set levels of the float to int16 conversion kernels
+ */
+enum class SimdLevel
+{
+  Scalar = 0,  ///< Portable scalar implementation
+  SSE2 = 1,  ///< x86 SSE2, 4 samples per iteration
+  AVX2 = 2,  ///< x86 AVX2, 8 samples per iteration
+  AVX512 = 3  ///< x86 AVX-512F, 16 samples per iteration
+};
+
+/**
+ * @brief Get the display name of a SimdLevel, e.g., "AVX2"
+ */
+std::string getSimdLevelName(SimdLevel level);
+
+/**
+ * @brief Get the highest SimdLevel supported by the CPU and operating system.
+ *
+ * The CPU features are detected once on first use. On platforms other than
+ * x86 this is always SimdLevel::Scalar.
+ */
+SimdLevel getSupportedSimdLevel();
+
+/**
+ * @brief Convert float values in [-1, 1] to little-endian int16 values.
+ *
+ * Each value is computed as `round(clamp(32767 * (source[i] * scale),
+ * -32767, 32767))` in double precision, with rounding of halfway cases away
+ * from zero (i.e., std::round). The product `source[i] * scale` is evaluated
+ * in single precision. All SimdLevels produce bit-identical results. NaN
+ * values are converted to -32767.
+ *
+ * The function does not allocate memory. Neither source nor dest need to be
+ * aligned.
+ *
+ * @param source The float values to convert
+ * @param dest The destination for numSamples int16 values
+ * @param numSamples The number of values to convert
+ * @param scale Factor applied to each value before the conversion
+ * @param level The instruction set to use
+ * @throws std::invalid_argument if level is not supported by the CPU
+ */
+void convertFloatToInt16(const float* source,
+                         int16_t* dest,
+                         SizeType numSamples,
+                         float scale,
+                         SimdLevel level);
+
+/**
+ * @brief Convert float values in [-1, 1] to little-endian int16 values using
+ * the highest SimdLevel supported by the CPU.
+ *
+ * @param source The float values to convert
+ * @param dest The destination for numSamples int16 values
+ * @param numSamples The number of values to convert
+ * @param scale Factor applied to each value before the conversion
+ */
+void convertFloatToInt16(const float* source,
+                         int16_t* dest,
+                         SizeType numSamples,
+                         float scale = 1.0f);
+
+/**
+ * @brief Convert interleaved multichannel float values to little-endian
+ * int16 values with a separate scale for each channel.
+ *
+ * Same as convertFloatToInt16 for row-major [numRows, numChannels] data
+ * where the values of channel c are multiplied by scales[c]. All SimdLevels
+ * produce bit-identical results. If all scales are equal, the block is
+ * converted with a single uniform scale. Otherwise, the vector kernels load
+ * the scales along with the values, repeating the scales for several rows
+ * if the rows are narrower than a vector.
+ *
+ * @param source The interleaved float values to convert
+ * @param dest The destination for numRows * numChannels int16 values
+ * @param numRows The number of rows (time samples)
+ * @param numChannels The number of channels (columns)
+ * @param scales The scale of each channel
+ * @param level The instruction set to use
+ * @throws std::invalid_argument if level is not supported by the CPU
+ */
+void convertFloatToInt16Interleaved(const float* source,
+                                    int16_t* dest,
+                                    SizeType numRows,
+                                    SizeType numChannels,
+                                    const float* scales,
+                                    SimdLevel level);
+
+/**
+ * @brief Convert interleaved multichannel float values to little-endian
+ * int16 values with a separate scale for each channel using the highest
+ * SimdLevel supported by the CPU.
+ *
+ * @param source The interleaved float values to convert
+ * @param dest The destination for numRows * numChannels int16 values
+ * @param numRows The number of rows (time samples)
+ * @param numChannels The number of channels (columns)
+ * @param scales The scale of each channel
+ */
+void convertFloatToInt16Interleaved(const float* source,
+                                    int16_t* dest,
+                                    SizeType numRows,
+                                    SizeType numChannels,
+                                    const float* scales);
+
+}  // namespace AQNWB
@@ -0,0 +1,476 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AQNWB
+{
+
+/**
+ * @brief Vector with inline storage for a small number of elements.
+ *
+ * Provides the commonly used subset of the std::vector interface. Up to N
+ * elements are stored inside the object itself, such that creating, copying
+ * and resizing small arrays (e.g., the shape of a dataset) does not allocate
+ * heap memory. Larger arrays are transparently moved to the heap. Iterators
+ * are plain pointers and are invalidated by any operation that changes the
+ * capacity.
+ *
+ * @tparam T The element type. Must be trivially copyable.
+ * @tparam N The number of elements stored inline
+ */
+template<typename T, std::size_t N>
+class SmallVector
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SmallVector requires a trivially copyable element type");
+  static_assert(N > 0, "SmallVector requires an inline capacity > 0");
+
+  template<typename InputIt>
+  using RequireIterator = std::enable_if_t<!std::is_integral_v<InputIt>>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /**
+   * @brief The number of elements that are stored without heap allocation
+   */
+  static constexpr size_type inline_capacity = N;
+
+  /**
+   * @brief Create an empty array
+   */
+  SmallVector() noexcept {}
+
+  /**
+   * @brief Create an array of count value-initialized elements
+   */
+  explicit SmallVector(size_type count)
+      : SmallVector(count, T {})
+  {
+  }
+
+  /**
+   * @brief Create an array of count copies of value
+   */
+  SmallVector(size_type count, const T& value) { assign(count, value); }
+
+  /**
+   * @brief Create an array from the elements in the range [first, last)
+   */
+  template<typename InputIt, typename = RequireIterator<InputIt>>
+  SmallVector(InputIt first, InputIt last)
+  {
+    assign(first, last);
+  }
+
+  /**
+   * @brief Create an array from an initializer list
+   */
+  SmallVector(std::initializer_list<T> init)
+  {
+    assign(init.begin(), init.end());
+  }
+
+  /**
+   * @brief Create an array from a std::vector
+   *
+   * Implicit to stay source-compatible with code using std::vector.
+   */
+  SmallVector(const std::vector<T>& other)
+  {
+    assign(other.begin(), other.end());
+  }
+
+  SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+
+  SmallVector(SmallVector&& other) noexcept { moveFrom(other); }
+
+  ~SmallVector() { release(); }
+
+  SmallVector& operator=(const SmallVector& other)
+  {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept
+  {
+    if (this != &other) {
+      release();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(std::initializer_list<T> init)
+  {
+    assign(init.begin(), init.end());
+    return *this;
+  }
+
+  /**
+   * @brief Copy the elements into a std::vector
+   */
+  operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+  /**
+   * @brief Replace the content with count copies of value
+   */
+  void assign(size_type count, const T& value)
+  {
+    // value may refer to an element of this array
+    const T copy = value;
+    m_size = 0;
+    reserve(count);
+    std::fill_n(m_data, count, copy);
+    m_size = count;
+  }
+
+  /**
+   * @brief Replace the content with the elements in the range [first, last)
+   */
+  template<typename InputIt, typename = RequireIterator<InputIt>>
+  void assign(InputIt first, InputIt last)
+  {
+    clear();
+    for (; first != last; ++first) {
+      push_back(static_cast<T>(*first));
+    }
+  }
+
+  /**
+   * @brief Replace the content with the elements of an initializer list
+   */
+  void assign(std::initializer_list<T> init)
+  {
+    assign(init.begin(), init.end());
+  }
+
+  inline reference operator[](size_type pos) { return m_data[pos]; }
+  inline const_reference operator[](size_type pos) const
+  {
+    return m_data[pos];
+  }
+
+  /**
+   * @brief Access an element with bounds checking
+   * @throws std::out_of_range if pos >= size()
+   */
+  reference at(size_type pos)
+  {
+    checkRange(pos);
+    return m_data[pos];
+  }
+
+  /**
+   * @brief Access an element with bounds checking
+   * @throws std::out_of_range if pos >= size()
+   */
+  const_reference at(size_type pos) const
+  {
+    checkRange(pos);
+    return m_data[pos];
+  }
+
+  inline reference front() { return m_data[0]; }
+  inline const_reference front() const { return m_data[0]; }
+  inline reference back() { return m_data[m_size - 1]; }
+  inline const_reference back() const { return m_data[m_size - 1]; }
+  inline T* data() noexcept { return m_data; }
+  inline const T* data() const noexcept { return m_data; }
+
+  inline iterator begin() noexcept { return m_data; }
+  inline const_iterator begin() const noexcept { return m_data; }
+  inline const_iterator cbegin() const noexcept { return m_data; }
+  inline iterator end() noexcept { return m_data + m_size; }
+  inline const_iterator end() const noexcept { return m_data + m_size; }
+  inline const_iterator cend() const noexcept { return m_data + m_size; }
+  inline reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  inline const_reverse_iterator rbegin() const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  inline reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rend() const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  inline bool empty() const noexcept { return m_size == 0; }
+  inline size_type size() const noexcept { return m_size; }
+  inline size_type capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Check whether the elements are stored inline, i.e., without a
+   * heap allocation
+   */
+  inline bool isInline() const noexcept { return m_data == m_inline.data(); }
+
+  /**
+   * @brief Ensure that the capacity is at least newCapacity
+   */
+  void reserve(size_type newCapacity)
+  {
+    if (newCapacity <= m_capacity) {
+      return;
+    }
+    T* storage = new T[newCapacity];
+    std::copy_n(m_data, m_size, storage);
+    if (!isInline()) {
+      delete[] m_data;
+    }
+    m_data = storage;
+    m_capacity = newCapacity;
+  }
+
+  /**
+   * @brief Release heap memory that is not needed to hold the elements
+   */
+  void shrink_to_fit()
+  {
+    if (isInline() || m_size == m_capacity) {
+      return;
+    }
+    SmallVector shrunk(begin(), end());
+    *this = std::move(shrunk);
+  }
+
+  inline void clear() noexcept { m_size = 0; }
+
+  void push_back(const T& value)
+  {
+    if (m_size == m_capacity) {
+      const T copy = value;
+      grow(m_size + 1);
+      m_data[m_size++] = copy;
+    } else {
+      m_data[m_size++] = value;
+    }
+  }
+
+  template<typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    push_back(T(std::forward<Args>(args)...));
+    return back();
+  }
+
+  inline void pop_back() { --m_size; }
+
+  void resize(size_type count) { resize(count, T {}); }
+
+  void resize(size_type count, const T& value)
+  {
+    if (count > m_size) {
+      const T copy = value;
+      reserve(count);
+      std::fill(m_data + m_size, m_data + count, copy);
+    }
+    m_size = count;
+  }
+
+  /**
+   * @brief Insert value before pos
+   * @return Iterator to the inserted element
+   */
+  iterator insert(const_iterator pos, const T& value)
+  {
+    return insert(pos, size_type {1}, value);
+  }
+
+  /**
+   * @brief Insert count copies of value before pos
+   * @return Iterator to the first inserted element
+   */
+  iterator insert(const_iterator pos, size_type count, const T& value)
+  {
+    const T copy = value;
+    const size_type index = makeGap(pos, count);
+    std::fill_n(m_data + index, count, copy);
+    return m_data + index;
+  }
+
+  /**
+   * @brief Insert the elements in the range [first, last) before pos
+   * @return Iterator to the first inserted element
+   */
+  template<typename InputIt, typename = RequireIterator<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    // copy first, since the range may refer to elements of this array
+    const SmallVector values(first, last);
+    const size_type index = makeGap(pos, values.size());
+    std::copy(values.begin(), values.end(), m_data + index);
+    return m_data + index;
+  }
+
+  /**
+   * @brief Insert the elements of an initializer list before pos
+   * @return Iterator to the first inserted element
+   */
+  iterator insert(const_iterator pos, std::initializer_list<T> init)
+  {
+    return insert(pos, init.begin(), init.end());
+  }
+
+  /**
+   * @brief Remove the element at pos
+   * @return Iterator following the removed element
+   */
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /**
+   * @brief Remove the elements in the range [first, last)
+   * @return Iterator following the last removed element
+   */
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    iterator dest = m_data + (first - m_data);
+    std::copy(last, cend(), dest);
+    m_size -= static_cast<size_type>(last - first);
+    return dest;
+  }
+
+  void swap(SmallVector& other) noexcept
+  {
+    SmallVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator>(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  friend bool operator<=(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const SmallVector& lhs, const SmallVector& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+private:
+  void checkRange(size_type pos) const
+  {
+    if (pos >= m_size) {
+      throw std::out_of_range("SmallVector index out of range");
+    }
+  }
+
+  /**
+   * @brief Grow the capacity geometrically to at least minCapacity
+   */
+  void grow(size_type minCapacity)
+  {
+    reserve(std::max(minCapacity, 2 * m_capacity));
+  }
+
+  /**
+   * @brief Open a gap of count elements before pos
+   * @return The index of the first element of the gap
+   */
+  size_type makeGap(const_iterator pos, size_type count)
+  {
+    const auto index = static_cast<size_type>(pos - m_data);
+    if (m_size + count > m_capacity) {
+      grow(m_size + count);
+    }
+    std::copy_backward(
+        m_data + index, m_data + m_size, m_data + m_size + count);
+    m_size += count;
+    return index;
+  }
+
+  /**
+   * @brief Free the heap storage, if any, and switch back to inline storage
+   */
+  void release() noexcept
+  {
+    if (!isInline()) {
+      delete[] m_data;
+    }
+    m_data = m_inline.data();
+    m_capacity = N;
+    m_size = 0;
+  }
+
+  /**
+   * @brief Take over the elements of other, leaving other empty. Requires
+   * that this array uses inline storage.
+   */
+  void moveFrom(SmallVector& other) noexcept
+  {
+    if (other.isInline()) {
+      std::copy_n(other.m_data, other.m_size, m_inline.data());
+    } else {
+      m_data = other.m_data;
+      m_capacity = other.m_capacity;
+      other.m_data = other.m_inline.data();
+      other.m_capacity = N;
+    }
+    m_size = other.m_size;
+    other.m_size = 0;
+  }
+
+  /**
+   * @brief The inline storage
+   */
+  std::array<T, N> m_inline;
+
+  /**
+   * @brief The storage in use, i.e., m_inline or a heap allocation
+   */
+  T* m_data = m_inline.data();
+
+  /**
+   * @brief The number of elements
+   */
+  size_type m_size = 0;
+
+  /**
+   * @brief The number of elements that fit into m_data
+   */
+  size_type m_capacity = N;
+};
+
+}  // namespace AQNWB
@@ -0,0 +1,267 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "Tracing.hpp"
+
+using namespace AQNWB;
+
+namespace
+{
+/**
+ * @brief Number of events per chunk of a thread buffer
+ */
+constexpr SizeType EventsPerChunk = 4096;
+
+/**
+ * @brief Fixed-size block of events. Written by a single thread.
+ */
+struct EventChunk
+{
+  std::array<TraceEvent, EventsPerChunk> events;
+
+  /**
+   * @brief Number of valid events, published with release semantics
+   */
+  std::atomic<SizeType> count {0};
+
+  /**
+   * @brief The next chunk, published with release semantics
+   */
+  std::atomic<EventChunk*> next {nullptr};
+};
+
+/**
+ * @brief The events recorded by a single thread
+ */
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(std::uint64_t id)
+      : threadId(id)
+      , tail(&head)
+  {
+  }
+
+  ThreadBuffer(const ThreadBuffer&) = delete;
+  ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+  ~ThreadBuffer() { releaseChunks(); }
+
+  /**
+   * @brief Free all chunks but the first one and reset the event count
+   */
+  void releaseChunks()
+  {
+    EventChunk* chunk = head.next.exchange(nullptr);
+    while (chunk != nullptr) {
+      EventChunk* next = chunk->next.load();
+      delete chunk;
+      chunk = next;
+    }
+    head.count.store(0);
+    tail = &head;
+    numEvents.store(0);
+  }
+
+  /**
+   * @brief Sequential id of the thread, used as tid in the trace
+   */
+  const std::uint64_t threadId;
+
+  /**
+   * @brief The first chunk of events
+   */
+  EventChunk head;
+
+  /**
+   * @brief The chunk events are appended to. Only used by the owning thread.
+   */
+  EventChunk* tail;
+
+  /**
+   * @brief The number of recorded events
+   */
+  std::atomic<SizeType> numEvents {0};
+
+  /**
+   * @brief The number of events dropped because the buffer was full
+   */
+  std::atomic<SizeType> numDropped {0};
+};
+
+/**
+ * @brief Global state of the tracer
+ */
+struct TracerState
+{
+  std::atomic<bool> enabled {false};
+  std::atomic<SizeType> maxEventsPerThread {SizeType {1} << 20};
+  const std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+
+  /**
+   * @brief Protects buffers and nextThreadId
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief The buffers of all threads that recorded events. Buffers are
+   * kept after their thread exits, such that their events can be exported.
+   */
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+  std::uint64_t nextThreadId = 1;
+};
+
+TracerState& getState()
+{
+  static TracerState state;
+  return state;
+}
+
+ThreadBuffer& getThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer = []()
+  {
+    TracerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto newBuffer = std::make_shared<ThreadBuffer>(state.nextThreadId++);
+    state.buffers.push_back(newBuffer);
+    return newBuffer;
+  }();
+  return *buffer;
+}
+}  // namespace
+
+void Tracer::setEnabled(bool enabled)
+{
+  getState().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled()
+{
+  return getState().enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setMaxEventsPerThread(SizeType maxEvents)
+{
+  getState().maxEventsPerThread.store(maxEvents, std::memory_order_relaxed);
+}
+
+SizeType Tracer::getMaxEventsPerThread()
+{
+  return getState().maxEventsPerThread.load(std::memory_order_relaxed);
+}
+
+SizeType Tracer::getNumEvents()
+{
+  TracerState& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  SizeType total = 0;
+  for (const auto& buffer : state.buffers) {
+    total += buffer->numEvents.load(std::memory_order_acquire);
+  }
+  return total;
+}
+
+SizeType Tracer::getNumDroppedEvents()
+{
+  TracerState& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  SizeType total = 0;
+  for (const auto& buffer : state.buffers) {
+    total += buffer->numDropped.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void Tracer::clear()
+{
+  TracerState& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (const auto& buffer : state.buffers) {
+    buffer->releaseChunks();
+    buffer->numDropped.store(0);
+  }
+}
+
+std::uint64_t Tracer::now()
+{
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - getState().epoch)
+          .count());
+}
+
+void Tracer::record(const TraceEvent& event)
+{
+  ThreadBuffer& buffer = getThreadBuffer();
+  SizeType numEvents = buffer.numEvents.load(std::memory_order_relaxed);
+  if (numEvents >= getMaxEventsPerThread()) {
+    buffer.numDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  EventChunk* chunk = buffer.tail;
+  SizeType index = chunk->count.load(std::memory_order_relaxed);
+  if (index == EventsPerChunk) {
+    auto* next = new EventChunk();
+    chunk->next.store(next, std::memory_order_release);
+    buffer.tail = next;
+    chunk = next;
+    index = 0;
+  }
+  chunk->events[index] = event;
+  chunk->count.store(index + 1, std::memory_order_release);
+  buffer.numEvents.store(numEvents + 1, std::memory_order_release);
+}
+
+std::string Tracer::toChromeTraceJSON()
+{
+  TracerState& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  bool first = true;
+  for (const auto& buffer : state.buffers) {
+    const EventChunk* chunk = &buffer->head;
+    while (chunk != nullptr) {
+      SizeType count = chunk->count.load(std::memory_order_acquire);
+      for (SizeType i = 0; i < count; ++i) {
+        const TraceEvent& event = chunk->events[i];
+        // complete events ("X") hold both the begin and the end
+        out << (first ? "\n" : ",\n") << "{\"name\": \"" << event.name
+            << "\", \"cat\": \"" << event.category
+            << "\", \"ph\": \"X\", \"ts\": "
+            << static_cast<double>(event.start) / 1000.0
+            << ", \"dur\": " << static_cast<double>(event.duration) / 1000.0
+            << ", \"pid\": 1, \"tid\": " << buffer->threadId << "}";
+        first = false;
+      }
+      chunk = chunk->next.load(std::memory_order_acquire);
+    }
+  }
+  out << "\n]}\n";
+  return out.str();
+}
+
+Status Tracer::writeChromeTrace(const std::string& filename)
+{
+  std::ofstream file(filename);
+  if (!file) {
+    std::cerr << "Tracer::writeChromeTrace: could not open file " << filename
+              << std::endl;
+    return Status::Failure;
+  }
+  file << toChromeTraceJSON();
+  return file.good() ? Status::Success : Status::Failure;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Types.hpp"
+
+using SizeType = AQNWB::Types::SizeType;
+using Status = AQNWB::Types::Status;
+
+namespace AQNWB
+{
+
+/**
+ * @brief A traced operation, i.e., a pair of begin and end events
+ */
+struct TraceEvent
+{
+  /**
+   * @brief The name of the operation. Must be a string literal.
+   */
+  const char* name = nullptr;
+
+  /**
+   * @brief The category of the operation. Must be a string literal.
+   */
+  const char* category = nullptr;
+
+  /**
+   * @brief The begin time in nanoseconds since the tracer was first used
+   */
+  std::uint64_t start = 0;
+
+  /**
+   * @brief The duration in nanoseconds
+   */
+  std::uint64_t duration = 0;
+};
+
+/**
+ * @brief Process-wide timeline of I/O and NWB operations.
+ *
+ * Records the begin and end of traced operations (see TraceScope) of all
+ * threads into per-thread buffers and exports them in the Chrome trace event
+ * format, which can be viewed in Perfetto (https://ui.perfetto.dev) or
+ * chrome://tracing. Recording is disabled by default. While disabled,
+ * tracing an operation costs a single atomic load.
+ *
+ * Each thread appends to its own buffer without locking. Buffers grow in
+ * chunks of events and hold at most getMaxEventsPerThread events; further
+ * events are dropped and counted (see getNumDroppedEvents).
+ */
+class Tracer
+{
+public:
+  /**
+   * @brief Enable or disable recording of events
+   */
+  static void setEnabled(bool enabled);
+
+  /**
+   * @brief Check whether events are being recorded
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief Set the maximum number of events buffered per thread
+   */
+  static void setMaxEventsPerThread(SizeType maxEvents);
+
+  /**
+   * @brief Get the maximum number of events buffered per thread
+   */
+  static SizeType getMaxEventsPerThread();
+
+  /**
+   * @brief Get the number of recorded events of all threads
+   */
+  static SizeType getNumEvents();
+
+  /**
+   * @brief Get the number of events dropped because a buffer was full
+   */
+  static SizeType getNumDroppedEvents();
+
+  /**
+   * @brief Discard all recorded events.
+   *
+   * Must not be called while other threads are recording events, e.g.,
+   * disable recording and wait for traced operations to complete first.
+   */
+  static void clear();
+
+  /**
+   * @brief Export all recorded events in the Chrome trace event format
+   * @return The JSON document
+   */
+  static std::string toChromeTraceJSON();
+
+  /**
+   * @brief Write all recorded events to a file in the Chrome trace event
+   * format
+   * @param filename The path of the file to write
+   * @return The status of the operation
+   */
+  static Status writeChromeTrace(const std::string& filename);
+
+  /**
+   * @brief Get the current time in nanoseconds since the tracer was first
+   * used
+   */
+  static std::uint64_t now();
+
+  /**
+   * @brief Record an event in the buffer of the calling thread
+   */
+  static void record(const TraceEvent& event);
+};
+
+/**
+ * @brief Traces the lifetime of the object as an operation.
+ *
+ * Create a TraceScope at the beginning of the operation to trace:
+ *
+ * \code{.cpp}
+ * TraceScope trace("HDF5IO::flush", "io");
+ * \endcode
+ */
+class TraceScope
+{
+public:
+  /**
+   * @brief Begin the operation if tracing is enabled
+   * @param name The name of the operation. Must be a string literal.
+   * @param category The category of the operation. Must be a string literal.
+   */
+  inline TraceScope(const char* name, const char* category)
+      : m_active(Tracer::isEnabled())
+  {
+    if (m_active) {
+      m_event.name = name;
+      m_event.category = category;
+      m_event.start = Tracer::now();
+    }
+  }
+
+  /**
+   * @brief End the operation and record it
+   */
+  inline ~TraceScope()
+  {
+    if (m_active) {
+      m_event.duration = Tracer::now() - m_event.start;
+      Tracer::record(m_event);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  /**
+   * @brief Whether tracing was enabled when the operation began
+   */
+  bool m_active;
+
+  /**
+   * @brief The event to record
+   */
+  TraceEvent m_event;
+};
+
+}  // namespace AQNWB
@@ -6,6 +6,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "SmallVector.hpp"
+
 namespace AQNWB
 {
 
@@ -105,10 +107,22 @@ public:
   static constexpr SizeType SizeTypeNotSet =
       (std::numeric_limits<SizeType>::max)();
 
+  /**
+   * @brief The number of elements a SizeArray holds without heap allocation.
+   *
+   * NWB datasets have at most 4 dimensions, such that shapes, offsets and
+   * chunk sizes never allocate. Longer arrays (e.g., index lists) are stored
+   * on the heap.
+   */
+  static constexpr std::size_t SizeArrayInlineCapacity = 8;
+
   /**
    * @brief Alias for an array of size types used in the project.
+   *
+   * Same interface as std::vector<SizeType> for the commonly used operations
+   * and implicitly convertible from and to std::vector<SizeType>.
    */
-  using SizeArray = std::vector<SizeType>;
+  using SizeArray = SmallVector<SizeType, SizeArrayInlineCapacity>;
 
   /**
    * @brief Alias for a vector of channels.
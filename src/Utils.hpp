@@ -11,9 +11,15 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include "Int16Conversion.hpp"
 #include "io/BaseIO.hpp"
 #include "io/hdf5/HDF5IO.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/null/NullIO.hpp"
+#include "io/raw/RawCaptureIO.hpp"
+#include "io/zarr/ZarrIO.hpp"
 
 namespace AQNWB
 {
@@ -211,7 +217,8 @@ static inline bool isISO8601Date(const std::string& dateStr)
 
 /**
  * @brief Factory method to create an IO object of the specified type.
- * @param type The type of IO object to create (e.g., "HDF5").
+ * @param type The type of IO object to create (e.g., "HDF5", "Memory",
+ * "Null", "RawCapture", or "Zarr").
  * @param filename The filename to use for the IO object.
  * @return A shared pointer to a BaseIO object.
  * @throws std::invalid_argument if the type is invalid.
@@ -221,6 +228,14 @@ static inline std::shared_ptr<IO::BaseIO> createIO(const std::string& type,
 {
   if (type == "HDF5") {
     return std::make_shared<AQNWB::IO::HDF5::HDF5IO>(filename);
+  } else if (type == "Memory") {
+    return std::make_shared<AQNWB::IO::Memory::MemoryIO>(filename);
+  } else if (type == "Null") {
+    return std::make_shared<AQNWB::IO::Null::NullIO>(filename);
+  } else if (type == "RawCapture") {
+    return std::make_shared<AQNWB::IO::Raw::RawCaptureIO>(filename);
+  } else if (type == "Zarr") {
+    return std::make_shared<AQNWB::IO::Zarr::ZarrIO>(filename);
   } else {
     throw std::invalid_argument("Invalid IO type");
   }
@@ -282,6 +297,9 @@ static inline std::string mergePaths(const std::string& path1,
  * @brief Method to convert float values to uint16 values. This method
  * was adapted from JUCE AudioDataConverters using a default value of
  * destBytesPerSample = 2.
+ *
+ * The conversion uses the vectorized kernel for the highest instruction set
+ * supported by the CPU (see AQNWB::convertFloatToInt16).
  * @param source The source float data to convert
  * @param dest The destination for the converted uint16 data
  * @param numSamples The number of samples to convert
@@ -290,21 +308,24 @@ static inline void convertFloatToInt16LE(const float* source,
                                          void* dest,
                                          SizeType numSamples)
 {
-  // TODO - several steps in this function may be unnecessary for our use
-  // case. Consider simplifying the intermediate cast to char and the
-  // final cast to uint16_t.
-  auto maxVal = static_cast<double>(0x7fff);
-  auto intData = static_cast<char*>(dest);
+  convertFloatToInt16(source, static_cast<int16_t*>(dest), numSamples);
+}
 
-  for (SizeType i = 0; i < numSamples; ++i) {
-    auto clampedValue =
-        std::clamp(maxVal * static_cast<double>(source[i]), -maxVal, maxVal);
-    auto intValue =
-        static_cast<uint16_t>(static_cast<int16_t>(std::round(clampedValue)));
-    intValue = detail::to_little_endian_u16(intValue);
-    *reinterpret_cast<uint16_t*>(intData) = intValue;
-    intData += 2;  // destBytesPerSample is always 2
-  }
+/**
+ * @brief Method to scale float values and convert to int16 values without
+ * allocating memory
+ * @param numSamples The number of samples to convert
+ * @param conversion_factor The conversion factor to scale the data
+ * @param data The data to convert
+ * @param dest The destination buffer for numSamples int16 values
+ */
+static inline void transformToInt16(SizeType numSamples,
+                                    float conversion_factor,
+                                    const float* data,
+                                    int16_t* dest)
+{
+  float multFactor = 1.0f / (32767.0f * conversion_factor);
+  convertFloatToInt16(data, dest, numSamples, multFactor);
 }
 
 /**
@@ -316,20 +337,56 @@ static inline void convertFloatToInt16LE(const float* source,
 static inline std::unique_ptr<int16_t[]> transformToInt16(
     SizeType numSamples, float conversion_factor, const float* data)
 {
-  std::unique_ptr<float[]> scaledData = std::make_unique<float[]>(numSamples);
   std::unique_ptr<int16_t[]> intData = std::make_unique<int16_t[]>(numSamples);
+  transformToInt16(numSamples, conversion_factor, data, intData.get());
+  return intData;
+}
 
-  // copy data and multiply by scaling factor
-  float multFactor = 1.0f / (32767.0f * conversion_factor);
-  std::transform(data,
-                 data + numSamples,
-                 scaledData.get(),
-                 [multFactor](float value) { return value * multFactor; });
-
-  // convert float to int16
-  convertFloatToInt16LE(scaledData.get(), intData.get(), numSamples);
+/**
+ * @brief Convert raw values to physical units in a single pass.
+ *
+ * Computes `out = in * factor + offset` for row-major [numRows, numColumns]
+ * data, where factor is columnFactors[column] or conversion if no column
+ * factors are given. The loops operate on contiguous rows without branches,
+ * such that the compiler can vectorize the conversion of ITYPE to OTYPE
+ * together with the scaling. `in` and `out` may be the same buffer if ITYPE
+ * and OTYPE are the same type.
+ *
+ * @param in The raw values
+ * @param out The output buffer of numRows * numColumns values
+ * @param numRows The number of rows
+ * @param numColumns The number of columns
+ * @param conversion The scale factor applied to all values if columnFactors
+ * is nullptr
+ * @param offset The offset added to all values after scaling
+ * @param columnFactors The complete scale factor of each column, i.e.,
+ * including the conversion. May be nullptr.
+ */
+template<typename ITYPE, typename OTYPE>
+static inline void scaleToPhysicalUnits(const ITYPE* in,
+                                        OTYPE* out,
+                                        SizeType numRows,
+                                        SizeType numColumns,
+                                        OTYPE conversion,
+                                        OTYPE offset,
+                                        const OTYPE* columnFactors = nullptr)
+{
+  if (columnFactors == nullptr) {
+    SizeType numValues = numRows * numColumns;
+    for (SizeType i = 0; i < numValues; ++i) {
+      out[i] = static_cast<OTYPE>(in[i]) * conversion + offset;
+    }
+    return;
+  }
 
-  return intData;
+  for (SizeType row = 0; row < numRows; ++row) {
+    const ITYPE* rowIn = in + row * numColumns;
+    OTYPE* rowOut = out + row * numColumns;
+    for (SizeType col = 0; col < numColumns; ++col) {
+      rowOut[col] =
+          static_cast<OTYPE>(rowIn[col]) * columnFactors[col] + offset;
+    }
+  }
 }
 
 /**
@@ -1,11 +1,44 @@
 #include "io/BaseIO.hpp"
 
 #include "Utils.hpp"
+#include "io/ChunkCache.hpp"
 #include "io/RecordingObjects.hpp"
 
 using namespace AQNWB::IO;
 using namespace AQNWB;
 
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+namespace
+{
+/**
+ * @brief Get the size of one element of a numeric type in bytes
+ * @param type The data type
+ * @return The size of one element, or 0 for string types
+ */
+SizeType getNumericTypeSize(const BaseDataType& type)
+{
+  switch (type.type) {
+    case BaseDataType::T_U8:
+    case BaseDataType::T_I8:
+      return 1;
+    case BaseDataType::T_U16:
+    case BaseDataType::T_I16:
+      return 2;
+    case BaseDataType::T_U32:
+    case BaseDataType::T_I32:
+    case BaseDataType::T_F32:
+      return 4;
+    case BaseDataType::T_U64:
+    case BaseDataType::T_I64:
+    case BaseDataType::T_F64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+}  // namespace
+#endif
+
 // BaseDataType
 
 BaseDataType::BaseDataType(BaseDataType::Type t, SizeType s)
@@ -150,7 +183,10 @@ BaseIO::BaseIO(const std::string& filename)
     : m_filename(filename)
     , m_readyToOpen(true)
     , m_opened(false)
+    , m_recordingPaused(std::make_shared<bool>(false))
     , m_recording_objects(std::make_shared<RecordingObjects>())
+    , m_chunkCache(std::make_shared<ChunkCache>())
+    , m_writeStatistics(std::make_shared<WriteStatistics>())
 {
 }
 
@@ -184,17 +220,34 @@ std::string BaseIO::getFullTypeName(const std::string& path) const
   // Combine the namespace and type name to get the full class name
   std::string fullClassName = typeNamespace + "::" + typeName;
 
+  // return the result
+  return getCompatibleTypeName(path, fullClassName);
+}
+
+std::string BaseIO::getCompatibleTypeName(const std::string& path,
+                                          const std::string& fullTypeName)
+{
   // Backward compatibility logic to ensure use of the ElectrodesTable class for
   // reading the electrodes table even ffor NWB <=2.8 where ElectrodesTable was
   // a DynamicTable without its own specific neurodata_type
   if (path == "/general/extracellular_ephys/electrodes"
-      && fullClassName == "core::DynamicTable")
+      && fullTypeName == "core::DynamicTable")
   {
-    fullClassName = "core::ElectrodesTable";
+    return "core::ElectrodesTable";
   }
+  return fullTypeName;
+}
 
-  // return the result
-  return fullClassName;
+Status BaseIO::visitStorageObjects(const std::string& path,
+                                   const StorageObjectCallback& callback,
+                                   const StorageObjectType& objectType) const
+{
+  for (const auto& obj : getStorageObjects(path, objectType)) {
+    if (!callback(obj.first, obj.second)) {
+      break;
+    }
+  }
+  return Status::Success;
 }
 
 std::unordered_map<std::string, std::string> BaseIO::findTypes(
@@ -303,9 +356,30 @@ BaseRecordingData::BaseRecordingData() {}
 
 BaseRecordingData::~BaseRecordingData() {}
 
+void BaseRecordingData::setWriteStatistics(
+    [[maybe_unused]] std::shared_ptr<WriteStatistics> statistics,
+    [[maybe_unused]] const std::string& path)
+{
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  m_writeStatistics = std::move(statistics);
+  m_writeStatisticsPath = path;
+#endif
+}
+
+DatasetWriteStats BaseRecordingData::getWriteStatistics() const
+{
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (m_writeStatistics) {
+    return m_writeStatistics->getDatasetStats(m_writeStatisticsPath);
+  }
+#endif
+  return DatasetWriteStats();
+}
+
 Status BaseIO::startRecording()
 {
   Status status = Status::Success;
+  *m_recordingPaused = false;
   // Finalize all recording objects before starting recording
   auto recording_objects = getRecordingObjects();
   if (recording_objects) {
@@ -318,6 +392,7 @@ Status BaseIO::startRecording()
 Status BaseIO::stopRecording()
 {
   Status status = Status::Success;
+  *m_recordingPaused = false;
   // Finalize all recording objects before stopping recording
   auto recording_objects = getRecordingObjects();
   if (recording_objects) {
@@ -339,12 +414,55 @@ Status BaseIO::stopRecording()
   return status;
 }
 
+Status BaseIO::pauseRecording(double time)
+{
+  if (!m_opened) {
+    std::cerr << "BaseIO::pauseRecording: the file is not open." << std::endl;
+    return Status::Failure;
+  }
+  if (*m_recordingPaused) {
+    std::cerr << "BaseIO::pauseRecording: the recording is already paused."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // Stop accepting writes before recording the pause
+  *m_recordingPaused = true;
+  Status status = Status::Success;
+  auto recording_objects = getRecordingObjects();
+  if (recording_objects) {
+    status = recording_objects->recordingPaused(time);
+  }
+  return flush() && status;
+}
+
+Status BaseIO::resumeRecording(double time)
+{
+  if (!*m_recordingPaused) {
+    std::cerr << "BaseIO::resumeRecording: the recording is not paused."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  Status status = Status::Success;
+  auto recording_objects = getRecordingObjects();
+  if (recording_objects) {
+    status = recording_objects->recordingResumed(time);
+  }
+  *m_recordingPaused = false;
+  return status;
+}
+
 Status BaseIO::close()
 {
+  *m_recordingPaused = false;
   auto recording_objects = getRecordingObjects();
   if (recording_objects) {
     m_recording_objects->clear();
   }
+  if (m_chunkCache) {
+    m_chunkCache->clear();
+  }
   return Status::Success;
 }
 
@@ -356,3 +474,62 @@ Status BaseRecordingData::writeDataBlock(const SizeArray& dataShape,
 {
   return writeDataBlock(dataShape, m_position, type, data);
 }
+
+Status BaseRecordingData::writeDataBlock(const SizeArray& dataShape,
+                                         const SizeArray& positionOffset,
+                                         const BaseDataType& type,
+                                         const void* data)
+{
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (WriteStatistics* statistics = getActiveWriteStatistics()) {
+    auto start = WriteStatistics::Clock::now();
+    Status status = writeDataBlockImpl(dataShape, positionOffset, type, data);
+    SizeType bytes = getNumericTypeSize(type);
+    for (SizeType dim : dataShape) {
+      bytes *= dim;
+    }
+    statistics->recordWrite(m_writeStatisticsPath,
+                            WriteStatistics::elapsedNanoseconds(start),
+                            bytes,
+                            status == Status::Success);
+    return status;
+  }
+#endif
+  return writeDataBlockImpl(dataShape, positionOffset, type, data);
+}
+
+Status BaseRecordingData::writeDataBlock(const SizeArray& dataShape,
+                                         const SizeArray& positionOffset,
+                                         const BaseDataType& type,
+                                         const std::vector<std::string>& data)
+{
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (WriteStatistics* statistics = getActiveWriteStatistics()) {
+    auto start = WriteStatistics::Clock::now();
+    Status status = writeDataBlockImpl(dataShape, positionOffset, type, data);
+    SizeType bytes = 0;
+    if (type.type == BaseDataType::Type::T_STR) {
+      bytes = data.size() * type.typeSize;
+    } else {
+      for (const auto& str : data) {
+        bytes += str.size();
+      }
+    }
+    statistics->recordWrite(m_writeStatisticsPath,
+                            WriteStatistics::elapsedNanoseconds(start),
+                            bytes,
+                            status == Status::Success);
+    return status;
+  }
+#endif
+  return writeDataBlockImpl(dataShape, positionOffset, type, data);
+}
+
+void BaseRecordingData::recordExtend()
+{
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (WriteStatistics* statistics = getActiveWriteStatistics()) {
+    statistics->recordExtend(m_writeStatisticsPath);
+  }
+#endif
+}
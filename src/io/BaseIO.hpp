@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <any>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "Types.hpp"
+#include "io/WriteStatistics.hpp"
 
 #define DEFAULT_STR_SIZE 256
 #define DEFAULT_ARRAY_SIZE 1
@@ -30,6 +32,7 @@ namespace AQNWB::IO
 {
 class BaseRecordingData;
 class RecordingObjects;
+class ChunkCache;
 class BaseIO;
 }  // namespace AQNWB::IO
 
@@ -579,6 +582,38 @@ public:
                     const StorageObjectType& objectType =
                         StorageObjectType::Undefined) const = 0;
 
+  /**
+   * @brief Callback invoked by visitStorageObjects for each storage object.
+   *
+   * The callback receives the relative path and the storage object type and
+   * returns true to continue or false to stop the iteration.
+   */
+  using StorageObjectCallback =
+      std::function<bool(const std::string&, StorageObjectType)>;
+
+  /**
+   * @brief Streams the storage objects (groups, datasets, attributes) inside a
+   * group to a callback.
+   *
+   * This is the streaming variant of getStorageObjects. Objects are passed to
+   * the callback one at a time, in the same order as returned by
+   * getStorageObjects, without materializing the full listing. The iteration
+   * stops as soon as the callback returns false. The default implementation
+   * iterates over the result of getStorageObjects.
+   *
+   * @param path The path to the group.
+   * @param callback The function to call for each object.
+   * @param objectType Define which types of storage object to look for, i.e.,
+   * only objects of this specified type will be passed to the callback.
+   *
+   * @return The status of the operation. Stopping early via the callback is
+   * not considered a failure.
+   */
+  virtual Status visitStorageObjects(
+      const std::string& path,
+      const StorageObjectCallback& callback,
+      const StorageObjectType& objectType = StorageObjectType::Undefined) const;
+
   /**
    * @brief Finds all datasets and groups of the given types in the HDF5 file.
    *
@@ -628,7 +663,7 @@ public:
    * @return String with the full name of the type consisting of
    * `namespace::typename`
    */
-  std::string getFullTypeName(const std::string& path) const;
+  virtual std::string getFullTypeName(const std::string& path) const;
 
   /**
    * @brief Reads a dataset and determines the data type
@@ -651,6 +686,27 @@ public:
                                        const SizeArray& stride = {},
                                        const SizeArray& block = {}) = 0;
 
+  /**
+   * @brief Reads an arbitrary selection of a dataset in a single read
+   * operation and determines the data type
+   *
+   * The selection is defined by an explicit list of indices for each
+   * dimension. The result is the compact block formed by the outer product of
+   * the index lists, i.e., the shape of the result is the number of indices
+   * for each dimension, and the data is ordered following the order of the
+   * indices in the lists. E.g., a selection of `{{}, {3, 17, 42}}` reads
+   * channels 3, 17, and 42 for all time points of a 2D `[time, channel]`
+   * dataset.
+   *
+   * @param dataPath The path to the dataset within the file.
+   * @param selection One list of indices per dimension of the dataset. An
+   * empty list selects all indices along the dimension.
+   *
+   * @return A DataGeneric structure containing the data and shape.
+   */
+  virtual DataBlockGeneric readDatasetSelection(
+      const std::string& dataPath, const std::vector<SizeArray>& selection) = 0;
+
   /**
    * @brief Reads a attribute  and determines the data type
    *
@@ -786,6 +842,55 @@ public:
    */
   virtual Status stopRecording();
 
+  /**
+   * @brief Pauses the recording without closing the file.
+   *
+   * The file and all recording datasets stay open, but the recording
+   * objects stop accepting writes, e.g., ElectricalSeries::writeChannel
+   * returns Status::Failure without writing or advancing its sample count.
+   * All recording objects are notified via
+   * RegisteredType::recordingPaused, e.g., to record the start of the pause
+   * in a TimeIntervals table, and the file is flushed. Like writes, pausing
+   * and resuming are not synchronized, i.e., they must not be called while
+   * writes are in progress in other threads.
+   * @param time The time of the pause in seconds, in the time base of the
+   * recorded timestamps.
+   * @return The status of the operation. Fails if the file is not open or
+   * the recording is already paused.
+   */
+  virtual Status pauseRecording(double time);
+
+  /**
+   * @brief Resumes a recording paused via pauseRecording.
+   *
+   * All recording objects are notified via RegisteredType::recordingResumed
+   * before writes are accepted again. Nothing is reopened or reinitialized,
+   * and writes continue at the positions where they stopped.
+   * @param time The time at which recording resumes in seconds, in the time
+   * base of the recorded timestamps.
+   * @return The status of the operation. Fails if the recording is not
+   * paused.
+   */
+  virtual Status resumeRecording(double time);
+
+  /**
+   * @brief Returns true if the recording is paused.
+   * @return True if the recording is paused, false otherwise.
+   */
+  inline bool isRecordingPaused() const { return *m_recordingPaused; }
+
+  /**
+   * @brief Get the flag that is set while the recording is paused.
+   *
+   * RegisteredType objects keep the flag to check for a pause on every write
+   * without locking their weak pointer to the IO. The flag outlives the IO.
+   * @return A shared pointer to the flag.
+   */
+  inline std::shared_ptr<const bool> getRecordingPausedFlag() const
+  {
+    return m_recordingPaused;
+  }
+
   /**
    * @brief Returns true if the file is in a mode where objects can
    * be added or deleted. Note, this does not apply to the modification
@@ -874,6 +979,35 @@ public:
     return m_recording_objects;
   }
 
+  /**
+   * @brief Returns the cache of decoded dataset chunks for this IO object.
+   *
+   * The cache is shared by all reads performed through this IO object,
+   * including all ReadDataWrapper objects, so that overlapping reads of the
+   * same chunks are served from memory. The cache is disabled by default and
+   * can be enabled by setting a memory budget via ChunkCache::setMaxBytes.
+   * Cached chunks are discarded when the IO is closed.
+   * @return A shared pointer to the ChunkCache.
+   */
+  inline std::shared_ptr<ChunkCache> getChunkCache() const
+  {
+    return m_chunkCache;
+  }
+
+  /**
+   * @brief Returns the write instrumentation for this IO object.
+   *
+   * Collects per-dataset counters (calls, bytes, extends, flushes, failures)
+   * and latency histograms of all writes performed through this IO object.
+   * Requires building with the CMake option AQNWB_ENABLE_INSTRUMENTATION
+   * and is disabled by default. Enable via WriteStatistics::setEnabled.
+   * @return A shared pointer to the WriteStatistics.
+   */
+  inline std::shared_ptr<WriteStatistics> getWriteStatistics() const
+  {
+    return m_writeStatistics;
+  }
+
 protected:
   /**
    * @brief The name of the file.
@@ -887,6 +1021,17 @@ protected:
    */
   virtual Status createGroupIfDoesNotExist(const std::string& path) = 0;
 
+  /**
+   * @brief Apply backward compatibility rules to the full type name of an
+   * object as used by getFullTypeName.
+   * @param path The path of the registered type.
+   * @param fullTypeName The full name of the type as stored in the file,
+   * i.e., `namespace::typename`
+   * @return The full name of the type to use for the object
+   */
+  static std::string getCompatibleTypeName(const std::string& path,
+                                           const std::string& fullTypeName);
+
   /**
    * @brief Whether the file is ready to be opened.
    */
@@ -897,11 +1042,29 @@ protected:
    */
   bool m_opened;
 
+  /**
+   * @brief Whether the recording is paused via pauseRecording. Shared with
+   * the RegisteredType objects, see getRecordingPausedFlag.
+   */
+  std::shared_ptr<bool> m_recordingPaused;
+
   /**
    * @brief The recording objects for tracking all RegisteredType objects used
    * for recording associated with this IO object.
    */
   std::shared_ptr<RecordingObjects> m_recording_objects;
+
+  /**
+   * @brief The cache of decoded dataset chunks shared by all reads from this
+   * IO object.
+   */
+  std::shared_ptr<ChunkCache> m_chunkCache;
+
+  /**
+   * @brief The write instrumentation shared by all datasets written through
+   * this IO object.
+   */
+  std::shared_ptr<WriteStatistics> m_writeStatistics;
 };
 
 /**
@@ -947,19 +1110,27 @@ public:
 
   /**
    * @brief Writes a block of data (any number of dimensions).
+   *
+   * Records the write in the WriteStatistics if instrumentation is enabled
+   * and otherwise forwards to writeDataBlockImpl, which is implemented by
+   * the IO backends.
    * @param dataShape The size of the data block.
    * @param positionOffset The position of the data block to write to.
    * @param type The data type of the elements in the data block.
    * @param data A pointer to the data block.
    * @return The status of the write operation.
    */
-  virtual Status writeDataBlock(const SizeArray& dataShape,
-                                const SizeArray& positionOffset,
-                                const BaseDataType& type,
-                                const void* data) = 0;
+  Status writeDataBlock(const SizeArray& dataShape,
+                        const SizeArray& positionOffset,
+                        const BaseDataType& type,
+                        const void* data);
 
   /**
    * @brief Writes a block of string data (any number of dimensions).
+   *
+   * Records the write in the WriteStatistics if instrumentation is enabled
+   * and otherwise forwards to writeDataBlockImpl, which is implemented by
+   * the IO backends.
    * @param dataShape The size of the data block.
    * @param positionOffset The position of the data block to write to.
    * @param type The data type of the elements in the data block. Either
@@ -968,10 +1139,10 @@ public:
    * @param data Vector with the string data
    * @return The status of the write operation.
    */
-  virtual Status writeDataBlock(const SizeArray& dataShape,
-                                const SizeArray& positionOffset,
-                                const BaseDataType& type,
-                                const std::vector<std::string>& data) = 0;
+  Status writeDataBlock(const SizeArray& dataShape,
+                        const SizeArray& positionOffset,
+                        const BaseDataType& type,
+                        const std::vector<std::string>& data);
 
   /**
    * @brief Get the number of dimensions in the dataset.
@@ -991,7 +1162,78 @@ public:
    */
   inline const SizeArray& getPosition() const { return m_position; }
 
+  /**
+   * @brief Attach the write instrumentation of the IO object that created
+   * this object.
+   *
+   * Called by the IO backends when creating BaseRecordingData objects. Has
+   * no effect if the library is built without AQNWB_ENABLE_INSTRUMENTATION.
+   * @param statistics The WriteStatistics of the IO object.
+   * @param path The path of the dataset.
+   */
+  void setWriteStatistics(std::shared_ptr<WriteStatistics> statistics,
+                          const std::string& path);
+
+  /**
+   * @brief Get the write statistics of the dataset.
+   * @return A copy of the statistics. Empty if no statistics were recorded.
+   */
+  DatasetWriteStats getWriteStatistics() const;
+
 protected:
+  /**
+   * @brief Writes a block of data (any number of dimensions) to the backend.
+   * @copydetails writeDataBlock(const SizeArray&, const SizeArray&, const
+   * BaseDataType&, const void*)
+   */
+  virtual Status writeDataBlockImpl(const SizeArray& dataShape,
+                                    const SizeArray& positionOffset,
+                                    const BaseDataType& type,
+                                    const void* data) = 0;
+
+  /**
+   * @brief Writes a block of string data (any number of dimensions) to the
+   * backend.
+   * @copydetails writeDataBlock(const SizeArray&, const SizeArray&, const
+   * BaseDataType&, const std::vector<std::string>&)
+   */
+  virtual Status writeDataBlockImpl(const SizeArray& dataShape,
+                                    const SizeArray& positionOffset,
+                                    const BaseDataType& type,
+                                    const std::vector<std::string>& data) = 0;
+
+  /**
+   * @brief Record that the dataset was extended in the WriteStatistics.
+   *
+   * Called by the IO backends when a write extends the dataset. Has no
+   * effect if instrumentation is disabled.
+   */
+  void recordExtend();
+
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  /**
+   * @brief Get the write instrumentation if recording is enabled.
+   * @return The WriteStatistics, or nullptr if none is attached or
+   * recording is disabled.
+   */
+  inline WriteStatistics* getActiveWriteStatistics() const
+  {
+    return (m_writeStatistics && m_writeStatistics->isEnabled())
+        ? m_writeStatistics.get()
+        : nullptr;
+  }
+
+  /**
+   * @brief The write instrumentation of the IO object
+   */
+  std::shared_ptr<WriteStatistics> m_writeStatistics;
+
+  /**
+   * @brief The path of the dataset used as key for the statistics
+   */
+  std::string m_writeStatisticsPath;
+#endif
+
   /**
    * @brief The size of the dataset in each dimension.
    */
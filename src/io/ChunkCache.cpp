@@ -0,0 +1,127 @@
+#include <functional>
+
+#include "io/ChunkCache.hpp"
+
+using namespace AQNWB::IO;
+
+// ChunkCache
+
+ChunkCache::ChunkCache(SizeType maxBytes)
+    : m_maxBytes(maxBytes)
+{
+}
+
+std::size_t ChunkCache::KeyHash::operator()(const Key& key) const
+{
+  std::size_t seed = std::hash<std::string> {}(key.path);
+  for (SizeType c : key.coords) {
+    seed ^= std::hash<SizeType> {}(c) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+void ChunkCache::setMaxBytes(SizeType maxBytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_maxBytes = maxBytes;
+  evictToFit(m_maxBytes);
+}
+
+SizeType ChunkCache::getMaxBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_maxBytes;
+}
+
+std::shared_ptr<const ChunkCache::Buffer> ChunkCache::get(
+    const std::string& path, const SizeArray& chunkCoords)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(Key {path, chunkCoords});
+  if (it == m_index.end()) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+  ++m_stats.hits;
+  // move the chunk to the front of the LRU list
+  m_lru.splice(m_lru.begin(), m_lru, it->second);
+  return it->second->second;
+}
+
+void ChunkCache::put(const std::string& path,
+                     const SizeArray& chunkCoords,
+                     std::shared_ptr<const Buffer> data)
+{
+  if (data == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Key key {path, chunkCoords};
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    erase(it->second);
+  }
+
+  SizeType numBytes = data->size();
+  if (numBytes > m_maxBytes) {
+    return;
+  }
+  evictToFit(m_maxBytes - numBytes);
+
+  m_lru.emplace_front(key, std::move(data));
+  m_index.emplace(std::move(key), m_lru.begin());
+  ++m_stats.numChunks;
+  m_stats.numBytes += numBytes;
+}
+
+void ChunkCache::invalidate(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_lru.begin(); it != m_lru.end();) {
+    auto next = std::next(it);
+    if (it->first.path == path) {
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+void ChunkCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lru.clear();
+  m_index.clear();
+  m_stats.numChunks = 0;
+  m_stats.numBytes = 0;
+}
+
+ChunkCacheStats ChunkCache::getStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void ChunkCache::resetStats()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stats.hits = 0;
+  m_stats.misses = 0;
+  m_stats.evictions = 0;
+}
+
+void ChunkCache::erase(std::list<Entry>::iterator it)
+{
+  m_stats.numBytes -= it->second->size();
+  --m_stats.numChunks;
+  m_index.erase(it->first);
+  m_lru.erase(it);
+}
+
+void ChunkCache::evictToFit(SizeType maxBytes)
+{
+  while (!m_lru.empty() && m_stats.numBytes > maxBytes) {
+    erase(std::prev(m_lru.end()));
+    ++m_stats.evictions;
+  }
+}
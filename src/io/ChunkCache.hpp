@@ -0,0 +1,222 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.hpp"
+
+using SizeArray = AQNWB::Types::SizeArray;
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB::IO
+{
+
+/**
+ * @brief Hit/miss statistics of a ChunkCache
+ */
+struct ChunkCacheStats
+{
+  /**
+   * @brief Number of chunk lookups that were served from the cache
+   */
+  SizeType hits = 0;
+
+  /**
+   * @brief Number of chunk lookups that were not found in the cache
+   */
+  SizeType misses = 0;
+
+  /**
+   * @brief Number of chunks that were evicted to stay within the budget
+   */
+  SizeType evictions = 0;
+
+  /**
+   * @brief Number of chunks currently held by the cache
+   */
+  SizeType numChunks = 0;
+
+  /**
+   * @brief Number of bytes currently held by the cache
+   */
+  SizeType numBytes = 0;
+
+  /**
+   * @brief Fraction of lookups that were hits.
+   * @return The hit rate in [0, 1], or 0 if no lookups have been performed.
+   */
+  inline double hitRate() const
+  {
+    SizeType lookups = hits + misses;
+    return (lookups == 0)
+        ? 0.0
+        : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+};
+
+/**
+ * @brief Least-recently-used cache of decoded dataset chunks.
+ *
+ * The cache is owned by a BaseIO object and is therefore shared by all
+ * ReadDataWrapper objects reading from the same file. Chunks are keyed by the
+ * path of the dataset and the coordinates of the chunk in the chunk grid
+ * (i.e., the chunk index along each dimension) and hold the decoded
+ * (i.e., decompressed) raw bytes of the chunk. The total size of all cached
+ * chunks is bounded by a configurable memory budget. A budget of 0 disables
+ * the cache.
+ *
+ * All methods are thread-safe.
+ */
+class ChunkCache
+{
+public:
+  /**
+   * @brief Buffer type used to store the decoded bytes of a chunk
+   */
+  using Buffer = std::vector<unsigned char>;
+
+  /**
+   * @brief Constructor
+   * @param maxBytes The memory budget of the cache in bytes. 0 disables the
+   * cache.
+   */
+  explicit ChunkCache(SizeType maxBytes = 0);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  ChunkCache(const ChunkCache&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  ChunkCache& operator=(const ChunkCache&) = delete;
+
+  /**
+   * @brief Set the memory budget of the cache.
+   *
+   * Least-recently-used chunks are evicted as needed to fit the new budget.
+   * @param maxBytes The memory budget in bytes. 0 disables the cache.
+   */
+  void setMaxBytes(SizeType maxBytes);
+
+  /**
+   * @brief Get the memory budget of the cache in bytes
+   */
+  SizeType getMaxBytes() const;
+
+  /**
+   * @brief Check whether the cache is enabled, i.e., has a non-zero budget
+   */
+  inline bool isEnabled() const { return getMaxBytes() > 0; }
+
+  /**
+   * @brief Look up a chunk in the cache and mark it as most recently used.
+   * @param path The path of the dataset
+   * @param chunkCoords The coordinates of the chunk in the chunk grid
+   * @return The decoded chunk, or nullptr if the chunk is not cached
+   */
+  std::shared_ptr<const Buffer> get(const std::string& path,
+                                    const SizeArray& chunkCoords);
+
+  /**
+   * @brief Add a decoded chunk to the cache.
+   *
+   * If the chunk is already cached it is replaced. Chunks that are larger
+   * than the memory budget are not cached.
+   * @param path The path of the dataset
+   * @param chunkCoords The coordinates of the chunk in the chunk grid
+   * @param data The decoded bytes of the chunk
+   */
+  void put(const std::string& path,
+           const SizeArray& chunkCoords,
+           std::shared_ptr<const Buffer> data);
+
+  /**
+   * @brief Remove all cached chunks of a dataset
+   * @param path The path of the dataset
+   */
+  void invalidate(const std::string& path);
+
+  /**
+   * @brief Remove all cached chunks. The statistics are not reset.
+   */
+  void clear();
+
+  /**
+   * @brief Get the current hit/miss statistics of the cache
+   */
+  ChunkCacheStats getStats() const;
+
+  /**
+   * @brief Reset the hit, miss, and eviction counters to 0
+   */
+  void resetStats();
+
+private:
+  /**
+   * @brief Key identifying a chunk of a dataset
+   */
+  struct Key
+  {
+    std::string path;
+    SizeArray coords;
+
+    inline bool operator==(const Key& other) const
+    {
+      return path == other.path && coords == other.coords;
+    }
+  };
+
+  /**
+   * @brief Hash function for Key
+   */
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  using Entry = std::pair<Key, std::shared_ptr<const Buffer>>;
+
+  /**
+   * @brief Remove an entry from the cache. The mutex must be held.
+   */
+  void erase(std::list<Entry>::iterator it);
+
+  /**
+   * @brief Evict least-recently-used chunks until the cache holds at most
+   * maxBytes. The mutex must be held.
+   */
+  void evictToFit(SizeType maxBytes);
+
+  /**
+   * @brief Cached chunks ordered from most to least recently used
+   */
+  std::list<Entry> m_lru;
+
+  /**
+   * @brief Index from chunk key to the position of the chunk in m_lru
+   */
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+
+  /**
+   * @brief The memory budget in bytes
+   */
+  SizeType m_maxBytes;
+
+  /**
+   * @brief The cache statistics
+   */
+  ChunkCacheStats m_stats;
+
+  /**
+   * @brief Mutex guarding all members
+   */
+  mutable std::mutex m_mutex;
+};
+
+}  // namespace AQNWB::IO
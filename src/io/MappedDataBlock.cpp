@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "io/MappedDataBlock.hpp"
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+using namespace AQNWB::IO;
+
+namespace
+{
+/**
+ * @brief Granularity that the offset of a mapping must be aligned to
+ */
+SizeType getMappingAlignment()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<SizeType>(info.dwAllocationGranularity);
+#else
+  return static_cast<SizeType>(sysconf(_SC_PAGESIZE));
+#endif
+}
+}  // namespace
+
+MemoryMapping::MemoryMapping(const std::string& filename,
+                             SizeType offset,
+                             SizeType length)
+    : m_length(length)
+{
+  SizeType alignment = getMappingAlignment();
+  SizeType alignedOffset = offset - (offset % alignment);
+  SizeType delta = offset - alignedOffset;
+  // mapping zero bytes is not allowed
+  m_mappedLength = std::max<SizeType>(length + delta, 1);
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Failed to open file for mapping: " + filename);
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+  m_base = MapViewOfFile(mapping,
+                         FILE_MAP_READ,
+                         static_cast<DWORD>(alignedOffset >> 32),
+                         static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                         static_cast<SIZE_T>(m_mappedLength));
+  // the view keeps a reference to the mapping object
+  CloseHandle(mapping);
+  if (m_base == nullptr) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file for mapping: " + filename);
+  }
+  void* base = mmap(nullptr,
+                    static_cast<size_t>(m_mappedLength),
+                    PROT_READ,
+                    MAP_SHARED,
+                    fd,
+                    static_cast<off_t>(alignedOffset));
+  // the mapping keeps a reference to the file
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+  m_base = base;
+#endif
+
+  m_data = static_cast<const char*>(m_base) + delta;
+}
+
+MemoryMapping::~MemoryMapping()
+{
+  if (m_base == nullptr) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_base);
+#else
+  munmap(m_base, static_cast<size_t>(m_mappedLength));
+#endif
+}
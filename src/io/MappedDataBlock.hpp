@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/ReadIO.hpp"
+
+using SizeArray = AQNWB::Types::SizeArray;
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB::IO
+{
+
+/**
+ * @brief Read-only memory mapping of a region of a file.
+ *
+ * The region is mapped on construction and unmapped on destruction. The
+ * mapping is aligned internally to the page size of the system, such that
+ * arbitrary offsets are supported.
+ */
+class MemoryMapping
+{
+public:
+  /**
+   * @brief Map a region of a file into memory.
+   * @param filename The path of the file.
+   * @param offset The offset in bytes of the region in the file.
+   * @param length The length in bytes of the region.
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  MemoryMapping(const std::string& filename, SizeType offset, SizeType length);
+
+  /**
+   * @brief Unmap the region.
+   */
+  ~MemoryMapping();
+
+  MemoryMapping(const MemoryMapping&) = delete;
+  MemoryMapping& operator=(const MemoryMapping&) = delete;
+
+  /**
+   * @brief Pointer to the first byte of the mapped region.
+   */
+  inline const void* data() const { return m_data; }
+
+  /**
+   * @brief The length in bytes of the mapped region.
+   */
+  inline SizeType length() const { return m_length; }
+
+private:
+  /**
+   * @brief The page-aligned address returned by the system
+   */
+  void* m_base = nullptr;
+
+  /**
+   * @brief The length of the page-aligned mapping
+   */
+  SizeType m_mappedLength = 0;
+
+  /**
+   * @brief The first byte of the requested region within the mapping
+   */
+  const void* m_data = nullptr;
+
+  /**
+   * @brief The length of the requested region
+   */
+  SizeType m_length = 0;
+};
+
+/**
+ * @brief Read-only, zero-copy view of a dataset backed by a memory mapping.
+ *
+ * Provides the same access to the values as DataBlock without copying them
+ * from the file. The view keeps the mapping alive, i.e., copies of a
+ * MappedDataBlock share the same mapping, which is released when the last
+ * copy is destroyed. The values reflect the content of the file at the time
+ * of access.
+ *
+ * @tparam DTYPE The data type of the values
+ */
+template<typename DTYPE>
+class MappedDataBlock
+{
+public:
+  /**
+   * @brief Constructor
+   * @param mapping The memory mapping holding the values
+   * @param shape The n-dimensional shape of the data
+   */
+  MappedDataBlock(std::shared_ptr<const MemoryMapping> mapping,
+                  const SizeArray& shape)
+      : m_mapping(std::move(mapping))
+      , m_shape(shape)
+  {
+    m_size = std::accumulate(m_shape.begin(),
+                             m_shape.end(),
+                             SizeType {1},
+                             std::multiplies<SizeType> {});
+    if (m_mapping == nullptr || m_mapping->length() < m_size * sizeof(DTYPE))
+    {
+      throw std::invalid_argument(
+          "Memory mapping is too small for the given shape.");
+    }
+  }
+
+  /**
+   * @brief Pointer to the first value
+   */
+  inline const DTYPE* data() const
+  {
+    return static_cast<const DTYPE*>(m_mapping->data());
+  }
+
+  /**
+   * @brief The number of values
+   */
+  inline SizeType size() const { return m_size; }
+
+  /**
+   * @brief The n-dimensional shape of the data
+   */
+  inline const SizeArray& getShape() const { return m_shape; }
+
+  /**
+   * @brief Access the value at a flat (row-major) index
+   */
+  inline const DTYPE& operator[](SizeType index) const
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Pointer to the first value
+   */
+  inline const DTYPE* begin() const { return data(); }
+
+  /**
+   * @brief Pointer to one past the last value
+   */
+  inline const DTYPE* end() const { return data() + m_size; }
+
+  /**
+   * @brief Multi-dimensional view of the mapped values.
+   *
+   * The view is only valid as long as this MappedDataBlock (or a copy of it)
+   * exists.
+   *
+   * @tparam NDIMS The number of dimensions. Same as getShape().size()
+   * @return A ConstMultiArrayView of the mapped values
+   */
+  template<std::size_t NDIMS>
+  inline ConstMultiArrayView<DTYPE, NDIMS> as_multi_array() const
+  {
+    if (m_shape.size() != NDIMS) {
+      throw std::invalid_argument(
+          "Shape size does not match the number of dimensions.");
+    }
+
+    std::array<std::size_t, NDIMS> shape_array {};
+    for (std::size_t i = 0; i < NDIMS; ++i) {
+      shape_array[i] = static_cast<std::size_t>(m_shape[i]);
+    }
+
+    std::array<std::size_t, NDIMS> strides {};
+    std::size_t stride = 1;
+    for (std::size_t i = NDIMS; i-- > 0;) {
+      strides[i] = stride;
+      stride *= shape_array[i];
+    }
+
+    return ConstMultiArrayView<DTYPE, NDIMS>(data(), shape_array, strides);
+  }
+
+  /**
+   * @brief Copy the mapped values into a DataBlock
+   */
+  inline DataBlock<DTYPE> toDataBlock() const
+  {
+    return DataBlock<DTYPE>(std::vector<DTYPE>(begin(), end()), m_shape);
+  }
+
+private:
+  std::shared_ptr<const MemoryMapping> m_mapping;
+  SizeArray m_shape;
+  SizeType m_size = 0;
+};
+
+}  // namespace AQNWB::IO
@@ -674,6 +674,52 @@ public:
         this->valuesGeneric(start, count, stride, block));
   }
 
+  /**
+   * @brief Reads an arbitrary selection of the dataset in one read operation.
+   *
+   * We do not support selections for attributes, so this function is
+   * disabled for attributes.
+   *
+   * @param selection One list of indices per dimension of the dataset. An
+   * empty list selects all indices along the dimension.
+   *
+   * @return An DataBlockGeneric structure containing the data and shape.
+   *
+   * @sa BaseIO::readDatasetSelection
+   */
+  template<StorageObjectType U = OTYPE,
+           typename std::enable_if<isDataset<U>::value, int>::type = 0>
+  inline DataBlockGeneric valuesGenericSelection(
+      const std::vector<SizeArray>& selection) const
+  {
+    return m_io->readDatasetSelection(m_path, selection);
+  }
+
+  /**
+   * @brief Reads an arbitrary selection of the dataset in one read operation
+   * with a specified data type.
+   *
+   * This convenience function uses valuesGenericSelection to read the data
+   * and then convert the DataBlockGeneric to a specific DataBlock.
+   *
+   * @tparam T the value type to use. By default this is set to the VTYPE
+   *           of the object.
+   *
+   * @param selection One list of indices per dimension of the dataset. An
+   * empty list selects all indices along the dimension.
+   *
+   * @return A DataBlock structure containing the data and shape.
+   */
+  template<typename T = VTYPE,
+           StorageObjectType U = OTYPE,
+           typename std::enable_if<isDataset<U>::value, int>::type = 0>
+  inline DataBlock<VTYPE> valuesSelection(
+      const std::vector<SizeArray>& selection) const
+  {
+    return DataBlock<VTYPE>::fromGeneric(
+        this->valuesGenericSelection(selection));
+  }
+
 protected:
   /**
    * @brief Pointer to the I/O object to use for reading.
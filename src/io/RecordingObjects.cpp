@@ -1,4 +1,3 @@
-#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -21,12 +20,10 @@ RecordingObjects::~RecordingObjects() {}
 SizeType RecordingObjects::getRecordingIndex(
     const std::shared_ptr<const AQNWB::NWB::RegisteredType>& object) const
 {
-  // Check if object already exists in the vector
-  for (SizeType i = 0; i < m_recording_objects.size(); ++i) {
-    // compares identity of the raw pointer for the RegisteredType object
-    if (m_recording_objects[i].get() == object.get()) {
-      return i;  // Return existing index
-    }
+  // compares identity of the raw pointer for the RegisteredType object
+  auto it = m_indexByObject.find(object.get());
+  if (it != m_indexByObject.end()) {
+    return it->second;
   }
   // Return sentinel value for failure
   return std::numeric_limits<SizeType>::max();
@@ -35,15 +32,36 @@ SizeType RecordingObjects::getRecordingIndex(
 SizeType RecordingObjects::addRecordingObject(
     const std::shared_ptr<AQNWB::NWB::RegisteredType>& object)
 {
-  // Check if object already exists in the vector
-  SizeType objectIndex = getRecordingIndex(object);
-  if (isValidIndex(objectIndex)) {
-    return objectIndex;  // Return existing index if found
-  } else {
-    // If not found, add it and return the new index
-    m_recording_objects.push_back(object);
-    return m_recording_objects.size() - 1;
+  // Return the existing index if the object is already in the collection
+  SizeType newIndex = m_recording_objects.size();
+  auto inserted = m_indexByObject.emplace(object.get(), newIndex);
+  if (!inserted.second) {
+    return inserted.first->second;
+  }
+
+  // If not found, add it and return the new index
+  m_recording_objects.push_back(object);
+  if (object) {
+    // keeps the index of the first object with the same path
+    m_indexByPath.emplace(object->getPath(), newIndex);
+  }
+  return newIndex;
+}
+
+std::vector<SizeType> RecordingObjects::addRecordingObjects(
+    const std::vector<std::shared_ptr<AQNWB::NWB::RegisteredType>>& objects)
+{
+  SizeType capacity = m_recording_objects.size() + objects.size();
+  m_recording_objects.reserve(capacity);
+  m_indexByObject.reserve(capacity);
+  m_indexByPath.reserve(capacity);
+
+  std::vector<SizeType> indexes;
+  indexes.reserve(objects.size());
+  for (const auto& object : objects) {
+    indexes.push_back(addRecordingObject(object));
   }
+  return indexes;
 }
 
 std::shared_ptr<AQNWB::NWB::RegisteredType>
@@ -59,11 +77,35 @@ RecordingObjects::getRecordingObject(const SizeType& objectInd)
 std::shared_ptr<AQNWB::NWB::RegisteredType>
 RecordingObjects::getRecordingObject(const std::string& path) const
 {
-  auto it = std::find_if(m_recording_objects.begin(),
-                         m_recording_objects.end(),
-                         [&path](const auto& obj)
-                         { return obj && obj->getPath() == path; });
-  return (it != m_recording_objects.end()) ? *it : nullptr;
+  auto it = m_indexByPath.find(path);
+  return (it != m_indexByPath.end()) ? m_recording_objects[it->second]
+                                     : nullptr;
+}
+
+std::map<std::string, DatasetWriteStats> RecordingObjects::getWriteStatistics(
+    const SizeType& objectInd) const
+{
+  std::map<std::string, DatasetWriteStats> result;
+  if (objectInd >= m_recording_objects.size()
+      || !m_recording_objects[objectInd])
+  {
+    return result;
+  }
+  for (const auto& [path, dataset] :
+       m_recording_objects[objectInd]->getCacheRecordingData())
+  {
+    if (dataset) {
+      result[path] = dataset->getWriteStatistics();
+    }
+  }
+  return result;
+}
+
+void RecordingObjects::clear()
+{
+  m_recording_objects.clear();
+  m_indexByObject.clear();
+  m_indexByPath.clear();
 }
 
 Status RecordingObjects::finalize()
@@ -80,6 +122,30 @@ Status RecordingObjects::finalize()
   return overallStatus;
 }
 
+Status RecordingObjects::recordingPaused(double time)
+{
+  Status overallStatus = Status::Success;
+  for (auto& object : m_recording_objects) {
+    if (object) {
+      Status status = object->recordingPaused(time);
+      overallStatus = overallStatus && status;
+    }
+  }
+  return overallStatus;
+}
+
+Status RecordingObjects::recordingResumed(double time)
+{
+  Status overallStatus = Status::Success;
+  for (auto& object : m_recording_objects) {
+    if (object) {
+      Status status = object->recordingResumed(time);
+      overallStatus = overallStatus && status;
+    }
+  }
+  return overallStatus;
+}
+
 Status RecordingObjects::clearRecordingDataCache()
 {
   Status overallStatus = Status::Success;
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "Channel.hpp"
 #include "Types.hpp"
 #include "nwb/base/TimeSeries.hpp"
@@ -54,6 +59,21 @@ public:
   SizeType addRecordingObject(
       const std::shared_ptr<AQNWB::NWB::RegisteredType>& object);
 
+  /**
+   * @brief Adds multiple RegisteredType objects to the recording objects
+   * collection.
+   *
+   * Same as calling addRecordingObject for each object, but reserves the
+   * storage for all objects up front. Use this when registering large
+   * numbers of objects, e.g., one series per unit or per ROI.
+   *
+   * @param objects The RegisteredType objects to add.
+   * @return The index of each object in the collection, in the order of
+   * the input.
+   */
+  std::vector<SizeType> addRecordingObjects(
+      const std::vector<std::shared_ptr<AQNWB::NWB::RegisteredType>>& objects);
+
   /**
    * @brief Gets the RegisteredType object from the recording objects collection
    * @param objectInd The index of the object within the collection.
@@ -64,8 +84,8 @@ public:
   /**
    * @brief Gets the RegisteredType object from the recording objects collection
    * based on the path of the object.
-   * NOTE: This function performs a linear search. If for some reason multiple
-   * objects with the same path exist, the first one found will be returned.
+   * NOTE: If multiple objects with the same path exist, the one that was
+   * added first will be returned.
    * @param path The path of the object to retrieve.
    * @return Shared pointer to the RegisteredType object if found, nullptr
    *         otherwise.
@@ -86,7 +106,7 @@ public:
   /**
    * @brief Clear the recording objects collection.
    */
-  void clear() { m_recording_objects.clear(); }
+  void clear();
 
   /**
    * @brief Finalize all RegisteredType objects managed by this RecordingObjects
@@ -103,6 +123,38 @@ public:
    */
   Status clearRecordingDataCache();
 
+  /**
+   * @brief Notify all RegisteredType objects managed by this RecordingObjects
+   * instance that recording was paused. This method calls recordingPaused()
+   * on all objects in the collection.
+   * @param time The time of the pause in seconds
+   * @return The status of the operation.
+   */
+  Status recordingPaused(double time);
+
+  /**
+   * @brief Notify all RegisteredType objects managed by this RecordingObjects
+   * instance that recording resumes. This method calls recordingResumed()
+   * on all objects in the collection.
+   * @param time The time at which recording resumes in seconds
+   * @return The status of the operation.
+   */
+  Status recordingResumed(double time);
+
+  /**
+   * @brief Get the write statistics of the datasets of a recording object.
+   *
+   * Covers the datasets in the recording data cache of the object, i.e.,
+   * the datasets that have been written to via the object since the cache
+   * was last cleared. Requires the write instrumentation to be enabled (see
+   * BaseIO::getWriteStatistics).
+   * @param objectInd The index of the object within the collection.
+   * @return The statistics of each dataset, keyed by the path of the
+   * dataset. Empty if the index is invalid.
+   */
+  std::map<std::string, DatasetWriteStats> getWriteStatistics(
+      const SizeType& objectInd) const;
+
   /**
    * @brief Get the number of recording objects
    */
@@ -121,6 +173,18 @@ private:
    */
   std::vector<std::shared_ptr<AQNWB::NWB::RegisteredType>> m_recording_objects;
 
+  /**
+   * @brief Index of each object in m_recording_objects by object identity
+   */
+  std::unordered_map<const AQNWB::NWB::RegisteredType*, SizeType>
+      m_indexByObject;
+
+  /**
+   * @brief Index of the first object with a given path in
+   * m_recording_objects
+   */
+  std::unordered_map<std::string, SizeType> m_indexByPath;
+
   /**
    * @brief The name of the collection of recording objects
    */
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "io/WriteStatistics.hpp"
+
+using namespace AQNWB::IO;
+
+namespace
+{
+/**
+ * @brief Get the index of the most significant bit of a non-zero value
+ */
+unsigned mostSignificantBit(std::uint64_t value)
+{
+  unsigned msb = 0;
+  while (value >>= 1) {
+    ++msb;
+  }
+  return msb;
+}
+
+/**
+ * @brief Escape a string for use as a JSON string value
+ */
+std::string escapeJSON(const std::string& value)
+{
+  std::ostringstream result;
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        result << "\\\"";
+        break;
+      case '\\':
+        result << "\\\\";
+        break;
+      case '\n':
+        result << "\\n";
+        break;
+      case '\t':
+        result << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          result << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                 << static_cast<int>(c) << std::dec;
+        } else {
+          result << c;
+        }
+    }
+  }
+  return result.str();
+}
+
+/**
+ * @brief Serialize a LatencyHistogram as a JSON object
+ */
+void writeJSON(std::ostream& out, const LatencyHistogram& histogram)
+{
+  out << "{\"count\": " << histogram.count()
+      << ", \"min\": " << histogram.min() << ", \"mean\": " << std::fixed
+      << std::setprecision(1) << histogram.mean()
+      << ", \"p50\": " << histogram.percentile(50.0)
+      << ", \"p99\": " << histogram.percentile(99.0)
+      << ", \"p99.9\": " << histogram.percentile(99.9)
+      << ", \"max\": " << histogram.max() << "}";
+}
+
+/**
+ * @brief Serialize a DatasetWriteStats as a JSON object
+ */
+void writeJSON(std::ostream& out, const DatasetWriteStats& stats)
+{
+  out << "{\"calls\": " << stats.calls << ", \"bytes\": " << stats.bytes
+      << ", \"extends\": " << stats.extends
+      << ", \"flushes\": " << stats.flushes
+      << ", \"failures\": " << stats.failures << ", \"write_latency_ns\": ";
+  writeJSON(out, stats.writeLatency);
+  out << ", \"flush_latency_ns\": ";
+  writeJSON(out, stats.flushLatency);
+  out << "}";
+}
+}  // namespace
+
+// LatencyHistogram
+
+SizeType LatencyHistogram::bucketIndex(std::uint64_t value)
+{
+  constexpr std::uint64_t subBuckets = std::uint64_t {1} << SubBucketBits;
+  if (value < 2 * subBuckets) {
+    return static_cast<SizeType>(value);
+  }
+  unsigned shift = mostSignificantBit(value) - SubBucketBits;
+  return static_cast<SizeType>(subBuckets * shift + (value >> shift));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(SizeType index)
+{
+  constexpr SizeType subBuckets = SizeType {1} << SubBucketBits;
+  if (index < 2 * subBuckets) {
+    return index;
+  }
+  SizeType shift = index / subBuckets - 1;
+  std::uint64_t subBucket = index % subBuckets + subBuckets;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds)
+{
+  SizeType index = bucketIndex(nanoseconds);
+  if (index >= m_buckets.size()) {
+    m_buckets.resize(bucketIndex((std::numeric_limits<std::uint64_t>::max)())
+                     + 1);
+  }
+  ++m_buckets[index];
+  m_min = (m_count == 0) ? nanoseconds : std::min(m_min, nanoseconds);
+  m_max = std::max(m_max, nanoseconds);
+  m_sum += static_cast<double>(nanoseconds);
+  ++m_count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  if (other.m_count == 0) {
+    return;
+  }
+  if (m_buckets.size() < other.m_buckets.size()) {
+    m_buckets.resize(other.m_buckets.size());
+  }
+  for (SizeType i = 0; i < other.m_buckets.size(); ++i) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+  m_min = (m_count == 0) ? other.m_min : std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+  m_count += other.m_count;
+}
+
+void LatencyHistogram::clear()
+{
+  m_buckets.clear();
+  m_count = 0;
+  m_sum = 0.0;
+  m_min = 0;
+  m_max = 0;
+}
+
+double LatencyHistogram::mean() const
+{
+  return m_count == 0 ? 0.0 : m_sum / static_cast<double>(m_count);
+}
+
+std::uint64_t LatencyHistogram::percentile(double percentile) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+  double clamped = std::clamp(percentile, 0.0, 100.0);
+  // rank of the value at the percentile, counting from 1
+  auto rank = static_cast<std::uint64_t>(
+      std::ceil(clamped / 100.0 * static_cast<double>(m_count)));
+  rank = std::max<std::uint64_t>(rank, 1);
+
+  std::uint64_t cumulative = 0;
+  for (SizeType i = 0; i < m_buckets.size(); ++i) {
+    cumulative += m_buckets[i];
+    if (cumulative >= rank) {
+      return std::min(bucketUpperBound(i), m_max);
+    }
+  }
+  return m_max;
+}
+
+// WriteStatistics
+
+void WriteStatistics::setEnabled(bool enabled)
+{
+  m_enabled.store(enabled && isCompiledIn(), std::memory_order_relaxed);
+}
+
+DatasetWriteStats WriteStatistics::getDatasetStats(
+    const std::string& path) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_datasets.find(path);
+  return (it != m_datasets.end()) ? it->second : DatasetWriteStats();
+}
+
+std::map<std::string, DatasetWriteStats> WriteStatistics::getAllDatasetStats()
+    const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_datasets;
+}
+
+DatasetWriteStats WriteStatistics::getFileStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_file;
+}
+
+void WriteStatistics::reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_datasets.clear();
+  m_file = DatasetWriteStats();
+}
+
+std::string WriteStatistics::toJSON() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::ostringstream out;
+  out << "{\"enabled\": " << (isEnabled() ? "true" : "false")
+      << ", \"file\": ";
+  writeJSON(out, m_file);
+  out << ", \"datasets\": {";
+  bool first = true;
+  for (const auto& [path, stats] : m_datasets) {
+    out << (first ? "" : ", ") << "\"" << escapeJSON(path) << "\": ";
+    writeJSON(out, stats);
+    first = false;
+  }
+  out << "}}";
+  return out.str();
+}
+
+void WriteStatistics::recordWrite(const std::string& path,
+                                  std::uint64_t nanoseconds,
+                                  SizeType bytes,
+                                  bool success)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  DatasetWriteStats& stats = m_datasets[path];
+  ++stats.calls;
+  if (success) {
+    stats.bytes += bytes;
+  } else {
+    ++stats.failures;
+  }
+  stats.writeLatency.record(nanoseconds);
+}
+
+void WriteStatistics::recordExtend(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_datasets[path].extends;
+}
+
+void WriteStatistics::recordFlush(const std::string& path,
+                                  std::uint64_t nanoseconds)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  DatasetWriteStats& stats = m_datasets[path];
+  ++stats.flushes;
+  stats.flushLatency.record(nanoseconds);
+}
+
+void WriteStatistics::recordFileFlush(std::uint64_t nanoseconds)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_file.flushes;
+  m_file.flushLatency.record(nanoseconds);
+}
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB::IO
+{
+
+/**
+ * @brief Histogram of latencies in nanoseconds with bounded relative error.
+ *
+ * Values are counted in log-linear buckets similar to an HDR histogram:
+ * values below 64 are counted exactly, larger values in 32 linear
+ * sub-buckets per power of two, i.e., with a relative error of at most
+ * 1/32. The buckets are allocated on the first recorded value.
+ */
+class LatencyHistogram
+{
+public:
+  /**
+   * @brief Count a value
+   * @param nanoseconds The latency to count
+   */
+  void record(std::uint64_t nanoseconds);
+
+  /**
+   * @brief Add the counts of another histogram to this histogram
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Remove all counted values
+   */
+  void clear();
+
+  /**
+   * @brief The number of counted values
+   */
+  inline std::uint64_t count() const { return m_count; }
+
+  /**
+   * @brief The smallest counted value, or 0 if the histogram is empty
+   */
+  inline std::uint64_t min() const { return m_count == 0 ? 0 : m_min; }
+
+  /**
+   * @brief The largest counted value, or 0 if the histogram is empty
+   */
+  inline std::uint64_t max() const { return m_max; }
+
+  /**
+   * @brief The mean of the counted values, or 0 if the histogram is empty
+   */
+  double mean() const;
+
+  /**
+   * @brief Get the value at a given percentile.
+   *
+   * The result is the largest value that falls into the same bucket as the
+   * value at the percentile, but at most max().
+   *
+   * @param percentile The percentile in [0, 100], e.g., 99.9
+   * @return The value at the percentile, or 0 if the histogram is empty
+   */
+  std::uint64_t percentile(double percentile) const;
+
+private:
+  /**
+   * @brief Number of linear sub-buckets per power of two
+   */
+  static constexpr unsigned SubBucketBits = 5;
+
+  /**
+   * @brief Get the index of the bucket counting a value
+   */
+  static SizeType bucketIndex(std::uint64_t value);
+
+  /**
+   * @brief Get the largest value counted by a bucket
+   */
+  static std::uint64_t bucketUpperBound(SizeType index);
+
+  /**
+   * @brief The number of values in each bucket
+   */
+  std::vector<std::uint64_t> m_buckets;
+
+  /**
+   * @brief The number of counted values
+   */
+  std::uint64_t m_count = 0;
+
+  /**
+   * @brief The sum of the counted values
+   */
+  double m_sum = 0.0;
+
+  /**
+   * @brief The smallest counted value
+   */
+  std::uint64_t m_min = 0;
+
+  /**
+   * @brief The largest counted value
+   */
+  std::uint64_t m_max = 0;
+};
+
+/**
+ * @brief I/O counters and latency histograms of a dataset
+ */
+struct DatasetWriteStats
+{
+  /**
+   * @brief Number of writeDataBlock calls
+   */
+  SizeType calls = 0;
+
+  /**
+   * @brief Number of bytes passed to successful writeDataBlock calls
+   */
+  SizeType bytes = 0;
+
+  /**
+   * @brief Number of times the dataset was extended
+   */
+  SizeType extends = 0;
+
+  /**
+   * @brief Number of times the dataset (or file) was flushed
+   */
+  SizeType flushes = 0;
+
+  /**
+   * @brief Number of writeDataBlock calls that failed
+   */
+  SizeType failures = 0;
+
+  /**
+   * @brief Latency of the writeDataBlock calls
+   */
+  LatencyHistogram writeLatency;
+
+  /**
+   * @brief Latency of the flushes
+   */
+  LatencyHistogram flushLatency;
+};
+
+/**
+ * @brief Opt-in write instrumentation of a BaseIO object.
+ *
+ * Collects a DatasetWriteStats for each dataset written through the IO
+ * object as well as for flushes of the whole file. Recording is only
+ * available if the library is built with the CMake option
+ * AQNWB_ENABLE_INSTRUMENTATION (see isCompiledIn). Otherwise, the write path
+ * contains no instrumentation code at all and all statistics stay empty.
+ * When compiled in, recording is disabled by default and is turned on via
+ * setEnabled.
+ *
+ * All methods are thread-safe.
+ */
+class WriteStatistics
+{
+public:
+  /**
+   * @brief Clock used to measure latencies
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructor
+   */
+  WriteStatistics() = default;
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  WriteStatistics(const WriteStatistics&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  WriteStatistics& operator=(const WriteStatistics&) = delete;
+
+  /**
+   * @brief Check whether the library was built with instrumentation support
+   */
+  static constexpr bool isCompiledIn()
+  {
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Enable or disable recording. Has no effect if the library was
+   * built without instrumentation support.
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * @brief Check whether statistics are being recorded
+   */
+  inline bool isEnabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the statistics of a dataset
+   * @param path The path of the dataset
+   * @return A copy of the statistics. Empty if nothing was recorded.
+   */
+  DatasetWriteStats getDatasetStats(const std::string& path) const;
+
+  /**
+   * @brief Get the statistics of all datasets
+   * @return A copy of the statistics, keyed by the path of the dataset
+   */
+  std::map<std::string, DatasetWriteStats> getAllDatasetStats() const;
+
+  /**
+   * @brief Get the statistics of flushes of the whole file
+   */
+  DatasetWriteStats getFileStats() const;
+
+  /**
+   * @brief Reset all counters and histograms
+   */
+  void reset();
+
+  /**
+   * @brief Serialize all statistics as JSON.
+   *
+   * Latencies are reported in nanoseconds as count, min, mean, p50, p99,
+   * p99.9, and max.
+   */
+  std::string toJSON() const;
+
+  /**
+   * @brief Record a writeDataBlock call of a dataset
+   * @param path The path of the dataset
+   * @param nanoseconds The latency of the call
+   * @param bytes The number of bytes written
+   * @param success Whether the call succeeded
+   */
+  void recordWrite(const std::string& path,
+                   std::uint64_t nanoseconds,
+                   SizeType bytes,
+                   bool success);
+
+  /**
+   * @brief Record that a dataset was extended
+   * @param path The path of the dataset
+   */
+  void recordExtend(const std::string& path);
+
+  /**
+   * @brief Record a flush of a dataset
+   * @param path The path of the dataset
+   * @param nanoseconds The latency of the flush
+   */
+  void recordFlush(const std::string& path, std::uint64_t nanoseconds);
+
+  /**
+   * @brief Record a flush of the whole file
+   * @param nanoseconds The latency of the flush
+   */
+  void recordFileFlush(std::uint64_t nanoseconds);
+
+  /**
+   * @brief Get the nanoseconds elapsed since a given time point
+   */
+  static inline std::uint64_t elapsedNanoseconds(Clock::time_point start)
+  {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now()
+                                                             - start)
+            .count());
+  }
+
+private:
+  /**
+   * @brief Whether statistics are being recorded
+   */
+  std::atomic<bool> m_enabled {false};
+
+  /**
+   * @brief Statistics of each dataset, keyed by path
+   */
+  std::map<std::string, DatasetWriteStats> m_datasets;
+
+  /**
+   * @brief Statistics of flushes of the whole file
+   */
+  DatasetWriteStats m_file;
+
+  /**
+   * @brief Mutex protecting the statistics
+   */
+  mutable std::mutex m_mutex;
+};
+
+}  // namespace AQNWB::IO
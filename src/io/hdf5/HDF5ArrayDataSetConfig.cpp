@@ -63,3 +63,13 @@ const std::vector<HDF5FilterConfig>& HDF5ArrayDataSetConfig::getFilters() const
 {
   return m_filters;
 }
+
+void HDF5ArrayDataSetConfig::setContiguous(bool contiguous)
+{
+  m_contiguous = contiguous;
+}
+
+bool HDF5ArrayDataSetConfig::isContiguous() const
+{
+  return m_contiguous;
+}
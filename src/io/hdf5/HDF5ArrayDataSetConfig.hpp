@@ -111,9 +111,29 @@ public:
    */
   const std::vector<HDF5FilterConfig>& getFilters() const;
 
+  /**
+   * @brief Sets whether the dataset uses the contiguous rather than the
+   * chunked layout.
+   *
+   * Contiguous datasets are stored as a single block at a fixed offset in the
+   * file and can be memory-mapped for reading (see HDF5IO::mapDataset). They
+   * have a fixed shape, i.e., all chunking values must be 0, and do not
+   * support filters.
+   * @param contiguous True to use the contiguous layout.
+   */
+  void setContiguous(bool contiguous);
+
+  /**
+   * @brief Returns whether the dataset uses the contiguous layout.
+   * @return True if the dataset uses the contiguous layout.
+   */
+  bool isContiguous() const;
+
 private:
   // The filters of the dataset
   std::vector<HDF5FilterConfig> m_filters;
+  // Whether to use the contiguous layout
+  bool m_contiguous = false;
 };
 
 }  // namespace AQNWB::IO::HDF5
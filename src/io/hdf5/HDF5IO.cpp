@@ -1,8 +1,11 @@
 #include <algorithm>
 #include <cassert>
 #include <codecvt>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
@@ -14,12 +17,259 @@
 #include <H5Fpublic.h>
 
 #include "Utils.hpp"
+#include "Tracing.hpp"
+#include "io/ChunkCache.hpp"
 #include "io/hdf5/HDF5ArrayDataSetConfig.hpp"
 #include "io/hdf5/HDF5RecordingData.hpp"
 
 using namespace H5;
 using namespace AQNWB::IO::HDF5;
 
+namespace
+{
+/**
+ * @brief Empty tag used to pass a type to a generic lambda
+ */
+template<typename T>
+struct TypeTag
+{
+  using type = T;
+};
+
+/**
+ * @brief Call func with a TypeTag for the native C++ type matching dataType
+ * @return False if dataType is not a supported native numeric type
+ */
+template<typename Func>
+bool visitNativeType(const H5::DataType& dataType, Func&& func)
+{
+  if (dataType == H5::PredType::NATIVE_DOUBLE) {
+    func(TypeTag<double> {});
+  } else if (dataType == H5::PredType::NATIVE_FLOAT) {
+    func(TypeTag<float> {});
+  } else if (dataType == H5::PredType::NATIVE_INT8) {
+    func(TypeTag<int8_t> {});
+  } else if (dataType == H5::PredType::NATIVE_UINT8) {
+    func(TypeTag<uint8_t> {});
+  } else if (dataType == H5::PredType::NATIVE_INT16) {
+    func(TypeTag<int16_t> {});
+  } else if (dataType == H5::PredType::NATIVE_UINT16) {
+    func(TypeTag<uint16_t> {});
+  } else if (dataType == H5::PredType::NATIVE_INT32) {
+    func(TypeTag<int32_t> {});
+  } else if (dataType == H5::PredType::NATIVE_UINT32) {
+    func(TypeTag<uint32_t> {});
+  } else if (dataType == H5::PredType::NATIVE_INT64) {
+    func(TypeTag<int64_t> {});
+  } else if (dataType == H5::PredType::NATIVE_UINT64) {
+    func(TypeTag<uint64_t> {});
+  } else if (dataType == H5::PredType::NATIVE_INT) {
+    func(TypeTag<int> {});
+  } else if (dataType == H5::PredType::NATIVE_UINT) {
+    func(TypeTag<unsigned int> {});
+  } else if (dataType == H5::PredType::NATIVE_LONG) {
+    func(TypeTag<long> {});
+  } else if (dataType == H5::PredType::NATIVE_ULONG) {
+    func(TypeTag<unsigned long> {});
+  } else if (dataType == H5::PredType::NATIVE_LLONG) {
+    func(TypeTag<long long> {});
+  } else if (dataType == H5::PredType::NATIVE_ULLONG) {
+    func(TypeTag<unsigned long long> {});
+  } else if (dataType == H5::PredType::NATIVE_UCHAR) {
+    func(TypeTag<unsigned char> {});
+  } else if (dataType == H5::PredType::NATIVE_USHORT) {
+    func(TypeTag<unsigned short> {});
+  } else if (dataType == H5::PredType::NATIVE_CHAR) {
+    func(TypeTag<char> {});
+  } else if (dataType == H5::PredType::NATIVE_SHORT) {
+    func(TypeTag<short> {});
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Read the first value of a string attribute of an object
+ * @param objectId The HDF5 object the attribute is attached to
+ * @param name The name of the attribute
+ * @param value Output value of the attribute
+ * @return False if the attribute does not exist or is not a string
+ */
+bool readStringAttributeValue(hid_t objectId,
+                              const char* name,
+                              std::string& value)
+{
+  if (H5Aexists(objectId, name) <= 0) {
+    return false;
+  }
+  hid_t attrId = H5Aopen(objectId, name, H5P_DEFAULT);
+  if (attrId < 0) {
+    return false;
+  }
+  hid_t typeId = H5Aget_type(attrId);
+  hid_t spaceId = H5Aget_space(attrId);
+  hssize_t numElements = H5Sget_simple_extent_npoints(spaceId);
+  bool success = false;
+  if (typeId >= 0 && numElements > 0 && H5Tget_class(typeId) == H5T_STRING) {
+    auto count = static_cast<size_t>(numElements);
+    if (H5Tis_variable_str(typeId) > 0) {
+      hid_t memTypeId = H5Tcopy(H5T_C_S1);
+      H5Tset_size(memTypeId, H5T_VARIABLE);
+      H5Tset_cset(memTypeId, H5Tget_cset(typeId));
+      std::vector<char*> buffer(count, nullptr);
+      if (H5Aread(attrId, memTypeId, buffer.data()) >= 0) {
+        value = (buffer[0] != nullptr) ? std::string(buffer[0]) : "";
+        success = true;
+        for (char* str : buffer) {
+          H5free_memory(str);
+        }
+      }
+      H5Tclose(memTypeId);
+    } else {
+      size_t size = H5Tget_size(typeId);
+      std::vector<char> buffer(size * count, '\0');
+      if (size > 0 && H5Aread(attrId, typeId, buffer.data()) >= 0) {
+        auto end = std::find(buffer.begin(),
+                             buffer.begin() + static_cast<std::ptrdiff_t>(size),
+                             '\0');
+        value.assign(buffer.begin(), end);
+        success = true;
+      }
+    }
+  }
+  H5Sclose(spaceId);
+  H5Tclose(typeId);
+  H5Aclose(attrId);
+  return success;
+}
+
+/**
+ * @brief Get the full type name `namespace::neurodata_type` of an object
+ * @return The full type name, or an empty string for untyped objects
+ */
+std::string readObjectTypeName(hid_t objectId)
+{
+  std::string typeNamespace;
+  std::string typeName;
+  if (readStringAttributeValue(objectId, "neurodata_type", typeName)
+      && readStringAttributeValue(objectId, "namespace", typeNamespace))
+  {
+    return typeNamespace + "::" + typeName;
+  }
+  return "";
+}
+
+/**
+ * @brief H5Lvisit callback adding the groups and datasets of the file to a
+ * type index, i.e., a std::map from path to full type name
+ */
+template<typename LinkInfo>
+herr_t addToTypeIndex(hid_t rootId,
+                      const char* name,
+                      const LinkInfo* info,
+                      void* opData)
+{
+  // soft and external links are not followed, consistent with
+  // BaseIO::findTypes
+  if (info->type != H5L_TYPE_HARD) {
+    return 0;
+  }
+  hid_t objectId = H5Oopen(rootId, name, H5P_DEFAULT);
+  if (objectId < 0) {
+    return 0;
+  }
+  H5I_type_t objectType = H5Iget_type(objectId);
+  if (objectType == H5I_GROUP || objectType == H5I_DATASET) {
+    auto* index = static_cast<std::map<std::string, std::string>*>(opData);
+    (*index)[std::string("/") + name] = readObjectTypeName(objectId);
+  }
+  H5Oclose(objectId);
+  return 0;
+}
+
+/**
+ * @brief Remove trailing slashes from a path other than the root path
+ */
+std::string trimTrailingSlashes(const std::string& path)
+{
+  size_t end = path.find_last_not_of('/');
+  return (end == std::string::npos) ? std::string("/")
+                                    : path.substr(0, end + 1);
+}
+
+/**
+ * @brief State of HDF5IO::visitStorageObjects passed to the H5Literate and
+ * H5Aiterate callbacks
+ */
+struct StorageObjectVisitor
+{
+  const AQNWB::IO::BaseIO::StorageObjectCallback& callback;
+  StorageObjectType objectType;
+  std::exception_ptr error = nullptr;
+
+  /**
+   * @brief Pass an object to the callback if it matches the filter
+   * @return The return value for the HDF5 iterate function, i.e., 0 to
+   * continue, 1 to stop, and -1 if the callback threw an exception
+   */
+  herr_t visit(const char* name, StorageObjectType type)
+  {
+    if (objectType != StorageObjectType::Undefined && type != objectType) {
+      return 0;
+    }
+    try {
+      return callback(name, type) ? 0 : 1;
+    } catch (...) {
+      error = std::current_exception();
+      return -1;
+    }
+  }
+};
+
+/**
+ * @brief H5Literate callback of HDF5IO::visitStorageObjects
+ */
+template<typename LinkInfo>
+herr_t visitStorageObjectLink(hid_t groupId,
+                              const char* name,
+                              const LinkInfo* info,
+                              void* opData)
+{
+  auto* visitor = static_cast<StorageObjectVisitor*>(opData);
+  // soft and external links are reported as Undefined
+  StorageObjectType type = StorageObjectType::Undefined;
+  if (info->type == H5L_TYPE_HARD) {
+    H5O_info_t objInfo;
+#if H5_VERSION_GE(1, 12, 0)
+    herr_t status = H5Oget_info_by_name(
+        groupId, name, &objInfo, H5O_INFO_BASIC, H5P_DEFAULT);
+#else
+    herr_t status =
+        H5Oget_info_by_name(groupId, name, &objInfo, H5P_DEFAULT);
+#endif
+    if (status >= 0 && objInfo.type == H5O_TYPE_GROUP) {
+      type = StorageObjectType::Group;
+    } else if (status >= 0 && objInfo.type == H5O_TYPE_DATASET) {
+      type = StorageObjectType::Dataset;
+    }
+  }
+  return visitor->visit(name, type);
+}
+
+/**
+ * @brief H5Aiterate callback of HDF5IO::visitStorageObjects
+ */
+herr_t visitStorageObjectAttribute(hid_t,
+                                   const char* name,
+                                   const H5A_info_t*,
+                                   void* opData)
+{
+  auto* visitor = static_cast<StorageObjectVisitor*>(opData);
+  return visitor->visit(name, StorageObjectType::Attribute);
+}
+}  // namespace
+
 // HDF5IO
 HDF5IO::HDF5IO(const std::string& fileName)
     : BaseIO(fileName)
@@ -55,6 +305,7 @@ Status HDF5IO::open()
 
 Status HDF5IO::open(FileMode mode)
 {
+  TraceScope trace("HDF5IO::open", "io");
   unsigned int accFlags = 0;
 
   if (m_opened) {
@@ -87,6 +338,7 @@ Status HDF5IO::open(FileMode mode)
   m_file = std::make_unique<H5::H5File>(
       getFileName(), accFlags, FileCreatPropList::DEFAULT, fapl);
   m_opened = true;
+  clearTypeIndex();
 
   return Status::Success;
 }
@@ -111,11 +363,22 @@ Status HDF5IO::closeFileImpl()
     m_file = nullptr;
     m_opened = false;
   }
+  clearTypeIndex();
   return Status::Success;
 }
 
 Status HDF5IO::flush()
 {
+  TraceScope trace("HDF5IO::flush", "io");
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (m_writeStatistics->isEnabled()) {
+    auto start = WriteStatistics::Clock::now();
+    int status = H5Fflush(m_file->getId(), H5F_SCOPE_GLOBAL);
+    m_writeStatistics->recordFileFlush(
+        WriteStatistics::elapsedNanoseconds(start));
+    return intToStatus(status);
+  }
+#endif
   int status = H5Fflush(m_file->getId(), H5F_SCOPE_GLOBAL);
   return intToStatus(status);
 }
@@ -212,6 +475,114 @@ std::vector<T> HDF5IO::readDataHelper(const HDF5TYPE& dataSource,
       dataSource, numElements, H5::DataSpace(), H5::DataSpace());
 }
 
+template<typename T>
+std::vector<T> HDF5IO::readChunkCachedHelper(
+    const H5::DataSet& dataset,
+    const std::string& dataPath,
+    const std::vector<hsize_t>& offset,
+    const std::vector<hsize_t>& count,
+    const std::vector<hsize_t>& dims,
+    const std::vector<hsize_t>& chunkDims)
+{
+  const size_t rank = count.size();
+  const size_t numElements = std::accumulate(
+      count.begin(), count.end(), size_t {1}, std::multiplies<size_t> {});
+  std::vector<T> data(numElements);
+  if (numElements == 0 || rank == 0) {
+    return data;
+  }
+
+  auto chunkCache = getChunkCache();
+  H5::DataType type = dataset.getDataType();
+  H5::DataSpace fileSpace = dataset.getSpace();
+
+  // Range of chunk coordinates intersecting the requested block
+  std::vector<hsize_t> firstChunk(rank), lastChunk(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    firstChunk[i] = offset[i] / chunkDims[i];
+    lastChunk[i] = (offset[i] + count[i] - 1) / chunkDims[i];
+  }
+
+  SizeArray chunkCoords(firstChunk.begin(), firstChunk.end());
+  std::vector<hsize_t> chunkStart(rank), chunkExtent(rank);
+  std::vector<hsize_t> lo(rank), hi(rank), pos(rank);
+  while (true) {
+    // Determine the region of the dataset covered by the current chunk
+    bool fullChunk = true;
+    for (size_t i = 0; i < rank; ++i) {
+      chunkStart[i] = chunkCoords[i] * chunkDims[i];
+      chunkExtent[i] = std::min(chunkDims[i], dims[i] - chunkStart[i]);
+      fullChunk = fullChunk && (chunkExtent[i] == chunkDims[i]);
+    }
+
+    // Get the decoded chunk from the cache or read it from the file. Chunks
+    // at the edge of the dataset may still grow and are therefore not cached.
+    std::shared_ptr<const ChunkCache::Buffer> chunk =
+        fullChunk ? chunkCache->get(dataPath, chunkCoords) : nullptr;
+    if (chunk == nullptr) {
+      size_t chunkElements = std::accumulate(chunkExtent.begin(),
+                                             chunkExtent.end(),
+                                             size_t {1},
+                                             std::multiplies<size_t> {});
+      auto buffer =
+          std::make_shared<ChunkCache::Buffer>(chunkElements * sizeof(T));
+      fileSpace.selectHyperslab(
+          H5S_SELECT_SET, chunkExtent.data(), chunkStart.data());
+      H5::DataSpace chunkSpace(static_cast<int>(rank), chunkExtent.data());
+      dataset.read(buffer->data(), type, chunkSpace, fileSpace);
+      if (fullChunk) {
+        chunkCache->put(dataPath, chunkCoords, buffer);
+      }
+      chunk = buffer;
+    }
+
+    // Copy the intersection of the chunk and the block row by row
+    for (size_t i = 0; i < rank; ++i) {
+      lo[i] = std::max(offset[i], chunkStart[i]);
+      hi[i] = std::min(offset[i] + count[i], chunkStart[i] + chunkExtent[i]);
+    }
+    const size_t rowBytes =
+        static_cast<size_t>(hi[rank - 1] - lo[rank - 1]) * sizeof(T);
+    pos = lo;
+    while (true) {
+      size_t srcIndex = 0;
+      size_t dstIndex = 0;
+      for (size_t i = 0; i < rank; ++i) {
+        srcIndex = srcIndex * chunkExtent[i] + (pos[i] - chunkStart[i]);
+        dstIndex = dstIndex * count[i] + (pos[i] - offset[i]);
+      }
+      std::memcpy(data.data() + dstIndex,
+                  chunk->data() + srcIndex * sizeof(T),
+                  rowBytes);
+      // Advance to the next row, i.e., all dimensions but the last
+      bool rowsDone = true;
+      for (size_t dim = rank - 1; dim-- > 0;) {
+        if (++pos[dim] < hi[dim]) {
+          rowsDone = false;
+          break;
+        }
+        pos[dim] = lo[dim];
+      }
+      if (rowsDone) {
+        break;
+      }
+    }
+
+    // Advance to the next chunk
+    bool chunksDone = true;
+    for (size_t dim = rank; dim-- > 0;) {
+      if (++chunkCoords[dim] <= lastChunk[dim]) {
+        chunksDone = false;
+        break;
+      }
+      chunkCoords[dim] = firstChunk[dim];
+    }
+    if (chunksDone) {
+      return data;
+    }
+  }
+}
+
 template<typename HDF5TYPE>
 std::vector<std::string> HDF5IO::readStringDataHelper(
     const HDF5TYPE& dataSource,
@@ -520,6 +891,7 @@ AQNWB::IO::DataBlockGeneric HDF5IO::readDataset(const std::string& dataPath,
                                                 const SizeArray& stride,
                                                 const SizeArray& block)
 {
+  TraceScope trace("HDF5IO::readDataset", "io");
   // Check that the dataset exists
   assert(H5Lexists(m_file->getId(), dataPath.c_str(), H5P_DEFAULT) > 0);
 
@@ -560,9 +932,9 @@ AQNWB::IO::DataBlockGeneric HDF5IO::readDataset(const std::string& dataPath,
 
   // Create a memory dataspace for the slice
   H5::DataSpace memspace;
+  std::vector<hsize_t> offset(rank, 0);
+  std::vector<hsize_t> block_count(dims);
   if (!start.empty() && !count.empty()) {
-    std::vector<hsize_t> offset(rank);
-    std::vector<hsize_t> block_count(rank);
     for (SizeType i = 0; i < rank; ++i) {
       offset[i] = start[i];
       block_count[i] = count[i];
@@ -603,6 +975,35 @@ AQNWB::IO::DataBlockGeneric HDF5IO::readDataset(const std::string& dataPath,
                                        size_t {1},
                                        std::multiplies<size_t> {});
 
+  // Decide whether to read via the chunk cache. This is only safe for
+  // unstrided selections of chunked datasets in files opened read-only, since
+  // cached chunks are not updated when data is written.
+  std::vector<hsize_t> chunkDims;
+  bool useChunkCache = getChunkCache()->isEnabled() && isReadOnly() && rank > 0;
+  for (SizeType i = 0; useChunkCache && i < rank; ++i) {
+    useChunkCache = (stride_hsize.empty() || stride_hsize[i] == 1)
+        && (block_hsize.empty() || block_hsize[i] == 1);
+  }
+  if (useChunkCache) {
+    H5::DSetCreatPropList plist = dataset.getCreatePlist();
+    useChunkCache = (plist.getLayout() == H5D_CHUNKED);
+    if (useChunkCache) {
+      chunkDims.resize(rank);
+      plist.getChunk(static_cast<int>(rank), chunkDims.data());
+    }
+  }
+
+  // Read numeric data either directly or via the chunk cache
+  auto readNumeric = [&](auto typeTag)
+  {
+    using T = typename decltype(typeTag)::type;
+    if (useChunkCache) {
+      return readChunkCachedHelper<T>(
+          dataset, dataPath, offset, block_count, dims, chunkDims);
+    }
+    return readDataHelper<T>(dataset, numElements, memspace, dataspace);
+  };
+
   // Read the dataset into a vector of the appropriate type
   H5::DataType dataType = dataset.getDataType();
   result.baseDataType = getBaseDataType(dataType);
@@ -611,102 +1012,188 @@ AQNWB::IO::DataBlockGeneric HDF5IO::readDataset(const std::string& dataPath,
     result.data =
         readStringDataHelper(dataset, numElements, memspace, dataspace);
     result.typeIndex = typeid(std::string);
-  } else if (dataType == H5::PredType::NATIVE_DOUBLE) {
-    result.data =
-        readDataHelper<double>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(double);
-  } else if (dataType == H5::PredType::NATIVE_FLOAT) {
-    result.data =
-        readDataHelper<float>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(float);
-  } else if (dataType == H5::PredType::NATIVE_INT8) {
-    result.data =
-        readDataHelper<int8_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(int8_t);
-  } else if (dataType == H5::PredType::NATIVE_UINT8) {
-    result.data =
-        readDataHelper<uint8_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(uint8_t);
-  } else if (dataType == H5::PredType::NATIVE_INT16) {
-    result.data =
-        readDataHelper<int16_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(int16_t);
-  } else if (dataType == H5::PredType::NATIVE_UINT16) {
-    result.data =
-        readDataHelper<uint16_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(uint16_t);
-  } else if (dataType == H5::PredType::NATIVE_INT32) {
-    result.data =
-        readDataHelper<int32_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(int32_t);
-  } else if (dataType == H5::PredType::NATIVE_UINT32) {
-    result.data =
-        readDataHelper<uint32_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(uint32_t);
-  } else if (dataType == H5::PredType::NATIVE_INT64) {
-    result.data =
-        readDataHelper<int64_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(int64_t);
-  } else if (dataType == H5::PredType::NATIVE_UINT64) {
-    result.data =
-        readDataHelper<uint64_t>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(uint64_t);
-  } else if (dataType == H5::PredType::NATIVE_INT) {
-    result.data =
-        readDataHelper<int>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(int);
-  } else if (dataType == H5::PredType::NATIVE_UINT) {
-    result.data =
-        readDataHelper<unsigned int>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(unsigned int);
-  } else if (dataType == H5::PredType::NATIVE_LONG) {
-    result.data =
-        readDataHelper<long>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(long);
-  } else if (dataType == H5::PredType::NATIVE_ULONG) {
-    result.data = readDataHelper<unsigned long>(
-        dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(unsigned long);
-  } else if (dataType == H5::PredType::NATIVE_LLONG) {
-    result.data =
-        readDataHelper<long long>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(long long);
-  } else if (dataType == H5::PredType::NATIVE_ULLONG) {
-    result.data = readDataHelper<unsigned long long>(
-        dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(unsigned long long);
-  } else if (dataType == H5::PredType::NATIVE_UCHAR) {
-    result.data = readDataHelper<unsigned char>(
-        dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(unsigned char);
-  } else if (dataType == H5::PredType::NATIVE_USHORT) {
-    result.data = readDataHelper<unsigned short>(
-        dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(unsigned short);
-  } else if (dataType == H5::PredType::NATIVE_CHAR) {
-    result.data =
-        readDataHelper<char>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(char);
-  } else if (dataType == H5::PredType::NATIVE_SHORT) {
-    result.data =
-        readDataHelper<short>(dataset, numElements, memspace, dataspace);
-    result.typeIndex = typeid(short);
-  } else {
+  } else if (!visitNativeType(dataType,
+                              [&](auto typeTag)
+                              {
+                                using T = typename decltype(typeTag)::type;
+                                result.data = readNumeric(typeTag);
+                                result.typeIndex = typeid(T);
+                              }))
+  {
     throw std::runtime_error("Unsupported data type");
   }
   // Return the result
   return result;
 }
 
+AQNWB::IO::DataBlockGeneric HDF5IO::readDatasetSelection(
+    const std::string& dataPath, const std::vector<SizeArray>& selection)
+{
+  TraceScope trace("HDF5IO::readDatasetSelection", "io");
+  // Check that the dataset exists
+  assert(H5Lexists(m_file->getId(), dataPath.c_str(), H5P_DEFAULT) > 0);
+
+  H5::DataSet dataset;
+  try {
+    dataset = m_file->openDataSet(dataPath);
+  } catch (const H5::Exception& e) {
+    std::cerr << "Failed to open dataset: " << e.getDetailMsg() << std::endl;
+    throw std::runtime_error("Failed to open dataset");
+  }
+
+  H5::DataSpace dataspace = dataset.getSpace();
+  SizeType rank = static_cast<SizeType>(dataspace.getSimpleExtentNdims());
+  if (rank == 0) {
+    return readDataset(dataPath);
+  }
+  if (selection.size() != rank) {
+    throw std::invalid_argument(
+        "HDF5IO::readDatasetSelection, selection must provide one list of "
+        "indices per dimension.");
+  }
+  std::vector<hsize_t> dims(rank);
+  dataspace.getSimpleExtentDims(dims.data(), nullptr);
+
+  // For each dimension determine the requested indices, the sorted unique
+  // indices that we read from the file, and the position of each requested
+  // index in the list of unique indices
+  IO::DataBlockGeneric result;
+  result.shape.resize(rank);
+  std::vector<std::vector<hsize_t>> uniqueIndices(rank);
+  std::vector<SizeArray> indexMap(rank);
+  bool needsReorder = false;
+  for (SizeType d = 0; d < rank; ++d) {
+    std::vector<hsize_t>& unique = uniqueIndices[d];
+    if (selection[d].empty()) {
+      unique.resize(dims[d]);
+      std::iota(unique.begin(), unique.end(), hsize_t {0});
+    } else {
+      unique.assign(selection[d].begin(), selection[d].end());
+      std::sort(unique.begin(), unique.end());
+      unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+      if (unique.back() >= dims[d]) {
+        throw std::runtime_error(
+            "Selection index for dimension not within extent.");
+      }
+      indexMap[d].reserve(selection[d].size());
+      for (SizeType index : selection[d]) {
+        indexMap[d].push_back(static_cast<SizeType>(
+            std::lower_bound(unique.begin(), unique.end(), index)
+            - unique.begin()));
+      }
+      needsReorder = needsReorder || (selection[d].size() != unique.size())
+          || !std::is_sorted(selection[d].begin(), selection[d].end());
+    }
+    result.shape[d] = selection[d].empty() ? dims[d] : selection[d].size();
+  }
+
+  // Build the file selection as the union of one hyperslab per combination
+  // of consecutive runs of indices along each dimension
+  std::vector<std::vector<std::pair<hsize_t, hsize_t>>> runs(rank);
+  std::vector<hsize_t> memDims(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    for (hsize_t index : uniqueIndices[d]) {
+      if (!runs[d].empty()
+          && runs[d].back().first + runs[d].back().second == index)
+      {
+        ++runs[d].back().second;
+      } else {
+        runs[d].emplace_back(index, 1);
+      }
+    }
+    memDims[d] = uniqueIndices[d].size();
+  }
+  dataspace.selectNone();
+  bool emptySelection = std::any_of(
+      runs.begin(), runs.end(), [](const auto& r) { return r.empty(); });
+  if (!emptySelection) {
+    std::vector<SizeType> runIndex(rank, 0);
+    std::vector<hsize_t> offset(rank), count(rank);
+    bool done = false;
+    while (!done) {
+      for (SizeType d = 0; d < rank; ++d) {
+        offset[d] = runs[d][runIndex[d]].first;
+        count[d] = runs[d][runIndex[d]].second;
+      }
+      dataspace.selectHyperslab(H5S_SELECT_OR, count.data(), offset.data());
+      done = true;
+      for (SizeType d = rank; d-- > 0;) {
+        if (++runIndex[d] < runs[d].size()) {
+          done = false;
+          break;
+        }
+        runIndex[d] = 0;
+      }
+    }
+  }
+  H5::DataSpace memspace(static_cast<int>(rank), memDims.data());
+  size_t numElements = std::accumulate(
+      memDims.begin(), memDims.end(), size_t {1}, std::multiplies<size_t> {});
+
+  // Scatter the compact block read from the file into the requested order
+  auto reorder = [&](auto&& compact)
+  {
+    using V = std::decay_t<decltype(compact)>;
+    if (!needsReorder) {
+      return V(std::move(compact));
+    }
+    size_t numOutput = std::accumulate(result.shape.begin(),
+                                       result.shape.end(),
+                                       size_t {1},
+                                       std::multiplies<size_t> {});
+    V output;
+    output.reserve(numOutput);
+    std::vector<SizeType> pos(rank, 0);
+    for (size_t i = 0; i < numOutput; ++i) {
+      size_t compactIndex = 0;
+      for (SizeType d = 0; d < rank; ++d) {
+        SizeType index = indexMap[d].empty() ? pos[d] : indexMap[d][pos[d]];
+        compactIndex = compactIndex * memDims[d] + index;
+      }
+      output.push_back(compact[compactIndex]);
+      for (SizeType d = rank; d-- > 0;) {
+        if (++pos[d] < result.shape[d]) {
+          break;
+        }
+        pos[d] = 0;
+      }
+    }
+    return output;
+  };
+
+  // Read the selection into a vector of the appropriate type
+  H5::DataType dataType = dataset.getDataType();
+  result.baseDataType = getBaseDataType(dataType);
+  if (dataType.getClass() == H5T_STRING) {
+    result.data = reorder(
+        readStringDataHelper(dataset, numElements, memspace, dataspace));
+    result.typeIndex = typeid(std::string);
+  } else if (!visitNativeType(
+                 dataType,
+                 [&](auto typeTag)
+                 {
+                   using T = typename decltype(typeTag)::type;
+                   result.data = reorder(readDataHelper<T>(
+                       dataset, numElements, memspace, dataspace));
+                   result.typeIndex = typeid(T);
+                 }))
+  {
+    throw std::runtime_error("Unsupported data type");
+  }
+  return result;
+}
+
 Status HDF5IO::createAttribute(const IO::BaseDataType& type,
                                const void* data,
                                const std::string& path,
                                const std::string& name,
                                const SizeType& size)
 {
+  TraceScope trace("HDF5IO::createAttribute", "io");
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   // For array attributes (size > 1), use the underlying element type (not
   // ArrayType) with a 1D dataspace when the array length was historically
@@ -760,9 +1247,11 @@ Status HDF5IO::createAttribute(const std::string& data,
                                const std::string& name,
                                const bool overwrite)
 {
+  TraceScope trace("HDF5IO::createAttribute", "io");
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   // Create variable length string type
   StrType H5type(PredType::C_S1, static_cast<size_t>(H5T_VARIABLE));
@@ -822,9 +1311,11 @@ Status HDF5IO::createAttribute(const std::vector<std::string>& data,
                                const std::string& name,
                                const bool overwrite)
 {
+  TraceScope trace("HDF5IO::createAttribute", "io");
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   // Create variable length string type
   StrType H5type(PredType::C_S1, static_cast<size_t>(H5T_VARIABLE));
@@ -891,9 +1382,11 @@ Status HDF5IO::createReferenceAttribute(const std::string& referencePath,
                                         const std::string& path,
                                         const std::string& name)
 {
+  TraceScope trace("HDF5IO::createReferenceAttribute", "io");
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   auto manage_attribute = [&](H5Object& loc)
   {
@@ -932,6 +1425,7 @@ Status HDF5IO::createGroup(const std::string& path)
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   try {
     m_file->createGroup(path);
@@ -950,6 +1444,7 @@ Status HDF5IO::createGroupIfDoesNotExist(const std::string& path)
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
   try {
     m_file->childObjType(path);
   } catch (const FileIException&) {
@@ -964,6 +1459,7 @@ Status HDF5IO::createLink(const std::string& path, const std::string& reference)
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
   if (!objectExists(reference)) {
     std::cerr << "HDF5IO::createLink Reference target does not exist: "
               << reference << std::endl;
@@ -985,6 +1481,7 @@ Status HDF5IO::createReferenceDataSet(
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   const hsize_t size = references.size();
 
@@ -1032,6 +1529,7 @@ Status HDF5IO::createStringDataSet(const std::string& path,
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   std::unique_ptr<H5::DataSet> dataset;
   DataType H5type = getH5Type(IO::BaseDataType::STR(value.length()));
@@ -1050,6 +1548,7 @@ Status HDF5IO::createStringDataSet(const std::string& path,
   if (!canModifyObjects()) {
     return Status::Failure;
   }
+  clearTypeIndex();
 
   std::unique_ptr<IO::BaseRecordingData> dataset;
   IO::ArrayDataSetConfig config(
@@ -1124,6 +1623,16 @@ bool HDF5IO::canModifyObjects()
   return statusOK && !inSWMRMode;
 }
 
+bool HDF5IO::isReadOnly() const
+{
+  if (!m_opened || m_file == nullptr) {
+    return false;
+  }
+  unsigned int intent;
+  herr_t status = H5Fget_intent(m_file->getId(), &intent);
+  return (status >= 0) && !(intent & H5F_ACC_RDWR);
+}
+
 bool HDF5IO::objectExists(const std::string& path) const
 {
   htri_t exists = H5Lexists(m_file->getId(), path.c_str(), H5P_DEFAULT);
@@ -1146,56 +1655,185 @@ HDF5IO::getStorageObjects(const std::string& path,
 
 {
   std::vector<std::pair<std::string, StorageObjectType>> objects;
+  visitStorageObjects(
+      path,
+      [&objects](const std::string& name, StorageObjectType type)
+      {
+        objects.emplace_back(name, type);
+        return true;
+      },
+      objectType);
+  return objects;
+}
 
+Status HDF5IO::visitStorageObjects(const std::string& path,
+                                   const StorageObjectCallback& callback,
+                                   const StorageObjectType& objectType) const
+{
   H5O_type_t h5Type = getH5ObjectType(path);
-  if (h5Type == H5O_TYPE_GROUP) {
-    H5::Group group = m_file->openGroup(path);
-    hsize_t num_objs = group.getNumObjs();
-    for (hsize_t i = 0; i < num_objs; ++i) {
-      std::string objName = group.getObjnameByIdx(i);
-      H5G_obj_t objType = group.getObjTypeByIdx(i);
-      StorageObjectType storageObjectType;
-      switch (objType) {
-        case H5G_GROUP:
-          storageObjectType = StorageObjectType::Group;
-          break;
-        case H5G_DATASET:
-          storageObjectType = StorageObjectType::Dataset;
-          break;
-        default:
-          storageObjectType = StorageObjectType::Undefined;
-      }
-      if (storageObjectType == objectType
-          || objectType == StorageObjectType::Undefined)
-      {
-        objects.emplace_back(objName, storageObjectType);
-      }
+  if (h5Type != H5O_TYPE_GROUP && h5Type != H5O_TYPE_DATASET) {
+    return Status::Failure;
+  }
+  hid_t objectId = H5Oopen(m_file->getId(), path.c_str(), H5P_DEFAULT);
+  if (objectId < 0) {
+    return Status::Failure;
+  }
+
+  StorageObjectVisitor visitor {callback, objectType};
+  herr_t status = 0;
+
+  // Visit the links of groups in a single pass in increasing name order
+  if (h5Type == H5O_TYPE_GROUP && objectType != StorageObjectType::Attribute)
+  {
+    hsize_t linkIndex = 0;
+#if H5_VERSION_GE(1, 12, 0)
+    status = H5Literate2(objectId,
+                         H5_INDEX_NAME,
+                         H5_ITER_INC,
+                         &linkIndex,
+                         visitStorageObjectLink<H5L_info2_t>,
+                         &visitor);
+#else
+    status = H5Literate(objectId,
+                        H5_INDEX_NAME,
+                        H5_ITER_INC,
+                        &linkIndex,
+                        visitStorageObjectLink<H5L_info_t>,
+                        &visitor);
+#endif
+  }
+
+  // Visit the attributes of groups and datasets
+  if (status == 0
+      && (objectType == StorageObjectType::Attribute
+          || objectType == StorageObjectType::Undefined))
+  {
+    hsize_t attrIndex = 0;
+    status = H5Aiterate2(objectId,
+                         H5_INDEX_NAME,
+                         H5_ITER_INC,
+                         &attrIndex,
+                         visitStorageObjectAttribute,
+                         &visitor);
+  }
+  H5Oclose(objectId);
+
+  // Propagate exceptions thrown by the callback
+  if (visitor.error) {
+    std::rethrow_exception(visitor.error);
+  }
+  return (status < 0) ? Status::Failure : Status::Success;
+}
+
+void HDF5IO::clearTypeIndex() const
+{
+  m_typeIndex.clear();
+  m_typeIndexValid = false;
+}
+
+const std::map<std::string, std::string>& HDF5IO::getTypeIndex() const
+{
+  if (m_typeIndexValid) {
+    return m_typeIndex;
+  }
+
+  // Visit all links of the file once, recording the type of each object
+  m_typeIndex.clear();
+  hid_t rootId = H5Gopen(m_file->getId(), "/", H5P_DEFAULT);
+  if (rootId < 0) {
+    return m_typeIndex;
+  }
+  m_typeIndex["/"] = readObjectTypeName(rootId);
+#if H5_VERSION_GE(1, 12, 0)
+  herr_t status = H5Lvisit2(rootId,
+                            H5_INDEX_NAME,
+                            H5_ITER_NATIVE,
+                            addToTypeIndex<H5L_info2_t>,
+                            &m_typeIndex);
+#else
+  herr_t status = H5Lvisit(rootId,
+                           H5_INDEX_NAME,
+                           H5_ITER_NATIVE,
+                           addToTypeIndex<H5L_info_t>,
+                           &m_typeIndex);
+#endif
+  H5Gclose(rootId);
+  m_typeIndexValid = (status >= 0);
+  return m_typeIndex;
+}
+
+std::unordered_map<std::string, std::string> HDF5IO::findTypes(
+    const std::string& starting_path,
+    const std::unordered_set<std::string>& types,
+    SearchMode search_mode,
+    bool exclude_starting_path) const
+{
+  TraceScope trace("HDF5IO::findTypes", "io");
+  if (!m_opened || starting_path.empty() || starting_path[0] != '/') {
+    return BaseIO::findTypes(
+        starting_path, types, search_mode, exclude_starting_path);
+  }
+
+  const auto& index = getTypeIndex();
+  std::string startPath = trimTrailingSlashes(starting_path);
+  auto startIt = index.find(startPath);
+  if (!m_typeIndexValid || startIt == index.end()) {
+    // e.g., soft links which are not part of the index
+    return BaseIO::findTypes(
+        starting_path, types, search_mode, exclude_starting_path);
+  }
+
+  std::unordered_map<std::string, std::string> found_types;
+  auto matches = [&types](const std::string& type)
+  { return !type.empty() && (types.empty() || types.count(type) > 0); };
+
+  // Handle the starting path itself
+  if (!startIt->second.empty() && !exclude_starting_path) {
+    if (matches(startIt->second)) {
+      found_types[starting_path] = startIt->second;
+    }
+    if (search_mode == SearchMode::STOP_ON_TYPE) {
+      return found_types;
     }
+  }
 
-    // Include attributes for groups
-    if (objectType == StorageObjectType::Attribute
-        || objectType == StorageObjectType::Undefined)
-    {
-      unsigned int numAttrs = static_cast<unsigned int>(group.getNumAttrs());
-      for (unsigned int i = 0; i < numAttrs; ++i) {
-        H5::Attribute attr = group.openAttribute(i);
-        objects.emplace_back(attr.getName(), StorageObjectType::Attribute);
-      }
+  // All objects below the starting path are stored consecutively in the index
+  std::string prefix = (startPath == "/") ? startPath : startPath + "/";
+  for (auto it = index.lower_bound(prefix);
+       it != index.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+       ++it)
+  {
+    if (it->first == startPath || !matches(it->second)) {
+      continue;
     }
-  } else if (h5Type == H5O_TYPE_DATASET) {
-    if (objectType == StorageObjectType::Attribute
-        || objectType == StorageObjectType::Undefined)
-    {
-      H5::DataSet dataset = m_file->openDataSet(path);
-      unsigned int numAttrs = static_cast<unsigned int>(dataset.getNumAttrs());
-      for (unsigned int i = 0; i < numAttrs; ++i) {
-        H5::Attribute attr = dataset.openAttribute(i);
-        objects.emplace_back(attr.getName(), StorageObjectType::Attribute);
+    // With STOP_ON_TYPE, skip objects nested inside another typed object
+    // below the starting path
+    bool nested = false;
+    if (search_mode == SearchMode::STOP_ON_TYPE) {
+      size_t pos = it->first.find_last_of('/');
+      while (!nested && pos != std::string::npos && pos >= prefix.size()) {
+        auto parent = index.find(it->first.substr(0, pos));
+        nested = (parent != index.end() && !parent->second.empty());
+        pos = it->first.find_last_of('/', pos - 1);
       }
     }
+    if (!nested) {
+      found_types[it->first] = it->second;
+    }
   }
+  return found_types;
+}
 
-  return objects;
+std::string HDF5IO::getFullTypeName(const std::string& path) const
+{
+  if (m_opened && !path.empty() && path[0] == '/') {
+    const auto& index = getTypeIndex();
+    auto it = index.find(trimTrailingSlashes(path));
+    if (m_typeIndexValid && it != index.end() && !it->second.empty()) {
+      return getCompatibleTypeName(path, it->second);
+    }
+  }
+  return BaseIO::getFullTypeName(path);
 }
 
 SizeArray HDF5IO::getStorageObjectShape(const std::string& path) const
@@ -1314,7 +1952,9 @@ std::shared_ptr<AQNWB::IO::BaseRecordingData> HDF5IO::getDataSet(
 
   try {
     data = std::make_unique<H5::DataSet>(m_file->openDataSet(path));
-    return std::make_shared<HDF5RecordingData>(std::move(data));
+    auto dataset = std::make_shared<HDF5RecordingData>(std::move(data));
+    dataset->setWriteStatistics(m_writeStatistics, path);
+    return dataset;
   } catch (const DataSetIException& error) {
     error.printErrorStack();
     return nullptr;
@@ -1330,11 +1970,13 @@ std::shared_ptr<AQNWB::IO::BaseRecordingData> HDF5IO::getDataSet(
 std::unique_ptr<AQNWB::IO::BaseRecordingData> HDF5IO::createArrayDataSet(
     const IO::BaseArrayDataSetConfig& config, const std::string& path)
 {
+  TraceScope trace("HDF5IO::createArrayDataSet", "io");
   if (!canModifyObjects()) {
     throw std::runtime_error(
         "Cannot create dataset at '" + path
         + "' because objects cannot be modified in this file.");
   }
+  clearTypeIndex();
 
   // Check if this is a link configuration
   if (config.isLink()) {
@@ -1390,13 +2032,32 @@ std::unique_ptr<AQNWB::IO::BaseRecordingData> HDF5IO::createArrayDataSet(
     }
   }
 
+  // Contiguous datasets have a fixed shape and no filters
+  const HDF5ArrayDataSetConfig* hdf5Config =
+      dynamic_cast<const HDF5ArrayDataSetConfig*>(&config);
+  bool contiguous = (hdf5Config != nullptr && hdf5Config->isContiguous());
+  if (contiguous
+      && (!hdf5Config->getFilters().empty()
+          || std::any_of(max_dims.begin(),
+                         max_dims.end(),
+                         [](hsize_t d) { return d == H5S_UNLIMITED; })))
+  {
+    throw std::runtime_error("Contiguous dataset at path '" + path
+                             + "' must not be chunked or filtered");
+  }
+
   try {
     DataSpace dSpace(static_cast<int>(dimension), dims.data(), max_dims.data());
-    prop.setChunk(static_cast<int>(dimension), chunk_dims.data());
+    if (contiguous) {
+      // allocate the storage on creation so that the data has a fixed
+      // offset in the file from the start
+      prop.setLayout(H5D_CONTIGUOUS);
+      H5Pset_alloc_time(prop.getId(), H5D_ALLOC_TIME_EARLY);
+    } else {
+      prop.setChunk(static_cast<int>(dimension), chunk_dims.data());
+    }
 
     // Apply filters if HDF5ArrayDataSetConfig is used
-    const HDF5ArrayDataSetConfig* hdf5Config =
-        dynamic_cast<const HDF5ArrayDataSetConfig*>(&config);
     if (hdf5Config) {
       for (const auto& filter : hdf5Config->getFilters()) {
         prop.setFilter(filter.filter_id,
@@ -1417,7 +2078,9 @@ std::unique_ptr<AQNWB::IO::BaseRecordingData> HDF5IO::createArrayDataSet(
                              + "': " + e.getDetailMsg());
   }
 
-  return std::make_unique<HDF5RecordingData>(std::move(data));
+  auto dataset = std::make_unique<HDF5RecordingData>(std::move(data));
+  dataset->setWriteStatistics(m_writeStatistics, path);
+  return dataset;
 }
 
 H5O_type_t HDF5IO::getH5ObjectType(const std::string& path) const
@@ -1445,6 +2108,95 @@ H5O_type_t HDF5IO::getH5ObjectType(const std::string& path) const
   return objectType;
 }
 
+namespace
+{
+/**
+ * @brief Check whether the storage of an open dataset can be memory-mapped
+ */
+bool isDataSetMappable(const H5::DataSet& dataset)
+{
+  DSetCreatPropList plist = dataset.getCreatePlist();
+  if (plist.getLayout() != H5D_CONTIGUOUS || plist.getNfilters() != 0
+      || plist.getExternalCount() != 0)
+  {
+    return false;
+  }
+  if (H5Dget_offset(dataset.getId()) == HADDR_UNDEF) {
+    return false;
+  }
+  // only fixed-size numbers stored in the byte order of this machine
+  DataType fileType = dataset.getDataType();
+  H5T_class_t typeClass = fileType.getClass();
+  if (typeClass != H5T_INTEGER && typeClass != H5T_FLOAT) {
+    return false;
+  }
+  hid_t nativeType = H5Tget_native_type(fileType.getId(), H5T_DIR_ASCEND);
+  if (nativeType < 0) {
+    return false;
+  }
+  bool isNative = (H5Tequal(nativeType, fileType.getId()) > 0);
+  H5Tclose(nativeType);
+  return isNative;
+}
+}  // namespace
+
+bool HDF5IO::isMappable(const std::string& path) const
+{
+  if (getH5ObjectType(path) != H5O_TYPE_DATASET) {
+    return false;
+  }
+  try {
+    return isDataSetMappable(m_file->openDataSet(path));
+  } catch (const H5::Exception&) {
+    return false;
+  }
+}
+
+std::shared_ptr<const AQNWB::IO::MemoryMapping> HDF5IO::mapDatasetRegion(
+    const std::string& path, const IO::BaseDataType& type, SizeArray& shape)
+{
+  if (getH5ObjectType(path) != H5O_TYPE_DATASET) {
+    throw std::runtime_error("No dataset found at path '" + path + "'");
+  }
+
+  haddr_t offset = HADDR_UNDEF;
+  SizeType numElements = 1;
+  try {
+    DataSet dataset = m_file->openDataSet(path);
+    if (!isDataSetMappable(dataset)) {
+      throw std::runtime_error("Dataset at path '" + path
+                               + "' is not contiguous and unfiltered");
+    }
+    if (!(dataset.getDataType() == getNativeType(type))) {
+      throw std::runtime_error("Dataset at path '" + path
+                               + "' is not stored as the requested type");
+    }
+
+    DataSpace dataspace = dataset.getSpace();
+    int rank = dataspace.getSimpleExtentNdims();
+    std::vector<hsize_t> dims(static_cast<size_t>(rank));
+    dataspace.getSimpleExtentDims(dims.data());
+    shape.assign(dims.begin(), dims.end());
+    for (hsize_t dim : dims) {
+      numElements *= static_cast<SizeType>(dim);
+    }
+    offset = H5Dget_offset(dataset.getId());
+  } catch (const H5::Exception& e) {
+    throw std::runtime_error("Failed to map dataset at path '" + path
+                             + "': " + e.getDetailMsg());
+  }
+
+  // make sure all data written so far is in the file
+  if (flush() != Status::Success) {
+    throw std::runtime_error("Failed to flush file before mapping dataset '"
+                             + path + "'");
+  }
+
+  SizeType typeSize = getNativeType(type).getSize();
+  return std::make_shared<const IO::MemoryMapping>(
+      getFileName(), static_cast<SizeType>(offset), numElements * typeSize);
+}
+
 H5::DataType HDF5IO::getNativeType(IO::BaseDataType type)
 {
   H5::DataType baseType;
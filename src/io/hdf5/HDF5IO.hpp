@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -8,6 +9,7 @@
 
 #include "Types.hpp"
 #include "io/BaseIO.hpp"
+#include "io/MappedDataBlock.hpp"
 #include "io/ReadIO.hpp"
 
 namespace H5
@@ -103,6 +105,28 @@ public:
                                           const SizeArray& stride = {},
                                           const SizeArray& block = {}) override;
 
+  /**
+   * @brief Reads an arbitrary selection of a dataset with a single read.
+   *
+   * The selection is given as a list of indices for each dimension, e.g., a
+   * range of time indices and a list of channel indices. The data is read via
+   * a union of hyperslabs covering all selected indices in one H5Dread and is
+   * returned as a compact block.
+   *
+   * @param dataPath The path to the dataset within the file.
+   * @param selection One list of indices per dimension. An empty list selects
+   * all indices along that dimension.
+   *
+   * @exception std::invalid_argument if the number of index lists does not
+   * match the rank of the dataset.
+   * @exception std::runtime_error if an index is outside the dataset extent.
+   *
+   * @return A DataGeneric structure containing the data and shape.
+   */
+  AQNWB::IO::DataBlockGeneric readDatasetSelection(
+      const std::string& dataPath,
+      const std::vector<SizeArray>& selection) override;
+
   /**
    * @brief Reads a attribute  and determines the data type
    *
@@ -265,6 +289,13 @@ public:
    */
   bool canModifyObjects() override;
 
+  /**
+   * @brief Returns true if the file is open in read-only mode.
+   * @return True if the file is open and cannot be written to, false
+   * otherwise.
+   */
+  bool isReadOnly() const;
+
   /**
    * @brief Creates an extendable dataset with the given configuration and path.
    * @param config The configuration for the dataset, including type, shape, and
@@ -351,6 +382,105 @@ public:
                     const StorageObjectType& objectType =
                         StorageObjectType::Undefined) const override;
 
+  /**
+   * @brief Streams the storage objects inside a group to a callback.
+   *
+   * Links are visited via H5Literate and attributes via H5Aiterate in a
+   * single linear pass, stopping as soon as the callback returns false.
+   * Exceptions thrown by the callback are propagated to the caller.
+   *
+   * @param path The path to the group.
+   * @param callback The function to call for each object.
+   * @param objectType Define which types of storage object to look for.
+   *
+   * @return The status of the operation. Failure if path is not a group or
+   * dataset.
+   */
+  Status visitStorageObjects(const std::string& path,
+                             const StorageObjectCallback& callback,
+                             const StorageObjectType& objectType =
+                                 StorageObjectType::Undefined) const override;
+
+  /**
+   * @brief Finds all typed objects of the given types.
+   *
+   * Same as BaseIO::findTypes but served from an index of all typed objects
+   * in the file. The index is built in a single pass over the file on first
+   * use and is discarded whenever the file is modified through this object.
+   * Searches starting at a path that is not part of the index (e.g., a soft
+   * link) fall back to BaseIO::findTypes.
+   *
+   * @param starting_path The path in the file to start the search from.
+   * @param types The set of types to search for. If empty, all typed objects
+   *              are returned.
+   * @param search_mode The search mode to use.
+   * @param exclude_starting_path If true, the starting path is not included
+   * in the search and the output, but only its children.
+   * @return An unordered map from the path of each object to its type.
+   */
+  std::unordered_map<std::string, std::string> findTypes(
+      const std::string& starting_path,
+      const std::unordered_set<std::string>& types,
+      SearchMode search_mode,
+      bool exclude_starting_path = false) const override;
+
+  /**
+   * @brief Get the full name of the type of an object via the typed object
+   * index used by findTypes.
+   *
+   * Falls back to BaseIO::getFullTypeName for objects that are not part of
+   * the index.
+   *
+   * @param path The path of the registered type.
+   * @return String with the full name of the type consisting of
+   * `namespace::typename`
+   */
+  std::string getFullTypeName(const std::string& path) const override;
+
+  /**
+   * @brief Discard the index of typed objects used by findTypes.
+   *
+   * The index is discarded automatically when objects or attributes are
+   * created through this object. This is only needed if the file is modified
+   * otherwise (e.g., through the HDF5 API directly).
+   */
+  void clearTypeIndex() const;
+
+  /**
+   * @brief Check whether a dataset can be read via mapDataset.
+   *
+   * This is the case for datasets with contiguous layout (see
+   * HDF5ArrayDataSetConfig::setContiguous) whose storage is allocated, not
+   * filtered, not external, and stored in the native type of the machine.
+   *
+   * @param path The path to the dataset.
+   * @return True if the dataset can be memory-mapped.
+   */
+  bool isMappable(const std::string& path) const;
+
+  /**
+   * @brief Read a dataset via a read-only memory mapping of the file.
+   *
+   * The values are accessed directly in the page cache of the operating
+   * system without copying them into a buffer. The file is flushed before
+   * the mapping is created such that all data written so far is visible.
+   *
+   * @tparam DTYPE The data type of the values. Must match the type the
+   * dataset is stored as.
+   * @param path The path to the dataset.
+   * @return A view of the values of the dataset.
+   * @throws std::runtime_error if the dataset is not mappable (see
+   * isMappable) or stored as a different type.
+   */
+  template<typename DTYPE>
+  IO::MappedDataBlock<DTYPE> mapDataset(const std::string& path)
+  {
+    SizeArray shape;
+    std::shared_ptr<const IO::MemoryMapping> mapping = mapDatasetRegion(
+        path, IO::BaseDataType::fromTypeId(typeid(DTYPE)), shape);
+    return IO::MappedDataBlock<DTYPE>(mapping, shape);
+  }
+
   /**
    * @brief Returns the HDF5 type of object at a given path.
    * @param path The location in the file of the object.
@@ -445,6 +575,32 @@ private:
   std::vector<T> readDataHelper(const HDF5TYPE& dataSource,
                                 size_t numElements) const;
 
+  /**
+   * @brief Reads a contiguous block of a chunked dataset via the chunk cache.
+   *
+   * The block is assembled from the decoded chunks it intersects. Chunks
+   * that are not yet cached are read from the file and, if they lie fully
+   * within the current extent of the dataset, added to the chunk cache of
+   * this IO object.
+   *
+   * @tparam T The data type of the dataset.
+   * @param dataset The HDF5 dataset to read from.
+   * @param dataPath The path to the dataset, used as key for the cache.
+   * @param offset The start of the block along each dimension.
+   * @param count The size of the block along each dimension.
+   * @param dims The current extent of the dataset.
+   * @param chunkDims The chunk shape of the dataset.
+   *
+   * @return A vector containing the data of the block in row-major order.
+   */
+  template<typename T>
+  std::vector<T> readChunkCachedHelper(const H5::DataSet& dataset,
+                                       const std::string& dataPath,
+                                       const std::vector<hsize_t>& offset,
+                                       const std::vector<hsize_t>& count,
+                                       const std::vector<hsize_t>& dims,
+                                       const std::vector<hsize_t>& chunkDims);
+
   /**
    * @brief Reads a variable-length string from an HDF5 dataset or attribute.
    *
@@ -485,6 +641,27 @@ private:
 
   std::unique_ptr<H5::Attribute> getAttribute(const std::string& path) const;
 
+  /**
+   * @brief Map the storage of a contiguous dataset into memory.
+   * @param path The path to the dataset.
+   * @param type The expected type of the values.
+   * @param shape Set to the shape of the dataset.
+   * @return The memory mapping of the values of the dataset.
+   */
+  std::shared_ptr<const IO::MemoryMapping> mapDatasetRegion(
+      const std::string& path, const IO::BaseDataType& type, SizeArray& shape);
+
+  /**
+   * @brief Get the index of typed objects, building it if needed.
+   *
+   * The index maps the path of every group and dataset reachable via hard
+   * links to its full type name `namespace::neurodata_type`, or an empty
+   * string for untyped objects.
+   *
+   * @return The index of objects in the file
+   */
+  const std::map<std::string, std::string>& getTypeIndex() const;
+
   /**
    * @brief Non-virtual helper that performs the actual HDF5 file close.
    *
@@ -507,6 +684,16 @@ private:
    * Set by @ref startRecording(bool) at the start of each recording cycle.
    */
   bool m_disableSWMRMode;
+
+  /**
+   * @brief Index of the types of all objects in the file. See getTypeIndex.
+   */
+  mutable std::map<std::string, std::string> m_typeIndex;
+
+  /**
+   * @brief Whether m_typeIndex is up to date with the file
+   */
+  mutable bool m_typeIndexValid = false;
 };
 
 }  // namespace AQNWB::IO::HDF5
@@ -1,3 +1,4 @@
+#include <array>
 #include <codecvt>
 #include <cstring>
 #include <filesystem>
@@ -11,6 +12,7 @@
 #include <H5Fpublic.h>
 
 #include "Utils.hpp"
+#include "Tracing.hpp"
 
 using namespace H5;
 using namespace AQNWB::IO::HDF5;
@@ -37,14 +39,24 @@ HDF5RecordingData::HDF5RecordingData(std::unique_ptr<H5::DataSet> data)
 HDF5RecordingData::~HDF5RecordingData()
 {
   // Safety
+#ifdef AQNWB_ENABLE_INSTRUMENTATION
+  if (WriteStatistics* statistics = getActiveWriteStatistics()) {
+    auto start = WriteStatistics::Clock::now();
+    m_dataset->flush(H5F_SCOPE_GLOBAL);
+    statistics->recordFlush(m_writeStatisticsPath,
+                            WriteStatistics::elapsedNanoseconds(start));
+    return;
+  }
+#endif
   m_dataset->flush(H5F_SCOPE_GLOBAL);
 }
 
-Status HDF5RecordingData::writeDataBlock(const SizeArray& dataShape,
-                                         const SizeArray& positionOffset,
-                                         const BaseDataType& type,
-                                         const void* data)
+Status HDF5RecordingData::writeDataBlockImpl(const SizeArray& dataShape,
+                                             const SizeArray& positionOffset,
+                                             const BaseDataType& type,
+                                             const void* data)
 {
+  TraceScope trace("HDF5RecordingData::writeDataBlock", "io");
   try {
     // check type. Strings should use the other variant of this function
     if (type.type == BaseDataType::Type::V_STR
@@ -93,11 +105,13 @@ Status HDF5RecordingData::writeDataBlock(const SizeArray& dataShape,
   return Status::Success;
 }
 
-Status HDF5RecordingData::writeDataBlock(const SizeArray& dataShape,
-                                         const SizeArray& positionOffset,
-                                         const AQNWB::IO::BaseDataType& type,
-                                         const std::vector<std::string>& data)
+Status HDF5RecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const AQNWB::IO::BaseDataType& type,
+    const std::vector<std::string>& data)
 {
+  TraceScope trace("HDF5RecordingData::writeDataBlock", "io");
   try {
     // validate and allocate space
     DataSpace mSpace;
@@ -115,25 +129,26 @@ Status HDF5RecordingData::writeDataBlock(const SizeArray& dataShape,
     if (type.type == BaseDataType::Type::V_STR) {
       // Handle variable length strings
       DataType nativeType = StrType(0, H5T_VARIABLE);
-      std::vector<const char*> cstrBuffer(data.size());
+      m_cstrBuffer.resize(data.size());
       for (size_t i = 0; i < data.size(); ++i) {
-        cstrBuffer[i] = data[i].c_str();
+        m_cstrBuffer[i] = data[i].c_str();
       }
       // Write the data
-      m_dataset->write(cstrBuffer.data(), nativeType, mSpace, fSpace);
+      m_dataset->write(m_cstrBuffer.data(), nativeType, mSpace, fSpace);
     } else if (type.type == BaseDataType::Type::T_STR) {
       // Handle fixed-length strings
       DataType nativeType = HDF5IO::getNativeType(type);
-      std::vector<char> buffer(data.size() * type.typeSize, '\0');
+      m_fixedStringBuffer.assign(data.size() * type.typeSize, '\0');
       size_t bufferIndex = 0;
       for (const auto& str : data) {
         if (str.size() > type.typeSize) {
           return Status::Failure;  // String length exceeds the fixed length
         }
-        std::memcpy(&buffer[bufferIndex], str.c_str(), str.size());
+        std::memcpy(
+            &m_fixedStringBuffer[bufferIndex], str.c_str(), str.size());
         bufferIndex += type.typeSize;
       }
-      m_dataset->write(buffer.data(), nativeType, mSpace, fSpace);
+      m_dataset->write(m_fixedStringBuffer.data(), nativeType, mSpace, fSpace);
     } else {
       std::cerr
           << "HDF5RecordingData::writeDataBlock non-string type for string data"
@@ -175,20 +190,32 @@ Status HDF5RecordingData::writeDataBlockHelper(const SizeArray& dataShape,
     return Status::Failure;
   }
 
+  // HDF5 dataspaces have at most H5S_MAX_RANK dimensions, such that the
+  // dimensions can be kept on the stack
+  if (numDimensions > H5S_MAX_RANK) {
+    return Status::Failure;
+  }
+
   // Ensure that we have enough space to accommodate new data
-  std::vector<hsize_t> dSetDims(numDimensions), offset(numDimensions);
+  std::array<hsize_t, H5S_MAX_RANK> dSetDims {}, offset {};
+  bool needsExtend = false;
   for (SizeType i = 0; i < numDimensions; ++i) {
     offset[i] = static_cast<hsize_t>(positionOffset[i]);
 
     if (dataShape[i] + offset[i] > m_shape[i]) {
       dSetDims[i] = dataShape[i] + offset[i];
+      needsExtend = true;
     } else {
       dSetDims[i] = m_shape[i];
     }
   }
 
-  // Adjust dataset dimensions if necessary
-  m_dataset->extend(dSetDims.data());
+  // Adjust dataset dimensions if necessary. Datasets with a fixed shape
+  // (e.g., contiguous datasets) cannot be extended at all.
+  if (needsExtend) {
+    m_dataset->extend(dSetDims.data());
+    recordExtend();
+  }
 
   // Set the size to the new size based on the updated dimensionality
   fSpace = m_dataset->getSpace();
@@ -198,7 +225,7 @@ Status HDF5RecordingData::writeDataBlockHelper(const SizeArray& dataShape,
   }
 
   // Create memory space with the shape of the data
-  std::vector<hsize_t> dataDims(numDimensions);
+  std::array<hsize_t, H5S_MAX_RANK> dataDims {};
   for (SizeType i = 0; i < numDimensions; ++i) {
     dataDims[i] = dataShape[i] == 0 ? 1 : static_cast<hsize_t>(dataShape[i]);
   }
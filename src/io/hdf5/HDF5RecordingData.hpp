@@ -41,6 +41,13 @@ public:
    */
   ~HDF5RecordingData() override;
 
+  /**
+   * @brief Gets a const pointer to the HDF5 dataset.
+   * @return A const pointer to the HDF5 dataset.
+   */
+  inline const H5::DataSet* getDataSet() const { return m_dataset.get(); }
+
+protected:
   /**
    * @brief Writes a block of data to the HDF5 dataset.
    * @param dataShape The size of the data block.
@@ -49,10 +56,10 @@ public:
    * @param data A pointer to the data block.
    * @return The status of the write operation.
    */
-  Status writeDataBlock(const SizeArray& dataShape,
-                        const SizeArray& positionOffset,
-                        const AQNWB::IO::BaseDataType& type,
-                        const void* data) override;
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const void* data) override;
 
   /**
    * @brief Writes a block of string data (any number of dimensions).
@@ -64,16 +71,10 @@ public:
    * @param data Vector with the string data
    * @return The status of the write operation.
    */
-  Status writeDataBlock(const SizeArray& dataShape,
-                        const SizeArray& positionOffset,
-                        const AQNWB::IO::BaseDataType& type,
-                        const std::vector<std::string>& data) override;
-
-  /**
-   * @brief Gets a const pointer to the HDF5 dataset.
-   * @return A const pointer to the HDF5 dataset.
-   */
-  inline const H5::DataSet* getDataSet() const { return m_dataset.get(); }
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const std::vector<std::string>& data) override;
 
 private:
   /**
@@ -93,5 +94,16 @@ private:
    * @brief Pointer to an extendable HDF5 dataset
    */
   std::unique_ptr<H5::DataSet> m_dataset;
+
+  /**
+   * @brief Reused buffer of pointers to variable-length strings to write,
+   * such that repeated string writes do not allocate
+   */
+  std::vector<const char*> m_cstrBuffer;
+
+  /**
+   * @brief Reused buffer of padded fixed-length strings to write
+   */
+  std::vector<char> m_fixedStringBuffer;
 };
 }  // namespace AQNWB::IO::HDF5
@@ -0,0 +1,1263 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+#include "io/memory/MemoryIO.hpp"
+
+#include "Tracing.hpp"
+#include "Utils.hpp"
+#include "io/memory/MemoryRecordingData.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Memory;
+
+namespace
+{
+/**
+ * @brief Maximum number of soft links followed to resolve a path, to detect
+ * cyclic links
+ */
+constexpr int MaxLinkDepth = 32;
+
+/**
+ * @brief Resolve a path starting at the root group
+ * @param root The root group
+ * @param path The path to resolve
+ * @param followLinks Whether to resolve a link at the end of the path
+ * @param depth The number of links followed so far
+ * @return The object or nullptr if it does not exist
+ */
+std::shared_ptr<MemoryObject> resolvePath(
+    const std::shared_ptr<MemoryObject>& root,
+    std::string_view path,
+    bool followLinks,
+    int depth)
+{
+  if (root == nullptr || depth > MaxLinkDepth) {
+    return nullptr;
+  }
+  std::shared_ptr<MemoryObject> object = root;
+  size_t pos = path.find_first_not_of('/');
+  while (pos != std::string_view::npos) {
+    size_t end = std::min(path.find('/', pos), path.size());
+    if (object->kind != MemoryObject::Kind::Group) {
+      return nullptr;
+    }
+    auto child = object->children.find(path.substr(pos, end - pos));
+    if (child == object->children.end()) {
+      return nullptr;
+    }
+    object = child->second;
+    pos = path.find_first_not_of('/', end);
+    if (object->kind == MemoryObject::Kind::Link
+        && (pos != std::string_view::npos || followLinks))
+    {
+      object = resolvePath(root, object->linkTarget, true, depth + 1);
+      if (object == nullptr) {
+        return nullptr;
+      }
+    }
+  }
+  return object;
+}
+
+/**
+ * @brief Split a path into the path of the parent and the name of the object
+ * @return False if the path has no name, e.g., for the root group
+ */
+bool splitPath(const std::string& path, std::string& parent, std::string& name)
+{
+  size_t end = path.find_last_not_of('/');
+  if (end == std::string::npos) {
+    return false;
+  }
+  size_t pos = path.find_last_of('/', end);
+  name = path.substr(pos == std::string::npos ? 0 : pos + 1,
+                     end - (pos == std::string::npos ? 0 : pos + 1) + 1);
+  parent = (pos == std::string::npos || pos == 0) ? std::string("/")
+                                                  : path.substr(0, pos);
+  return true;
+}
+
+/**
+ * @brief Get the number of elements of a shape
+ */
+SizeType getNumElements(const SizeArray& shape)
+{
+  return std::accumulate(
+      shape.begin(), shape.end(), SizeType {1}, std::multiplies<SizeType> {});
+}
+
+/**
+ * @brief Copy the values of a dataset at the outer product of index lists
+ * @param object The dataset
+ * @param indices One list of indices per dimension of the dataset
+ * @return The selected values in row-major order
+ */
+template<typename T>
+std::vector<T> gatherValues(const MemoryObject& object,
+                            const std::vector<std::vector<SizeType>>& indices)
+{
+  const SizeType rank = indices.size();
+  SizeType numElements = 1;
+  for (const auto& dimIndices : indices) {
+    numElements *= dimIndices.size();
+  }
+  std::vector<T> output(numElements);
+  if (numElements == 0) {
+    return output;
+  }
+
+  // Copy a run of consecutive elements of the dataset
+  auto copyRun = [&](SizeType source, SizeType target, SizeType length)
+  {
+    if constexpr (std::is_same_v<T, std::string>) {
+      std::copy_n(object.strings.begin() + static_cast<std::ptrdiff_t>(source),
+                  length,
+                  output.begin() + static_cast<std::ptrdiff_t>(target));
+    } else {
+      std::memcpy(output.data() + target,
+                  object.values.data() + source * sizeof(T),
+                  length * sizeof(T));
+    }
+  };
+  if (rank == 0) {
+    copyRun(0, 0, 1);
+    return output;
+  }
+
+  SizeArray strides(rank, 1);
+  for (SizeType d = rank - 1; d-- > 0;) {
+    strides[d] = strides[d + 1] * object.shape[d + 1];
+  }
+  const std::vector<SizeType>& inner = indices[rank - 1];
+  bool innerContiguous = true;
+  for (SizeType i = 1; innerContiguous && i < inner.size(); ++i) {
+    innerContiguous = (inner[i] == inner[i - 1] + 1);
+  }
+
+  // Iterate over all combinations of the outer indices
+  SizeArray position(rank, 0);
+  SizeType target = 0;
+  bool done = false;
+  while (!done) {
+    SizeType base = 0;
+    for (SizeType d = 0; d + 1 < rank; ++d) {
+      base += indices[d][position[d]] * strides[d];
+    }
+    if (innerContiguous) {
+      copyRun(base + inner[0], target, inner.size());
+    } else {
+      for (SizeType i = 0; i < inner.size(); ++i) {
+        copyRun(base + inner[i], target + i, 1);
+      }
+    }
+    target += inner.size();
+    done = true;
+    for (SizeType d = rank - 1; d-- > 0;) {
+      if (++position[d] < indices[d].size()) {
+        done = false;
+        break;
+      }
+      position[d] = 0;
+    }
+  }
+  return output;
+}
+
+/**
+ * @brief Read the values of a dataset at the outer product of index lists
+ * @param object The dataset
+ * @param indices One list of indices per dimension of the dataset
+ * @param result The result to fill with the data, type, and type index
+ */
+void readValues(const MemoryObject& object,
+                const std::vector<std::vector<SizeType>>& indices,
+                DataBlockGeneric& result)
+{
+  if (object.isReference) {
+    result.baseDataType = BaseDataType::V_STR;
+  } else {
+    result.baseDataType = object.dataType;
+  }
+  if (MemoryIO::getTypeSize(object.dataType) == 0 || object.isReference) {
+    result.data = gatherValues<std::string>(object, indices);
+    result.typeIndex = typeid(std::string);
+  } else {
+    visitNumericType(object.dataType.type,
+                     [&](auto typeTag)
+                     {
+                       using T = typename decltype(typeTag)::type;
+                       result.data = gatherValues<T>(object, indices);
+                       result.typeIndex = typeid(T);
+                     });
+  }
+}
+
+/**
+ * @brief Create the attributes of an object in the target of an export
+ * @param object The group or dataset with the attributes
+ * @param path The path of the object
+ * @param target The I/O object to export to
+ * @param deferred Exports to run after all objects were created
+ * @return The status of the export
+ */
+Status exportAttributes(const MemoryObject& object,
+                        const std::string& path,
+                        BaseIO& target,
+                        std::vector<std::function<Status()>>& deferred)
+{
+  Status status = Status::Success;
+  for (const auto& [name, attribute] : object.attributes) {
+    const BaseDataType& type = attribute.dataType;
+    const SizeType numElements = getNumElements(attribute.shape);
+    if (attribute.isReference) {
+      std::string referencePath = attribute.strings[0];
+      std::string attributeName = name;
+      deferred.push_back(
+          [&target, referencePath, path, attributeName]()
+          {
+            return target.createReferenceAttribute(
+                referencePath, path, attributeName);
+          });
+    } else if (type.type == BaseDataType::Type::V_STR) {
+      if (attribute.shape.empty()) {
+        status = status
+            && target.createAttribute(attribute.strings[0], path, name, true);
+      } else {
+        status = status
+            && target.createAttribute(attribute.strings, path, name, true);
+      }
+    } else if (type.type == BaseDataType::Type::T_STR) {
+      std::vector<char> buffer(numElements * type.typeSize, '\0');
+      for (SizeType i = 0; i < numElements; ++i) {
+        std::memcpy(buffer.data() + i * type.typeSize,
+                    attribute.strings[i].data(),
+                    std::min(attribute.strings[i].size(), type.typeSize));
+      }
+      status = status
+          && target.createAttribute(
+              type, buffer.data(), path, name, numElements);
+    } else {
+      status = status
+          && target.createAttribute(
+              type, attribute.values.data(), path, name, numElements);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Function that creates an array dataset in the target of an export
+ * and writes its values
+ */
+using ArrayExporter =
+    std::function<Status(const MemoryObject&, const std::string&, BaseIO&)>;
+
+/**
+ * @brief Create an object and all objects inside it in the target of an
+ * export
+ * @param object The object to export
+ * @param path The path of the object
+ * @param target The I/O object to export to
+ * @param exportArray Function to export array datasets
+ * @param deferred Exports to run after all objects were created, i.e.,
+ * links and object references
+ * @return The status of the export
+ */
+Status exportObject(const MemoryObject& object,
+                    const std::string& path,
+                    BaseIO& target,
+                    const ArrayExporter& exportArray,
+                    std::vector<std::function<Status()>>& deferred)
+{
+  switch (object.kind) {
+    case MemoryObject::Kind::Link: {
+      std::string linkTarget = object.linkTarget;
+      deferred.push_back([&target, path, linkTarget]()
+                         { return target.createLink(path, linkTarget); });
+      return Status::Success;
+    }
+    case MemoryObject::Kind::Group: {
+      Status status = Status::Success;
+      if (path != "/") {
+        status = target.createGroup(path);
+      }
+      status = status && exportAttributes(object, path, target, deferred);
+      for (const auto& [name, child] : object.children) {
+        status = status
+            && exportObject(*child,
+                            AQNWB::mergePaths(path, name),
+                            target,
+                            exportArray,
+                            deferred);
+      }
+      return status;
+    }
+    case MemoryObject::Kind::Dataset:
+      break;
+  }
+
+  if (object.isReference) {
+    deferred.push_back(
+        [&object, &target, path, &deferred]()
+        {
+          Status status = target.createReferenceDataSet(path, object.strings);
+          return status && exportAttributes(object, path, target, deferred);
+        });
+    return Status::Success;
+  }
+  if (object.shape.empty()) {
+    if (MemoryIO::getTypeSize(object.dataType) != 0) {
+      std::cerr << "MemoryIO::exportTo cannot export numeric scalar dataset "
+                << path << std::endl;
+      return Status::Failure;
+    }
+    return target.createStringDataSet(path, object.strings[0])
+        && exportAttributes(object, path, target, deferred);
+  }
+
+  return exportArray(object, path, target)
+      && exportAttributes(object, path, target, deferred);
+}
+
+/**
+ * @brief Create a block of default values, i.e., zeros or empty strings
+ * @param dataType The data type of the values
+ * @param shape The shape of the block
+ */
+DataBlockGeneric makeDefaultBlock(const BaseDataType& dataType,
+                                  const SizeArray& shape)
+{
+  DataBlockGeneric result;
+  result.shape = shape;
+  result.baseDataType = dataType;
+  const SizeType numElements = getNumElements(shape);
+  if (!visitNumericType(dataType.type,
+                        [&](auto typeTag)
+                        {
+                          using T = typename decltype(typeTag)::type;
+                          result.data = std::vector<T>(numElements);
+                          result.typeIndex = typeid(T);
+                        }))
+  {
+    result.data = std::vector<std::string>(numElements);
+    result.typeIndex = typeid(std::string);
+  }
+  return result;
+}
+
+/**
+ * @brief Get the number of bytes of the values of an object and the objects
+ * inside it
+ */
+SizeType getObjectBytes(const MemoryObject& object)
+{
+  SizeType bytes = object.values.size();
+  for (const auto& str : object.strings) {
+    bytes += str.size();
+  }
+  for (const auto& [name, attribute] : object.attributes) {
+    bytes += attribute.values.size();
+    for (const auto& str : attribute.strings) {
+      bytes += str.size();
+    }
+  }
+  for (const auto& [name, child] : object.children) {
+    bytes += getObjectBytes(*child);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Grow a dataset to a new shape, keeping the values at their indices
+ * @param dataset The dataset
+ * @param newShape The new shape. Must not be smaller than the current shape
+ * in any dimension.
+ */
+void resizeDataset(MemoryObject& dataset, const SizeArray& newShape)
+{
+  const SizeType typeSize = MemoryIO::getTypeSize(dataset.dataType);
+  const bool isString = (typeSize == 0);
+  const SizeArray oldShape = dataset.shape;
+  const SizeType rank = oldShape.size();
+  SizeType newNumElements = 1;
+  for (SizeType dim : newShape) {
+    newNumElements *= dim;
+  }
+
+  // Growing only the first dimension keeps the row-major layout
+  bool leadingOnly = true;
+  for (SizeType d = 1; d < rank; ++d) {
+    leadingOnly = leadingOnly && (oldShape[d] == newShape[d]);
+  }
+  if (leadingOnly) {
+    if (isString) {
+      dataset.strings.resize(newNumElements);
+    } else {
+      dataset.values.resize(newNumElements * typeSize);
+    }
+    dataset.shape = newShape;
+    return;
+  }
+
+  // Otherwise copy the rows of the old layout into a new buffer
+  const SizeType oldNumElements = dataset.getNumElements();
+  const SizeType rowLength = oldShape[rank - 1];
+  SizeArray newStrides(rank, 1);
+  for (SizeType d = rank - 1; d-- > 0;) {
+    newStrides[d] = newStrides[d + 1] * newShape[d + 1];
+  }
+  std::vector<unsigned char> values(isString ? 0 : newNumElements * typeSize);
+  std::vector<std::string> strings(isString ? newNumElements : 0);
+  SizeArray position(rank, 0);
+  for (SizeType source = 0; rowLength > 0 && source < oldNumElements;
+       source += rowLength)
+  {
+    SizeType target = 0;
+    for (SizeType d = 0; d + 1 < rank; ++d) {
+      target += position[d] * newStrides[d];
+    }
+    if (isString) {
+      std::move(dataset.strings.begin() + static_cast<std::ptrdiff_t>(source),
+                dataset.strings.begin()
+                    + static_cast<std::ptrdiff_t>(source + rowLength),
+                strings.begin() + static_cast<std::ptrdiff_t>(target));
+    } else {
+      std::memcpy(values.data() + target * typeSize,
+                  dataset.values.data() + source * typeSize,
+                  rowLength * typeSize);
+    }
+    for (SizeType d = rank - 1; d-- > 0;) {
+      if (++position[d] < oldShape[d]) {
+        break;
+      }
+      position[d] = 0;
+    }
+  }
+  dataset.values = std::move(values);
+  dataset.strings = std::move(strings);
+  dataset.shape = newShape;
+}
+}  // namespace
+
+// MemoryObject
+
+SizeType MemoryObject::getNumElements() const
+{
+  return ::getNumElements(shape);
+}
+
+Status MemoryObject::extendForBlock(const SizeArray& dataShape,
+                                    const SizeArray& positionOffset,
+                                    bool keepValues,
+                                    bool& extended)
+{
+  extended = false;
+  // Check that the dataShape and positionOffset inputs match the dimensions
+  // of the dataset
+  const SizeType numDimensions = shape.size();
+  if (dataShape.size() != numDimensions
+      || positionOffset.size() != numDimensions)
+  {
+    return Status::Failure;
+  }
+
+  // Validate all dimensions before extending
+  bool needsExtend = false;
+  for (SizeType i = 0; i < numDimensions; ++i) {
+    const SizeType end = positionOffset[i] + dataShape[i];
+    if (end > shape[i]) {
+      bool extendable = (i < chunking.size() && chunking[i] > 0);
+      if (!extendable) {
+        std::cerr << "MemoryObject::extendForBlock cannot extend a dimension "
+                     "of fixed size"
+                  << std::endl;
+        return Status::Failure;
+      }
+      needsExtend = true;
+    }
+    if (positionOffset[i] + ((dataShape[i] == 0) ? 1 : dataShape[i])
+        > std::max(end, shape[i]))
+    {
+      return Status::Failure;  // selection is not within the extent
+    }
+  }
+
+  if (!needsExtend) {
+    return Status::Success;
+  }
+  if (keepValues) {
+    SizeArray newShape = shape;
+    for (SizeType i = 0; i < numDimensions; ++i) {
+      newShape[i] = std::max(shape[i], positionOffset[i] + dataShape[i]);
+    }
+    resizeDataset(*this, newShape);
+  } else {
+    for (SizeType i = 0; i < numDimensions; ++i) {
+      shape[i] = std::max(shape[i], positionOffset[i] + dataShape[i]);
+    }
+  }
+  extended = true;
+  return Status::Success;
+}
+
+// MemoryIO
+
+MemoryIO::MemoryIO(const std::string& fileName)
+    : MemoryIO(fileName, true)
+{
+}
+
+MemoryIO::MemoryIO(const std::string& fileName, bool keepValues)
+    : BaseIO(fileName)
+    , m_keepValues(keepValues)
+{
+}
+
+MemoryIO::~MemoryIO()
+{
+  BaseIO::close();  // clear the recording containers
+}
+
+Status MemoryIO::open()
+{
+  return open(m_root != nullptr ? FileMode::ReadWrite : FileMode::Overwrite);
+}
+
+Status MemoryIO::open(FileMode mode)
+{
+  TraceScope trace("MemoryIO::open", "io");
+  if (m_opened) {
+    return Status::Failure;
+  }
+
+  switch (mode) {
+    case FileMode::Overwrite:
+      m_root = std::make_shared<MemoryObject>();
+      break;
+    case FileMode::ReadWrite:
+    case FileMode::ReadOnly:
+      if (m_root == nullptr) {
+        return Status::Failure;
+      }
+      break;
+    default:
+      throw std::invalid_argument("Invalid file mode");
+  }
+  m_readOnly = (mode == FileMode::ReadOnly);
+  m_opened = true;
+  return Status::Success;
+}
+
+Status MemoryIO::close()
+{
+  Status status = BaseIO::close();  // clear the recording containers
+  m_opened = false;
+  return status;
+}
+
+Status MemoryIO::flush()
+{
+  return m_opened ? Status::Success : Status::Failure;
+}
+
+std::shared_ptr<MemoryObject> MemoryIO::findObject(const std::string& path,
+                                                   bool followLinks) const
+{
+  if (!m_opened) {
+    return nullptr;
+  }
+  return resolvePath(m_root, path, followLinks, 0);
+}
+
+std::shared_ptr<MemoryObject> MemoryIO::findDataset(
+    const std::string& path) const
+{
+  auto object = findObject(path);
+  if (object == nullptr || object->kind != MemoryObject::Kind::Dataset) {
+    throw std::runtime_error("Failed to open dataset '" + path + "'");
+  }
+  return object;
+}
+
+const MemoryAttribute* MemoryIO::findAttribute(const std::string& path) const
+{
+  std::string parentPath, name;
+  if (!splitPath(path, parentPath, name)) {
+    return nullptr;
+  }
+  auto parent = findObject(parentPath);
+  if (parent == nullptr) {
+    return nullptr;
+  }
+  auto attribute = parent->attributes.find(name);
+  return (attribute == parent->attributes.end()) ? nullptr
+                                                 : &attribute->second;
+}
+
+Status MemoryIO::insertObject(const std::string& path,
+                              std::shared_ptr<MemoryObject> object)
+{
+  std::string parentPath, name;
+  if (!splitPath(path, parentPath, name)) {
+    return Status::Failure;
+  }
+  auto parent = findObject(parentPath);
+  if (parent == nullptr || parent->kind != MemoryObject::Kind::Group) {
+    return Status::Failure;
+  }
+  return parent->children.emplace(name, std::move(object)).second
+      ? Status::Success
+      : Status::Failure;
+}
+
+Status MemoryIO::setAttribute(const std::string& path,
+                              const std::string& name,
+                              MemoryAttribute attribute,
+                              bool overwrite)
+{
+  auto object = findObject(path);
+  if (object == nullptr || object->kind == MemoryObject::Kind::Link) {
+    return Status::Failure;
+  }
+  if (!m_keepValues) {
+    attribute.values = std::vector<unsigned char>();
+    if (!attribute.isReference) {
+      attribute.strings = std::vector<std::string>();
+    }
+  }
+  auto existing = object->attributes.find(name);
+  if (existing != object->attributes.end()) {
+    if (!overwrite) {
+      return Status::Failure;  // don't allow overwriting
+    }
+    existing->second = std::move(attribute);
+  } else {
+    object->attributes.emplace(name, std::move(attribute));
+  }
+  return Status::Success;
+}
+
+StorageObjectType MemoryIO::getStorageObjectType(std::string path) const
+{
+  auto object = findObject(path);
+  if (object != nullptr) {
+    return (object->kind == MemoryObject::Kind::Group)
+        ? StorageObjectType::Group
+        : StorageObjectType::Dataset;
+  }
+  if (findAttribute(path) != nullptr) {
+    return StorageObjectType::Attribute;
+  }
+  return StorageObjectType::Undefined;
+}
+
+DataBlockGeneric MemoryIO::readDataset(const std::string& dataPath,
+                                       const SizeArray& start,
+                                       const SizeArray& count,
+                                       const SizeArray& stride,
+                                       const SizeArray& block)
+{
+  TraceScope trace("MemoryIO::readDataset", "io");
+  auto dataset = findDataset(dataPath);
+  const SizeArray& dims = dataset->shape;
+  const SizeType rank = dims.size();
+  bool useSelection = !start.empty() && !count.empty() && rank > 0;
+  if (useSelection
+      && (start.size() < rank || count.size() < rank
+          || (!stride.empty() && stride.size() < rank)
+          || (!block.empty() && block.size() < rank)))
+  {
+    throw std::invalid_argument(
+        "MemoryIO::readDataset, selection must provide values for all "
+        "dimensions.");
+  }
+
+  // Determine the indices of the hyperslab along each dimension
+  DataBlockGeneric result;
+  result.shape.resize(rank);
+  std::vector<std::vector<SizeType>> indices(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    if (!useSelection) {
+      indices[d].resize(dims[d]);
+      std::iota(indices[d].begin(), indices[d].end(), SizeType {0});
+    } else {
+      SizeType dimStride = stride.empty() ? 1 : stride[d];
+      SizeType dimBlock = block.empty() ? 1 : block[d];
+      if (start[d] > dims[d]) {
+        throw std::runtime_error(
+            "Selection + offset for dimension not within extent.");
+      }
+      indices[d].reserve(count[d] * dimBlock);
+      for (SizeType k = 0; k < count[d]; ++k) {
+        for (SizeType j = 0; j < dimBlock; ++j) {
+          SizeType index = start[d] + k * dimStride + j;
+          if (index >= dims[d]) {
+            throw std::runtime_error(
+                "Selection + offset for dimension not within extent.");
+          }
+          indices[d].push_back(index);
+        }
+      }
+    }
+    result.shape[d] = indices[d].size();
+  }
+
+  if (!m_keepValues) {
+    return makeDefaultBlock(dataset->dataType, result.shape);
+  }
+  readValues(*dataset, indices, result);
+  return result;
+}
+
+DataBlockGeneric MemoryIO::readDatasetSelection(
+    const std::string& dataPath, const std::vector<SizeArray>& selection)
+{
+  TraceScope trace("MemoryIO::readDatasetSelection", "io");
+  auto dataset = findDataset(dataPath);
+  const SizeArray& dims = dataset->shape;
+  const SizeType rank = dims.size();
+  if (rank == 0) {
+    return readDataset(dataPath);
+  }
+  if (selection.size() != rank) {
+    throw std::invalid_argument(
+        "MemoryIO::readDatasetSelection, selection must provide one list of "
+        "indices per dimension.");
+  }
+
+  DataBlockGeneric result;
+  result.shape.resize(rank);
+  std::vector<std::vector<SizeType>> indices(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    if (selection[d].empty()) {
+      indices[d].resize(dims[d]);
+      std::iota(indices[d].begin(), indices[d].end(), SizeType {0});
+    } else {
+      for (SizeType index : selection[d]) {
+        if (index >= dims[d]) {
+          throw std::runtime_error(
+              "Selection index for dimension not within extent.");
+        }
+      }
+      indices[d].assign(selection[d].begin(), selection[d].end());
+    }
+    result.shape[d] = indices[d].size();
+  }
+
+  if (!m_keepValues) {
+    return makeDefaultBlock(dataset->dataType, result.shape);
+  }
+  readValues(*dataset, indices, result);
+  return result;
+}
+
+DataBlockGeneric MemoryIO::readAttribute(const std::string& dataPath) const
+{
+  const MemoryAttribute* attribute = findAttribute(dataPath);
+  if (attribute == nullptr) {
+    throw std::invalid_argument(
+        "MemoryIO::readAttribute, attribute does not exist. " + dataPath);
+  }
+  if (!m_keepValues && !attribute->isReference) {
+    return makeDefaultBlock(attribute->dataType, attribute->shape);
+  }
+
+  DataBlockGeneric result;
+  result.shape = attribute->shape;
+  result.baseDataType = attribute->dataType;
+  if (!visitNumericType(
+          attribute->dataType.type,
+          [&](auto typeTag)
+          {
+            using T = typename decltype(typeTag)::type;
+            std::vector<T> values(attribute->values.size() / sizeof(T));
+            std::memcpy(values.data(),
+                        attribute->values.data(),
+                        values.size() * sizeof(T));
+            result.data = std::move(values);
+            result.typeIndex = typeid(T);
+          }))
+  {
+    result.data = attribute->strings;
+    result.typeIndex = typeid(std::string);
+  }
+  return result;
+}
+
+std::string MemoryIO::readReferenceAttribute(const std::string& dataPath) const
+{
+  const MemoryAttribute* attribute = findAttribute(dataPath);
+  if (attribute == nullptr) {
+    throw std::invalid_argument(
+        "MemoryIO::readReferenceAttribute, attribute does not exist.");
+  }
+  if (!attribute->isReference) {
+    throw std::invalid_argument(
+        "MemoryIO::readReferenceAttribute, attribute is not a reference.");
+  }
+  return attribute->strings[0];
+}
+
+Status MemoryIO::createAttribute(const BaseDataType& type,
+                                 const void* data,
+                                 const std::string& path,
+                                 const std::string& name,
+                                 const SizeType& size)
+{
+  TraceScope trace("MemoryIO::createAttribute", "io");
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+
+  MemoryAttribute attribute;
+  attribute.dataType = type;
+  if (type.type == BaseDataType::Type::T_STR) {
+    // fixed-length strings of typeSize characters each
+    const auto* chars = static_cast<const char*>(data);
+    for (SizeType i = 0; i < size; ++i) {
+      const char* str = chars + i * type.typeSize;
+      attribute.strings.emplace_back(
+          str, strnlen(str, static_cast<size_t>(type.typeSize)));
+    }
+  } else if (type.type == BaseDataType::Type::V_STR) {
+    const auto* strs = static_cast<const char* const*>(data);
+    attribute.strings.assign(strs, strs + size);
+  } else {
+    // Like HDF5IO, array attributes with the array length encoded in the
+    // typeSize are stored as a 1D array of the element type
+    SizeType numElements = size;
+    if (type.typeSize > 1 && type.typeSize != size) {
+      numElements *= type.typeSize;
+    }
+    attribute.dataType = BaseDataType(type.type, 1);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    attribute.values.assign(bytes, bytes + numElements * getTypeSize(type));
+  }
+  SizeType numElements = attribute.strings.empty()
+      ? attribute.values.size() / getTypeSize(attribute.dataType)
+      : attribute.strings.size();
+  if (size > 1 || numElements > 1) {
+    attribute.shape = SizeArray {numElements};
+  }
+  return setAttribute(path, name, std::move(attribute), true);
+}
+
+Status MemoryIO::createAttribute(const std::string& data,
+                                 const std::string& path,
+                                 const std::string& name,
+                                 const bool overwrite)
+{
+  TraceScope trace("MemoryIO::createAttribute", "io");
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  MemoryAttribute attribute;
+  attribute.dataType = BaseDataType::V_STR;
+  attribute.strings = {data};
+  return setAttribute(path, name, std::move(attribute), overwrite);
+}
+
+Status MemoryIO::createAttribute(const std::vector<std::string>& data,
+                                 const std::string& path,
+                                 const std::string& name,
+                                 const bool overwrite)
+{
+  TraceScope trace("MemoryIO::createAttribute", "io");
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  MemoryAttribute attribute;
+  attribute.dataType = BaseDataType::V_STR;
+  attribute.shape = SizeArray {data.size()};
+  attribute.strings = data;
+  return setAttribute(path, name, std::move(attribute), overwrite);
+}
+
+Status MemoryIO::createReferenceAttribute(const std::string& referencePath,
+                                          const std::string& path,
+                                          const std::string& name)
+{
+  TraceScope trace("MemoryIO::createReferenceAttribute", "io");
+  if (!canModifyObjects() || findObject(referencePath) == nullptr) {
+    return Status::Failure;
+  }
+  MemoryAttribute attribute;
+  attribute.dataType = BaseDataType::V_STR;
+  attribute.strings = {referencePath};
+  attribute.isReference = true;
+  return setAttribute(path, name, std::move(attribute), true);
+}
+
+Status MemoryIO::createGroup(const std::string& path)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  return insertObject(path, std::make_shared<MemoryObject>());
+}
+
+Status MemoryIO::createGroupIfDoesNotExist(const std::string& path)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  if (findObject(path, false) != nullptr) {
+    return Status::Success;
+  }
+  return createGroup(path);
+}
+
+Status MemoryIO::createLink(const std::string& path,
+                            const std::string& reference)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  if (!objectExists(reference)) {
+    std::cerr << "MemoryIO::createLink Reference target does not exist: "
+              << reference << std::endl;
+    return Status::Failure;  // Reference target must exist
+  }
+  auto link = std::make_shared<MemoryObject>();
+  link->kind = MemoryObject::Kind::Link;
+  link->linkTarget = reference;
+  return insertObject(path, std::move(link));
+}
+
+Status MemoryIO::createStringDataSet(const std::string& path,
+                                     const std::string& value)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  auto dataset = std::make_shared<MemoryObject>();
+  dataset->kind = MemoryObject::Kind::Dataset;
+  dataset->dataType = BaseDataType::STR(value.length());
+  if (m_keepValues) {
+    dataset->strings = {value};
+  }
+  return insertObject(path, std::move(dataset));
+}
+
+Status MemoryIO::createStringDataSet(const std::string& path,
+                                     const std::vector<std::string>& values)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  auto dataset = std::make_shared<MemoryObject>();
+  dataset->kind = MemoryObject::Kind::Dataset;
+  dataset->dataType = BaseDataType::V_STR;
+  dataset->shape = SizeArray {values.size()};
+  dataset->chunking = SizeArray {1};
+  if (m_keepValues) {
+    dataset->strings = values;
+  }
+  return insertObject(path, std::move(dataset));
+}
+
+Status MemoryIO::createReferenceDataSet(
+    const std::string& path, const std::vector<std::string>& references)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  for (const auto& reference : references) {
+    if (findObject(reference) == nullptr) {
+      return Status::Failure;
+    }
+  }
+  auto dataset = std::make_shared<MemoryObject>();
+  dataset->kind = MemoryObject::Kind::Dataset;
+  dataset->dataType = BaseDataType::V_STR;
+  dataset->shape = SizeArray {references.size()};
+  if (m_keepValues) {
+    dataset->strings = references;
+  }
+  dataset->isReference = true;
+  return insertObject(path, std::move(dataset));
+}
+
+Status MemoryIO::startRecording()
+{
+  if (!m_opened) {
+    return Status::Failure;
+  }
+  return BaseIO::startRecording();
+}
+
+bool MemoryIO::canModifyObjects()
+{
+  return m_opened && !m_readOnly;
+}
+
+std::unique_ptr<BaseRecordingData> MemoryIO::createArrayDataSet(
+    const BaseArrayDataSetConfig& config, const std::string& path)
+{
+  TraceScope trace("MemoryIO::createArrayDataSet", "io");
+  if (!canModifyObjects()) {
+    throw std::runtime_error(
+        "Cannot create dataset at '" + path
+        + "' because objects cannot be modified in this file.");
+  }
+
+  // Check if this is a link configuration
+  if (config.isLink()) {
+    const LinkArrayDataSetConfig* linkConfig =
+        dynamic_cast<const LinkArrayDataSetConfig*>(&config);
+    if (linkConfig) {
+      Status status = createLink(path, linkConfig->getTargetPath());
+      if (status != Status::Success) {
+        throw std::runtime_error("Failed to create link from " + path + " to "
+                                 + linkConfig->getTargetPath());
+      }
+      // Return nullptr for links as they don't provide a recordable dataset
+      return nullptr;
+    }
+  }
+
+  // Regular dataset creation
+  const ArrayDataSetConfig* arrayConfig =
+      dynamic_cast<const ArrayDataSetConfig*>(&config);
+  if (!arrayConfig) {
+    throw std::runtime_error(
+        "Invalid configuration type for dataset creation. Expected "
+        "ArrayDataSetConfig or LinkArrayDataSetConfig.");
+  }
+  if (arrayConfig->getShape().empty()) {
+    throw std::runtime_error("Invalid dimension size");
+  }
+
+  auto dataset = std::make_shared<MemoryObject>();
+  dataset->kind = MemoryObject::Kind::Dataset;
+  dataset->dataType = arrayConfig->getType();
+  dataset->shape = arrayConfig->getShape();
+  dataset->chunking = arrayConfig->getChunking();
+  const SizeType typeSize = getTypeSize(dataset->dataType);
+  if (!m_keepValues) {
+    // only the shape is kept
+  } else if (typeSize == 0) {
+    dataset->strings.resize(dataset->getNumElements());
+  } else {
+    dataset->values.resize(dataset->getNumElements() * typeSize);
+  }
+  if (insertObject(path, dataset) != Status::Success) {
+    throw std::runtime_error("Failed to create dataset at path '" + path
+                             + "'");
+  }
+
+  auto recordingData = createRecordingData(dataset);
+  recordingData->setWriteStatistics(m_writeStatistics, path);
+  return recordingData;
+}
+
+std::shared_ptr<BaseRecordingData> MemoryIO::getDataSet(const std::string& path)
+{
+  auto object = findObject(path);
+  if (object == nullptr || object->kind != MemoryObject::Kind::Dataset) {
+    return nullptr;
+  }
+  std::shared_ptr<BaseRecordingData> recordingData =
+      createRecordingData(object);
+  recordingData->setWriteStatistics(m_writeStatistics, path);
+  return recordingData;
+}
+
+std::unique_ptr<BaseRecordingData> MemoryIO::createRecordingData(
+    std::shared_ptr<MemoryObject> dataset)
+{
+  return std::make_unique<MemoryRecordingData>(std::move(dataset));
+}
+
+bool MemoryIO::objectExists(const std::string& path) const
+{
+  return findObject(path, false) != nullptr;
+}
+
+bool MemoryIO::attributeExists(const std::string& path) const
+{
+  return findAttribute(path) != nullptr;
+}
+
+std::vector<std::pair<std::string, StorageObjectType>>
+MemoryIO::getStorageObjects(const std::string& path,
+                            const StorageObjectType& objectType) const
+{
+  std::vector<std::pair<std::string, StorageObjectType>> objects;
+  visitStorageObjects(
+      path,
+      [&objects](const std::string& name, StorageObjectType type)
+      {
+        objects.emplace_back(name, type);
+        return true;
+      },
+      objectType);
+  return objects;
+}
+
+Status MemoryIO::visitStorageObjects(const std::string& path,
+                                     const StorageObjectCallback& callback,
+                                     const StorageObjectType& objectType) const
+{
+  auto object = findObject(path);
+  if (object == nullptr) {
+    return Status::Failure;
+  }
+
+  // Visit the objects inside groups. Soft links are reported as Undefined.
+  if (object->kind == MemoryObject::Kind::Group
+      && objectType != StorageObjectType::Attribute)
+  {
+    for (const auto& [name, child] : object->children) {
+      StorageObjectType type = StorageObjectType::Undefined;
+      if (child->kind == MemoryObject::Kind::Group) {
+        type = StorageObjectType::Group;
+      } else if (child->kind == MemoryObject::Kind::Dataset) {
+        type = StorageObjectType::Dataset;
+      }
+      if (objectType != StorageObjectType::Undefined && type != objectType) {
+        continue;
+      }
+      if (!callback(name, type)) {
+        return Status::Success;
+      }
+    }
+  }
+
+  // Visit the attributes of groups and datasets
+  if (objectType == StorageObjectType::Attribute
+      || objectType == StorageObjectType::Undefined)
+  {
+    for (const auto& [name, attribute] : object->attributes) {
+      if (!callback(name, StorageObjectType::Attribute)) {
+        return Status::Success;
+      }
+    }
+  }
+  return Status::Success;
+}
+
+SizeArray MemoryIO::getStorageObjectShape(const std::string& path) const
+{
+  auto object = findObject(path);
+  if (object != nullptr) {
+    // Groups don't have a shape
+    return (object->kind == MemoryObject::Kind::Dataset) ? object->shape
+                                                         : SizeArray();
+  }
+  const MemoryAttribute* attribute = findAttribute(path);
+  if (attribute == nullptr) {
+    throw std::runtime_error("MemoryIO::getStorageObjectShape: Object at '"
+                             + path + "' does not exist.");
+  }
+  return attribute->shape;
+}
+
+SizeArray MemoryIO::getStorageObjectChunking(const std::string& path) const
+{
+  auto object = findObject(path);
+  if (object == nullptr || object->kind != MemoryObject::Kind::Dataset
+      || object->chunking.empty())
+  {
+    return SizeArray();
+  }
+  // Like in HDF5, dimensions that cannot be extended use their size as chunk
+  SizeArray chunking(object->shape.size());
+  for (SizeType i = 0; i < chunking.size(); ++i) {
+    chunking[i] = (i < object->chunking.size() && object->chunking[i] > 0)
+        ? object->chunking[i]
+        : object->shape[i];
+  }
+  return chunking;
+}
+
+BaseDataType MemoryIO::getStorageObjectDataType(const std::string& path) const
+{
+  auto object = findObject(path);
+  if (object != nullptr && object->kind == MemoryObject::Kind::Dataset) {
+    return object->isReference ? BaseDataType::V_STR : object->dataType;
+  }
+  if (object == nullptr) {
+    if (const MemoryAttribute* attribute = findAttribute(path)) {
+      return attribute->dataType;
+    }
+  }
+  StorageObjectType objType = getStorageObjectType(path);
+  throw std::runtime_error("MemoryIO::getStorageObjectDataType: Object at '"
+                           + path + "' is a "
+                           + Types::storageObjectTypeToString(objType)
+                           + ". Groups do not have data types.");
+}
+
+Status MemoryIO::exportTo(BaseIO& target) const
+{
+  TraceScope trace("MemoryIO::exportTo", "io");
+  if (m_root == nullptr || !m_keepValues || !target.canModifyObjects()) {
+    return Status::Failure;
+  }
+  std::vector<std::function<Status()>> deferred;
+  ArrayExporter exportArray =
+      [this](const MemoryObject& object, const std::string& path, BaseIO& io)
+  { return exportArrayDataSet(object, path, io); };
+  Status status = exportObject(*m_root, "/", target, exportArray, deferred);
+  // Links and references require their targets to exist. Exporting a
+  // reference dataset may defer its reference attributes.
+  for (SizeType i = 0; i < deferred.size(); ++i) {
+    std::function<Status()> exportDeferred = deferred[i];
+    status = status && exportDeferred();
+  }
+  return status;
+}
+
+Status MemoryIO::exportArrayDataSet(const MemoryObject& dataset,
+                                    const std::string& path,
+                                    BaseIO& target) const
+{
+  SizeArray chunking = dataset.chunking;
+  chunking.resize(dataset.shape.size(), 0);
+  try {
+    ArrayDataSetConfig config(dataset.dataType, dataset.shape, chunking);
+    std::unique_ptr<BaseRecordingData> recordingData =
+        target.createArrayDataSet(config, path);
+    if (recordingData == nullptr) {
+      return Status::Failure;
+    }
+    if (dataset.getNumElements() == 0) {
+      return Status::Success;
+    }
+    SizeArray offset(dataset.shape.size(), 0);
+    if (getTypeSize(dataset.dataType) == 0) {
+      return recordingData->writeDataBlock(
+          dataset.shape, offset, dataset.dataType, dataset.strings);
+    }
+    return recordingData->writeDataBlock(
+        dataset.shape, offset, dataset.dataType, dataset.values.data());
+  } catch (const std::runtime_error& e) {
+    std::cerr << "MemoryIO::exportTo failed to create dataset " << path << ": "
+              << e.what() << std::endl;
+    return Status::Failure;
+  }
+}
+
+SizeType MemoryIO::getDataBytes() const
+{
+  return m_root == nullptr ? 0 : getObjectBytes(*m_root);
+}
+
+SizeType MemoryIO::getTypeSize(const BaseDataType& type)
+{
+  SizeType size = 0;
+  visitNumericType(type.type,
+                   [&size](auto typeTag)
+                   {
+                     using T = typename decltype(typeTag)::type;
+                     size = sizeof(T);
+                   });
+  return size;
+}
@@ -0,0 +1,690 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/ReadIO.hpp"
+
+/*!
+ * \namespace AQNWB::IO::Memory
+ * \brief Namespace for all components of the in-memory I/O backend
+ */
+namespace AQNWB::IO::Memory
+{
+
+/**
+ * @brief Tag type used to dispatch on the C++ type of a BaseDataType
+ */
+template<typename T>
+struct TypeTag
+{
+  using type = T;
+};
+
+/**
+ * @brief Call a function with the TypeTag of the C++ type of a numeric
+ * BaseDataType
+ * @param type The numeric data type
+ * @param func The function to call with a TypeTag of the C++ type
+ * @return False if the type is not numeric, i.e., a string type
+ */
+template<typename Func>
+bool visitNumericType(BaseDataType::Type type, Func&& func)
+{
+  switch (type) {
+    case BaseDataType::Type::T_U8:
+      func(TypeTag<uint8_t> {});
+      return true;
+    case BaseDataType::Type::T_U16:
+      func(TypeTag<uint16_t> {});
+      return true;
+    case BaseDataType::Type::T_U32:
+      func(TypeTag<uint32_t> {});
+      return true;
+    case BaseDataType::Type::T_U64:
+      func(TypeTag<uint64_t> {});
+      return true;
+    case BaseDataType::Type::T_I8:
+      func(TypeTag<int8_t> {});
+      return true;
+    case BaseDataType::Type::T_I16:
+      func(TypeTag<int16_t> {});
+      return true;
+    case BaseDataType::Type::T_I32:
+      func(TypeTag<int32_t> {});
+      return true;
+    case BaseDataType::Type::T_I64:
+      func(TypeTag<int64_t> {});
+      return true;
+    case BaseDataType::Type::T_F32:
+      func(TypeTag<float> {});
+      return true;
+    case BaseDataType::Type::T_F64:
+      func(TypeTag<double> {});
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Convert numeric values to another numeric type
+ *
+ * Values outside of the range of the target type are clipped and NaN is
+ * converted to 0 for integer types, similar to HDF5.
+ *
+ * @param source The values to convert
+ * @param sourceType The type of the values to convert
+ * @param target The buffer to write the converted values to
+ * @param targetType The type of the values in the buffer
+ * @param numElements The number of values to convert
+ */
+void convertValues(const unsigned char* source,
+                   BaseDataType::Type sourceType,
+                   unsigned char* target,
+                   BaseDataType::Type targetType,
+                   SizeType numElements);
+
+/**
+ * @brief An attribute stored in memory
+ */
+struct MemoryAttribute
+{
+  /**
+   * @brief The data type of the attribute
+   */
+  BaseDataType dataType;
+
+  /**
+   * @brief The shape of the attribute. Empty for scalar attributes.
+   */
+  SizeArray shape;
+
+  /**
+   * @brief The raw values of numeric attributes in native byte order
+   */
+  std::vector<unsigned char> values;
+
+  /**
+   * @brief The values of string attributes, or the path of the referenced
+   * object of reference attributes
+   */
+  std::vector<std::string> strings;
+
+  /**
+   * @brief Whether the attribute is an object reference
+   */
+  bool isReference = false;
+};
+
+/**
+ * @brief A group, dataset, or soft link stored in memory
+ */
+struct MemoryObject
+{
+  /**
+   * @brief The kind of an object
+   */
+  enum class Kind
+  {
+    Group,
+    Dataset,
+    Link
+  };
+
+  /**
+   * @brief The kind of the object
+   */
+  Kind kind = Kind::Group;
+
+  /**
+   * @brief The objects inside a group, ordered by name
+   */
+  std::map<std::string, std::shared_ptr<MemoryObject>, std::less<>>
+      children;
+
+  /**
+   * @brief The attributes of a group or dataset, ordered by name
+   */
+  std::map<std::string, MemoryAttribute, std::less<>> attributes;
+
+  /**
+   * @brief The data type of a dataset
+   */
+  BaseDataType dataType;
+
+  /**
+   * @brief The current shape of a dataset. Empty for scalar datasets.
+   */
+  SizeArray shape;
+
+  /**
+   * @brief The chunking of a dataset as configured on creation. Dimensions
+   * with chunking 0 cannot be extended.
+   */
+  SizeArray chunking;
+
+  /**
+   * @brief The raw values of a numeric dataset in row-major order
+   */
+  std::vector<unsigned char> values;
+
+  /**
+   * @brief The values of a string dataset in row-major order, or the paths of
+   * the referenced objects of a reference dataset
+   */
+  std::vector<std::string> strings;
+
+  /**
+   * @brief Whether the dataset holds object references
+   */
+  bool isReference = false;
+
+  /**
+   * @brief The path of the target of a soft link
+   */
+  std::string linkTarget;
+
+  /**
+   * @brief Get the number of elements of a dataset
+   */
+  SizeType getNumElements() const;
+
+  /**
+   * @brief Validate a block write to a dataset and extend the dataset if the
+   * block reaches beyond its current shape.
+   *
+   * Like in HDF5, dimensions of size 0 write a single element without
+   * extending the dataset, and only dimensions with chunking larger than 0
+   * can be extended. The dataset is left unchanged if the block is invalid.
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param keepValues Whether to grow the values along with the shape, or to
+   * change only the shape of a dataset that discards its values.
+   * @param extended Set to true if the dataset was extended (return value)
+   * @return The status of the operation.
+   */
+  Status extendForBlock(const SizeArray& dataShape,
+                        const SizeArray& positionOffset,
+                        bool keepValues,
+                        bool& extended);
+};
+
+/**
+ * @brief The MemoryIO class keeps all groups, datasets, and attributes of a
+ * "file" in memory.
+ *
+ * MemoryIO implements the full BaseIO interface, including recording via
+ * MemoryRecordingData and the read API, without performing any file I/O. It
+ * can be used for tests, for processing pipelines that never touch the disk,
+ * and to measure the overhead of AqNWB itself. The contents can be written
+ * to another I/O backend, e.g., an HDF5IO, via exportTo.
+ *
+ * The file name is only used as a label. The contents are kept when the file
+ * is closed, such that the file can be reopened for reading or appending, and
+ * are discarded when opening with FileMode::Overwrite or when the MemoryIO is
+ * destroyed. Since there is no SWMR mode, stopRecording leaves the file open.
+ *
+ * Data written with a different numeric type than the type of the dataset is
+ * converted on write with values clipped to the range of the dataset type,
+ * similar to HDF5. Object references are returned as the paths of the
+ * referenced objects, i.e., as strings, by readDataset and readAttribute.
+ *
+ * Derived backends can keep only the structure of the file, i.e., the
+ * objects with their types and shapes, and discard all values (see
+ * NullIO). Reads then return default values, i.e., zeros or empty strings,
+ * in the shape of the selection, and the recording data of the datasets is
+ * created via createRecordingData.
+ */
+class MemoryIO : public BaseIO
+{
+public:
+  /**
+   * @brief Constructor for the MemoryIO class.
+   * @param fileName The name of the file, only used as a label.
+   */
+  explicit MemoryIO(const std::string& fileName);
+
+  /**
+   * @brief Destructor.
+   */
+  ~MemoryIO() override;
+
+  /**
+   * @brief Opens the existing file for reading and writing, or creates a new
+   * empty file if the file was never opened.
+   * @return The status of the file opening operation.
+   */
+  Status open() override;
+
+  /**
+   * @brief Opens the existing file or creates a new empty file.
+   * @param mode Access mode to use when opening the file. ReadWrite and
+   * ReadOnly fail if the file was never opened.
+   * @return The status of the file opening operation.
+   */
+  Status open(FileMode mode) override;
+
+  /**
+   * @brief Closes the file. The contents are kept in memory.
+   * @return The status of the file closing operation.
+   */
+  Status close() override;
+
+  /**
+   * @brief Does nothing since all data is in memory
+   * @return Status::Success if the file is open.
+   */
+  Status flush() override;
+
+  /**
+   * @brief  Get the storage type (Group, Dataset, Attribute) of the object at
+   * path
+   * @param path The path of the object in the file
+   * @return The StorageObjectType. May be Undefined if the object does not
+   * exist.
+   */
+  StorageObjectType getStorageObjectType(std::string path) const override;
+
+  /**
+   * @brief Reads a dataset or a slice of a dataset.
+   *
+   * The slice is defined by a hyperslab of `count` blocks of size `block`
+   * separated by `stride` starting at `start` for each dimension, like in
+   * HDF5.
+   *
+   * @param dataPath The path to the dataset within the file.
+   * @param start The starting indices for the slice (optional).
+   * @param count The number of blocks to read for each dimension (optional).
+   * @param stride The stride for each dimension (optional).
+   * @param block The block size for each dimension (optional).
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::runtime_error if the dataset does not exist or if the slice
+   * is not within the extent of the dataset.
+   */
+  DataBlockGeneric readDataset(const std::string& dataPath,
+                               const SizeArray& start = {},
+                               const SizeArray& count = {},
+                               const SizeArray& stride = {},
+                               const SizeArray& block = {}) override;
+
+  /**
+   * @brief Reads an arbitrary selection of a dataset defined by a list of
+   * indices per dimension.
+   * @param dataPath The path to the dataset within the file.
+   * @param selection One list of indices per dimension of the dataset. An
+   * empty list selects all indices along the dimension.
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::invalid_argument if the selection does not have one list per
+   * dimension.
+   * @throws std::runtime_error if the dataset does not exist or if an index is
+   * not within the extent of the dataset.
+   */
+  DataBlockGeneric readDatasetSelection(
+      const std::string& dataPath,
+      const std::vector<SizeArray>& selection) override;
+
+  /**
+   * @brief Reads an attribute and determines the data type
+   * @param dataPath The path to the attribute within the file.
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::invalid_argument if the attribute does not exist.
+   */
+  DataBlockGeneric readAttribute(const std::string& dataPath) const override;
+
+  /**
+   * @brief Reads a reference attribute and returns the path to the referenced
+   * object.
+   * @param dataPath The path to the reference attribute within the file.
+   * @return The path to the referenced object.
+   * @throws std::invalid_argument if the attribute does not exist or is not a
+   * reference.
+   */
+  std::string readReferenceAttribute(
+      const std::string& dataPath) const override;
+
+  /**
+   * @brief Creates an attribute at a given location in the file. Existing
+   * attributes are overwritten.
+   * @param type The base data type of the attribute.
+   * @param data Pointer to the attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param size The size of the attribute (default is 1).
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const BaseDataType& type,
+                         const void* data,
+                         const std::string& path,
+                         const std::string& name,
+                         const SizeType& size = 1) override;
+
+  /**
+   * @brief Creates a string attribute at a given location in the file.
+   * @param data The string attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::string& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Creates an array of variable length strings attribute at a given
+   * location in the file.
+   * @param data The string array attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::vector<std::string>& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Sets an object reference attribute for a given location in the
+   * file.
+   * @param referencePath The full path to the referenced group / dataset.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @return The status of the attribute creation operation.
+   */
+  Status createReferenceAttribute(const std::string& referencePath,
+                                  const std::string& path,
+                                  const std::string& name) override;
+
+  /**
+   * @brief Creates a new group in the file. The parent group must exist.
+   * @param path The location in the file of the new group.
+   * @return The status of the group creation operation.
+   */
+  Status createGroup(const std::string& path) override;
+
+  /**
+   * @brief Creates a soft link to another location in the file.
+   * @param path The location in the file to the new link.
+   * @param reference The location in the file of the object that is being
+   * linked to.
+   * @return The status of the link creation operation.
+   */
+  Status createLink(const std::string& path,
+                    const std::string& reference) override;
+
+  /**
+   * @brief Creates a scalar dataset with a fixed-length string value.
+   * @param path The location in the file of the dataset.
+   * @param value The string value of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::string& value) override;
+
+  /**
+   * @brief Creates a dataset that holds an array of variable length strings.
+   * @param path The location in the file of the dataset.
+   * @param values The vector of string values of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::vector<std::string>& values) override;
+
+  /**
+   * @brief Creates a dataset that holds an array of references to groups
+   * within the file.
+   * @param path The location in the file of the new dataset.
+   * @param references The array of references.
+   * @return The status of the dataset creation operation.
+   */
+  Status createReferenceDataSet(
+      const std::string& path,
+      const std::vector<std::string>& references) override;
+
+  /**
+   * @brief Starts the recording process.
+   * @return The status of the operation. Fails if the file is not open.
+   */
+  Status startRecording() override;
+
+  /**
+   * @brief Returns true if the file is open for writing.
+   * @return True if objects can be added, false otherwise.
+   */
+  bool canModifyObjects() override;
+
+  /**
+   * @brief Creates an extendable dataset with the given configuration and
+   * path.
+   * @param config The configuration for the dataset, including type, shape,
+   * and chunking. Dimensions with chunking larger than 0 can be extended by
+   * writes. Can also be a LinkArrayDataSetConfig to create a soft-link.
+   * @param path The location in the file of the new dataset.
+   * @return A pointer to the created dataset. Returns nullptr for links.
+   * @throws std::runtime_error if dataset or link creation fails.
+   */
+  std::unique_ptr<BaseRecordingData> createArrayDataSet(
+      const BaseArrayDataSetConfig& config, const std::string& path) override;
+
+  /**
+   * @brief Returns a pointer to a dataset at a given path.
+   * @param path The location in the file of the dataset.
+   * @return A shared pointer to the dataset, or nullptr if the file is not
+   * open or the dataset does not exist.
+   */
+  std::shared_ptr<BaseRecordingData> getDataSet(
+      const std::string& path) override;
+
+  /**
+   * @brief Checks whether a Dataset, Group, or Link already exists at the
+   * location in the file.
+   * @param path The location of the object in the file.
+   * @return Whether the object exists.
+   */
+  bool objectExists(const std::string& path) const override;
+
+  /**
+   * @brief Checks whether an Attribute exists at the location in the file.
+   * @param path The location of the attribute in the file.
+   * @return Whether the attribute exists.
+   */
+  bool attributeExists(const std::string& path) const override;
+
+  /**
+   * @brief Gets the list of storage objects (groups, datasets, attributes)
+   * inside a group.
+   *
+   * Objects are listed by name, followed by the attributes. Soft links are
+   * reported as StorageObjectType::Undefined.
+   *
+   * @param path The path to the group.
+   * @param objectType Define which types of storage object to look for.
+   * @return A vector of pairs of relative paths and their corresponding
+   * storage object types.
+   */
+  std::vector<std::pair<std::string, StorageObjectType>> getStorageObjects(
+      const std::string& path,
+      const StorageObjectType& objectType =
+          StorageObjectType::Undefined) const override;
+
+  /**
+   * @brief Streams the storage objects inside a group to a callback in the
+   * same order as getStorageObjects.
+   * @param path The path to the group.
+   * @param callback The function to call for each object.
+   * @param objectType Define which types of storage object to look for.
+   * @return Status::Failure if the path is not a group or dataset.
+   */
+  Status visitStorageObjects(const std::string& path,
+                             const StorageObjectCallback& callback,
+                             const StorageObjectType& objectType =
+                                 StorageObjectType::Undefined) const override;
+
+  /**
+   * @brief Returns the size of the dataset or attribute for each dimension.
+   * @param path The location of the dataset or attribute in the file
+   * @return The shape of the dataset or attribute. Empty for groups.
+   * @throws std::runtime_error if the object does not exist.
+   */
+  SizeArray getStorageObjectShape(const std::string& path) const override;
+
+  /**
+   * @brief Gets the chunking configuration of a dataset.
+   * @param path The path to the dataset.
+   * @return The chunking of the dataset as configured on creation, or an
+   * empty SizeArray if the dataset was not chunked or if the path is not a
+   * dataset.
+   */
+  SizeArray getStorageObjectChunking(const std::string& path) const override;
+
+  /**
+   * @brief Gets the BaseDataType of a dataset or attribute.
+   * @param path The path to the dataset or attribute.
+   * @return The BaseDataType of the dataset or attribute. Object references
+   * are reported as BaseDataType::V_STR.
+   * @throws std::runtime_error if the object is a Group or does not exist.
+   */
+  BaseDataType getStorageObjectDataType(
+      const std::string& path) const override;
+
+  /**
+   * @brief Write all objects and attributes of the file to another I/O
+   * object, e.g., to save the file as HDF5.
+   *
+   * The target must be open for writing. Datasets are created with their
+   * current shape and the chunking they were created with. Links and object
+   * references are created after all groups and datasets.
+   *
+   * @param target The I/O object to write to
+   * @return The status of the export. Fails if any object could not be
+   * created or if the values are discarded.
+   */
+  Status exportTo(BaseIO& target) const;
+
+  /**
+   * @brief Get the number of bytes of dataset and attribute values held in
+   * memory.
+   */
+  SizeType getDataBytes() const;
+
+  /**
+   * @brief Get the size in bytes of a numeric data type.
+   * @param type The data type
+   * @return The size of one element, or 0 for string types
+   */
+  static SizeType getTypeSize(const BaseDataType& type);
+
+protected:
+  /**
+   * @brief Constructor for derived backends.
+   * @param fileName The name of the file, only used as a label.
+   * @param keepValues Whether to keep the values of datasets and attributes.
+   * If false, only the structure of the file is kept and reads return
+   * default values.
+   */
+  MemoryIO(const std::string& fileName, bool keepValues);
+
+  /**
+   * @brief Creates a new group if it does not already exist.
+   * @param path The location of the group in the file.
+   * @return The status of the operation.
+   */
+  Status createGroupIfDoesNotExist(const std::string& path) override;
+
+  /**
+   * @brief Create the recording data to write to a dataset, used by
+   * createArrayDataSet and getDataSet.
+   * @param dataset The dataset to write to
+   * @return A MemoryRecordingData of the dataset
+   */
+  virtual std::unique_ptr<BaseRecordingData> createRecordingData(
+      std::shared_ptr<MemoryObject> dataset);
+
+  /**
+   * @brief Create an array dataset in the target of exportTo and write its
+   * values. The attributes of the dataset are exported separately.
+   * @param dataset The dataset to export
+   * @param path The path of the dataset
+   * @param target The I/O object to export to
+   * @return The status of the export
+   */
+  virtual Status exportArrayDataSet(const MemoryObject& dataset,
+                                    const std::string& path,
+                                    BaseIO& target) const;
+
+  /**
+   * @brief Find the object at a path.
+   * @param path The path of the object
+   * @param followLinks Whether to return the target if the object itself is
+   * a soft link. Links in the parent path are always followed.
+   * @return The object or nullptr if it does not exist.
+   */
+  std::shared_ptr<MemoryObject> findObject(const std::string& path,
+                                           bool followLinks = true) const;
+
+  /**
+   * @brief The root group of the file, or nullptr if the file was never
+   * opened
+   */
+  std::shared_ptr<MemoryObject> m_root;
+
+private:
+  /**
+   * @brief Find the dataset at a path.
+   * @throws std::runtime_error if there is no dataset at the path
+   */
+  std::shared_ptr<MemoryObject> findDataset(const std::string& path) const;
+
+  /**
+   * @brief Find the attribute at a path
+   * @param path The path of the attribute, i.e., the path of the parent
+   * object and the name of the attribute
+   * @return The attribute or nullptr if it does not exist.
+   */
+  const MemoryAttribute* findAttribute(const std::string& path) const;
+
+  /**
+   * @brief Add a new object to its parent group
+   * @param path The path of the new object
+   * @param object The object to add
+   * @return Status::Failure if the parent group does not exist or an object
+   * already exists at the path.
+   */
+  Status insertObject(const std::string& path,
+                      std::shared_ptr<MemoryObject> object);
+
+  /**
+   * @brief Add or replace an attribute of a group or dataset
+   * @param path The path of the group or dataset
+   * @param name The name of the attribute
+   * @param attribute The attribute
+   * @param overwrite Whether to replace an existing attribute
+   * @return The status of the operation.
+   */
+  Status setAttribute(const std::string& path,
+                      const std::string& name,
+                      MemoryAttribute attribute,
+                      bool overwrite);
+
+  /**
+   * @brief Whether the file was opened read-only
+   */
+  bool m_readOnly = false;
+
+  /**
+   * @brief Whether the values of datasets and attributes are kept
+   */
+  bool m_keepValues;
+};
+
+}  // namespace AQNWB::IO::Memory
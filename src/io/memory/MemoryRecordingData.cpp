@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "io/memory/MemoryRecordingData.hpp"
+
+#include "Tracing.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Memory;
+
+namespace
+{
+/**
+ * @brief Convert a value to another numeric type, clipping values outside of
+ * the range of the target type and converting NaN to 0 for integer types
+ */
+template<typename D, typename S>
+D convertValue(S value)
+{
+  if constexpr (std::is_same_v<D, S> || std::is_floating_point_v<D>) {
+    return static_cast<D>(value);
+  } else if constexpr (std::is_floating_point_v<S>) {
+    if (std::isnan(value)) {
+      return D {0};
+    }
+    if (value <= static_cast<S>(std::numeric_limits<D>::lowest())) {
+      return std::numeric_limits<D>::lowest();
+    }
+    if (value >= static_cast<S>(std::numeric_limits<D>::max())) {
+      return std::numeric_limits<D>::max();
+    }
+    return static_cast<D>(value);
+  } else {
+    if constexpr (std::is_signed_v<S>) {
+      if (value < S {0}) {
+        if constexpr (std::is_signed_v<D>) {
+          if (static_cast<intmax_t>(value)
+              < static_cast<intmax_t>(std::numeric_limits<D>::lowest()))
+          {
+            return std::numeric_limits<D>::lowest();
+          }
+          return static_cast<D>(value);
+        } else {
+          return D {0};
+        }
+      }
+    }
+    if (static_cast<uintmax_t>(value)
+        > static_cast<uintmax_t>(std::numeric_limits<D>::max()))
+    {
+      return std::numeric_limits<D>::max();
+    }
+    return static_cast<D>(value);
+  }
+}
+}  // namespace
+
+void AQNWB::IO::Memory::convertValues(const unsigned char* source,
+                                      BaseDataType::Type sourceType,
+                                      unsigned char* target,
+                                      BaseDataType::Type targetType,
+                                      SizeType numElements)
+{
+  if (sourceType == targetType) {
+    std::memcpy(target,
+                source,
+                numElements * MemoryIO::getTypeSize(BaseDataType(sourceType)));
+    return;
+  }
+  visitNumericType(
+      targetType,
+      [&](auto targetTag)
+      {
+        using D = typename decltype(targetTag)::type;
+        visitNumericType(sourceType,
+                         [&](auto sourceTag)
+                         {
+                           using S = typename decltype(sourceTag)::type;
+                           for (SizeType i = 0; i < numElements; ++i) {
+                             S value;
+                             std::memcpy(&value, source + i * sizeof(S),
+                                         sizeof(S));
+                             D converted = convertValue<D>(value);
+                             std::memcpy(target + i * sizeof(D), &converted,
+                                         sizeof(D));
+                           }
+                         });
+      });
+}
+
+MemoryRecordingData::MemoryRecordingData(std::shared_ptr<MemoryObject> dataset)
+    : m_dataset(std::move(dataset))
+{
+  m_shape = m_dataset->shape;
+  m_position = SizeArray(m_shape.size(), 0);
+}
+
+MemoryRecordingData::~MemoryRecordingData() {}
+
+Status MemoryRecordingData::writeDataBlockImpl(const SizeArray& dataShape,
+                                               const SizeArray& positionOffset,
+                                               const BaseDataType& type,
+                                               const void* data)
+{
+  TraceScope trace("MemoryRecordingData::writeDataBlock", "io");
+  // check type. Strings should use the other variant of this function
+  const SizeType sourceSize = MemoryIO::getTypeSize(type);
+  if (sourceSize == 0) {
+    std::cerr << "MemoryRecordingData::writeDataBlock called for string data, "
+                 "use MemoryRecordingData::writeDataBlock with a string array "
+                 "data input instead of void* data."
+              << std::endl;
+    return Status::Failure;
+  }
+  const SizeType targetSize = MemoryIO::getTypeSize(m_dataset->dataType);
+  if (targetSize == 0 || m_dataset->isReference) {
+    std::cerr << "MemoryRecordingData::writeDataBlock numeric data for a "
+                 "non-numeric dataset"
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // validate and allocate space
+  bool extended = false;
+  if (m_dataset->extendForBlock(dataShape, positionOffset, true, extended)
+      == Status::Failure)
+  {
+    return Status::Failure;
+  }
+  if (extended) {
+    recordExtend();
+  }
+  m_shape = m_dataset->shape;
+
+  // Write the data
+  const auto* source = static_cast<const unsigned char*>(data);
+  const BaseDataType::Type targetType = m_dataset->dataType.type;
+  forEachRow(positionOffset,
+             dataShape,
+             [&](SizeType blockIndex, SizeType datasetIndex, SizeType length)
+             {
+               convertValues(source + blockIndex * sourceSize,
+                             type.type,
+                             m_dataset->values.data()
+                                 + datasetIndex * targetSize,
+                             targetType,
+                             length);
+             });
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+  return Status::Success;
+}
+
+Status MemoryRecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const AQNWB::IO::BaseDataType& type,
+    const std::vector<std::string>& data)
+{
+  TraceScope trace("MemoryRecordingData::writeDataBlock", "io");
+  if (type.type != BaseDataType::Type::V_STR
+      && type.type != BaseDataType::Type::T_STR)
+  {
+    std::cerr
+        << "MemoryRecordingData::writeDataBlock non-string type for string data"
+        << std::endl;
+    return Status::Failure;
+  }
+  const BaseDataType& targetType = m_dataset->dataType;
+  if (MemoryIO::getTypeSize(targetType) != 0 || m_dataset->isReference) {
+    std::cerr << "MemoryRecordingData::writeDataBlock string data for a "
+                 "non-string dataset"
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // validate the data before modifying the dataset
+  SizeType numElements = 1;
+  for (SizeType dim : dataShape) {
+    numElements *= (dim == 0) ? 1 : dim;
+  }
+  if (data.size() < numElements) {
+    return Status::Failure;
+  }
+  if (type.type == BaseDataType::Type::T_STR) {
+    for (SizeType i = 0; i < numElements; ++i) {
+      if (data[i].size() > type.typeSize) {
+        return Status::Failure;  // String length exceeds the fixed length
+      }
+    }
+  }
+
+  // validate and allocate space
+  bool extended = false;
+  if (m_dataset->extendForBlock(dataShape, positionOffset, true, extended)
+      == Status::Failure)
+  {
+    return Status::Failure;
+  }
+  if (extended) {
+    recordExtend();
+  }
+  m_shape = m_dataset->shape;
+
+  // Write the data, truncating strings to the length of fixed-length string
+  // datasets
+  const SizeType maxLength = (targetType.type == BaseDataType::Type::T_STR)
+      ? targetType.typeSize
+      : std::string::npos;
+  forEachRow(positionOffset,
+             dataShape,
+             [&](SizeType blockIndex, SizeType datasetIndex, SizeType length)
+             {
+               for (SizeType i = 0; i < length; ++i) {
+                 m_dataset->strings[datasetIndex + i].assign(
+                     data[blockIndex + i], 0, maxLength);
+               }
+             });
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+  return Status::Success;
+}
+
+template<typename Func>
+void MemoryRecordingData::forEachRow(const SizeArray& positionOffset,
+                                     const SizeArray& dataShape,
+                                     Func&& copyRow) const
+{
+  const SizeType rank = dataShape.size();
+  if (rank == 0) {
+    copyRow(SizeType {0}, SizeType {0}, SizeType {1});
+    return;
+  }
+  const SizeArray& shape = m_dataset->shape;
+  SizeArray strides(rank, 1);
+  for (SizeType d = rank - 1; d-- > 0;) {
+    strides[d] = strides[d + 1] * shape[d + 1];
+  }
+  const SizeType rowLength = std::max<SizeType>(dataShape[rank - 1], 1);
+  SizeArray position(rank, 0);
+  SizeType blockIndex = 0;
+  bool done = false;
+  while (!done) {
+    SizeType datasetIndex = positionOffset[rank - 1];
+    for (SizeType d = 0; d + 1 < rank; ++d) {
+      datasetIndex += (positionOffset[d] + position[d]) * strides[d];
+    }
+    copyRow(blockIndex, datasetIndex, rowLength);
+    blockIndex += rowLength;
+    done = true;
+    for (SizeType d = rank - 1; d-- > 0;) {
+      if (++position[d] < std::max<SizeType>(dataShape[d], 1)) {
+        done = false;
+        break;
+      }
+      position[d] = 0;
+    }
+  }
+}
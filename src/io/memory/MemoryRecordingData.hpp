@@ -0,0 +1,98 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/BaseIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+
+namespace AQNWB::IO::Memory
+{
+/**
+ * @brief Represents a dataset of a MemoryIO that can be extended
+ * indefinitely in blocks.
+ *
+ * Writes beyond the current shape of the dataset grow the dataset along all
+ * dimensions that were created with chunking larger than 0.
+ */
+class MemoryRecordingData : public AQNWB::IO::BaseRecordingData
+{
+public:
+  /**
+   * @brief Constructs a MemoryRecordingData object.
+   * @param dataset The dataset to write to.
+   */
+  explicit MemoryRecordingData(std::shared_ptr<MemoryObject> dataset);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  MemoryRecordingData(const MemoryRecordingData&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  MemoryRecordingData& operator=(const MemoryRecordingData&) = delete;
+
+  /**
+   * @brief Destroys the MemoryRecordingData object.
+   */
+  ~MemoryRecordingData() override;
+
+  /**
+   * @brief Gets a const pointer to the dataset.
+   * @return A const pointer to the dataset.
+   */
+  inline const MemoryObject* getDataSet() const { return m_dataset.get(); }
+
+protected:
+  /**
+   * @brief Writes a block of data to the dataset.
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block.
+   * @param data A pointer to the data block.
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const void* data) override;
+
+  /**
+   * @brief Writes a block of string data (any number of dimensions).
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block. Either
+   *             BaseDataType::Type::V_STR or BaseDataType::Type::T_STR
+   *             for variable and fixed-length strings repsetively.
+   * @param data Vector with the string data
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const std::vector<std::string>& data) override;
+
+private:
+  /**
+   * @brief Call a function for each contiguous row of a block in the dataset
+   * @param positionOffset The position of the block in the dataset
+   * @param dataShape The shape of the block. Dimensions of size 0 are
+   * treated as size 1.
+   * @param copyRow Function called with the index of the first element of
+   * the row in the block, the index of the first element in the dataset, and
+   * the number of elements of the row.
+   */
+  template<typename Func>
+  void forEachRow(const SizeArray& positionOffset,
+                  const SizeArray& dataShape,
+                  Func&& copyRow) const;
+
+  /**
+   * @brief The dataset to write to
+   */
+  std::shared_ptr<MemoryObject> m_dataset;
+};
+}  // namespace AQNWB::IO::Memory
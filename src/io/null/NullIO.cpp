@@ -0,0 +1,132 @@
+#include <cstring>
+
+#include "io/null/NullIO.hpp"
+
+#include "Tracing.hpp"
+#include "io/null/NullRecordingData.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Null;
+using AQNWB::IO::Memory::MemoryIO;
+
+// NullIO
+
+NullIO::NullIO(const std::string& fileName)
+    : MemoryIO(fileName, false)
+    , m_counters(std::make_shared<NullIOCounters>())
+{
+}
+
+NullIO::~NullIO() {}
+
+Status NullIO::createAttribute(const BaseDataType& type,
+                               const void* data,
+                               const std::string& path,
+                               const std::string& name,
+                               const SizeType& size)
+{
+  TraceScope trace("NullIO::createAttribute", "io");
+  Status status = MemoryIO::createAttribute(type, data, path, name, size);
+  if (status != Status::Success) {
+    return status;
+  }
+  SizeType bytes = 0;
+  if (type.type == BaseDataType::Type::T_STR) {
+    bytes = size * type.typeSize;
+  } else if (type.type == BaseDataType::Type::V_STR) {
+    const auto* strs = static_cast<const char* const*>(data);
+    for (SizeType i = 0; i < size; ++i) {
+      bytes += std::strlen(strs[i]);
+    }
+  } else {
+    // Like HDF5IO, array attributes with the array length encoded in the
+    // typeSize are stored as a 1D array of the element type
+    SizeType numElements = size;
+    if (type.typeSize > 1 && type.typeSize != size) {
+      numElements *= type.typeSize;
+    }
+    bytes = numElements * getTypeSize(type);
+  }
+  m_counters->attributeBytes += bytes;
+  return status;
+}
+
+Status NullIO::createAttribute(const std::string& data,
+                               const std::string& path,
+                               const std::string& name,
+                               const bool overwrite)
+{
+  TraceScope trace("NullIO::createAttribute", "io");
+  Status status = MemoryIO::createAttribute(data, path, name, overwrite);
+  if (status == Status::Success) {
+    m_counters->attributeBytes += data.size();
+  }
+  return status;
+}
+
+Status NullIO::createAttribute(const std::vector<std::string>& data,
+                               const std::string& path,
+                               const std::string& name,
+                               const bool overwrite)
+{
+  TraceScope trace("NullIO::createAttribute", "io");
+  Status status = MemoryIO::createAttribute(data, path, name, overwrite);
+  if (status == Status::Success) {
+    for (const auto& str : data) {
+      m_counters->attributeBytes += str.size();
+    }
+  }
+  return status;
+}
+
+Status NullIO::createStringDataSet(const std::string& path,
+                                   const std::string& value)
+{
+  TraceScope trace("NullIO::createStringDataSet", "io");
+  Status status = MemoryIO::createStringDataSet(path, value);
+  if (status == Status::Success) {
+    m_counters->dataBytes += value.size();
+  }
+  return status;
+}
+
+Status NullIO::createStringDataSet(const std::string& path,
+                                   const std::vector<std::string>& values)
+{
+  TraceScope trace("NullIO::createStringDataSet", "io");
+  Status status = MemoryIO::createStringDataSet(path, values);
+  if (status == Status::Success) {
+    for (const auto& value : values) {
+      m_counters->dataBytes += value.size();
+    }
+  }
+  return status;
+}
+
+std::unique_ptr<BaseRecordingData> NullIO::createRecordingData(
+    std::shared_ptr<Memory::MemoryObject> dataset)
+{
+  return std::make_unique<NullRecordingData>(std::move(dataset), m_counters);
+}
+
+SizeType NullIO::getNumWrites() const
+{
+  return m_counters->numWrites;
+}
+
+SizeType NullIO::getDataBytesWritten() const
+{
+  return m_counters->dataBytes;
+}
+
+SizeType NullIO::getAttributeBytesWritten() const
+{
+  return m_counters->attributeBytes;
+}
+
+void NullIO::resetCounters()
+{
+  m_counters->numWrites = 0;
+  m_counters->dataBytes = 0;
+  m_counters->attributeBytes = 0;
+}
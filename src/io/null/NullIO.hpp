@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+
+/*!
+ * \namespace AQNWB::IO::Null
+ * \brief Namespace for all components of the null (discard) I/O backend
+ */
+namespace AQNWB::IO::Null
+{
+
+/**
+ * @brief Counters of the data accepted by a NullIO and its datasets
+ */
+struct NullIOCounters
+{
+  /**
+   * @brief The number of successful writeDataBlock calls
+   */
+  std::atomic<SizeType> numWrites {0};
+
+  /**
+   * @brief The number of bytes written to datasets
+   */
+  std::atomic<SizeType> dataBytes {0};
+
+  /**
+   * @brief The number of bytes written to attributes
+   */
+  std::atomic<SizeType> attributeBytes {0};
+};
+
+/**
+ * @brief The NullIO class accepts all operations of BaseIO without storing
+ * any data.
+ *
+ * NullIO is a MemoryIO that discards all values. It keeps track of the
+ * structure of the file, i.e., of the groups, datasets, links, and
+ * attributes and of the types and shapes of datasets and attributes, such
+ * that NWBFile, the NWB types, and RecordingObjects work as with any other
+ * backend. The values of datasets and attributes are only counted in bytes
+ * (see getDataBytesWritten). This makes
+ * it possible to profile acquisition code at the upper bound of the
+ * throughput of AqNWB itself, without any cost of storage.
+ *
+ * Reads succeed for all existing objects and return default values, i.e.,
+ * zeros for numeric data and empty strings for string data, with the shape
+ * of the selection. Since the values of attributes are discarded, reading
+ * types via getFullTypeName or findTypes does not find any types.
+ *
+ * The file name is only used as a label. The structure is kept when the file
+ * is closed, such that the file can be reopened, and is discarded when
+ * opening with FileMode::Overwrite.
+ */
+class NullIO : public Memory::MemoryIO
+{
+public:
+  /**
+   * @brief Constructor for the NullIO class.
+   * @param fileName The name of the file, only used as a label.
+   */
+  explicit NullIO(const std::string& fileName);
+
+  /**
+   * @brief Destructor.
+   */
+  ~NullIO() override;
+
+  /**
+   * @brief Creates an attribute at a given location in the file and counts
+   * its bytes. Existing attributes are overwritten.
+   * @param type The base data type of the attribute.
+   * @param data Pointer to the attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param size The size of the attribute (default is 1).
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const BaseDataType& type,
+                         const void* data,
+                         const std::string& path,
+                         const std::string& name,
+                         const SizeType& size = 1) override;
+
+  /**
+   * @brief Creates a string attribute at a given location in the file and
+   * counts its bytes.
+   * @param data The string attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::string& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Creates an array of variable length strings attribute at a given
+   * location in the file and counts its bytes.
+   * @param data The string array attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::vector<std::string>& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Creates a scalar dataset with a fixed-length string value and
+   * counts its bytes.
+   * @param path The location in the file of the dataset.
+   * @param value The string value of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::string& value) override;
+
+  /**
+   * @brief Creates a dataset that holds an array of variable length strings
+   * and counts its bytes.
+   * @param path The location in the file of the dataset.
+   * @param values The vector of string values of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::vector<std::string>& values) override;
+
+  /**
+   * @brief Get the number of successful writeDataBlock calls on the datasets
+   * of the file
+   */
+  SizeType getNumWrites() const;
+
+  /**
+   * @brief Get the number of bytes written to datasets, including string and
+   * reference datasets. Variable length strings count their length.
+   */
+  SizeType getDataBytesWritten() const;
+
+  /**
+   * @brief Get the number of bytes written to attributes
+   */
+  SizeType getAttributeBytesWritten() const;
+
+  /**
+   * @brief Reset the write and byte counters to 0
+   */
+  void resetCounters();
+
+protected:
+  /**
+   * @brief Create a NullRecordingData that counts the writes to a dataset.
+   * @param dataset The dataset to write to
+   * @return A NullRecordingData of the dataset
+   */
+  std::unique_ptr<BaseRecordingData> createRecordingData(
+      std::shared_ptr<Memory::MemoryObject> dataset) override;
+
+private:
+  /**
+   * @brief The counters shared with the datasets of the file
+   */
+  std::shared_ptr<NullIOCounters> m_counters;
+};
+
+}  // namespace AQNWB::IO::Null
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "io/null/NullRecordingData.hpp"
+
+#include "Tracing.hpp"
+#include "io/memory/MemoryIO.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Null;
+using AQNWB::IO::Memory::MemoryIO;
+
+NullRecordingData::NullRecordingData(
+    std::shared_ptr<Memory::MemoryObject> dataset,
+    std::shared_ptr<NullIOCounters> counters)
+    : m_dataset(std::move(dataset))
+    , m_counters(std::move(counters))
+{
+  m_shape = m_dataset->shape;
+  m_position = SizeArray(m_shape.size(), 0);
+}
+
+NullRecordingData::~NullRecordingData() {}
+
+Status NullRecordingData::writeDataBlockImpl(const SizeArray& dataShape,
+                                             const SizeArray& positionOffset,
+                                             const BaseDataType& type,
+                                             const void* data)
+{
+  TraceScope trace("NullRecordingData::writeDataBlock", "io");
+  // check type. Strings should use the other variant of this function
+  SizeType bytes = MemoryIO::getTypeSize(type);
+  Status status = Status::Failure;
+  if (bytes == 0) {
+    std::cerr << "NullRecordingData::writeDataBlock called for string data, "
+                 "use NullRecordingData::writeDataBlock with a string array "
+                 "data input instead of void* data."
+              << std::endl;
+  } else if (MemoryIO::getTypeSize(m_dataset->dataType) == 0) {
+    std::cerr << "NullRecordingData::writeDataBlock numeric data for a "
+                 "non-numeric dataset"
+              << std::endl;
+  } else if (data != nullptr) {
+    for (SizeType dim : dataShape) {
+      bytes *= (dim == 0) ? 1 : dim;
+    }
+    status = writeDataBlockHelper(dataShape, positionOffset, bytes);
+  }
+  return status;
+}
+
+Status NullRecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const AQNWB::IO::BaseDataType& type,
+    const std::vector<std::string>& data)
+{
+  TraceScope trace("NullRecordingData::writeDataBlock", "io");
+  SizeType bytes = 0;
+  Status status = Status::Failure;
+  SizeType numElements = 1;
+  for (SizeType dim : dataShape) {
+    numElements *= (dim == 0) ? 1 : dim;
+  }
+  if (type.type != BaseDataType::Type::V_STR
+      && type.type != BaseDataType::Type::T_STR)
+  {
+    std::cerr
+        << "NullRecordingData::writeDataBlock non-string type for string data"
+        << std::endl;
+  } else if (MemoryIO::getTypeSize(m_dataset->dataType) != 0) {
+    std::cerr << "NullRecordingData::writeDataBlock string data for a "
+                 "non-string dataset"
+              << std::endl;
+  } else if (data.size() >= numElements) {
+    bool valid = true;
+    for (SizeType i = 0; i < numElements; ++i) {
+      if (type.type == BaseDataType::Type::T_STR
+          && data[i].size() > type.typeSize)
+      {
+        valid = false;  // String length exceeds the fixed length
+        break;
+      }
+      bytes += data[i].size();
+    }
+    if (type.type == BaseDataType::Type::T_STR) {
+      bytes = numElements * type.typeSize;
+    }
+    if (valid) {
+      status = writeDataBlockHelper(dataShape, positionOffset, bytes);
+    }
+  }
+  return status;
+}
+
+Status NullRecordingData::writeDataBlockHelper(const SizeArray& dataShape,
+                                               const SizeArray& positionOffset,
+                                               SizeType bytes)
+{
+  // Validate the block and extend the shape, discarding the values
+  bool extended = false;
+  if (m_dataset->extendForBlock(dataShape, positionOffset, false, extended)
+      == Status::Failure)
+  {
+    return Status::Failure;
+  }
+  if (extended) {
+    recordExtend();
+  }
+  m_shape = m_dataset->shape;
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+  ++m_counters->numWrites;
+  m_counters->dataBytes += bytes;
+  return Status::Success;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/BaseIO.hpp"
+#include "io/null/NullIO.hpp"
+
+namespace AQNWB::IO::Null
+{
+/**
+ * @brief Represents a dataset of a NullIO that discards all data written to
+ * it.
+ *
+ * Writes are validated and extend the shape of the dataset like writes to an
+ * HDF5 dataset, and the written bytes are counted in the NullIOCounters of
+ * the NullIO.
+ */
+class NullRecordingData : public AQNWB::IO::BaseRecordingData
+{
+public:
+  /**
+   * @brief Constructs a NullRecordingData object.
+   * @param dataset The dataset to write to.
+   * @param counters The counters of the NullIO.
+   */
+  NullRecordingData(std::shared_ptr<Memory::MemoryObject> dataset,
+                    std::shared_ptr<NullIOCounters> counters);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  NullRecordingData(const NullRecordingData&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  NullRecordingData& operator=(const NullRecordingData&) = delete;
+
+  /**
+   * @brief Destroys the NullRecordingData object.
+   */
+  ~NullRecordingData() override;
+
+  /**
+   * @brief Gets a const pointer to the dataset.
+   * @return A const pointer to the dataset.
+   */
+  inline const Memory::MemoryObject* getDataSet() const
+  {
+    return m_dataset.get();
+  }
+
+protected:
+  /**
+   * @brief Writes a block of data to the dataset.
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block.
+   * @param data A pointer to the data block.
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const void* data) override;
+
+  /**
+   * @brief Writes a block of string data (any number of dimensions).
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block. Either
+   *             BaseDataType::Type::V_STR or BaseDataType::Type::T_STR
+   *             for variable and fixed-length strings respectively.
+   * @param data Vector with the string data
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const std::vector<std::string>& data) override;
+
+private:
+  /**
+   * @brief Validate parameters, extend the dataset if necessary, and count
+   * the write
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param bytes The number of bytes of the data block.
+   * @return The status of the operation.
+   */
+  Status writeDataBlockHelper(const SizeArray& dataShape,
+                              const SizeArray& positionOffset,
+                              SizeType bytes);
+
+  /**
+   * @brief The dataset to write to
+   */
+  std::shared_ptr<Memory::MemoryObject> m_dataset;
+
+  /**
+   * @brief The counters of the NullIO
+   */
+  std::shared_ptr<NullIOCounters> m_counters;
+};
+}  // namespace AQNWB::IO::Null
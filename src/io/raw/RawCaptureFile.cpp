@@ -0,0 +1,425 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "io/raw/RawCaptureFile.hpp"
+
+#include "io/memory/MemoryRecordingData.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Raw;
+namespace fs = std::filesystem;
+
+namespace
+{
+/**
+ * @brief The magic at the start of every log
+ */
+constexpr char Magic[8] = {'A', 'Q', 'N', 'W', 'B', 'R', 'A', 'W'};
+
+/**
+ * @brief The version of the log format
+ */
+constexpr uint32_t FormatVersion = 1;
+
+/**
+ * @brief The size of the file header: magic, version, and rank
+ */
+constexpr uint64_t FileHeaderSize = sizeof(Magic) + 2 * sizeof(uint32_t);
+
+/**
+ * @brief The marker at the start of every record
+ */
+constexpr char RecordMarker[4] = {'R', 'C', 'R', 'D'};
+
+/**
+ * @brief The size of the buffer of files opened for appending
+ */
+constexpr size_t WriteBufferSize = size_t {1} << 20;
+
+/**
+ * @brief Get the size of a record header: marker, type, type size, shape,
+ * offset, and number of data bytes
+ */
+uint64_t getRecordHeaderSize(SizeType rank)
+{
+  return sizeof(RecordMarker) + sizeof(uint32_t) + sizeof(uint64_t)
+      + 2 * rank * sizeof(uint64_t) + sizeof(uint64_t);
+}
+
+/**
+ * @brief Get the number of elements of a block, with dimensions of size 0
+ * counted as 1
+ */
+SizeType getBlockElements(const SizeArray& shape)
+{
+  SizeType numElements = 1;
+  for (SizeType dim : shape) {
+    numElements *= (dim == 0) ? 1 : dim;
+  }
+  return numElements;
+}
+
+/**
+ * @brief Append a value to a buffer in native byte order
+ */
+template<typename T>
+void putValue(std::vector<unsigned char>& buffer, T value)
+{
+  const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @brief Read a value from a buffer in native byte order
+ */
+template<typename T>
+T getValue(const unsigned char*& data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+  return value;
+}
+
+/**
+ * @brief Read and check the header of a log
+ * @throws std::runtime_error if the header is invalid
+ */
+void readFileHeader(std::ifstream& stream,
+                    const fs::path& path,
+                    SizeType rank)
+{
+  char magic[sizeof(Magic)];
+  uint32_t version = 0;
+  uint32_t fileRank = 0;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+  stream.read(reinterpret_cast<char*>(&fileRank), sizeof(fileRank));
+  if (!stream || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+    throw std::runtime_error("Not a raw capture file: " + path.string());
+  }
+  if (version != FormatVersion || fileRank != rank) {
+    throw std::runtime_error("Unsupported raw capture file: " + path.string());
+  }
+}
+
+/**
+ * @brief Read the header of the record at the current position of a stream
+ * @param stream The stream
+ * @param rank The rank of the dataset
+ * @param fileSize The size of the file
+ * @param record The record (return value)
+ * @return False if there is no complete record at the position
+ */
+bool readRecordHeader(std::ifstream& stream,
+                      SizeType rank,
+                      uint64_t fileSize,
+                      RawCaptureFile::Record& record)
+{
+  const uint64_t headerSize = getRecordHeaderSize(rank);
+  record.position = static_cast<uint64_t>(stream.tellg());
+  if (!stream || record.position + headerSize > fileSize) {
+    return false;
+  }
+  std::vector<unsigned char> header(headerSize);
+  stream.read(reinterpret_cast<char*>(header.data()),
+              static_cast<std::streamsize>(headerSize));
+  if (!stream
+      || std::memcmp(header.data(), RecordMarker, sizeof(RecordMarker)) != 0)
+  {
+    return false;
+  }
+
+  const unsigned char* data = header.data() + sizeof(RecordMarker);
+  record.type.type =
+      static_cast<BaseDataType::Type>(getValue<uint32_t>(data));
+  record.type.typeSize = static_cast<SizeType>(getValue<uint64_t>(data));
+  record.shape.resize(rank);
+  record.offset.resize(rank);
+  for (SizeType i = 0; i < rank; ++i) {
+    record.shape[i] = static_cast<SizeType>(getValue<uint64_t>(data));
+  }
+  for (SizeType i = 0; i < rank; ++i) {
+    record.offset[i] = static_cast<SizeType>(getValue<uint64_t>(data));
+  }
+  const uint64_t dataBytes = getValue<uint64_t>(data);
+  record.end = record.position + headerSize + dataBytes;
+  return record.end <= fileSize;
+}
+
+/**
+ * @brief Decode the strings of a record
+ * @throws std::runtime_error if the data is invalid
+ */
+std::vector<std::string> decodeStrings(const std::vector<unsigned char>& data,
+                                       SizeType numElements)
+{
+  std::vector<std::string> strings(numElements);
+  SizeType pos = 0;
+  for (auto& str : strings) {
+    uint64_t length = 0;
+    if (pos + sizeof(length) > data.size()) {
+      throw std::runtime_error("Invalid string record in raw capture file");
+    }
+    std::memcpy(&length, data.data() + pos, sizeof(length));
+    pos += sizeof(length);
+    if (pos + length > data.size()) {
+      throw std::runtime_error("Invalid string record in raw capture file");
+    }
+    str.assign(reinterpret_cast<const char*>(data.data() + pos), length);
+    pos += length;
+  }
+  return strings;
+}
+}  // namespace
+
+RawCaptureFile::RawCaptureFile(fs::path path, SizeType rank)
+    : m_path(std::move(path))
+    , m_rank(rank)
+{
+}
+
+RawCaptureFile::~RawCaptureFile()
+{
+  close();
+}
+
+Status RawCaptureFile::openStream(const char* mode)
+{
+  m_file = std::fopen(m_path.string().c_str(), mode);
+  if (m_file == nullptr) {
+    std::cerr << "RawCaptureFile failed to open " << m_path << std::endl;
+    return Status::Failure;
+  }
+  m_buffer.resize(WriteBufferSize);
+  std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+  m_header.reserve(getRecordHeaderSize(m_rank));
+  return Status::Success;
+}
+
+Status RawCaptureFile::create()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file != nullptr) {
+    return Status::Failure;
+  }
+  if (openStream("wb") != Status::Success) {
+    return Status::Failure;
+  }
+  const uint32_t version = FormatVersion;
+  const auto rank = static_cast<uint32_t>(m_rank);
+  bool success = std::fwrite(Magic, sizeof(Magic), 1, m_file) == 1
+      && std::fwrite(&version, sizeof(version), 1, m_file) == 1
+      && std::fwrite(&rank, sizeof(rank), 1, m_file) == 1;
+  return success ? Status::Success : Status::Failure;
+}
+
+Status RawCaptureFile::openForAppend()
+{
+  const uint64_t end = scan([](const Record&) {});
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file != nullptr) {
+    return Status::Failure;
+  }
+  std::error_code error;
+  if (fs::file_size(m_path, error) != end) {
+    std::cerr << "RawCaptureFile removing an incomplete record at the end of "
+              << m_path << std::endl;
+    fs::resize_file(m_path, end, error);
+    if (error) {
+      return Status::Failure;
+    }
+  }
+  return openStream("ab");
+}
+
+Status RawCaptureFile::appendRecord(const SizeArray& shape,
+                                    const SizeArray& offset,
+                                    const BaseDataType& type,
+                                    const void* data,
+                                    uint64_t dataBytes)
+{
+  if (m_file == nullptr || shape.size() != m_rank || offset.size() != m_rank) {
+    return Status::Failure;
+  }
+  m_header.clear();
+  m_header.insert(
+      m_header.end(), RecordMarker, RecordMarker + sizeof(RecordMarker));
+  putValue(m_header, static_cast<uint32_t>(type.type));
+  putValue(m_header, static_cast<uint64_t>(type.typeSize));
+  for (SizeType dim : shape) {
+    putValue(m_header, static_cast<uint64_t>(dim));
+  }
+  for (SizeType pos : offset) {
+    putValue(m_header, static_cast<uint64_t>(pos));
+  }
+  putValue(m_header, dataBytes);
+  if (std::fwrite(m_header.data(), m_header.size(), 1, m_file) != 1
+      || (dataBytes > 0 && std::fwrite(data, dataBytes, 1, m_file) != 1))
+  {
+    return Status::Failure;
+  }
+  return Status::Success;
+}
+
+Status RawCaptureFile::append(const SizeArray& shape,
+                              const SizeArray& offset,
+                              const BaseDataType& type,
+                              const void* data)
+{
+  const SizeType typeSize = Memory::MemoryIO::getTypeSize(type);
+  if (typeSize == 0) {
+    return Status::Failure;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return appendRecord(
+      shape, offset, type, data, getBlockElements(shape) * typeSize);
+}
+
+Status RawCaptureFile::appendStrings(const SizeArray& shape,
+                                     const SizeArray& offset,
+                                     const BaseDataType& type,
+                                     const std::vector<std::string>& data)
+{
+  const SizeType numElements = getBlockElements(shape);
+  if (data.size() < numElements) {
+    return Status::Failure;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_strings.clear();
+  for (SizeType i = 0; i < numElements; ++i) {
+    putValue(m_strings, static_cast<uint64_t>(data[i].size()));
+    m_strings.insert(m_strings.end(), data[i].begin(), data[i].end());
+  }
+  return appendRecord(shape, offset, type, m_strings.data(), m_strings.size());
+}
+
+Status RawCaptureFile::flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file == nullptr) {
+    return Status::Success;
+  }
+  return (std::fflush(m_file) == 0) ? Status::Success : Status::Failure;
+}
+
+Status RawCaptureFile::close()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file == nullptr) {
+    return Status::Success;
+  }
+  bool success = (std::fclose(m_file) == 0);
+  m_file = nullptr;
+  m_buffer = std::vector<char>();
+  return success ? Status::Success : Status::Failure;
+}
+
+uint64_t RawCaptureFile::getFirstRecordPosition() const
+{
+  return FileHeaderSize;
+}
+
+uint64_t RawCaptureFile::scan(
+    const std::function<void(const Record&)>& callback) const
+{
+  std::ifstream stream(m_path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("Failed to open raw capture file "
+                             + m_path.string());
+  }
+  readFileHeader(stream, m_path, m_rank);
+  const uint64_t fileSize = fs::file_size(m_path);
+  uint64_t end = FileHeaderSize;
+  Record record;
+  while (readRecordHeader(stream, m_rank, fileSize, record)) {
+    callback(record);
+    end = record.end;
+    stream.seekg(static_cast<std::streamoff>(end));
+  }
+  return end;
+}
+
+void RawCaptureFile::replay(
+    uint64_t begin,
+    uint64_t end,
+    SizeType firstRow,
+    const std::shared_ptr<Memory::MemoryObject>& block) const
+{
+  std::ifstream stream(m_path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("Failed to open raw capture file "
+                             + m_path.string());
+  }
+  const uint64_t fileSize = fs::file_size(m_path);
+  const uint64_t headerSize = getRecordHeaderSize(m_rank);
+  const SizeType numRows = (m_rank == 0) ? 1 : block->shape[0];
+  Memory::MemoryRecordingData writer(block);
+  std::vector<unsigned char> data;
+  Record record;
+  stream.seekg(static_cast<std::streamoff>(begin));
+  while (static_cast<uint64_t>(stream.tellg()) < end
+         && readRecordHeader(stream, m_rank, fileSize, record))
+  {
+    // Determine the rows of the record within the block
+    SizeArray shape = record.shape;
+    SizeArray offset = record.offset;
+    SizeType skipRows = 0;
+    SizeType rows = 1;
+    SizeType rowElements = getBlockElements(shape);
+    if (m_rank > 0) {
+      const SizeType recordRows = (shape[0] == 0) ? 1 : shape[0];
+      const SizeType first = std::max(offset[0], firstRow);
+      const SizeType last =
+          std::min(offset[0] + recordRows, firstRow + numRows);
+      if (first >= last) {
+        stream.seekg(static_cast<std::streamoff>(record.end));
+        continue;
+      }
+      skipRows = first - offset[0];
+      rows = last - first;
+      rowElements /= recordRows;
+      shape[0] = rows;
+      offset[0] = first - firstRow;
+    }
+
+    // Read only the data of these rows for numeric records
+    const SizeType typeSize = Memory::MemoryIO::getTypeSize(record.type);
+    const bool isString = (typeSize == 0);
+    uint64_t dataPosition = record.position + headerSize;
+    uint64_t dataBytes = record.end - dataPosition;
+    if (!isString) {
+      dataPosition += skipRows * rowElements * typeSize;
+      dataBytes = rows * rowElements * typeSize;
+    }
+    data.resize(dataBytes);
+    stream.seekg(static_cast<std::streamoff>(dataPosition));
+    stream.read(reinterpret_cast<char*>(data.data()),
+                static_cast<std::streamsize>(dataBytes));
+    if (!stream) {
+      throw std::runtime_error("Failed to read raw capture file "
+                               + m_path.string());
+    }
+    stream.seekg(static_cast<std::streamoff>(record.end));
+
+    Status status = Status::Success;
+    if (isString) {
+      std::vector<std::string> strings =
+          decodeStrings(data, getBlockElements(record.shape));
+      strings.erase(strings.begin(),
+                    strings.begin()
+                        + static_cast<std::ptrdiff_t>(skipRows * rowElements));
+      strings.resize(rows * rowElements);
+      status = writer.writeDataBlock(shape, offset, record.type, strings);
+    } else {
+      status = writer.writeDataBlock(shape, offset, record.type, data.data());
+    }
+    if (status != Status::Success) {
+      throw std::runtime_error("Invalid record in raw capture file "
+                               + m_path.string());
+    }
+  }
+}
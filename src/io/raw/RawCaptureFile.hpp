@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+
+/*!
+ * \namespace AQNWB::IO::Raw
+ * \brief Namespace for all components of the raw capture I/O backend
+ */
+namespace AQNWB::IO::Raw
+{
+/**
+ * @brief The binary log of the data blocks written to one dataset of a raw
+ * capture.
+ *
+ * The file starts with a header, i.e., the magic `AQNWBRAW`, the version of
+ * the format, and the rank of the dataset. It is followed by one record per
+ * block written. A record holds the data type, shape, and position of the
+ * block and the number of bytes of its data, followed by the data in the
+ * type it was written with, i.e., without conversion. Strings are stored as
+ * their length followed by their characters. All values are stored in the
+ * native byte order.
+ *
+ * Appending a block is a sequential buffered write of the record. Records
+ * that were only partially written, e.g., because the acquisition crashed,
+ * are ignored when reading the log and are removed when the log is opened
+ * for appending.
+ */
+class RawCaptureFile
+{
+public:
+  /**
+   * @brief A block of data in the log
+   */
+  struct Record
+  {
+    /**
+     * @brief The data type the block was written with
+     */
+    BaseDataType type;
+
+    /**
+     * @brief The shape of the block. Like in HDF5, dimensions of size 0 are
+     * written as a single element.
+     */
+    SizeArray shape;
+
+    /**
+     * @brief The position of the block in the dataset
+     */
+    SizeArray offset;
+
+    /**
+     * @brief The position of the record in the file
+     */
+    uint64_t position = 0;
+
+    /**
+     * @brief The position of the end of the record in the file
+     */
+    uint64_t end = 0;
+  };
+
+  /**
+   * @brief Constructor. The file is not opened until create() or
+   * openForAppend() is called.
+   * @param path The path of the file
+   * @param rank The rank of the dataset
+   */
+  RawCaptureFile(std::filesystem::path path, SizeType rank);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  RawCaptureFile(const RawCaptureFile&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  RawCaptureFile& operator=(const RawCaptureFile&) = delete;
+
+  /**
+   * @brief Destructor. Flushes and closes the file.
+   */
+  ~RawCaptureFile();
+
+  /**
+   * @brief Create an empty log, replacing an existing file
+   * @return The status of the operation
+   */
+  Status create();
+
+  /**
+   * @brief Open an existing log for appending. A partially written record
+   * at the end of the log is removed.
+   * @return The status of the operation
+   */
+  Status openForAppend();
+
+  /**
+   * @brief Append a block of numeric data
+   * @param shape The shape of the block
+   * @param offset The position of the block in the dataset
+   * @param type The numeric type of the values
+   * @param data The values of the block in row-major order
+   * @return The status of the operation
+   */
+  Status append(const SizeArray& shape,
+                const SizeArray& offset,
+                const BaseDataType& type,
+                const void* data);
+
+  /**
+   * @brief Append a block of strings
+   * @param shape The shape of the block
+   * @param offset The position of the block in the dataset
+   * @param type The string type, V_STR or T_STR
+   * @param data The strings of the block in row-major order
+   * @return The status of the operation
+   */
+  Status appendStrings(const SizeArray& shape,
+                       const SizeArray& offset,
+                       const BaseDataType& type,
+                       const std::vector<std::string>& data);
+
+  /**
+   * @brief Write buffered records to the file
+   * @return The status of the operation
+   */
+  Status flush();
+
+  /**
+   * @brief Flush and close the file
+   * @return The status of the operation
+   */
+  Status close();
+
+  /**
+   * @brief Read the headers of all complete records
+   * @param callback Function called with each record in the order of the log
+   * @return The position of the end of the last complete record
+   * @throws std::runtime_error if the file cannot be read or is not a log of
+   * a dataset with the rank of this log
+   */
+  uint64_t scan(const std::function<void(const Record&)>& callback) const;
+
+  /**
+   * @brief Write the records in a range of the log to a block of rows of the
+   * dataset, converting the values to the type of the block.
+   * @param begin The position of the first record
+   * @param end The end of the range. Partially written records at the end of
+   * the log are ignored.
+   * @param firstRow The index along the first dimension of the first row of
+   * the block
+   * @param block The block with the full size of all other dimensions of the
+   * dataset and a fixed shape. Parts of records outside of the block are
+   * skipped.
+   * @throws std::runtime_error if the file cannot be read
+   */
+  void replay(uint64_t begin,
+              uint64_t end,
+              SizeType firstRow,
+              const std::shared_ptr<Memory::MemoryObject>& block) const;
+
+  /**
+   * @brief Get the position of the first record in the file
+   */
+  uint64_t getFirstRecordPosition() const;
+
+  /**
+   * @brief Get the path of the file
+   */
+  inline const std::filesystem::path& getPath() const { return m_path; }
+
+  /**
+   * @brief Get the rank of the dataset
+   */
+  inline SizeType getRank() const { return m_rank; }
+
+private:
+  /**
+   * @brief Write the header of a record and the data. Must be called with
+   * m_mutex locked.
+   */
+  Status appendRecord(const SizeArray& shape,
+                      const SizeArray& offset,
+                      const BaseDataType& type,
+                      const void* data,
+                      uint64_t dataBytes);
+
+  /**
+   * @brief Open the file for appending with the write buffer. Must be called
+   * with m_mutex locked.
+   */
+  Status openStream(const char* mode);
+
+  /**
+   * @brief The path of the file
+   */
+  std::filesystem::path m_path;
+
+  /**
+   * @brief The rank of the dataset
+   */
+  SizeType m_rank = 0;
+
+  /**
+   * @brief The file, or nullptr if it is not open for appending
+   */
+  std::FILE* m_file = nullptr;
+
+  /**
+   * @brief The buffer of m_file
+   */
+  std::vector<char> m_buffer;
+
+  /**
+   * @brief Reused buffer for record headers
+   */
+  std::vector<unsigned char> m_header;
+
+  /**
+   * @brief Reused buffer for the encoded strings of a record
+   */
+  std::vector<unsigned char> m_strings;
+
+  /**
+   * @brief Mutex serializing appends, flushes, and closing
+   */
+  mutable std::mutex m_mutex;
+};
+}  // namespace AQNWB::IO::Raw
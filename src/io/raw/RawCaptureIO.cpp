@@ -0,0 +1,663 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "io/raw/RawCaptureIO.hpp"
+
+#include "Tracing.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "io/raw/RawCaptureRecordingData.hpp"
+#include "io/zarr/ZarrArray.hpp"
+#include "io/zarr/ZarrJson.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Raw;
+using Memory::MemoryAttribute;
+using Memory::MemoryObject;
+using Zarr::JsonValue;
+using Zarr::ZarrArray;
+namespace fs = std::filesystem;
+
+namespace
+{
+/**
+ * @brief The file holding the object tree of a capture
+ */
+constexpr const char* ManifestFile = "manifest.json";
+
+/**
+ * @brief The directory holding the logs of the recorded datasets
+ */
+constexpr const char* DataDirectory = "data";
+
+/**
+ * @brief The format name in the manifest
+ */
+constexpr const char* ManifestFormat = "aqnwb-raw-capture";
+
+/**
+ * @brief The version of the manifest and log format
+ */
+constexpr int64_t ManifestVersion = 1;
+
+/**
+ * @brief Get the native byte order, which is the byte order of the logs
+ */
+const char* getByteOrder()
+{
+  const uint16_t value = 1;
+  unsigned char first = 0;
+  std::memcpy(&first, &value, 1);
+  return (first == 1) ? "little" : "big";
+}
+
+/**
+ * @brief Get a member of a JSON object of the manifest
+ * @throws std::runtime_error if the member does not exist
+ */
+const JsonValue& getMember(const JsonValue& value, const char* key)
+{
+  const JsonValue* member = value.find(key);
+  if (member == nullptr) {
+    throw std::runtime_error(std::string("missing member '") + key + "'");
+  }
+  return *member;
+}
+
+/**
+ * @brief Convert a shape to JSON
+ */
+JsonValue shapeToJson(const SizeArray& shape)
+{
+  JsonValue json = JsonValue::array();
+  for (SizeType dim : shape) {
+    json.push(JsonValue::fromUInt(dim));
+  }
+  return json;
+}
+
+/**
+ * @brief Read a shape from JSON
+ */
+SizeArray shapeFromJson(const JsonValue& json)
+{
+  SizeArray shape;
+  for (const JsonValue& dim : json.getElements()) {
+    shape.push_back(static_cast<SizeType>(dim.toUInt()));
+  }
+  return shape;
+}
+
+/**
+ * @brief Get the data type of a dataset or attribute in the manifest
+ */
+BaseDataType dataTypeFromJson(const JsonValue& json)
+{
+  BaseDataType type;
+  if (!ZarrArray::parseZarrDataType(getMember(json, "dtype").getText(), type))
+  {
+    throw std::runtime_error("unsupported dtype "
+                             + getMember(json, "dtype").getText());
+  }
+  return type;
+}
+
+/**
+ * @brief Convert the values of a dataset or attribute to JSON. Numeric
+ * values are written with enough digits to be restored exactly.
+ */
+JsonValue valuesToJson(const BaseDataType& type,
+                       const std::vector<unsigned char>& values,
+                       const std::vector<std::string>& strings)
+{
+  JsonValue json = JsonValue::array();
+  bool isNumeric = Memory::visitNumericType(
+      type.type,
+      [&](auto typeTag)
+      {
+        using T = typename decltype(typeTag)::type;
+        const SizeType numElements = values.size() / sizeof(T);
+        for (SizeType i = 0; i < numElements; ++i) {
+          T value;
+          std::memcpy(&value, values.data() + i * sizeof(T), sizeof(T));
+          if constexpr (std::is_floating_point_v<T>) {
+            json.push(JsonValue::fromDouble(
+                value, std::numeric_limits<T>::max_digits10));
+          } else if constexpr (std::is_signed_v<T>) {
+            json.push(JsonValue::fromInt(value));
+          } else {
+            json.push(JsonValue::fromUInt(value));
+          }
+        }
+      });
+  if (!isNumeric) {
+    for (const std::string& str : strings) {
+      json.push(JsonValue::string(str));
+    }
+  }
+  return json;
+}
+
+/**
+ * @brief Read the values of a dataset or attribute from JSON
+ */
+void valuesFromJson(const JsonValue& json,
+                    const BaseDataType& type,
+                    std::vector<unsigned char>& values,
+                    std::vector<std::string>& strings)
+{
+  const auto& elements = json.getElements();
+  bool isNumeric = Memory::visitNumericType(
+      type.type,
+      [&](auto typeTag)
+      {
+        using T = typename decltype(typeTag)::type;
+        values.resize(elements.size() * sizeof(T));
+        for (SizeType i = 0; i < elements.size(); ++i) {
+          T value;
+          if constexpr (std::is_floating_point_v<T>) {
+            value = static_cast<T>(elements[i].toDouble());
+          } else if constexpr (std::is_signed_v<T>) {
+            value = static_cast<T>(elements[i].toInt());
+          } else {
+            value = static_cast<T>(elements[i].toUInt());
+          }
+          std::memcpy(values.data() + i * sizeof(T), &value, sizeof(T));
+        }
+      });
+  if (!isNumeric) {
+    for (const JsonValue& element : elements) {
+      if (element.getKind() != JsonValue::Kind::String) {
+        throw std::runtime_error("string value expected");
+      }
+      strings.push_back(element.getText());
+    }
+  }
+}
+
+/**
+ * @brief Convert an attribute to JSON
+ */
+JsonValue attributeToJson(const MemoryAttribute& attribute)
+{
+  JsonValue json = JsonValue::object();
+  json.set("dtype",
+           JsonValue::string(ZarrArray::getZarrDataType(attribute.dataType)));
+  json.set("shape", shapeToJson(attribute.shape));
+  json.set("reference", JsonValue::boolean(attribute.isReference));
+  json.set(
+      "values",
+      valuesToJson(attribute.dataType, attribute.values, attribute.strings));
+  return json;
+}
+
+/**
+ * @brief Read an attribute from JSON
+ */
+MemoryAttribute attributeFromJson(const JsonValue& json)
+{
+  MemoryAttribute attribute;
+  attribute.dataType = dataTypeFromJson(json);
+  attribute.shape = shapeFromJson(getMember(json, "shape"));
+  attribute.isReference = getMember(json, "reference").getBool();
+  valuesFromJson(getMember(json, "values"),
+                 attribute.dataType,
+                 attribute.values,
+                 attribute.strings);
+  return attribute;
+}
+
+/**
+ * @brief Convert an object and its children to JSON
+ * @param object The object
+ * @param getLogName Function returning the name of the log of a recorded
+ * dataset, or an empty string for datasets held in memory
+ */
+JsonValue objectToJson(
+    const MemoryObject& object,
+    const std::function<std::string(const MemoryObject&)>& getLogName)
+{
+  JsonValue json = JsonValue::object();
+  switch (object.kind) {
+    case MemoryObject::Kind::Link:
+      json.set("kind", JsonValue::string("link"));
+      json.set("target", JsonValue::string(object.linkTarget));
+      return json;
+    case MemoryObject::Kind::Group: {
+      json.set("kind", JsonValue::string("group"));
+      JsonValue children = JsonValue::object();
+      for (const auto& [name, child] : object.children) {
+        children.set(name, objectToJson(*child, getLogName));
+      }
+      json.set("children", std::move(children));
+      break;
+    }
+    case MemoryObject::Kind::Dataset: {
+      json.set("kind", JsonValue::string("dataset"));
+      json.set("dtype",
+               JsonValue::string(ZarrArray::getZarrDataType(object.dataType)));
+      json.set("shape", shapeToJson(object.shape));
+      json.set("chunking", shapeToJson(object.chunking));
+      json.set("reference", JsonValue::boolean(object.isReference));
+      std::string logName = getLogName(object);
+      if (!logName.empty()) {
+        json.set("file", JsonValue::string(logName));
+      } else {
+        json.set("values",
+                 valuesToJson(object.dataType, object.values, object.strings));
+      }
+      break;
+    }
+  }
+  JsonValue attributes = JsonValue::object();
+  for (const auto& [name, attribute] : object.attributes) {
+    attributes.set(name, attributeToJson(attribute));
+  }
+  json.set("attributes", std::move(attributes));
+  return json;
+}
+
+/**
+ * @brief Read an object and its children from JSON
+ * @param json The JSON of the object
+ * @param recorded The recorded datasets and the names of their logs (return
+ * value)
+ */
+std::shared_ptr<MemoryObject> objectFromJson(
+    const JsonValue& json,
+    std::vector<std::pair<std::shared_ptr<MemoryObject>, std::string>>&
+        recorded)
+{
+  auto object = std::make_shared<MemoryObject>();
+  const std::string& kind = getMember(json, "kind").getText();
+  if (kind == "link") {
+    object->kind = MemoryObject::Kind::Link;
+    object->linkTarget = getMember(json, "target").getText();
+    return object;
+  }
+  if (kind == "group") {
+    object->kind = MemoryObject::Kind::Group;
+    for (const auto& [name, child] : getMember(json, "children").getMembers())
+    {
+      object->children[name] = objectFromJson(child, recorded);
+    }
+  } else if (kind == "dataset") {
+    object->kind = MemoryObject::Kind::Dataset;
+    object->dataType = dataTypeFromJson(json);
+    object->shape = shapeFromJson(getMember(json, "shape"));
+    object->chunking = shapeFromJson(getMember(json, "chunking"));
+    object->isReference = getMember(json, "reference").getBool();
+    if (const JsonValue* file = json.find("file")) {
+      recorded.emplace_back(object, file->getText());
+    } else {
+      valuesFromJson(getMember(json, "values"),
+                     object->dataType,
+                     object->values,
+                     object->strings);
+    }
+  } else {
+    throw std::runtime_error("unknown object kind " + kind);
+  }
+  for (const auto& [name, attribute] :
+       getMember(json, "attributes").getMembers())
+  {
+    object->attributes[name] = attributeFromJson(attribute);
+  }
+  return object;
+}
+}  // namespace
+
+RawCaptureIO::RawCaptureIO(const std::string& directory)
+    : MemoryIO(directory)
+{
+}
+
+RawCaptureIO::~RawCaptureIO()
+{
+  if (m_opened) {
+    close();
+  }
+}
+
+Status RawCaptureIO::open()
+{
+  std::error_code error;
+  return open(fs::exists(fs::path(getFileName()) / ManifestFile, error)
+                  ? FileMode::ReadWrite
+                  : FileMode::Overwrite);
+}
+
+Status RawCaptureIO::open(FileMode mode)
+{
+  TraceScope trace("RawCaptureIO::open", "io");
+  if (m_opened) {
+    return Status::Failure;
+  }
+
+  const fs::path root(getFileName());
+  std::error_code error;
+  const bool isCapture = fs::exists(root / ManifestFile, error);
+  switch (mode) {
+    case FileMode::Overwrite:
+      if (fs::exists(root, error)) {
+        // only replace captures, never other data
+        if (!isCapture
+            && !(fs::is_directory(root, error) && fs::is_empty(root, error)))
+        {
+          std::cerr << "RawCaptureIO::open cannot overwrite " << root
+                    << " because it is not a raw capture" << std::endl;
+          return Status::Failure;
+        }
+        fs::remove_all(root, error);
+      }
+      fs::create_directories(root / DataDirectory, error);
+      if (error || MemoryIO::open(FileMode::Overwrite) != Status::Success) {
+        std::cerr << "RawCaptureIO::open failed to create " << root
+                  << std::endl;
+        return Status::Failure;
+      }
+      m_dataSets.clear();
+      if (writeManifest() != Status::Success) {
+        MemoryIO::close();
+        return Status::Failure;
+      }
+      return Status::Success;
+    case FileMode::ReadWrite:
+    case FileMode::ReadOnly:
+      if (!isCapture
+          || readManifest(mode == FileMode::ReadWrite) != Status::Success)
+      {
+        return Status::Failure;
+      }
+      return MemoryIO::open(mode);
+    default:
+      throw std::invalid_argument("Invalid file mode");
+  }
+}
+
+Status RawCaptureIO::close()
+{
+  Status status = Status::Success;
+  if (m_opened && canModifyObjects()) {
+    status = flush();
+  }
+  status = MemoryIO::close() && status;
+  for (const auto& [dataset, raw] : m_dataSets) {
+    status = raw.file->close() && status;
+  }
+  m_dataSets.clear();
+  m_root = nullptr;
+  return status;
+}
+
+Status RawCaptureIO::flush()
+{
+  TraceScope trace("RawCaptureIO::flush", "io");
+  if (!m_opened) {
+    return Status::Failure;
+  }
+  if (!canModifyObjects()) {
+    return Status::Success;
+  }
+  // Flush the logs first, such that the manifest never holds shapes beyond
+  // the data on disk
+  Status status = Status::Success;
+  for (const auto& [dataset, raw] : m_dataSets) {
+    status = raw.file->flush() && status;
+  }
+  return writeManifest() && status;
+}
+
+Status RawCaptureIO::writeManifest() const
+{
+  TraceScope trace("RawCaptureIO::writeManifest", "io");
+  JsonValue manifest = JsonValue::object();
+  manifest.set("format", JsonValue::string(ManifestFormat));
+  manifest.set("version", JsonValue::fromInt(ManifestVersion));
+  manifest.set("byte_order", JsonValue::string(getByteOrder()));
+  manifest.set("root",
+               objectToJson(*m_root,
+                            [this](const MemoryObject& dataset)
+                            {
+                              const RawDataSet* raw = findRawDataSet(&dataset);
+                              return raw ? raw->fileName : std::string();
+                            }));
+  const fs::path path = fs::path(getFileName()) / ManifestFile;
+  if (!Zarr::writeFile(path, manifest.dump(4))) {
+    std::cerr << "RawCaptureIO failed to write " << path << std::endl;
+    return Status::Failure;
+  }
+  return Status::Success;
+}
+
+Status RawCaptureIO::readManifest(bool append)
+{
+  TraceScope trace("RawCaptureIO::readManifest", "io");
+  const fs::path root(getFileName());
+  std::shared_ptr<MemoryObject> rootGroup;
+  std::map<const MemoryObject*, RawDataSet> dataSets;
+  try {
+    JsonValue manifest = Zarr::readJsonFile(root / ManifestFile);
+    if (getMember(manifest, "format").getText() != ManifestFormat
+        || getMember(manifest, "version").toInt() != ManifestVersion)
+    {
+      throw std::runtime_error("unsupported format");
+    }
+    if (getMember(manifest, "byte_order").getText() != getByteOrder()) {
+      throw std::runtime_error(
+          "the capture was recorded with a different byte order");
+    }
+    std::vector<std::pair<std::shared_ptr<MemoryObject>, std::string>>
+        recorded;
+    rootGroup = objectFromJson(getMember(manifest, "root"), recorded);
+    if (rootGroup->kind != MemoryObject::Kind::Group) {
+      throw std::runtime_error("the root is not a group");
+    }
+
+    // The logs may hold records written after the manifest was saved
+    for (const auto& [dataset, fileName] : recorded) {
+      auto file = std::make_shared<RawCaptureFile>(root / fileName,
+                                                   dataset->shape.size());
+      SizeArray& shape = dataset->shape;
+      file->scan(
+          [&shape](const RawCaptureFile::Record& record)
+          {
+            for (SizeType d = 0; d < shape.size(); ++d) {
+              shape[d] = std::max(shape[d], record.offset[d] + record.shape[d]);
+            }
+          });
+      if (append && file->openForAppend() != Status::Success) {
+        throw std::runtime_error("failed to open " + fileName);
+      }
+      dataSets[dataset.get()] = RawDataSet {fileName, std::move(file)};
+    }
+  } catch (const std::runtime_error& e) {
+    std::cerr << "RawCaptureIO failed to read " << root << ": " << e.what()
+              << std::endl;
+    return Status::Failure;
+  }
+  m_root = std::move(rootGroup);
+  m_dataSets = std::move(dataSets);
+  return Status::Success;
+}
+
+const RawCaptureIO::RawDataSet* RawCaptureIO::findRawDataSet(
+    const MemoryObject* dataset) const
+{
+  auto it = m_dataSets.find(dataset);
+  return (it == m_dataSets.end()) ? nullptr : &it->second;
+}
+
+template<typename Read>
+DataBlockGeneric RawCaptureIO::readRawDataSet(const std::string& dataPath,
+                                              Read&& read)
+{
+  auto dataset = findObject(dataPath);
+  const RawDataSet* raw = (dataset != nullptr) ? findRawDataSet(dataset.get())
+                                               : nullptr;
+  if (raw == nullptr) {
+    return read();
+  }
+
+  // Replay the log into a buffer with the current shape of the dataset
+  raw->file->flush();
+  auto block = std::make_shared<MemoryObject>();
+  block->kind = MemoryObject::Kind::Dataset;
+  block->dataType = dataset->dataType;
+  block->shape = dataset->shape;
+  const SizeType typeSize = getTypeSize(dataset->dataType);
+  if (typeSize == 0) {
+    block->strings.resize(block->getNumElements());
+  } else {
+    block->values.resize(block->getNumElements() * typeSize);
+  }
+  raw->file->replay(raw->file->getFirstRecordPosition(),
+                    std::numeric_limits<uint64_t>::max(),
+                    0,
+                    block);
+
+  // Lend the values to the dataset for the read of MemoryIO
+  struct ValuesGuard
+  {
+    MemoryObject& dataset;
+    ~ValuesGuard()
+    {
+      dataset.values = std::vector<unsigned char>();
+      dataset.strings = std::vector<std::string>();
+    }
+  } guard {*dataset};
+  dataset->values.swap(block->values);
+  dataset->strings.swap(block->strings);
+  return read();
+}
+
+DataBlockGeneric RawCaptureIO::readDataset(const std::string& dataPath,
+                                           const SizeArray& start,
+                                           const SizeArray& count,
+                                           const SizeArray& stride,
+                                           const SizeArray& block)
+{
+  TraceScope trace("RawCaptureIO::readDataset", "io");
+  return readRawDataSet(
+      dataPath,
+      [&]()
+      { return MemoryIO::readDataset(dataPath, start, count, stride, block); });
+}
+
+DataBlockGeneric RawCaptureIO::readDatasetSelection(
+    const std::string& dataPath, const std::vector<SizeArray>& selection)
+{
+  TraceScope trace("RawCaptureIO::readDatasetSelection", "io");
+  return readRawDataSet(
+      dataPath,
+      [&]() { return MemoryIO::readDatasetSelection(dataPath, selection); });
+}
+
+Status RawCaptureIO::startRecording()
+{
+  Status status = MemoryIO::startRecording();
+  if (status != Status::Success) {
+    return status;
+  }
+  return flush();
+}
+
+Status RawCaptureIO::stopRecording()
+{
+  Status status = MemoryIO::stopRecording();
+  if (m_opened && canModifyObjects()) {
+    status = flush() && status;
+  }
+  return status;
+}
+
+std::unique_ptr<BaseRecordingData> RawCaptureIO::createArrayDataSet(
+    const BaseArrayDataSetConfig& config, const std::string& path)
+{
+  TraceScope trace("RawCaptureIO::createArrayDataSet", "io");
+  std::unique_ptr<BaseRecordingData> placeholder =
+      MemoryIO::createArrayDataSet(config, path);
+  if (placeholder == nullptr) {
+    return nullptr;  // links
+  }
+
+  // Only the shape of the dataset is kept in memory
+  auto dataset = findObject(path);
+  const SizeType numBytes = dataset->values.size();
+  const SizeType numStrings = dataset->strings.size();
+  dataset->values = std::vector<unsigned char>();
+  dataset->strings = std::vector<std::string>();
+
+  const fs::path root(getFileName());
+  std::string fileName;
+  SizeType index = m_dataSets.size();
+  std::error_code error;
+  do {
+    fileName = std::string(DataDirectory) + "/" + std::to_string(index++)
+        + ".raw";
+  } while (fs::exists(root / fileName, error));
+  auto file =
+      std::make_shared<RawCaptureFile>(root / fileName, dataset->shape.size());
+  if (file->create() != Status::Success) {
+    // keep the dataset valid as a dataset in memory
+    dataset->values.resize(numBytes);
+    dataset->strings.resize(numStrings);
+    throw std::runtime_error("Failed to create the log of dataset '" + path
+                             + "'");
+  }
+  m_dataSets[dataset.get()] = RawDataSet {fileName, file};
+
+  auto recordingData =
+      std::make_unique<RawCaptureRecordingData>(dataset, std::move(file));
+  recordingData->setWriteStatistics(m_writeStatistics, path);
+  return recordingData;
+}
+
+std::shared_ptr<BaseRecordingData> RawCaptureIO::getDataSet(
+    const std::string& path)
+{
+  auto dataset = findObject(path);
+  const RawDataSet* raw =
+      (dataset != nullptr) ? findRawDataSet(dataset.get()) : nullptr;
+  if (raw == nullptr) {
+    return MemoryIO::getDataSet(path);
+  }
+  auto recordingData =
+      std::make_shared<RawCaptureRecordingData>(dataset, raw->file);
+  recordingData->setWriteStatistics(m_writeStatistics, path);
+  return recordingData;
+}
+
+Status RawCaptureIO::exportArrayDataSet(const MemoryObject& dataset,
+                                        const std::string& path,
+                                        BaseIO& target) const
+{
+  const RawDataSet* raw = findRawDataSet(&dataset);
+  if (raw == nullptr) {
+    return MemoryIO::exportArrayDataSet(dataset, path, target);
+  }
+  return packDataSet(*raw->file, dataset, path, target, m_packOptions);
+}
+
+Status RawCaptureIO::pack(const std::string& nwbPath,
+                          const PackOptions& options)
+{
+  TraceScope trace("RawCaptureIO::pack", "io");
+  if (!m_opened) {
+    return Status::Failure;
+  }
+  if (canModifyObjects() && flush() != Status::Success) {
+    return Status::Failure;
+  }
+  m_packOptions = options;
+  HDF5::HDF5IO target(nwbPath);
+  if (target.open(FileMode::Overwrite) != Status::Success) {
+    return Status::Failure;
+  }
+  Status status = exportTo(target);
+  return target.close() && status;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/ReadIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/raw/RawCaptureFile.hpp"
+#include "io/raw/RawCapturePacker.hpp"
+
+namespace AQNWB::IO::Raw
+{
+/**
+ * @brief The RawCaptureIO class records NWB files as a directory of flat
+ * binary logs, one per recorded dataset, plus a small manifest, to minimize
+ * the cost of acquisition. The capture is converted to an HDF5 NWB file
+ * afterwards via pack, or with the `aqnwb_pack` tool.
+ *
+ * Groups, attributes, links, and datasets written at once, e.g., string
+ * datasets, are kept in memory like in MemoryIO and are saved in
+ * `manifest.json` on flush, startRecording, stopRecording, and close.
+ * Datasets created via createArrayDataSet only keep their shape in memory.
+ * Every block written to them is appended unchanged as a record to the log
+ * `data/<n>.raw` of the dataset (see RawCaptureFile), i.e., acquisition only
+ * copies the block into a write buffer. Values are converted to the type of
+ * the dataset when reading or packing.
+ *
+ * Captures can be reopened with FileMode::ReadWrite to continue recording,
+ * e.g., after a crash. Records that were only partially written are
+ * discarded and the shapes of the datasets are restored from the logs.
+ * Captures are not portable between machines of different byte order.
+ */
+class RawCaptureIO : public Memory::MemoryIO
+{
+public:
+  /**
+   * @brief Constructor for the RawCaptureIO class.
+   * @param directory The path of the directory of the capture.
+   */
+  explicit RawCaptureIO(const std::string& directory);
+
+  /**
+   * @brief Destructor. Flushes and closes the capture if it is open.
+   */
+  ~RawCaptureIO() override;
+
+  /**
+   * @brief Opens an existing capture for reading and writing, or creates a
+   * new capture if the directory does not exist.
+   * @return The status of the file opening operation.
+   */
+  Status open() override;
+
+  /**
+   * @brief Opens an existing capture or creates a new capture.
+   * @param mode Access mode to use when opening the file. Overwrite replaces
+   * an existing capture, but fails for directories that are not empty and not
+   * a capture. ReadWrite and ReadOnly fail if there is no capture.
+   * @return The status of the file opening operation.
+   */
+  Status open(FileMode mode) override;
+
+  /**
+   * @brief Flushes all logs, saves the manifest, and closes the capture.
+   * @return The status of the file closing operation.
+   */
+  Status close() override;
+
+  /**
+   * @brief Writes buffered records to the logs and saves the manifest.
+   * @return The status of the flush operation.
+   */
+  Status flush() override;
+
+  /**
+   * @brief Reads a dataset or a slice of a dataset. Recorded datasets are
+   * read from their log.
+   * @copydetails Memory::MemoryIO::readDataset
+   */
+  DataBlockGeneric readDataset(const std::string& dataPath,
+                               const SizeArray& start = {},
+                               const SizeArray& count = {},
+                               const SizeArray& stride = {},
+                               const SizeArray& block = {}) override;
+
+  /**
+   * @brief Reads an arbitrary selection of a dataset. Recorded datasets are
+   * read from their log.
+   * @copydetails Memory::MemoryIO::readDatasetSelection
+   */
+  DataBlockGeneric readDatasetSelection(
+      const std::string& dataPath,
+      const std::vector<SizeArray>& selection) override;
+
+  /**
+   * @brief Starts the recording process and saves the manifest.
+   * @return The status of the operation. Fails if the file is not open.
+   */
+  Status startRecording() override;
+
+  /**
+   * @brief Stops the recording process and flushes the capture. The capture
+   * stays open.
+   * @return The status of the operation.
+   */
+  Status stopRecording() override;
+
+  /**
+   * @brief Creates an extendable dataset that is recorded to its own log.
+   * @param config The configuration for the dataset, including type, shape,
+   * and chunking. Dimensions with chunking larger than 0 can be extended by
+   * writes and are chunked along the first dimension when packing. Can also
+   * be a LinkArrayDataSetConfig to create a soft-link.
+   * @param path The location in the file of the new dataset.
+   * @return A pointer to the created dataset. Returns nullptr for links.
+   * @throws std::runtime_error if dataset or link creation fails.
+   */
+  std::unique_ptr<BaseRecordingData> createArrayDataSet(
+      const BaseArrayDataSetConfig& config, const std::string& path) override;
+
+  /**
+   * @brief Returns a pointer to a dataset at a given path.
+   * @param path The location in the file of the dataset.
+   * @return A shared pointer to the dataset, or nullptr if the file is not
+   * open or the dataset does not exist.
+   */
+  std::shared_ptr<BaseRecordingData> getDataSet(
+      const std::string& path) override;
+
+  /**
+   * @brief Convert the capture to an NWB file in HDF5.
+   *
+   * The capture is flushed if it is open for writing and must be open.
+   * Recorded datasets are written in parallel blocks with the chunking and
+   * compression of the options (see packDataSet). All other objects are
+   * copied as with exportTo.
+   *
+   * @param nwbPath The path of the HDF5 file to create. Existing files are
+   * overwritten.
+   * @param options The chunking, compression, and number of threads
+   * @return The status of the operation
+   */
+  Status pack(const std::string& nwbPath,
+              const PackOptions& options = PackOptions());
+
+protected:
+  /**
+   * @brief Export a dataset, packing recorded datasets from their log.
+   * @copydetails Memory::MemoryIO::exportArrayDataSet
+   */
+  Status exportArrayDataSet(const Memory::MemoryObject& dataset,
+                            const std::string& path,
+                            BaseIO& target) const override;
+
+private:
+  /**
+   * @brief The log of a recorded dataset
+   */
+  struct RawDataSet
+  {
+    /**
+     * @brief The path of the log relative to the capture directory
+     */
+    std::string fileName;
+
+    /**
+     * @brief The log
+     */
+    std::shared_ptr<RawCaptureFile> file;
+  };
+
+  /**
+   * @brief Save the object tree to the manifest
+   * @return The status of the operation
+   */
+  Status writeManifest() const;
+
+  /**
+   * @brief Load the object tree from the manifest and open the logs of the
+   * recorded datasets
+   * @param append Whether to open the logs for appending
+   * @return The status of the operation
+   */
+  Status readManifest(bool append);
+
+  /**
+   * @brief Find the log of a recorded dataset
+   * @return The log or nullptr if the object is not a recorded dataset
+   */
+  const RawDataSet* findRawDataSet(const Memory::MemoryObject* dataset) const;
+
+  /**
+   * @brief Read the values of a recorded dataset from its log into the
+   * dataset, call a read function of MemoryIO, and release the values again
+   */
+  template<typename Read>
+  DataBlockGeneric readRawDataSet(const std::string& dataPath, Read&& read);
+
+  /**
+   * @brief The logs of the recorded datasets
+   */
+  std::map<const Memory::MemoryObject*, RawDataSet> m_dataSets;
+
+  /**
+   * @brief The options used by exportArrayDataSet while packing
+   */
+  PackOptions m_packOptions;
+};
+}  // namespace AQNWB::IO::Raw
@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "io/raw/RawCapturePacker.hpp"
+
+#include <H5Cpp.h>
+
+#include "Tracing.hpp"
+#include "io/hdf5/HDF5ArrayDataSetConfig.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "io/hdf5/HDF5RecordingData.hpp"
+
+#ifdef AQNWB_HAVE_ZLIB
+#  include <zlib.h>
+#endif
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Raw;
+using Memory::MemoryIO;
+using Memory::MemoryObject;
+
+namespace
+{
+/**
+ * @brief Whether chunks can be written directly via H5Dwrite_chunk
+ */
+#if H5_VERSION_GE(1, 10, 3)
+constexpr bool DirectChunkWrites = true;
+#else
+constexpr bool DirectChunkWrites = false;
+#endif
+
+/**
+ * @brief Whether the workers can compress chunks with the deflate filter
+ */
+#ifdef AQNWB_HAVE_ZLIB
+constexpr bool DeflateAvailable = true;
+#else
+constexpr bool DeflateAvailable = false;
+#endif
+
+/**
+ * @brief An encoded chunk ready to be written to an HDF5 dataset
+ */
+struct EncodedChunk
+{
+  /**
+   * @brief The position of the first element of the chunk in the dataset
+   */
+  std::vector<hsize_t> offset;
+
+  /**
+   * @brief The filtered bytes of the chunk
+   */
+  std::vector<unsigned char> bytes;
+};
+
+/**
+ * @brief A block of rows of a dataset prepared by a worker thread
+ */
+struct PackedBlock
+{
+  /**
+   * @brief The index along the first dimension of the first row
+   */
+  SizeType firstRow = 0;
+
+  /**
+   * @brief The values of the block, for writes via writeDataBlock
+   */
+  std::shared_ptr<MemoryObject> values;
+
+  /**
+   * @brief The encoded chunks of the block, for direct chunk writes
+   */
+  std::vector<EncodedChunk> chunks;
+
+  /**
+   * @brief The error message if the block could not be prepared
+   */
+  std::string error;
+};
+
+/**
+ * @brief Copy the part of a block of rows within a chunk to a zero-filled
+ * chunk buffer
+ * @param block The block of rows
+ * @param chunkStart The position of the chunk in the block
+ * @param chunkDims The shape of the chunks
+ * @param typeSize The size of one element
+ * @param chunk The chunk buffer (return value)
+ */
+void copyChunk(const MemoryObject& block,
+               const SizeArray& chunkStart,
+               const SizeArray& chunkDims,
+               SizeType typeSize,
+               std::vector<unsigned char>& chunk)
+{
+  const SizeType rank = chunkDims.size();
+  SizeType chunkElements = 1;
+  SizeArray extent(rank), blockStrides(rank, 1), chunkStrides(rank, 1);
+  for (SizeType d = 0; d < rank; ++d) {
+    chunkElements *= chunkDims[d];
+    extent[d] = std::min(chunkDims[d], block.shape[d] - chunkStart[d]);
+  }
+  for (SizeType d = rank - 1; d-- > 0;) {
+    blockStrides[d] = blockStrides[d + 1] * block.shape[d + 1];
+    chunkStrides[d] = chunkStrides[d + 1] * chunkDims[d + 1];
+  }
+  chunk.assign(chunkElements * typeSize, 0);
+
+  // Copy one run along the last dimension per position in the other
+  // dimensions
+  SizeArray position(rank, 0);
+  bool done = false;
+  while (!done) {
+    SizeType source = chunkStart[rank - 1];
+    SizeType target = 0;
+    for (SizeType d = 0; d + 1 < rank; ++d) {
+      source += (chunkStart[d] + position[d]) * blockStrides[d];
+      target += position[d] * chunkStrides[d];
+    }
+    std::memcpy(chunk.data() + target * typeSize,
+                block.values.data() + source * typeSize,
+                extent[rank - 1] * typeSize);
+    done = true;
+    for (SizeType d = rank - 1; d-- > 0;) {
+      if (++position[d] < extent[d]) {
+        done = false;
+        break;
+      }
+      position[d] = 0;
+    }
+  }
+}
+
+/**
+ * @brief Apply the HDF5 shuffle filter, i.e., group the bytes of all
+ * elements by their significance
+ */
+std::vector<unsigned char> shuffleBytes(const std::vector<unsigned char>& data,
+                                        SizeType typeSize)
+{
+  const SizeType numElements = data.size() / typeSize;
+  std::vector<unsigned char> shuffled(data.size());
+  for (SizeType i = 0; i < numElements; ++i) {
+    for (SizeType j = 0; j < typeSize; ++j) {
+      shuffled[j * numElements + i] = data[i * typeSize + j];
+    }
+  }
+  return shuffled;
+}
+
+/**
+ * @brief Compress data like the HDF5 deflate filter
+ * @throws std::runtime_error if zlib fails
+ */
+std::vector<unsigned char> deflateBytes(const std::vector<unsigned char>& data,
+                                        unsigned int level)
+{
+#ifdef AQNWB_HAVE_ZLIB
+  uLongf size = compressBound(static_cast<uLong>(data.size()));
+  std::vector<unsigned char> compressed(size);
+  if (compress2(compressed.data(),
+                &size,
+                data.data(),
+                static_cast<uLong>(data.size()),
+                static_cast<int>(level))
+      != Z_OK)
+  {
+    throw std::runtime_error("zlib failed to compress a chunk");
+  }
+  compressed.resize(size);
+  return compressed;
+#else
+  (void)level;
+  return data;
+#endif
+}
+}  // namespace
+
+Status AQNWB::IO::Raw::packDataSet(const RawCaptureFile& file,
+                                   const MemoryObject& dataset,
+                                   const std::string& path,
+                                   BaseIO& target,
+                                   const PackOptions& options)
+{
+  TraceScope trace("RawCapture::packDataSet", "io");
+  const SizeArray& shape = dataset.shape;
+  const SizeType rank = shape.size();
+  if (rank == 0) {
+    std::cerr << "packDataSet cannot pack scalar dataset " << path << std::endl;
+    return Status::Failure;
+  }
+  SizeArray chunking = dataset.chunking;
+  chunking.resize(rank, 0);
+  if (options.chunkRows > 0 && chunking[0] > 0) {
+    chunking[0] = options.chunkRows;
+  }
+
+  // Numeric datasets written to HDF5 are compressed and, if possible,
+  // written chunk by chunk
+  const SizeType typeSize = MemoryIO::getTypeSize(dataset.dataType);
+  auto* hdf5Target = dynamic_cast<HDF5::HDF5IO*>(&target);
+  const bool compress =
+      hdf5Target != nullptr && typeSize > 0 && options.compressionLevel > 0;
+  bool writeChunks = hdf5Target != nullptr && typeSize > 0 && DirectChunkWrites
+      && (!compress || DeflateAvailable);
+
+  std::unique_ptr<BaseRecordingData> recordingData;
+  try {
+    if (hdf5Target != nullptr) {
+      HDF5::HDF5ArrayDataSetConfig config(dataset.dataType, shape, chunking);
+      if (compress) {
+        if (options.shuffle) {
+          config.addFilter(HDF5::HDF5FilterConfig::createShuffleFilter());
+        }
+        config.addFilter(
+            HDF5::HDF5FilterConfig::createGzipFilter(options.compressionLevel));
+      }
+      recordingData = target.createArrayDataSet(config, path);
+    } else {
+      ArrayDataSetConfig config(dataset.dataType, shape, chunking);
+      recordingData = target.createArrayDataSet(config, path);
+    }
+  } catch (const std::runtime_error& e) {
+    std::cerr << "packDataSet failed to create dataset " << path << ": "
+              << e.what() << std::endl;
+    return Status::Failure;
+  }
+  if (recordingData == nullptr) {
+    return Status::Failure;
+  }
+  auto* hdf5Data = dynamic_cast<HDF5::HDF5RecordingData*>(recordingData.get());
+  writeChunks = writeChunks && hdf5Data != nullptr;
+
+  // Blocks of rows span one chunk along the first dimension, like HDF5IO
+  // chunks span the whole dimension if its chunking is 0
+  SizeArray chunkDims(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    chunkDims[d] = (chunking[d] > 0) ? chunking[d] : shape[d];
+  }
+  const SizeType blockRows = std::max<SizeType>(chunkDims[0], 1);
+  const SizeType numBlocks = (shape[0] + blockRows - 1) / blockRows;
+  if (numBlocks == 0) {
+    return Status::Success;
+  }
+
+  // Index the ranges of the log with records of each block. Consecutive
+  // records of the same block are merged into one range.
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> ranges(numBlocks);
+  try {
+    file.scan(
+        [&](const RawCaptureFile::Record& record)
+        {
+          const SizeType rows = std::max<SizeType>(record.shape[0], 1);
+          const SizeType first = record.offset[0] / blockRows;
+          const SizeType last = std::min(
+              (record.offset[0] + rows - 1) / blockRows, numBlocks - 1);
+          for (SizeType b = first; b <= last; ++b) {
+            auto& blockRanges = ranges[b];
+            if (!blockRanges.empty()
+                && blockRanges.back().second == record.position)
+            {
+              blockRanges.back().second = record.end;
+            } else {
+              blockRanges.emplace_back(record.position, record.end);
+            }
+          }
+        });
+  } catch (const std::runtime_error& e) {
+    std::cerr << "packDataSet failed to read " << path << ": " << e.what()
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // Prepare a block in a worker thread
+  auto prepareBlock = [&](SizeType index, PackedBlock& packed)
+  {
+    try {
+      packed.firstRow = index * blockRows;
+      auto block = std::make_shared<MemoryObject>();
+      block->kind = MemoryObject::Kind::Dataset;
+      block->dataType = dataset.dataType;
+      block->shape = shape;
+      block->shape[0] = writeChunks
+          ? blockRows
+          : std::min(blockRows, shape[0] - packed.firstRow);
+      if (typeSize == 0) {
+        block->strings.resize(block->getNumElements());
+      } else {
+        block->values.resize(block->getNumElements() * typeSize);
+      }
+      for (const auto& [begin, end] : ranges[index]) {
+        file.replay(begin, end, packed.firstRow, block);
+      }
+      if (!writeChunks) {
+        packed.values = block;
+        return;
+      }
+
+      // Split the block into chunks along all other dimensions
+      SizeArray chunkIndex(rank, 0);
+      std::vector<unsigned char> chunk;
+      bool done = false;
+      while (!done) {
+        SizeArray chunkStart(rank, 0);
+        EncodedChunk encoded;
+        encoded.offset.resize(rank);
+        for (SizeType d = 0; d < rank; ++d) {
+          chunkStart[d] = chunkIndex[d] * chunkDims[d];
+          encoded.offset[d] = static_cast<hsize_t>(chunkStart[d]);
+        }
+        encoded.offset[0] = static_cast<hsize_t>(packed.firstRow);
+        copyChunk(*block, chunkStart, chunkDims, typeSize, chunk);
+        if (compress) {
+          encoded.bytes = deflateBytes(
+              options.shuffle ? shuffleBytes(chunk, typeSize) : chunk,
+              options.compressionLevel);
+        } else {
+          encoded.bytes = chunk;
+        }
+        packed.chunks.push_back(std::move(encoded));
+        done = true;
+        for (SizeType d = rank; d-- > 1;) {
+          if (++chunkIndex[d] * chunkDims[d] < shape[d]) {
+            done = false;
+            break;
+          }
+          chunkIndex[d] = 0;
+        }
+      }
+    } catch (const std::exception& e) {
+      packed.error = e.what();
+    }
+  };
+
+  // Prepare up to one block per thread in parallel, then write the blocks
+  const SizeType numThreads = (options.numThreads > 0)
+      ? options.numThreads
+      : std::max<SizeType>(std::thread::hardware_concurrency(), 1);
+  for (SizeType first = 0; first < numBlocks; first += numThreads) {
+    const SizeType count = std::min(numThreads, numBlocks - first);
+    std::vector<PackedBlock> blocks(count);
+    std::vector<std::thread> threads;
+    for (SizeType i = 1; i < count; ++i) {
+      threads.emplace_back(prepareBlock, first + i, std::ref(blocks[i]));
+    }
+    prepareBlock(first, blocks[0]);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (const PackedBlock& packed : blocks) {
+      if (!packed.error.empty()) {
+        std::cerr << "packDataSet failed to read " << path << ": "
+                  << packed.error << std::endl;
+        return Status::Failure;
+      }
+      if (writeChunks) {
+        const hid_t datasetId = hdf5Data->getDataSet()->getId();
+        for (const EncodedChunk& chunk : packed.chunks) {
+#if H5_VERSION_GE(1, 10, 3)
+          if (H5Dwrite_chunk(datasetId,
+                             H5P_DEFAULT,
+                             0,
+                             chunk.offset.data(),
+                             chunk.bytes.size(),
+                             chunk.bytes.data())
+              < 0)
+          {
+            return Status::Failure;
+          }
+#endif
+        }
+        continue;
+      }
+      const MemoryObject& block = *packed.values;
+      if (block.getNumElements() == 0) {
+        continue;
+      }
+      SizeArray offset(rank, 0);
+      offset[0] = packed.firstRow;
+      Status status = (typeSize == 0)
+          ? recordingData->writeDataBlock(
+              block.shape, offset, block.dataType, block.strings)
+          : recordingData->writeDataBlock(
+              block.shape, offset, block.dataType, block.values.data());
+      if (status != Status::Success) {
+        return Status::Failure;
+      }
+    }
+  }
+  return Status::Success;
+}
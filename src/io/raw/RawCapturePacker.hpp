@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/raw/RawCaptureFile.hpp"
+
+namespace AQNWB::IO::Raw
+{
+/**
+ * @brief Options for converting the recorded datasets of a raw capture
+ */
+struct PackOptions
+{
+  /**
+   * @brief The number of elements per chunk along the first dimension of
+   * extendable datasets, or 0 to keep the chunking of the capture
+   */
+  SizeType chunkRows = 0;
+
+  /**
+   * @brief The gzip (deflate) compression level (1-9) of numeric datasets
+   * written to HDF5, or 0 to store the chunks uncompressed
+   */
+  unsigned int compressionLevel = 4;
+
+  /**
+   * @brief Whether to apply the shuffle filter before compressing
+   */
+  bool shuffle = true;
+
+  /**
+   * @brief The number of worker threads, or 0 for one thread per core
+   */
+  SizeType numThreads = 0;
+};
+
+/**
+ * @brief Create a recorded dataset of a raw capture in another I/O object and
+ * write its data.
+ *
+ * The dataset is processed in blocks of chunks along the first dimension.
+ * Worker threads replay the records of the log overlapping their block,
+ * converting the values to the type of the dataset. For an HDF5IO target,
+ * numeric datasets are chunked and compressed with the shuffle and gzip
+ * filters. The workers also split their block into chunks and compress them,
+ * such that the chunks only need to be written to the file (via
+ * `H5Dwrite_chunk`) while HDF5 holds its global lock. Without zlib support,
+ * the compression is left to HDF5. Other datasets and targets are written
+ * block by block via BaseRecordingData::writeDataBlock.
+ *
+ * @param file The log of the dataset
+ * @param dataset The dataset in the object tree of the capture, with its
+ * final shape
+ * @param path The path of the dataset
+ * @param target The I/O object to write to
+ * @param options The chunking, compression, and number of threads
+ * @return The status of the operation
+ */
+Status packDataSet(const RawCaptureFile& file,
+                   const Memory::MemoryObject& dataset,
+                   const std::string& path,
+                   BaseIO& target,
+                   const PackOptions& options);
+}  // namespace AQNWB::IO::Raw
@@ -0,0 +1,131 @@
+#include <iostream>
+
+#include "io/raw/RawCaptureRecordingData.hpp"
+
+#include "Tracing.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Raw;
+
+RawCaptureRecordingData::RawCaptureRecordingData(
+    std::shared_ptr<Memory::MemoryObject> dataset,
+    std::shared_ptr<RawCaptureFile> file)
+    : m_dataset(std::move(dataset))
+    , m_file(std::move(file))
+{
+  m_shape = m_dataset->shape;
+  m_position = SizeArray(m_shape.size(), 0);
+}
+
+RawCaptureRecordingData::~RawCaptureRecordingData() {}
+
+Status RawCaptureRecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const BaseDataType& type,
+    const void* data)
+{
+  TraceScope trace("RawCaptureRecordingData::writeDataBlock", "io");
+  // check type. Strings should use the other variant of this function
+  if (Memory::MemoryIO::getTypeSize(type) == 0) {
+    std::cerr
+        << "RawCaptureRecordingData::writeDataBlock called for string data, "
+           "use RawCaptureRecordingData::writeDataBlock with a string array "
+           "data input instead of void* data."
+        << std::endl;
+    return Status::Failure;
+  }
+  if (Memory::MemoryIO::getTypeSize(m_dataset->dataType) == 0) {
+    std::cerr << "RawCaptureRecordingData::writeDataBlock numeric data for a "
+                 "non-numeric dataset"
+              << std::endl;
+    return Status::Failure;
+  }
+
+  if (writeDataBlockHelper(dataShape, positionOffset) == Status::Failure) {
+    return Status::Failure;
+  }
+  // The values are converted to the type of the dataset when packing
+  if (m_file->append(dataShape, positionOffset, type, data) != Status::Success)
+  {
+    return Status::Failure;
+  }
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+  return Status::Success;
+}
+
+Status RawCaptureRecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const AQNWB::IO::BaseDataType& type,
+    const std::vector<std::string>& data)
+{
+  TraceScope trace("RawCaptureRecordingData::writeDataBlock", "io");
+  if (type.type != BaseDataType::Type::V_STR
+      && type.type != BaseDataType::Type::T_STR)
+  {
+    std::cerr << "RawCaptureRecordingData::writeDataBlock non-string type for "
+                 "string data"
+              << std::endl;
+    return Status::Failure;
+  }
+  if (Memory::MemoryIO::getTypeSize(m_dataset->dataType) != 0) {
+    std::cerr << "RawCaptureRecordingData::writeDataBlock string data for a "
+                 "non-string dataset"
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // validate the data before modifying the dataset
+  SizeType numElements = 1;
+  for (SizeType dim : dataShape) {
+    numElements *= (dim == 0) ? 1 : dim;
+  }
+  if (data.size() < numElements) {
+    return Status::Failure;
+  }
+  if (type.type == BaseDataType::Type::T_STR) {
+    for (SizeType i = 0; i < numElements; ++i) {
+      if (data[i].size() > type.typeSize) {
+        return Status::Failure;  // String length exceeds the fixed length
+      }
+    }
+  }
+
+  if (writeDataBlockHelper(dataShape, positionOffset) == Status::Failure) {
+    return Status::Failure;
+  }
+  if (m_file->appendStrings(dataShape, positionOffset, type, data)
+      != Status::Success)
+  {
+    return Status::Failure;
+  }
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+  return Status::Success;
+}
+
+Status RawCaptureRecordingData::writeDataBlockHelper(
+    const SizeArray& dataShape, const SizeArray& positionOffset)
+{
+  // Validate the block and extend the shape. The values are kept in the
+  // capture file.
+  bool extended = false;
+  if (m_dataset->extendForBlock(dataShape, positionOffset, false, extended)
+      == Status::Failure)
+  {
+    return Status::Failure;
+  }
+  if (extended) {
+    recordExtend();
+  }
+  m_shape = m_dataset->shape;
+  return Status::Success;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/BaseIO.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/raw/RawCaptureFile.hpp"
+
+namespace AQNWB::IO::Raw
+{
+/**
+ * @brief Represents a dataset of a RawCaptureIO that can be extended
+ * indefinitely in blocks.
+ *
+ * Every block is appended unchanged to the RawCaptureFile of the dataset.
+ * Only the shape of the dataset is kept in memory. Like for MemoryIO, writes
+ * beyond the current shape grow the dataset along all dimensions that were
+ * created with chunking larger than 0.
+ */
+class RawCaptureRecordingData : public AQNWB::IO::BaseRecordingData
+{
+public:
+  /**
+   * @brief Constructs a RawCaptureRecordingData object.
+   * @param dataset The dataset in the object tree of the capture, holding the
+   * data type, shape, and chunking but no values.
+   * @param file The log of the dataset
+   */
+  RawCaptureRecordingData(std::shared_ptr<Memory::MemoryObject> dataset,
+                          std::shared_ptr<RawCaptureFile> file);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  RawCaptureRecordingData(const RawCaptureRecordingData&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  RawCaptureRecordingData& operator=(const RawCaptureRecordingData&) = delete;
+
+  /**
+   * @brief Destroys the RawCaptureRecordingData object.
+   */
+  ~RawCaptureRecordingData() override;
+
+  /**
+   * @brief Gets the log of the dataset.
+   */
+  inline const RawCaptureFile* getFile() const { return m_file.get(); }
+
+protected:
+  /**
+   * @brief Writes a block of data to the dataset.
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block.
+   * @param data A pointer to the data block.
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const void* data) override;
+
+  /**
+   * @brief Writes a block of string data (any number of dimensions).
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block. Either
+   *             BaseDataType::Type::V_STR or BaseDataType::Type::T_STR
+   *             for variable and fixed-length strings repsetively.
+   * @param data Vector with the string data
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const std::vector<std::string>& data) override;
+
+private:
+  /**
+   * @brief Validate parameters and extend the shape of the dataset if
+   * necessary
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @return The status of the operation.
+   */
+  Status writeDataBlockHelper(const SizeArray& dataShape,
+                              const SizeArray& positionOffset);
+
+  /**
+   * @brief The dataset in the object tree of the capture
+   */
+  std::shared_ptr<Memory::MemoryObject> m_dataset;
+
+  /**
+   * @brief The log of the dataset
+   */
+  std::shared_ptr<RawCaptureFile> m_file;
+};
+}  // namespace AQNWB::IO::Raw
@@ -0,0 +1,984 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "io/zarr/ZarrArray.hpp"
+
+#include "io/memory/MemoryIO.hpp"
+#include "io/zarr/ZarrJson.hpp"
+
+#ifdef AQNWB_HAVE_ZLIB
+#  include <zlib.h>
+#endif
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Zarr;
+using AQNWB::IO::Memory::MemoryIO;
+
+namespace
+{
+/**
+ * @brief The id of the filter for variable-length strings
+ */
+constexpr const char* VlenUtf8Filter = "vlen-utf8";
+
+/**
+ * @brief The id of the filter for object references
+ */
+constexpr const char* Json2Filter = "json2";
+
+/**
+ * @brief Append a 32-bit unsigned integer in little-endian byte order
+ */
+void appendUInt32(std::vector<unsigned char>& out, uint32_t value)
+{
+  for (size_t i = 0; i < 4; ++i) {
+    out.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+/**
+ * @brief Read a 32-bit unsigned integer in little-endian byte order
+ * @throws std::runtime_error if the buffer is too short
+ */
+uint32_t readUInt32(const std::vector<unsigned char>& in, size_t& pos)
+{
+  if (pos + 4 > in.size()) {
+    throw std::runtime_error("truncated vlen-utf8 chunk");
+  }
+  uint32_t value = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(in[pos + i]) << (8 * i);
+  }
+  pos += 4;
+  return value;
+}
+
+/**
+ * @brief Convert a shape to a JSON array
+ */
+JsonValue toJson(const SizeArray& values)
+{
+  JsonValue array = JsonValue::array();
+  for (SizeType value : values) {
+    array.push(JsonValue::fromUInt(value));
+  }
+  return array;
+}
+
+/**
+ * @brief Convert a JSON array of non-negative integers to a shape
+ * @throws std::runtime_error if the value is not such an array
+ */
+SizeArray toSizeArray(const JsonValue* value, const std::string& name)
+{
+  if (value == nullptr || value->getKind() != JsonValue::Kind::Array) {
+    throw std::runtime_error("missing or invalid '" + name + "'");
+  }
+  SizeArray result;
+  for (const JsonValue& element : value->getElements()) {
+    if (!element.isInteger() || element.getText().front() == '-') {
+      throw std::runtime_error("invalid '" + name + "'");
+    }
+    result.push_back(static_cast<SizeType>(element.toUInt()));
+  }
+  return result;
+}
+
+/**
+ * @brief Append the paths of the references of a json2 chunk, flattening
+ * nested arrays of multi-dimensional chunks
+ */
+void appendReferences(const JsonValue& value, std::vector<std::string>& out)
+{
+  switch (value.getKind()) {
+    case JsonValue::Kind::Array:
+      for (const JsonValue& element : value.getElements()) {
+        appendReferences(element, out);
+      }
+      break;
+    case JsonValue::Kind::Object: {
+      const JsonValue* path = value.find("path");
+      out.push_back(path != nullptr ? path->getText() : std::string());
+      break;
+    }
+    case JsonValue::Kind::String:
+      out.push_back(value.getText());
+      break;
+    default:
+      out.emplace_back();
+      break;
+  }
+}
+
+#ifdef AQNWB_HAVE_ZLIB
+/**
+ * @brief Compress bytes in the zlib format
+ */
+std::vector<unsigned char> compressBytes(const std::vector<unsigned char>& in,
+                                         int level)
+{
+  uLongf size = compressBound(static_cast<uLong>(in.size()));
+  std::vector<unsigned char> out(size);
+  if (compress2(out.data(), &size, in.data(), static_cast<uLong>(in.size()),
+                level)
+      != Z_OK)
+  {
+    throw std::runtime_error("zlib compression failed");
+  }
+  out.resize(size);
+  return out;
+}
+
+/**
+ * @brief Decompress bytes in the zlib format
+ * @param in The compressed bytes
+ * @param expectedSize The size of the decompressed bytes if known, else 0
+ */
+std::vector<unsigned char> decompressBytes(
+    const std::vector<unsigned char>& in, size_t expectedSize)
+{
+  size_t capacity = (expectedSize > 0) ? expectedSize : 4 * in.size() + 64;
+  while (true) {
+    std::vector<unsigned char> out(capacity);
+    uLongf size = static_cast<uLongf>(capacity);
+    int result = uncompress(
+        out.data(), &size, in.data(), static_cast<uLong>(in.size()));
+    if (result == Z_OK) {
+      out.resize(size);
+      return out;
+    }
+    if (result != Z_BUF_ERROR) {
+      throw std::runtime_error("zlib decompression failed");
+    }
+    capacity *= 2;
+  }
+}
+#endif
+}  // namespace
+
+ZarrArray::ZarrArray(std::filesystem::path directory,
+                     const BaseDataType& dataType,
+                     bool isReference,
+                     const SizeArray& shape,
+                     const SizeArray& chunks,
+                     int compressionLevel)
+    : m_directory(std::move(directory))
+    , m_dataType(dataType)
+    , m_isReference(isReference)
+    , m_shape(shape)
+    , m_chunks(chunks)
+    , m_compressionLevel(compressionLevel)
+{
+  if (m_dataType.type == BaseDataType::Type::T_STR) {
+    m_dataType.typeSize = std::max<SizeType>(m_dataType.typeSize, 1);
+    m_elementSize = m_dataType.typeSize;
+  } else if (!m_isReference) {
+    m_elementSize = MemoryIO::getTypeSize(m_dataType);
+  }
+#ifdef AQNWB_HAVE_ZLIB
+  m_compressed = (m_compressionLevel > 0);
+#else
+  m_compressionLevel = 0;
+#endif
+}
+
+ZarrArray::~ZarrArray()
+{
+  // the pending stores refer to this array
+  waitForStores(true);
+}
+
+std::shared_ptr<ZarrArray> ZarrArray::load(
+    const std::filesystem::path& directory)
+{
+  JsonValue metadata = readJsonFile(directory / ".zarray");
+  try {
+    const JsonValue* format = metadata.find("zarr_format");
+    if (format == nullptr || format->getText() != "2") {
+      throw std::runtime_error("unsupported zarr_format");
+    }
+    SizeArray shape = toSizeArray(metadata.find("shape"), "shape");
+    SizeArray chunks = toSizeArray(metadata.find("chunks"), "chunks");
+    if (chunks.size() != shape.size()
+        || std::find(chunks.begin(), chunks.end(), 0) != chunks.end())
+    {
+      throw std::runtime_error("invalid 'chunks'");
+    }
+
+    const JsonValue* dtype = metadata.find("dtype");
+    BaseDataType type;
+    if (dtype == nullptr || !parseZarrDataType(dtype->getText(), type)) {
+      throw std::runtime_error("unsupported 'dtype'");
+    }
+    const JsonValue* order = metadata.find("order");
+    if (order != nullptr && order->getText() != "C") {
+      throw std::runtime_error("unsupported 'order'");
+    }
+
+    // Only the filters used for strings and references are supported
+    bool isReference = false;
+    const JsonValue* filters = metadata.find("filters");
+    std::string filter;
+    if (filters != nullptr && filters->getKind() == JsonValue::Kind::Array) {
+      if (filters->getElements().size() > 1) {
+        throw std::runtime_error("unsupported 'filters'");
+      }
+      if (!filters->getElements().empty()) {
+        const JsonValue* id = filters->getElements()[0].find("id");
+        filter = (id != nullptr) ? id->getText() : "";
+      }
+    }
+    if (type.type == BaseDataType::Type::V_STR) {
+      isReference = (filter == Json2Filter);
+      if (filter != VlenUtf8Filter && !isReference) {
+        throw std::runtime_error("unsupported object codec");
+      }
+    } else if (!filter.empty()) {
+      throw std::runtime_error("unsupported filter '" + filter + "'");
+    }
+
+    int compressionLevel = 0;
+    bool compressed = false;
+    const JsonValue* compressor = metadata.find("compressor");
+    if (compressor != nullptr && compressor->getKind() != JsonValue::Kind::Null)
+    {
+      const JsonValue* id = compressor->find("id");
+#ifdef AQNWB_HAVE_ZLIB
+      if (id == nullptr || id->getText() != "zlib") {
+        throw std::runtime_error("unsupported compressor");
+      }
+      const JsonValue* level = compressor->find("level");
+      compressionLevel = (level != nullptr && level->isInteger())
+          ? static_cast<int>(level->toInt())
+          : Z_DEFAULT_COMPRESSION;
+      compressed = true;
+#else
+      throw std::runtime_error(
+          "unsupported compressor '" + (id != nullptr ? id->getText() : "")
+          + "', AqNWB was built without zlib");
+#endif
+    }
+
+    auto array = std::make_shared<ZarrArray>(
+        directory, type, isReference, shape, chunks, compressionLevel);
+    // zlib level 0 is a valid compressor that only wraps the data
+    array->m_compressed = compressed;
+    const JsonValue* separator = metadata.find("dimension_separator");
+    if (separator != nullptr && separator->getText() == "/") {
+      array->m_separator = '/';
+    }
+    array->m_metadataDirty = false;
+    return array;
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error("Invalid Zarr array " + directory.string() + ": "
+                             + e.what());
+  }
+}
+
+std::string ZarrArray::getZarrDataType(const BaseDataType& type)
+{
+  switch (type.type) {
+    case BaseDataType::Type::T_U8:
+      return "|u1";
+    case BaseDataType::Type::T_U16:
+      return "<u2";
+    case BaseDataType::Type::T_U32:
+      return "<u4";
+    case BaseDataType::Type::T_U64:
+      return "<u8";
+    case BaseDataType::Type::T_I8:
+      return "|i1";
+    case BaseDataType::Type::T_I16:
+      return "<i2";
+    case BaseDataType::Type::T_I32:
+      return "<i4";
+    case BaseDataType::Type::T_I64:
+      return "<i8";
+    case BaseDataType::Type::T_F32:
+      return "<f4";
+    case BaseDataType::Type::T_F64:
+      return "<f8";
+    case BaseDataType::Type::T_STR:
+      return "|S" + std::to_string(std::max<SizeType>(type.typeSize, 1));
+    default:
+      return "|O";
+  }
+}
+
+bool ZarrArray::parseZarrDataType(const std::string& dtype, BaseDataType& type)
+{
+  static const std::pair<const char*, BaseDataType> numericTypes[] = {
+      {"u1", BaseDataType::U8},
+      {"u2", BaseDataType::U16},
+      {"u4", BaseDataType::U32},
+      {"u8", BaseDataType::U64},
+      {"i1", BaseDataType::I8},
+      {"i2", BaseDataType::I16},
+      {"i4", BaseDataType::I32},
+      {"i8", BaseDataType::I64},
+      {"f4", BaseDataType::F32},
+      {"f8", BaseDataType::F64}};
+  if (dtype == "|O") {
+    type = BaseDataType::V_STR;
+    return true;
+  }
+  if (dtype.size() > 2 && dtype.compare(0, 2, "|S") == 0) {
+    try {
+      type = BaseDataType::STR(std::stoull(dtype.substr(2)));
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+  // Single-byte types have no byte order. Big-endian data is not supported.
+  if (dtype.size() != 3 || (dtype[0] != '<' && dtype[0] != '|')) {
+    return false;
+  }
+  for (const auto& [name, numericType] : numericTypes) {
+    if (dtype.compare(1, 2, name) == 0) {
+      type = numericType;
+      return true;
+    }
+  }
+  return false;
+}
+
+SizeArray ZarrArray::getShape() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_shape;
+}
+
+SizeType ZarrArray::getChunkElements() const
+{
+  SizeType numElements = 1;
+  for (SizeType chunk : m_chunks) {
+    numElements *= chunk;
+  }
+  return numElements;
+}
+
+std::string ZarrArray::getChunkKey(const SizeArray& index) const
+{
+  if (index.empty()) {
+    return "0";
+  }
+  std::string key = std::to_string(index[0]);
+  for (SizeType d = 1; d < index.size(); ++d) {
+    key += m_separator;
+    key += std::to_string(index[d]);
+  }
+  return key;
+}
+
+Status ZarrArray::writeValues(const SizeArray& dataShape,
+                              const SizeArray& positionOffset,
+                              BaseDataType::Type type,
+                              const void* data,
+                              bool& extended)
+{
+  const SizeType sourceSize = MemoryIO::getTypeSize(BaseDataType(type));
+  if (sourceSize == 0 || m_elementSize == 0
+      || m_dataType.type == BaseDataType::Type::T_STR || data == nullptr)
+  {
+    return Status::Failure;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  SizeArray blockShape;
+  if (prepareWrite(dataShape, positionOffset, blockShape, extended)
+      != Status::Success)
+  {
+    return Status::Failure;
+  }
+  const auto* source = static_cast<const unsigned char*>(data);
+  const BaseDataType::Type targetType = m_dataType.type;
+  return forEachRun(positionOffset,
+                    blockShape,
+                    [&](Chunk& chunk,
+                        SizeType blockIndex,
+                        SizeType chunkIndex,
+                        SizeType length)
+                    {
+                      Memory::convertValues(
+                          source + blockIndex * sourceSize,
+                          type,
+                          chunk.values.data() + chunkIndex * m_elementSize,
+                          targetType,
+                          length);
+                    });
+}
+
+Status ZarrArray::writeStrings(const SizeArray& dataShape,
+                               const SizeArray& positionOffset,
+                               const std::vector<std::string>& data,
+                               bool& extended)
+{
+  const bool fixedLength = (m_dataType.type == BaseDataType::Type::T_STR);
+  if (m_elementSize != 0 && !fixedLength) {
+    return Status::Failure;
+  }
+  SizeType numElements = 1;
+  for (SizeType dim : dataShape) {
+    numElements *= (dim == 0) ? 1 : dim;
+  }
+  if (data.size() < numElements) {
+    return Status::Failure;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  SizeArray blockShape;
+  if (prepareWrite(dataShape, positionOffset, blockShape, extended)
+      != Status::Success)
+  {
+    return Status::Failure;
+  }
+  return forEachRun(positionOffset,
+                    blockShape,
+                    [&](Chunk& chunk,
+                        SizeType blockIndex,
+                        SizeType chunkIndex,
+                        SizeType length)
+                    {
+                      for (SizeType i = 0; i < length; ++i) {
+                        const std::string& str = data[blockIndex + i];
+                        if (fixedLength) {
+                          unsigned char* target = chunk.values.data()
+                              + (chunkIndex + i) * m_elementSize;
+                          const SizeType size =
+                              std::min(str.size(), m_elementSize);
+                          std::memcpy(target, str.data(), size);
+                          std::memset(target + size, 0, m_elementSize - size);
+                        } else {
+                          chunk.strings[chunkIndex + i] = str;
+                        }
+                      }
+                    });
+}
+
+Status ZarrArray::prepareWrite(const SizeArray& dataShape,
+                               const SizeArray& positionOffset,
+                               SizeArray& blockShape,
+                               bool& extended)
+{
+  const SizeType rank = m_shape.size();
+  if (dataShape.size() != rank || positionOffset.size() != rank) {
+    return Status::Failure;
+  }
+
+  // Zarr arrays can be resized along all dimensions
+  extended = false;
+  blockShape.resize(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    blockShape[d] = (dataShape[d] == 0) ? 1 : dataShape[d];
+    if (dataShape[d] + positionOffset[d] > m_shape[d]) {
+      m_shape[d] = dataShape[d] + positionOffset[d];
+      extended = true;
+    }
+    if (blockShape[d] + positionOffset[d] > m_shape[d]) {
+      return Status::Failure;  // selection is not within the extent
+    }
+  }
+  if (extended) {
+    m_metadataDirty = true;
+  }
+
+  // Appending writes never return to earlier chunks along the first
+  // dimension, so those are complete and can be released
+  if (rank > 0) {
+    evictChunks(positionOffset[0] / m_chunks[0]);
+  }
+  return Status::Success;
+}
+
+template<typename Func>
+Status ZarrArray::forEachRun(const SizeArray& positionOffset,
+                             const SizeArray& blockShape,
+                             Func&& copyRun)
+{
+  const SizeType rank = blockShape.size();
+  if (rank == 0) {
+    Chunk* chunk = getChunk(SizeArray());
+    if (chunk == nullptr) {
+      return Status::Failure;
+    }
+    copyRun(*chunk, SizeType {0}, SizeType {0}, SizeType {1});
+    chunk->dirty = true;
+    return Status::Success;
+  }
+
+  SizeArray firstChunk(rank), lastChunk(rank);
+  SizeArray blockStrides(rank, 1), chunkStrides(rank, 1);
+  for (SizeType d = 0; d < rank; ++d) {
+    firstChunk[d] = positionOffset[d] / m_chunks[d];
+    lastChunk[d] = (positionOffset[d] + blockShape[d] - 1) / m_chunks[d];
+  }
+  for (SizeType d = rank - 1; d-- > 0;) {
+    blockStrides[d] = blockStrides[d + 1] * blockShape[d + 1];
+    chunkStrides[d] = chunkStrides[d + 1] * m_chunks[d + 1];
+  }
+
+  // Iterate over all chunks overlapping the block and, within each chunk,
+  // over the rows of the overlap
+  SizeArray chunkIndex = firstChunk;
+  SizeArray begin(rank), end(rank), position(rank);
+  while (true) {
+    Chunk* chunk = getChunk(chunkIndex);
+    if (chunk == nullptr) {
+      return Status::Failure;
+    }
+    for (SizeType d = 0; d < rank; ++d) {
+      const SizeType chunkStart = chunkIndex[d] * m_chunks[d];
+      begin[d] = std::max(positionOffset[d], chunkStart);
+      end[d] = std::min(positionOffset[d] + blockShape[d],
+                        chunkStart + m_chunks[d]);
+    }
+    const SizeType runLength = end[rank - 1] - begin[rank - 1];
+    position = begin;
+    bool done = false;
+    while (!done) {
+      SizeType blockIndex = 0;
+      SizeType chunkOffset = 0;
+      for (SizeType d = 0; d < rank; ++d) {
+        blockIndex += (position[d] - positionOffset[d]) * blockStrides[d];
+        chunkOffset +=
+            (position[d] - chunkIndex[d] * m_chunks[d]) * chunkStrides[d];
+      }
+      copyRun(*chunk, blockIndex, chunkOffset, runLength);
+      done = true;
+      for (SizeType d = rank - 1; d-- > 0;) {
+        if (++position[d] < end[d]) {
+          done = false;
+          break;
+        }
+        position[d] = begin[d];
+      }
+    }
+    chunk->dirty = true;
+
+    bool next = false;
+    for (SizeType d = rank; d-- > 0;) {
+      if (++chunkIndex[d] <= lastChunk[d]) {
+        next = true;
+        break;
+      }
+      chunkIndex[d] = firstChunk[d];
+    }
+    if (!next) {
+      return Status::Success;
+    }
+  }
+}
+
+void ZarrArray::evictChunks(SizeType firstChunk)
+{
+  for (auto it = m_cache.begin(); it != m_cache.end();) {
+    if (it->second.index[0] >= firstChunk) {
+      ++it;
+      continue;
+    }
+    if (it->second.dirty) {
+      // the store owns the chunk, such that writing can continue
+      auto chunk = std::make_shared<Chunk>(std::move(it->second));
+      submitStore([this, chunk]() { return storeChunk(*chunk); });
+    }
+    it = m_cache.erase(it);
+  }
+}
+
+ZarrArray::Chunk* ZarrArray::getChunk(const SizeArray& index)
+{
+  auto [it, inserted] = m_cache.try_emplace(getChunkKey(index));
+  if (inserted) {
+    it->second.index = index;
+    // an evicted chunk may still be stored in the background
+    waitForStores(false);
+    try {
+      loadChunk(it->second);
+    } catch (const std::runtime_error& e) {
+      // never overwrite data that cannot be decoded
+      std::cerr << "ZarrArray: " << e.what() << std::endl;
+      m_cache.erase(it);
+      return nullptr;
+    }
+  }
+  return &it->second;
+}
+
+void ZarrArray::loadChunk(Chunk& chunk) const
+{
+  const std::filesystem::path path = m_directory / getChunkKey(chunk.index);
+  std::string contents;
+  if (!readFile(path, contents)) {
+    // chunks that were never stored hold the fill value
+    chunk.values.assign(getChunkElements() * m_elementSize, 0);
+    chunk.strings.assign((m_elementSize == 0) ? getChunkElements() : 0,
+                         std::string());
+    return;
+  }
+  decodeChunk(std::vector<unsigned char>(contents.begin(), contents.end()),
+              chunk);
+}
+
+void ZarrArray::setWorkerPool(std::shared_ptr<ZarrWorkerPool> pool)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pool = std::move(pool);
+}
+
+void ZarrArray::submitStore(std::function<Status()> store)
+{
+  if (m_pool == nullptr) {
+    if (store() != Status::Success) {
+      std::lock_guard<std::mutex> lock(m_storeMutex);
+      m_storeFailed = true;
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_storeMutex);
+    ++m_pendingStores;
+  }
+  m_pool->submit(
+      [this, store = std::move(store)]()
+      {
+        const Status status = store();
+        std::lock_guard<std::mutex> lock(m_storeMutex);
+        m_storeFailed = m_storeFailed || (status != Status::Success);
+        --m_pendingStores;
+        m_storeDone.notify_all();
+      });
+}
+
+Status ZarrArray::waitForStores(bool clearFailures)
+{
+  std::unique_lock<std::mutex> lock(m_storeMutex);
+  m_storeDone.wait(lock, [this]() { return m_pendingStores == 0; });
+  const bool failed = m_storeFailed;
+  if (clearFailures) {
+    m_storeFailed = false;
+  }
+  return failed ? Status::Failure : Status::Success;
+}
+
+Status ZarrArray::storeChunk(const Chunk& chunk) const
+{
+  const std::filesystem::path path = m_directory / getChunkKey(chunk.index);
+  try {
+    if (m_separator == '/') {
+      std::filesystem::create_directories(path.parent_path());
+    }
+    std::vector<unsigned char> encoded = encodeChunk(chunk);
+    if (writeFile(path,
+                  std::string_view(reinterpret_cast<const char*>(
+                                       encoded.data()),
+                                   encoded.size())))
+    {
+      return Status::Success;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "ZarrArray: " << e.what() << std::endl;
+  }
+  std::cerr << "ZarrArray: failed to write chunk " << path << std::endl;
+  return Status::Failure;
+}
+
+std::vector<unsigned char> ZarrArray::encodeChunk(const Chunk& chunk) const
+{
+  std::vector<unsigned char> encoded;
+  if (m_isReference) {
+    // json2 codec: the items, followed by the dtype and the shape
+    JsonValue items = JsonValue::array();
+    for (const std::string& path : chunk.strings) {
+      JsonValue reference = JsonValue::object();
+      reference.set("source", JsonValue::string("."));
+      reference.set("path", JsonValue::string(path));
+      items.push(std::move(reference));
+    }
+    items.push(JsonValue::string("|O"));
+    items.push(toJson(m_chunks));
+    std::string text = items.dump();
+    encoded.assign(text.begin(), text.end());
+  } else if (m_elementSize == 0) {
+    // vlen-utf8 codec: the number of items, then the length and bytes of
+    // each item
+    SizeType size = 4;
+    for (const std::string& str : chunk.strings) {
+      size += 4 + str.size();
+    }
+    encoded.reserve(size);
+    appendUInt32(encoded, static_cast<uint32_t>(chunk.strings.size()));
+    for (const std::string& str : chunk.strings) {
+      appendUInt32(encoded, static_cast<uint32_t>(str.size()));
+      encoded.insert(encoded.end(), str.begin(), str.end());
+    }
+  } else if (!m_compressed) {
+    return chunk.values;
+  } else {
+    encoded = chunk.values;
+  }
+#ifdef AQNWB_HAVE_ZLIB
+  if (m_compressed) {
+    return compressBytes(encoded, m_compressionLevel);
+  }
+#endif
+  return encoded;
+}
+
+void ZarrArray::decodeChunk(std::vector<unsigned char> encoded,
+                            Chunk& chunk) const
+{
+  const SizeType numElements = getChunkElements();
+  if (m_compressed) {
+#ifdef AQNWB_HAVE_ZLIB
+    encoded = decompressBytes(encoded, numElements * m_elementSize);
+#endif
+  }
+  const std::string key = getChunkKey(chunk.index);
+  if (m_isReference) {
+    chunk.strings.clear();
+    JsonValue items =
+        JsonValue::parse(std::string(encoded.begin(), encoded.end()));
+    const auto& elements = items.getElements();
+    // the last two items are the dtype and the shape
+    for (SizeType i = 0; i + 2 < elements.size(); ++i) {
+      appendReferences(elements[i], chunk.strings);
+    }
+    chunk.strings.resize(numElements);
+  } else if (m_elementSize == 0) {
+    size_t pos = 0;
+    const uint32_t count = readUInt32(encoded, pos);
+    chunk.strings.assign(numElements, std::string());
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t length = readUInt32(encoded, pos);
+      if (pos + length > encoded.size()) {
+        throw std::runtime_error("truncated vlen-utf8 chunk " + key);
+      }
+      if (i < numElements) {
+        chunk.strings[i].assign(
+            reinterpret_cast<const char*>(encoded.data() + pos), length);
+      }
+      pos += length;
+    }
+  } else {
+    if (encoded.size() != numElements * m_elementSize) {
+      throw std::runtime_error("unexpected size of chunk "
+                               + (m_directory / key).string());
+    }
+    chunk.values = std::move(encoded);
+  }
+}
+
+DataBlockGeneric ZarrArray::read(
+    const std::vector<std::vector<SizeType>>& indices)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const SizeType rank = indices.size();
+  DataBlockGeneric result;
+  result.shape.resize(rank);
+  SizeType numElements = 1;
+  for (SizeType d = 0; d < rank; ++d) {
+    result.shape[d] = indices[d].size();
+    numElements *= indices[d].size();
+  }
+  std::vector<unsigned char> values(numElements * m_elementSize);
+  std::vector<std::string> strings((m_elementSize == 0) ? numElements : 0);
+
+  // Copy one element from a chunk to the output
+  auto copyElement = [&](const Chunk& chunk, SizeType source, SizeType target)
+  {
+    if (m_elementSize == 0) {
+      strings[target] = chunk.strings[source];
+    } else {
+      std::memcpy(values.data() + target * m_elementSize,
+                  chunk.values.data() + source * m_elementSize,
+                  m_elementSize);
+    }
+  };
+  // Get a chunk from the cache of a writer or from disk. Evicted chunks may
+  // still be stored in the background.
+  Chunk loaded;
+  auto findChunk = [&](const SizeArray& index) -> const Chunk&
+  {
+    auto cached = m_cache.find(getChunkKey(index));
+    if (cached != m_cache.end()) {
+      return cached->second;
+    }
+    waitForStores(false);
+    loaded.index = index;
+    loadChunk(loaded);
+    return loaded;
+  };
+
+  if (numElements > 0 && rank == 0) {
+    copyElement(findChunk(SizeArray()), 0, 0);
+  } else if (numElements > 0) {
+    // Group the selected indices of each dimension by chunk
+    struct ChunkSelection
+    {
+      SizeType chunk;
+      std::vector<SizeType> outputs;
+      std::vector<SizeType> offsets;
+    };
+    std::vector<std::vector<ChunkSelection>> selections(rank);
+    for (SizeType d = 0; d < rank; ++d) {
+      std::map<SizeType, ChunkSelection> byChunk;
+      for (SizeType i = 0; i < indices[d].size(); ++i) {
+        const SizeType chunk = indices[d][i] / m_chunks[d];
+        ChunkSelection& selection = byChunk[chunk];
+        selection.chunk = chunk;
+        selection.outputs.push_back(i);
+        selection.offsets.push_back(indices[d][i] - chunk * m_chunks[d]);
+      }
+      for (auto& [chunk, selection] : byChunk) {
+        selections[d].push_back(std::move(selection));
+      }
+    }
+    SizeArray outputStrides(rank, 1), chunkStrides(rank, 1);
+    for (SizeType d = rank - 1; d-- > 0;) {
+      outputStrides[d] = outputStrides[d + 1] * result.shape[d + 1];
+      chunkStrides[d] = chunkStrides[d + 1] * m_chunks[d + 1];
+    }
+
+    // Iterate over all chunks with selected elements, and over the selected
+    // elements within each chunk
+    SizeArray selection(rank, 0), chunkIndex(rank), position(rank);
+    bool chunksDone = false;
+    while (!chunksDone) {
+      for (SizeType d = 0; d < rank; ++d) {
+        chunkIndex[d] = selections[d][selection[d]].chunk;
+      }
+      const Chunk& chunk = findChunk(chunkIndex);
+      std::fill(position.begin(), position.end(), 0);
+      bool done = false;
+      while (!done) {
+        SizeType source = 0;
+        SizeType target = 0;
+        for (SizeType d = 0; d < rank; ++d) {
+          const ChunkSelection& dimSelection = selections[d][selection[d]];
+          source += dimSelection.offsets[position[d]] * chunkStrides[d];
+          target += dimSelection.outputs[position[d]] * outputStrides[d];
+        }
+        copyElement(chunk, source, target);
+        done = true;
+        for (SizeType d = rank; d-- > 0;) {
+          if (++position[d] < selections[d][selection[d]].outputs.size()) {
+            done = false;
+            break;
+          }
+          position[d] = 0;
+        }
+      }
+      chunksDone = true;
+      for (SizeType d = rank; d-- > 0;) {
+        if (++selection[d] < selections[d].size()) {
+          chunksDone = false;
+          break;
+        }
+        selection[d] = 0;
+      }
+    }
+  }
+
+  result.baseDataType = m_isReference ? BaseDataType::V_STR : m_dataType;
+  if (m_dataType.type == BaseDataType::Type::T_STR) {
+    // fixed-length strings are padded with null characters
+    strings.resize(numElements);
+    for (SizeType i = 0; i < numElements; ++i) {
+      const char* str =
+          reinterpret_cast<const char*>(values.data() + i * m_elementSize);
+      strings[i].assign(str, strnlen(str, m_elementSize));
+    }
+  }
+  if (m_elementSize == 0 || m_dataType.type == BaseDataType::Type::T_STR) {
+    result.data = std::move(strings);
+    result.typeIndex = typeid(std::string);
+  } else {
+    Memory::visitNumericType(m_dataType.type,
+                             [&](auto typeTag)
+                             {
+                               using T = typename decltype(typeTag)::type;
+                               std::vector<T> data(numElements);
+                               std::memcpy(data.data(),
+                                           values.data(),
+                                           values.size());
+                               result.data = std::move(data);
+                               result.typeIndex = typeid(T);
+                             });
+  }
+  return result;
+}
+
+Status ZarrArray::writeMetadata()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return storeMetadata();
+}
+
+Status ZarrArray::storeMetadata()
+{
+  JsonValue metadata = JsonValue::object();
+  metadata.set("chunks", toJson(m_chunks));
+  if (m_compressed) {
+    JsonValue compressor = JsonValue::object();
+    compressor.set("id", JsonValue::string("zlib"));
+    compressor.set("level", JsonValue::fromInt(m_compressionLevel));
+    metadata.set("compressor", std::move(compressor));
+  } else {
+    metadata.set("compressor", JsonValue());
+  }
+  metadata.set("dimension_separator",
+               JsonValue::string(std::string(1, m_separator)));
+  metadata.set("dtype", JsonValue::string(getZarrDataType(m_dataType)));
+  if (m_elementSize == 0) {
+    JsonValue filter = JsonValue::object();
+    filter.set("id",
+               JsonValue::string(m_isReference ? Json2Filter : VlenUtf8Filter));
+    JsonValue filters = JsonValue::array();
+    filters.push(std::move(filter));
+    metadata.set("fill_value", JsonValue());
+    metadata.set("filters", std::move(filters));
+  } else {
+    metadata.set("fill_value",
+                 (m_dataType.type == BaseDataType::Type::T_STR)
+                     ? JsonValue::string("")
+                     : JsonValue::fromInt(0));
+    metadata.set("filters", JsonValue());
+  }
+  metadata.set("order", JsonValue::string("C"));
+  metadata.set("shape", toJson(m_shape));
+  metadata.set("zarr_format", JsonValue::fromInt(2));
+  if (!writeFile(m_directory / ".zarray", metadata.dump(4))) {
+    std::cerr << "ZarrArray: failed to write metadata of " << m_directory
+              << std::endl;
+    return Status::Failure;
+  }
+  m_metadataDirty = false;
+  return Status::Success;
+}
+
+Status ZarrArray::flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<Chunk*> dirtyChunks;
+  for (auto& [key, chunk] : m_cache) {
+    if (chunk.dirty) {
+      dirtyChunks.push_back(&chunk);
+    }
+  }
+  // store the chunks before the metadata, such that readers never see a
+  // shape that includes data that was not stored yet
+  for (Chunk* chunk : dirtyChunks) {
+    submitStore([this, chunk]() { return storeChunk(*chunk); });
+  }
+  Status status = waitForStores(true);
+  for (Chunk* chunk : dirtyChunks) {
+    chunk->dirty = (status != Status::Success);
+  }
+  if (m_metadataDirty) {
+    status = status && storeMetadata();
+  }
+  return status;
+}
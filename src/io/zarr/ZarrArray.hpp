@@ -0,0 +1,401 @@
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/ReadIO.hpp"
+#include "io/zarr/ZarrWorkerPool.hpp"
+
+namespace AQNWB::IO::Zarr
+{
+/**
+ * @brief A chunked array of a Zarr (v2) directory store.
+ *
+ * The metadata of the array is kept in the `.zarray` file of the array
+ * directory and every chunk is stored in a separate file named by its chunk
+ * indices, e.g., `3.0`. Numeric and fixed-length string values are stored as
+ * raw little-endian bytes, variable-length strings with the `vlen-utf8`
+ * filter, and object references with the `json2` filter using the
+ * conventions of hdmf-zarr. Chunks can be compressed with zlib if AqNWB was
+ * built with zlib.
+ *
+ * Chunks are cached in memory while they are written. When a write starts in
+ * a later chunk along the first dimension, all cached chunks before it are
+ * complete for appending writes and are handed to the worker pool (see
+ * setWorkerPool), which stores them in the background. flush() stores all
+ * modified chunks and the metadata and waits for the pending stores. Chunks
+ * that fail to store in the background are reported by the next flush().
+ * Files are replaced atomically, such that readers in other processes see
+ * either the old or the new content of a chunk.
+ *
+ * All methods are thread-safe. Writes to different arrays do not block each
+ * other.
+ */
+class ZarrArray
+{
+public:
+  /**
+   * @brief Constructor for a new array. The metadata is not written until
+   * writeMetadata() or flush() is called.
+   * @param directory The directory of the array
+   * @param dataType The data type of the elements
+   * @param isReference Whether the array holds object references
+   * @param shape The initial shape of the array
+   * @param chunks The shape of the chunks, with the same rank as the shape
+   * @param compressionLevel The zlib compression level of the chunks, or 0
+   * to store the chunks uncompressed
+   */
+  ZarrArray(std::filesystem::path directory,
+            const BaseDataType& dataType,
+            bool isReference,
+            const SizeArray& shape,
+            const SizeArray& chunks,
+            int compressionLevel);
+
+  /**
+   * @brief Destructor. Waits for the pending stores of chunks.
+   */
+  ~ZarrArray();
+
+  /**
+   * @brief Load an existing array from the `.zarray` file of its directory
+   * @param directory The directory of the array
+   * @return The array
+   * @throws std::runtime_error if the metadata cannot be read or uses
+   * features that are not supported, e.g., other compressors than zlib
+   */
+  static std::shared_ptr<ZarrArray> load(
+      const std::filesystem::path& directory);
+
+  /**
+   * @brief Write numeric values to a block of the array, converting them to
+   * the data type of the array.
+   *
+   * The array is extended if the block ends beyond its shape. Like in HDF5,
+   * dimensions of size 0 write a single element without extending the
+   * array.
+   *
+   * @param dataShape The shape of the block
+   * @param positionOffset The position of the block in the array
+   * @param type The numeric type of the values
+   * @param data The values of the block in row-major order
+   * @param extended Set to true if the array was extended (return value)
+   * @return The status of the write operation. Fails if a chunk of the block
+   * exists on disk but cannot be decoded.
+   */
+  Status writeValues(const SizeArray& dataShape,
+                     const SizeArray& positionOffset,
+                     BaseDataType::Type type,
+                     const void* data,
+                     bool& extended);
+
+  /**
+   * @brief Write strings to a block of a string or reference array.
+   * Strings are truncated to the length of fixed-length string arrays.
+   * @param dataShape The shape of the block
+   * @param positionOffset The position of the block in the array
+   * @param data The strings of the block in row-major order
+   * @param extended Set to true if the array was extended (return value)
+   * @return The status of the write operation. Fails if a chunk of the block
+   * exists on disk but cannot be decoded.
+   */
+  Status writeStrings(const SizeArray& dataShape,
+                      const SizeArray& positionOffset,
+                      const std::vector<std::string>& data,
+                      bool& extended);
+
+  /**
+   * @brief Read the elements at the outer product of index lists
+   * @param indices One sorted or unsorted list of indices per dimension,
+   * all within the shape of the array
+   * @return The values with one dimension per index list. Strings and object
+   * references are returned as std::string.
+   * @throws std::runtime_error if a chunk cannot be decoded
+   */
+  DataBlockGeneric read(const std::vector<std::vector<SizeType>>& indices);
+
+  /**
+   * @brief Write the `.zarray` metadata file
+   * @return The status of the operation.
+   */
+  Status writeMetadata();
+
+  /**
+   * @brief Store all modified chunks and the metadata, and wait for the
+   * pending stores of chunks
+   * @return The status of the operation. Fails if any chunk failed to store
+   * since the last flush.
+   */
+  Status flush();
+
+  /**
+   * @brief Set the worker pool that stores the chunks. Without a pool,
+   * chunks are stored on the writing thread.
+   * @param pool The worker pool, usually shared by all arrays of a ZarrIO
+   */
+  void setWorkerPool(std::shared_ptr<ZarrWorkerPool> pool);
+
+  /**
+   * @brief Get the current shape of the array
+   */
+  SizeArray getShape() const;
+
+  /**
+   * @brief Get the shape of the chunks
+   */
+  inline const SizeArray& getChunks() const { return m_chunks; }
+
+  /**
+   * @brief Get the data type of the elements
+   */
+  inline const BaseDataType& getDataType() const { return m_dataType; }
+
+  /**
+   * @brief Check whether the array holds object references
+   */
+  inline bool isReference() const { return m_isReference; }
+
+  /**
+   * @brief Get the Zarr dtype string of a data type, e.g., "<i2"
+   * @param type The data type
+   * @return The dtype. Variable-length strings are "|O".
+   */
+  static std::string getZarrDataType(const BaseDataType& type);
+
+  /**
+   * @brief Parse a Zarr dtype string
+   * @param dtype The dtype, e.g., "<f4" or "|S8"
+   * @param type The data type (return value). "|O" is parsed as V_STR.
+   * @return False if the dtype is not supported
+   */
+  static bool parseZarrDataType(const std::string& dtype, BaseDataType& type);
+
+private:
+  /**
+   * @brief A chunk held in memory
+   */
+  struct Chunk
+  {
+    /**
+     * @brief The chunk indices along each dimension
+     */
+    SizeArray index;
+
+    /**
+     * @brief The raw values of numeric and fixed-length string chunks
+     */
+    std::vector<unsigned char> values;
+
+    /**
+     * @brief The values of variable-length string and reference chunks
+     */
+    std::vector<std::string> strings;
+
+    /**
+     * @brief Whether the chunk was modified since it was stored
+     */
+    bool dirty = false;
+  };
+
+  /**
+   * @brief Validate a block and extend the array if necessary. Must be
+   * called with m_mutex locked.
+   * @param dataShape The size of the data block
+   * @param positionOffset The position of the block
+   * @param blockShape dataShape with dimensions of size 0 treated as size 1
+   * (return value)
+   * @param extended Set to true if the array was extended (return value)
+   * @return The status of the operation
+   */
+  Status prepareWrite(const SizeArray& dataShape,
+                      const SizeArray& positionOffset,
+                      SizeArray& blockShape,
+                      bool& extended);
+
+  /**
+   * @brief Call a function for each contiguous run of a block within each
+   * chunk that the block overlaps. Must be called with m_mutex locked.
+   * @param positionOffset The position of the block
+   * @param blockShape The shape of the block
+   * @param copyRun Function called with the chunk, the index of the first
+   * element of the run in the block, the index of the first element in the
+   * chunk, and the number of elements of the run
+   * @return Status::Failure if a chunk cannot be loaded
+   */
+  template<typename Func>
+  Status forEachRun(const SizeArray& positionOffset,
+                  const SizeArray& blockShape,
+                  Func&& copyRun);
+
+  /**
+   * @brief Release the cached chunks before a chunk index along the first
+   * dimension, storing the modified ones on the worker pool. Must be called
+   * with m_mutex locked.
+   * @param firstChunk The first chunk index along the first dimension to
+   * keep in memory
+   */
+  void evictChunks(SizeType firstChunk);
+
+  /**
+   * @brief Write the `.zarray` metadata file. Must be called with m_mutex
+   * locked.
+   * @return The status of the operation.
+   */
+  Status storeMetadata();
+
+  /**
+   * @brief Get a cached chunk for writing, loading it from disk or creating
+   * it if it is not cached. Must be called with m_mutex locked.
+   * @return The chunk, or nullptr if the chunk exists on disk but cannot be
+   * decoded
+   */
+  Chunk* getChunk(const SizeArray& index);
+
+  /**
+   * @brief Load a chunk from disk
+   * @param chunk The chunk with its index set (return value). Chunks that
+   * were never stored are filled with the fill value.
+   * @throws std::runtime_error if the chunk cannot be decoded
+   */
+  void loadChunk(Chunk& chunk) const;
+
+  /**
+   * @brief Store a chunk on the worker pool, or on the calling thread if
+   * there is no pool. Failures are recorded for waitForStores.
+   * @param store The function storing the chunk. The chunk must stay valid
+   * until waitForStores returns.
+   */
+  void submitStore(std::function<Status()> store);
+
+  /**
+   * @brief Wait until all chunks submitted by submitStore are stored
+   * @param clearFailures Whether to forget the failed stores after
+   * reporting them
+   * @return Status::Failure if any store failed since the failures were
+   * last cleared
+   */
+  Status waitForStores(bool clearFailures);
+
+  /**
+   * @brief Encode and store a chunk to disk
+   * @return The status of the operation
+   */
+  Status storeChunk(const Chunk& chunk) const;
+
+  /**
+   * @brief Encode the values of a chunk, including compression
+   */
+  std::vector<unsigned char> encodeChunk(const Chunk& chunk) const;
+
+  /**
+   * @brief Decode the contents of a chunk file into a chunk
+   * @throws std::runtime_error if the contents are invalid
+   */
+  void decodeChunk(std::vector<unsigned char> encoded, Chunk& chunk) const;
+
+  /**
+   * @brief Get the file name of a chunk, e.g., "3.0"
+   */
+  std::string getChunkKey(const SizeArray& index) const;
+
+  /**
+   * @brief Get the number of elements of a chunk
+   */
+  SizeType getChunkElements() const;
+
+  /**
+   * @brief The directory of the array
+   */
+  std::filesystem::path m_directory;
+
+  /**
+   * @brief The data type of the elements
+   */
+  BaseDataType m_dataType;
+
+  /**
+   * @brief Whether the array holds object references
+   */
+  bool m_isReference = false;
+
+  /**
+   * @brief The size in bytes of one element, or 0 if the elements are stored
+   * as std::string, i.e., for variable-length strings and references
+   */
+  SizeType m_elementSize = 0;
+
+  /**
+   * @brief The current shape
+   */
+  SizeArray m_shape;
+
+  /**
+   * @brief The shape of the chunks
+   */
+  SizeArray m_chunks;
+
+  /**
+   * @brief The zlib compression level
+   */
+  int m_compressionLevel = 0;
+
+  /**
+   * @brief Whether the chunks are compressed with zlib
+   */
+  bool m_compressed = false;
+
+  /**
+   * @brief The separator of the chunk indices in chunk file names
+   */
+  char m_separator = '.';
+
+  /**
+   * @brief Whether the metadata changed since it was written
+   */
+  bool m_metadataDirty = true;
+
+  /**
+   * @brief The chunks held in memory by their key
+   */
+  std::map<std::string, Chunk> m_cache;
+
+  /**
+   * @brief Mutex protecting the shape and the cached chunks
+   */
+  mutable std::mutex m_mutex;
+
+  /**
+   * @brief The worker pool storing the chunks, or nullptr to store the
+   * chunks on the writing thread
+   */
+  std::shared_ptr<ZarrWorkerPool> m_pool;
+
+  /**
+   * @brief The number of chunks submitted to the pool that are not stored yet
+   */
+  SizeType m_pendingStores = 0;
+
+  /**
+   * @brief Whether a store failed since the last flush
+   */
+  bool m_storeFailed = false;
+
+  /**
+   * @brief Mutex protecting m_pendingStores and m_storeFailed
+   */
+  std::mutex m_storeMutex;
+
+  /**
+   * @brief Signaled when a pending store finishes
+   */
+  std::condition_variable m_storeDone;
+};
+}  // namespace AQNWB::IO::Zarr
@@ -0,0 +1,1121 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "io/zarr/ZarrIO.hpp"
+
+#include "Tracing.hpp"
+#include "Utils.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/zarr/ZarrRecordingData.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Zarr;
+namespace fs = std::filesystem;
+
+namespace
+{
+/**
+ * @brief Maximum number of soft links followed to resolve a path, to detect
+ * cyclic links
+ */
+constexpr int MaxLinkDepth = 32;
+
+/**
+ * @brief The attribute of a group that holds its soft links
+ */
+constexpr const char* LinkAttribute = "zarr_link";
+
+/**
+ * @brief The file with the exact types of the attributes of an object
+ */
+constexpr const char* DataTypesFile = ".aqnwb_dtypes";
+
+/**
+ * @brief Split a path into the path of the parent and the name of the object
+ * @return False if the path has no name, e.g., for the root group
+ */
+bool splitPath(const std::string& path, std::string& parent, std::string& name)
+{
+  size_t end = path.find_last_not_of('/');
+  if (end == std::string::npos) {
+    return false;
+  }
+  size_t pos = path.find_last_of('/', end);
+  name = path.substr(pos == std::string::npos ? 0 : pos + 1,
+                     end - (pos == std::string::npos ? 0 : pos + 1) + 1);
+  parent = (pos == std::string::npos || pos == 0) ? std::string("/")
+                                                  : path.substr(0, pos);
+  return true;
+}
+
+/**
+ * @brief Read a JSON object from a file of the store
+ * @return The object, or an empty object if the file does not exist or is
+ * not a valid JSON object
+ */
+JsonValue readJsonObject(const fs::path& path)
+{
+  std::string text;
+  if (readFile(path, text)) {
+    try {
+      JsonValue value = JsonValue::parse(text);
+      if (value.getKind() == JsonValue::Kind::Object) {
+        return value;
+      }
+    } catch (const std::runtime_error& e) {
+      std::cerr << "ZarrIO: " << e.what() << " in " << path << std::endl;
+    }
+  }
+  return JsonValue::object();
+}
+
+/**
+ * @brief Get the metadata of a group
+ */
+std::string getGroupMetadata()
+{
+  JsonValue metadata = JsonValue::object();
+  metadata.set("zarr_format", JsonValue::fromInt(2));
+  return metadata.dump(4);
+}
+
+/**
+ * @brief Check whether an attribute value is an object reference
+ */
+const JsonValue* getReferencePath(const JsonValue& value)
+{
+  const JsonValue* dtype = value.find("zarr_dtype");
+  const JsonValue* reference = value.find("value");
+  if (dtype == nullptr || dtype->getText() != "object" || reference == nullptr)
+  {
+    return nullptr;
+  }
+  return reference->find("path");
+}
+
+/**
+ * @brief Get the data type of an attribute
+ * @param value The JSON value of the attribute
+ * @param dtype The Zarr dtype of the attribute, or an empty string to infer
+ * the type from the JSON value, e.g., for attributes written by other tools
+ */
+BaseDataType getAttributeType(const JsonValue& value, const std::string& dtype)
+{
+  BaseDataType type = BaseDataType::V_STR;
+  if (!dtype.empty() && ZarrArray::parseZarrDataType(dtype, type)) {
+    return type;
+  }
+  const JsonValue* element = &value;
+  if (value.getKind() == JsonValue::Kind::Array) {
+    if (value.getElements().empty()) {
+      return BaseDataType::V_STR;
+    }
+    element = &value.getElements()[0];
+  }
+  switch (element->getKind()) {
+    case JsonValue::Kind::Number:
+      return element->isInteger() ? BaseDataType::I64 : BaseDataType::F64;
+    case JsonValue::Kind::Bool:
+      return BaseDataType::U8;
+    default:
+      return BaseDataType::V_STR;
+  }
+}
+
+/**
+ * @brief Convert a numeric value to JSON
+ */
+template<typename T>
+JsonValue toJsonNumber(T value)
+{
+  if constexpr (std::is_floating_point_v<T>) {
+    return JsonValue::fromDouble(value, std::is_same_v<T, float> ? 9 : 17);
+  } else if constexpr (std::is_signed_v<T>) {
+    return JsonValue::fromInt(value);
+  } else {
+    return JsonValue::fromUInt(value);
+  }
+}
+
+/**
+ * @brief Convert a JSON number, boolean, or "NaN" and infinity string to a
+ * numeric value
+ */
+template<typename T>
+T fromJsonNumber(const JsonValue& value)
+{
+  if (value.getKind() == JsonValue::Kind::Bool) {
+    return static_cast<T>(value.getBool());
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(value.toDouble());
+  } else if constexpr (std::is_signed_v<T>) {
+    return value.isInteger() ? static_cast<T>(value.toInt())
+                             : static_cast<T>(value.toDouble());
+  } else {
+    return value.isInteger() ? static_cast<T>(value.toUInt())
+                             : static_cast<T>(value.toDouble());
+  }
+}
+}  // namespace
+
+ZarrIO::ZarrIO(const std::string& fileName, int compressionLevel)
+    : BaseIO(fileName)
+    , m_compressionLevel(compressionLevel)
+    , m_workerPool(std::make_shared<ZarrWorkerPool>())
+{
+#ifndef AQNWB_HAVE_ZLIB
+  if (m_compressionLevel > 0) {
+    std::cerr << "ZarrIO: AqNWB was built without zlib, chunks are stored "
+                 "uncompressed"
+              << std::endl;
+    m_compressionLevel = 0;
+  }
+#endif
+}
+
+ZarrIO::~ZarrIO()
+{
+  close();
+}
+
+Status ZarrIO::open()
+{
+  if (fs::exists(getFileName())) {
+    return open(FileMode::ReadWrite);
+  } else {
+    return open(FileMode::Overwrite);
+  }
+}
+
+Status ZarrIO::open(FileMode mode)
+{
+  TraceScope trace("ZarrIO::open", "io");
+  if (m_opened) {
+    return Status::Failure;
+  }
+
+  const fs::path root(getFileName());
+  std::error_code error;
+  const bool isStore = fs::exists(root / ".zgroup", error);
+  switch (mode) {
+    case FileMode::Overwrite:
+      if (fs::exists(root, error)) {
+        // only replace Zarr stores, never other data
+        if (!isStore
+            && !(fs::is_directory(root, error) && fs::is_empty(root, error)))
+        {
+          std::cerr << "ZarrIO::open cannot overwrite " << root
+                    << " because it is not a Zarr store" << std::endl;
+          return Status::Failure;
+        }
+        fs::remove_all(root, error);
+      }
+      fs::create_directories(root, error);
+      if (error || !writeFile(root / ".zgroup", getGroupMetadata())) {
+        std::cerr << "ZarrIO::open failed to create " << root << std::endl;
+        return Status::Failure;
+      }
+      break;
+    case FileMode::ReadWrite:
+    case FileMode::ReadOnly:
+      if (!isStore) {
+        return Status::Failure;
+      }
+      break;
+    default:
+      throw std::invalid_argument("Invalid file mode");
+  }
+  m_readOnly = (mode == FileMode::ReadOnly);
+  m_opened = true;
+  return Status::Success;
+}
+
+Status ZarrIO::close()
+{
+  Status status = Status::Success;
+  if (m_opened && !m_readOnly) {
+    status = flush();
+  }
+  status = BaseIO::close() && status;  // clear the recording containers
+  {
+    std::lock_guard<std::mutex> lock(m_arraysMutex);
+    m_arrays.clear();
+  }
+  m_workerPool->stop();
+  m_opened = false;
+  return status;
+}
+
+Status ZarrIO::flush()
+{
+  TraceScope trace("ZarrIO::flush", "io");
+  if (!m_opened) {
+    return Status::Failure;
+  }
+  std::lock_guard<std::mutex> lock(m_arraysMutex);
+  Status status = Status::Success;
+  for (const auto& [path, array] : m_arrays) {
+    status = array->flush() && status;
+  }
+  return status;
+}
+
+fs::path ZarrIO::getObjectDirectory(const std::string& path) const
+{
+  fs::path directory(getFileName());
+  const size_t start = path.find_first_not_of('/');
+  if (start != std::string::npos) {
+    directory /= path.substr(start);
+  }
+  return directory;
+}
+
+StorageObjectType ZarrIO::getObjectType(const std::string& path) const
+{
+  const fs::path directory = getObjectDirectory(path);
+  std::error_code error;
+  if (fs::exists(directory / ".zgroup", error)) {
+    return StorageObjectType::Group;
+  }
+  if (fs::exists(directory / ".zarray", error)) {
+    return StorageObjectType::Dataset;
+  }
+  return StorageObjectType::Undefined;
+}
+
+std::string ZarrIO::findLink(const std::string& group,
+                             const std::string& name) const
+{
+  JsonValue attributes = readJsonObject(getObjectDirectory(group) / ".zattrs");
+  const JsonValue* links = attributes.find(LinkAttribute);
+  if (links == nullptr) {
+    return "";
+  }
+  for (const JsonValue& link : links->getElements()) {
+    const JsonValue* linkName = link.find("name");
+    const JsonValue* target = link.find("path");
+    if (linkName != nullptr && target != nullptr && linkName->getText() == name)
+    {
+      return target->getText();
+    }
+  }
+  return "";
+}
+
+std::string ZarrIO::resolvePath(const std::string& path,
+                                bool followLinks,
+                                int depth) const
+{
+  if (!m_opened || depth > MaxLinkDepth) {
+    return "";
+  }
+  std::string current = "/";
+  size_t pos = path.find_first_not_of('/');
+  while (pos != std::string::npos) {
+    size_t end = std::min(path.find('/', pos), path.size());
+    std::string name = path.substr(pos, end - pos);
+    pos = path.find_first_not_of('/', end);
+    if (name.front() == '.') {
+      return "";  // metadata files and relative paths are not objects
+    }
+    std::string candidate = AQNWB::mergePaths(current, name);
+    if (getObjectType(candidate) != StorageObjectType::Undefined) {
+      current = candidate;
+      continue;
+    }
+    std::string target = findLink(current, name);
+    if (target.empty()) {
+      return "";
+    }
+    if (pos == std::string::npos && !followLinks) {
+      return candidate;
+    }
+    current = resolvePath(target, true, depth + 1);
+    if (current.empty()) {
+      return "";
+    }
+  }
+  return current;
+}
+
+Status ZarrIO::prepareNewObject(const std::string& path,
+                                std::string& parent,
+                                std::string& name)
+{
+  std::string parentPath;
+  if (!canModifyObjects() || !splitPath(path, parentPath, name)
+      || name.front() == '.')
+  {
+    return Status::Failure;
+  }
+  parent = resolvePath(parentPath);
+  if (parent.empty() || getObjectType(parent) != StorageObjectType::Group) {
+    return Status::Failure;
+  }
+  const std::string fullPath = AQNWB::mergePaths(parent, name);
+  if (getObjectType(fullPath) != StorageObjectType::Undefined
+      || !findLink(parent, name).empty())
+  {
+    return Status::Failure;  // an object already exists at the path
+  }
+  return Status::Success;
+}
+
+bool ZarrIO::findAttribute(const std::string& path,
+                           JsonValue& value,
+                           std::string& dtype) const
+{
+  std::string parentPath, name;
+  if (!splitPath(path, parentPath, name) || name == LinkAttribute) {
+    return false;
+  }
+  const std::string parent = resolvePath(parentPath);
+  if (parent.empty() || getObjectType(parent) == StorageObjectType::Undefined)
+  {
+    return false;
+  }
+  const fs::path directory = getObjectDirectory(parent);
+  JsonValue attributes = readJsonObject(directory / ".zattrs");
+  const JsonValue* attribute = attributes.find(name);
+  if (attribute == nullptr) {
+    return false;
+  }
+  value = *attribute;
+  JsonValue dtypes = readJsonObject(directory / DataTypesFile);
+  const JsonValue* attributeType = dtypes.find(name);
+  dtype = (attributeType != nullptr) ? attributeType->getText() : "";
+  return true;
+}
+
+Status ZarrIO::setAttribute(const std::string& path,
+                            const std::string& name,
+                            JsonValue value,
+                            const std::string& dtype,
+                            bool overwrite)
+{
+  if (!canModifyObjects() || name == LinkAttribute) {
+    return Status::Failure;
+  }
+  const std::string object = resolvePath(path);
+  if (object.empty() || getObjectType(object) == StorageObjectType::Undefined)
+  {
+    return Status::Failure;
+  }
+  const fs::path directory = getObjectDirectory(object);
+  JsonValue attributes = readJsonObject(directory / ".zattrs");
+  if (attributes.find(name) != nullptr && !overwrite) {
+    return Status::Failure;  // don't allow overwriting
+  }
+  attributes.set(name, std::move(value));
+  if (!writeFile(directory / ".zattrs", attributes.dump(4))) {
+    return Status::Failure;
+  }
+
+  // keep the exact type of numeric attributes
+  JsonValue dtypes = readJsonObject(directory / DataTypesFile);
+  bool changed = false;
+  if (!dtype.empty()) {
+    dtypes.set(name, JsonValue::string(dtype));
+    changed = true;
+  } else {
+    changed = dtypes.erase(name);
+  }
+  if (changed && !writeFile(directory / DataTypesFile, dtypes.dump(4))) {
+    return Status::Failure;
+  }
+  return Status::Success;
+}
+
+std::shared_ptr<ZarrArray> ZarrIO::getArray(const std::string& path) const
+{
+  if (m_readOnly) {
+    // load the current metadata for live reads
+    return ZarrArray::load(getObjectDirectory(path));
+  }
+  std::lock_guard<std::mutex> lock(m_arraysMutex);
+  auto existing = m_arrays.find(path);
+  if (existing != m_arrays.end()) {
+    return existing->second;
+  }
+  auto array = ZarrArray::load(getObjectDirectory(path));
+  array->setWorkerPool(m_workerPool);
+  m_arrays.emplace(path, array);
+  return array;
+}
+
+std::shared_ptr<ZarrArray> ZarrIO::createArray(const std::string& path,
+                                               const BaseDataType& type,
+                                               bool isReference,
+                                               const SizeArray& shape,
+                                               const SizeArray& chunks)
+{
+  std::string parent, name;
+  if (prepareNewObject(path, parent, name) != Status::Success) {
+    return nullptr;
+  }
+  const std::string fullPath = AQNWB::mergePaths(parent, name);
+  const fs::path directory = getObjectDirectory(fullPath);
+  std::error_code error;
+  fs::create_directory(directory, error);
+  if (error) {
+    return nullptr;
+  }
+  auto array = std::make_shared<ZarrArray>(
+      directory, type, isReference, shape, chunks, m_compressionLevel);
+  if (array->writeMetadata() != Status::Success) {
+    return nullptr;
+  }
+  array->setWorkerPool(m_workerPool);
+  std::lock_guard<std::mutex> lock(m_arraysMutex);
+  m_arrays[fullPath] = array;
+  return array;
+}
+
+StorageObjectType ZarrIO::getStorageObjectType(std::string path) const
+{
+  const std::string object = resolvePath(path);
+  if (!object.empty()) {
+    return getObjectType(object);
+  }
+  JsonValue value;
+  std::string dtype;
+  if (findAttribute(path, value, dtype)) {
+    return StorageObjectType::Attribute;
+  }
+  return StorageObjectType::Undefined;
+}
+
+DataBlockGeneric ZarrIO::readDataset(const std::string& dataPath,
+                                     const SizeArray& start,
+                                     const SizeArray& count,
+                                     const SizeArray& stride,
+                                     const SizeArray& block)
+{
+  TraceScope trace("ZarrIO::readDataset", "io");
+  const std::string object = resolvePath(dataPath);
+  if (object.empty() || getObjectType(object) != StorageObjectType::Dataset) {
+    throw std::runtime_error("Failed to open dataset '" + dataPath + "'");
+  }
+  auto array = getArray(object);
+  const SizeArray dims = array->getShape();
+  const SizeType rank = dims.size();
+  bool useSelection = !start.empty() && !count.empty() && rank > 0;
+  if (useSelection
+      && (start.size() < rank || count.size() < rank
+          || (!stride.empty() && stride.size() < rank)
+          || (!block.empty() && block.size() < rank)))
+  {
+    throw std::invalid_argument(
+        "ZarrIO::readDataset, selection must provide values for all "
+        "dimensions.");
+  }
+
+  // Determine the indices of the hyperslab along each dimension
+  std::vector<std::vector<SizeType>> indices(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    if (!useSelection) {
+      indices[d].resize(dims[d]);
+      std::iota(indices[d].begin(), indices[d].end(), SizeType {0});
+    } else {
+      SizeType dimStride = stride.empty() ? 1 : stride[d];
+      SizeType dimBlock = block.empty() ? 1 : block[d];
+      if (start[d] > dims[d]) {
+        throw std::runtime_error(
+            "Selection + offset for dimension not within extent.");
+      }
+      indices[d].reserve(count[d] * dimBlock);
+      for (SizeType k = 0; k < count[d]; ++k) {
+        for (SizeType j = 0; j < dimBlock; ++j) {
+          SizeType index = start[d] + k * dimStride + j;
+          if (index >= dims[d]) {
+            throw std::runtime_error(
+                "Selection + offset for dimension not within extent.");
+          }
+          indices[d].push_back(index);
+        }
+      }
+    }
+  }
+  return array->read(indices);
+}
+
+DataBlockGeneric ZarrIO::readDatasetSelection(
+    const std::string& dataPath, const std::vector<SizeArray>& selection)
+{
+  TraceScope trace("ZarrIO::readDatasetSelection", "io");
+  const std::string object = resolvePath(dataPath);
+  if (object.empty() || getObjectType(object) != StorageObjectType::Dataset) {
+    throw std::runtime_error("Failed to open dataset '" + dataPath + "'");
+  }
+  auto array = getArray(object);
+  const SizeArray dims = array->getShape();
+  const SizeType rank = dims.size();
+  if (rank == 0) {
+    return array->read({});
+  }
+  if (selection.size() != rank) {
+    throw std::invalid_argument(
+        "ZarrIO::readDatasetSelection, selection must provide one list of "
+        "indices per dimension.");
+  }
+
+  std::vector<std::vector<SizeType>> indices(rank);
+  for (SizeType d = 0; d < rank; ++d) {
+    if (selection[d].empty()) {
+      indices[d].resize(dims[d]);
+      std::iota(indices[d].begin(), indices[d].end(), SizeType {0});
+    } else {
+      for (SizeType index : selection[d]) {
+        if (index >= dims[d]) {
+          throw std::runtime_error(
+              "Selection index for dimension not within extent.");
+        }
+      }
+      indices[d].assign(selection[d].begin(), selection[d].end());
+    }
+  }
+  return array->read(indices);
+}
+
+DataBlockGeneric ZarrIO::readAttribute(const std::string& dataPath) const
+{
+  JsonValue value;
+  std::string dtype;
+  if (!findAttribute(dataPath, value, dtype)) {
+    throw std::invalid_argument(
+        "ZarrIO::readAttribute, attribute does not exist. " + dataPath);
+  }
+
+  DataBlockGeneric result;
+  if (const JsonValue* reference = getReferencePath(value)) {
+    result.baseDataType = BaseDataType::V_STR;
+    result.data = std::vector<std::string> {reference->getText()};
+    result.typeIndex = typeid(std::string);
+    return result;
+  }
+
+  std::vector<JsonValue> elements;
+  if (value.getKind() == JsonValue::Kind::Array) {
+    elements = value.getElements();
+    result.shape = SizeArray {elements.size()};
+  } else {
+    elements.push_back(value);
+  }
+  result.baseDataType = getAttributeType(value, dtype);
+  if (!Memory::visitNumericType(
+          result.baseDataType.type,
+          [&](auto typeTag)
+          {
+            using T = typename decltype(typeTag)::type;
+            std::vector<T> values;
+            values.reserve(elements.size());
+            for (const JsonValue& element : elements) {
+              values.push_back(fromJsonNumber<T>(element));
+            }
+            result.data = std::move(values);
+            result.typeIndex = typeid(T);
+          }))
+  {
+    std::vector<std::string> strings;
+    strings.reserve(elements.size());
+    for (const JsonValue& element : elements) {
+      strings.push_back(element.getText());
+    }
+    result.data = std::move(strings);
+    result.typeIndex = typeid(std::string);
+  }
+  return result;
+}
+
+std::string ZarrIO::readReferenceAttribute(const std::string& dataPath) const
+{
+  JsonValue value;
+  std::string dtype;
+  if (!findAttribute(dataPath, value, dtype)) {
+    throw std::invalid_argument(
+        "ZarrIO::readReferenceAttribute, attribute does not exist. "
+        + dataPath);
+  }
+  const JsonValue* reference = getReferencePath(value);
+  if (reference == nullptr) {
+    throw std::invalid_argument(
+        "ZarrIO::readReferenceAttribute, attribute is not a reference.");
+  }
+  return reference->getText();
+}
+
+Status ZarrIO::createAttribute(const BaseDataType& type,
+                               const void* data,
+                               const std::string& path,
+                               const std::string& name,
+                               const SizeType& size)
+{
+  TraceScope trace("ZarrIO::createAttribute", "io");
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+
+  JsonValue values = JsonValue::array();
+  std::string dtype;
+  SizeType numElements = size;
+  if (type.type == BaseDataType::Type::T_STR) {
+    // fixed-length strings of typeSize characters each
+    const auto* chars = static_cast<const char*>(data);
+    for (SizeType i = 0; i < size; ++i) {
+      const char* str = chars + i * type.typeSize;
+      values.push(JsonValue::string(
+          std::string(str, strnlen(str, static_cast<size_t>(type.typeSize)))));
+    }
+    dtype = ZarrArray::getZarrDataType(type);
+  } else if (type.type == BaseDataType::Type::V_STR) {
+    const auto* strs = static_cast<const char* const*>(data);
+    for (SizeType i = 0; i < size; ++i) {
+      values.push(JsonValue::string(strs[i]));
+    }
+  } else {
+    // Like HDF5IO, array attributes with the array length encoded in the
+    // typeSize are stored as a 1D array of the element type
+    if (type.typeSize > 1 && type.typeSize != size) {
+      numElements *= type.typeSize;
+    }
+    const BaseDataType elementType(type.type, 1);
+    dtype = ZarrArray::getZarrDataType(elementType);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    Memory::visitNumericType(type.type,
+                             [&](auto typeTag)
+                             {
+                               using T = typename decltype(typeTag)::type;
+                               for (SizeType i = 0; i < numElements; ++i) {
+                                 T value;
+                                 std::memcpy(
+                                     &value, bytes + i * sizeof(T), sizeof(T));
+                                 values.push(toJsonNumber(value));
+                               }
+                             });
+  }
+  if (size > 1 || numElements > 1 || values.getElements().empty()) {
+    return setAttribute(path, name, std::move(values), dtype, true);
+  }
+  return setAttribute(path, name, values.getElements()[0], dtype, true);
+}
+
+Status ZarrIO::createAttribute(const std::string& data,
+                               const std::string& path,
+                               const std::string& name,
+                               const bool overwrite)
+{
+  TraceScope trace("ZarrIO::createAttribute", "io");
+  return setAttribute(path, name, JsonValue::string(data), "", overwrite);
+}
+
+Status ZarrIO::createAttribute(const std::vector<std::string>& data,
+                               const std::string& path,
+                               const std::string& name,
+                               const bool overwrite)
+{
+  TraceScope trace("ZarrIO::createAttribute", "io");
+  JsonValue values = JsonValue::array();
+  for (const std::string& str : data) {
+    values.push(JsonValue::string(str));
+  }
+  return setAttribute(path, name, std::move(values), "", overwrite);
+}
+
+Status ZarrIO::createReferenceAttribute(const std::string& referencePath,
+                                        const std::string& path,
+                                        const std::string& name)
+{
+  TraceScope trace("ZarrIO::createReferenceAttribute", "io");
+  if (!canModifyObjects() || resolvePath(referencePath).empty()) {
+    return Status::Failure;
+  }
+  // hdmf-zarr stores object references as JSON objects
+  JsonValue reference = JsonValue::object();
+  reference.set("source", JsonValue::string("."));
+  reference.set("path",
+                JsonValue::string(AQNWB::mergePaths("/", referencePath)));
+  JsonValue value = JsonValue::object();
+  value.set("zarr_dtype", JsonValue::string("object"));
+  value.set("value", std::move(reference));
+  return setAttribute(path, name, std::move(value), "", true);
+}
+
+Status ZarrIO::createGroup(const std::string& path)
+{
+  std::string parent, name;
+  if (prepareNewObject(path, parent, name) != Status::Success) {
+    return Status::Failure;
+  }
+  const fs::path directory =
+      getObjectDirectory(AQNWB::mergePaths(parent, name));
+  std::error_code error;
+  fs::create_directory(directory, error);
+  if (error || !writeFile(directory / ".zgroup", getGroupMetadata())) {
+    std::cerr << "ZarrIO::createGroup failed to create " << directory
+              << std::endl;
+    return Status::Failure;
+  }
+  return Status::Success;
+}
+
+Status ZarrIO::createGroupIfDoesNotExist(const std::string& path)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  if (objectExists(path)) {
+    return Status::Success;
+  }
+  return createGroup(path);
+}
+
+Status ZarrIO::createLink(const std::string& path, const std::string& reference)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  if (!objectExists(reference)) {
+    std::cerr << "ZarrIO::createLink Reference target does not exist: "
+              << reference << std::endl;
+    return Status::Failure;  // Reference target must exist
+  }
+  std::string parent, name;
+  if (prepareNewObject(path, parent, name) != Status::Success) {
+    return Status::Failure;
+  }
+
+  // hdmf-zarr stores the soft links of a group in its attributes
+  const fs::path attributesFile = getObjectDirectory(parent) / ".zattrs";
+  JsonValue attributes = readJsonObject(attributesFile);
+  const JsonValue* existing = attributes.find(LinkAttribute);
+  JsonValue links = (existing != nullptr) ? *existing : JsonValue::array();
+  JsonValue link = JsonValue::object();
+  link.set("name", JsonValue::string(name));
+  link.set("source", JsonValue::string("."));
+  link.set("path", JsonValue::string(AQNWB::mergePaths("/", reference)));
+  links.push(std::move(link));
+  attributes.set(LinkAttribute, std::move(links));
+  return writeFile(attributesFile, attributes.dump(4)) ? Status::Success
+                                                       : Status::Failure;
+}
+
+Status ZarrIO::createStringDataSet(const std::string& path,
+                                   const std::string& value)
+{
+  auto array = createArray(
+      path, BaseDataType::STR(value.length()), false, SizeArray(), SizeArray());
+  bool extended = false;
+  if (array == nullptr
+      || array->writeStrings(SizeArray(), SizeArray(), {value}, extended)
+          != Status::Success)
+  {
+    return Status::Failure;
+  }
+  return array->flush();
+}
+
+Status ZarrIO::createStringDataSet(const std::string& path,
+                                   const std::vector<std::string>& values)
+{
+  const SizeArray shape {values.size()};
+  auto array = createArray(path,
+                           BaseDataType::V_STR,
+                           false,
+                           shape,
+                           SizeArray {std::max<SizeType>(values.size(), 1)});
+  bool extended = false;
+  if (array == nullptr
+      || (!values.empty()
+          && array->writeStrings(shape, SizeArray {0}, values, extended)
+              != Status::Success))
+  {
+    return Status::Failure;
+  }
+  return array->flush();
+}
+
+Status ZarrIO::createReferenceDataSet(
+    const std::string& path, const std::vector<std::string>& references)
+{
+  if (!canModifyObjects()) {
+    return Status::Failure;
+  }
+  std::vector<std::string> paths;
+  for (const auto& reference : references) {
+    if (resolvePath(reference).empty()) {
+      return Status::Failure;
+    }
+    paths.push_back(AQNWB::mergePaths("/", reference));
+  }
+  const SizeArray shape {references.size()};
+  auto array =
+      createArray(path,
+                  BaseDataType::V_STR,
+                  true,
+                  shape,
+                  SizeArray {std::max<SizeType>(references.size(), 1)});
+  bool extended = false;
+  if (array == nullptr
+      || (!paths.empty()
+          && array->writeStrings(shape, SizeArray {0}, paths, extended)
+              != Status::Success))
+  {
+    return Status::Failure;
+  }
+  return array->flush();
+}
+
+Status ZarrIO::startRecording()
+{
+  if (!m_opened) {
+    return Status::Failure;
+  }
+  Status status = BaseIO::startRecording();
+  return flush() && status;
+}
+
+Status ZarrIO::stopRecording()
+{
+  Status status = BaseIO::stopRecording();
+  if (m_opened && !m_readOnly) {
+    status = flush() && status;
+  }
+  return status;
+}
+
+bool ZarrIO::canModifyObjects()
+{
+  return m_opened && !m_readOnly;
+}
+
+std::unique_ptr<BaseRecordingData> ZarrIO::createArrayDataSet(
+    const BaseArrayDataSetConfig& config, const std::string& path)
+{
+  TraceScope trace("ZarrIO::createArrayDataSet", "io");
+  if (!canModifyObjects()) {
+    throw std::runtime_error(
+        "Cannot create dataset at '" + path
+        + "' because objects cannot be modified in this file.");
+  }
+
+  // Check if this is a link configuration
+  if (config.isLink()) {
+    const LinkArrayDataSetConfig* linkConfig =
+        dynamic_cast<const LinkArrayDataSetConfig*>(&config);
+    if (linkConfig) {
+      Status status = createLink(path, linkConfig->getTargetPath());
+      if (status != Status::Success) {
+        throw std::runtime_error("Failed to create link from " + path + " to "
+                                 + linkConfig->getTargetPath());
+      }
+      // Return nullptr for links as they don't provide a recordable dataset
+      return nullptr;
+    }
+  }
+
+  // Regular dataset creation
+  const ArrayDataSetConfig* arrayConfig =
+      dynamic_cast<const ArrayDataSetConfig*>(&config);
+  if (!arrayConfig) {
+    throw std::runtime_error(
+        "Invalid configuration type for dataset creation. Expected "
+        "ArrayDataSetConfig or LinkArrayDataSetConfig.");
+  }
+  const SizeArray& shape = arrayConfig->getShape();
+  if (shape.empty()) {
+    throw std::runtime_error("Invalid dimension size");
+  }
+
+  // Dimensions without chunking are stored in a single chunk
+  const SizeArray& chunking = arrayConfig->getChunking();
+  SizeArray chunks(shape.size());
+  for (SizeType i = 0; i < shape.size(); ++i) {
+    chunks[i] = (i < chunking.size() && chunking[i] > 0)
+        ? chunking[i]
+        : std::max<SizeType>(shape[i], 1);
+  }
+  auto array =
+      createArray(path, arrayConfig->getType(), false, shape, chunks);
+  if (array == nullptr) {
+    throw std::runtime_error("Failed to create dataset at path '" + path
+                             + "'");
+  }
+
+  auto recordingData = std::make_unique<ZarrRecordingData>(array);
+  recordingData->setWriteStatistics(m_writeStatistics, path);
+  return recordingData;
+}
+
+std::shared_ptr<BaseRecordingData> ZarrIO::getDataSet(const std::string& path)
+{
+  const std::string object = resolvePath(path);
+  if (object.empty() || getObjectType(object) != StorageObjectType::Dataset) {
+    return nullptr;
+  }
+  try {
+    auto recordingData = std::make_shared<ZarrRecordingData>(getArray(object));
+    recordingData->setWriteStatistics(m_writeStatistics, path);
+    return recordingData;
+  } catch (const std::runtime_error& e) {
+    std::cerr << "ZarrIO::getDataSet " << e.what() << std::endl;
+    return nullptr;
+  }
+}
+
+bool ZarrIO::objectExists(const std::string& path) const
+{
+  return !resolvePath(path, false).empty();
+}
+
+bool ZarrIO::attributeExists(const std::string& path) const
+{
+  JsonValue value;
+  std::string dtype;
+  return findAttribute(path, value, dtype);
+}
+
+std::vector<std::pair<std::string, StorageObjectType>>
+ZarrIO::getStorageObjects(const std::string& path,
+                          const StorageObjectType& objectType) const
+{
+  std::vector<std::pair<std::string, StorageObjectType>> objects;
+  visitStorageObjects(
+      path,
+      [&objects](const std::string& name, StorageObjectType type)
+      {
+        objects.emplace_back(name, type);
+        return true;
+      },
+      objectType);
+  return objects;
+}
+
+Status ZarrIO::visitStorageObjects(const std::string& path,
+                                   const StorageObjectCallback& callback,
+                                   const StorageObjectType& objectType) const
+{
+  const std::string object = resolvePath(path);
+  const StorageObjectType type =
+      object.empty() ? StorageObjectType::Undefined : getObjectType(object);
+  if (type == StorageObjectType::Undefined) {
+    return Status::Failure;
+  }
+  const fs::path directory = getObjectDirectory(object);
+  JsonValue attributes = readJsonObject(directory / ".zattrs");
+
+  // Visit the objects inside groups by name. Soft links are reported as
+  // Undefined.
+  if (type == StorageObjectType::Group
+      && objectType != StorageObjectType::Attribute)
+  {
+    std::vector<std::pair<std::string, StorageObjectType>> children;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+      std::string name = entry.path().filename().string();
+      if (name.front() == '.' || !entry.is_directory(error)) {
+        continue;
+      }
+      StorageObjectType childType =
+          getObjectType(AQNWB::mergePaths(object, name));
+      if (childType != StorageObjectType::Undefined) {
+        children.emplace_back(std::move(name), childType);
+      }
+    }
+    if (const JsonValue* links = attributes.find(LinkAttribute)) {
+      for (const JsonValue& link : links->getElements()) {
+        if (const JsonValue* name = link.find("name")) {
+          children.emplace_back(name->getText(), StorageObjectType::Undefined);
+        }
+      }
+    }
+    std::sort(children.begin(), children.end());
+    for (const auto& [name, childType] : children) {
+      if (objectType != StorageObjectType::Undefined && childType != objectType)
+      {
+        continue;
+      }
+      if (!callback(name, childType)) {
+        return Status::Success;
+      }
+    }
+  }
+
+  // Visit the attributes of groups and datasets by name
+  if (objectType == StorageObjectType::Attribute
+      || objectType == StorageObjectType::Undefined)
+  {
+    std::vector<std::string> names;
+    for (const auto& [name, value] : attributes.getMembers()) {
+      if (name != LinkAttribute) {
+        names.push_back(name);
+      }
+    }
+    std::sort(names.begin(), names.end());
+    for (const std::string& name : names) {
+      if (!callback(name, StorageObjectType::Attribute)) {
+        return Status::Success;
+      }
+    }
+  }
+  return Status::Success;
+}
+
+SizeArray ZarrIO::getStorageObjectShape(const std::string& path) const
+{
+  const std::string object = resolvePath(path);
+  if (!object.empty()) {
+    // Groups don't have a shape
+    return (getObjectType(object) == StorageObjectType::Dataset)
+        ? getArray(object)->getShape()
+        : SizeArray();
+  }
+  JsonValue value;
+  std::string dtype;
+  if (!findAttribute(path, value, dtype)) {
+    throw std::runtime_error("ZarrIO::getStorageObjectShape: Object at '"
+                             + path + "' does not exist.");
+  }
+  if (value.getKind() == JsonValue::Kind::Array) {
+    return SizeArray {value.getElements().size()};
+  }
+  return SizeArray();
+}
+
+SizeArray ZarrIO::getStorageObjectChunking(const std::string& path) const
+{
+  const std::string object = resolvePath(path);
+  if (object.empty() || getObjectType(object) != StorageObjectType::Dataset) {
+    return SizeArray();
+  }
+  return getArray(object)->getChunks();
+}
+
+BaseDataType ZarrIO::getStorageObjectDataType(const std::string& path) const
+{
+  const std::string object = resolvePath(path);
+  if (!object.empty()) {
+    if (getObjectType(object) != StorageObjectType::Dataset) {
+      throw std::runtime_error(
+          "ZarrIO::getStorageObjectDataType: Object at '" + path
+          + "' is not a dataset or attribute.");
+    }
+    auto array = getArray(object);
+    return array->isReference() ? BaseDataType::V_STR : array->getDataType();
+  }
+  JsonValue value;
+  std::string dtype;
+  if (!findAttribute(path, value, dtype)) {
+    throw std::runtime_error("ZarrIO::getStorageObjectDataType: Object at '"
+                             + path + "' does not exist.");
+  }
+  if (getReferencePath(value) != nullptr) {
+    return BaseDataType::V_STR;
+  }
+  return getAttributeType(value, dtype);
+}
@@ -0,0 +1,508 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/ReadIO.hpp"
+#include "io/zarr/ZarrArray.hpp"
+#include "io/zarr/ZarrJson.hpp"
+
+namespace AQNWB::IO::Zarr
+{
+/**
+ * @brief The ZarrIO class writes and reads NWB files as Zarr (v2) directory
+ * stores on the local filesystem, following the NWB Zarr conventions of
+ * hdmf-zarr.
+ *
+ * Groups are directories with a `.zgroup` file, datasets are chunked arrays
+ * (see ZarrArray) with one file per chunk, and attributes are stored as JSON
+ * in the `.zattrs` file of their group or dataset. Soft links are stored in
+ * the `zarr_link` attribute of their parent group and object references as
+ * JSON objects with the path of the referenced object. Since JSON numbers
+ * have no type, the exact types of numeric attributes are kept in an
+ * additional `.aqnwb_dtypes` file, which is ignored by other Zarr readers.
+ *
+ * Since every chunk is a separate file, data of different datasets is
+ * written, and compressed with zlib if a compression level is set, in
+ * parallel without a global lock. Chunks are stored once a write starts in a
+ * later chunk along the first dimension, and on flush, by a bounded pool of
+ * worker threads that is shared by all datasets of the file. flush() waits
+ * for all chunks to be stored and close() joins the threads.
+ *
+ * A ZarrIO opened with FileMode::ReadOnly reads the metadata of a dataset
+ * on every read, such that data flushed by a writer in another process is
+ * visible immediately, similar to SWMR mode in HDF5. Files and chunks are
+ * replaced atomically, such that readers never see partially written files.
+ */
+class ZarrIO : public BaseIO
+{
+public:
+  /**
+   * @brief Constructor for the ZarrIO class.
+   * @param fileName The path of the directory of the Zarr store.
+   * @param compressionLevel The zlib compression level (1-9) of the chunks
+   * of datasets created with this object, or 0 to store the chunks
+   * uncompressed. Ignored if AqNWB was built without zlib.
+   */
+  explicit ZarrIO(const std::string& fileName, int compressionLevel = 0);
+
+  /**
+   * @brief Destructor. Flushes and closes the file if it is open.
+   */
+  ~ZarrIO() override;
+
+  /**
+   * @brief Opens an existing store for reading and writing, or creates a new
+   * store if the directory does not exist.
+   * @return The status of the file opening operation.
+   */
+  Status open() override;
+
+  /**
+   * @brief Opens an existing store or creates a new store.
+   * @param mode Access mode to use when opening the file. Overwrite replaces
+   * an existing Zarr store, but fails for directories that are not empty and
+   * not a Zarr store. ReadWrite and ReadOnly fail if there is no store.
+   * @return The status of the file opening operation.
+   */
+  Status open(FileMode mode) override;
+
+  /**
+   * @brief Flushes all data and closes the file.
+   * @return The status of the file closing operation.
+   */
+  Status close() override;
+
+  /**
+   * @brief Stores all modified chunks and the metadata of all datasets.
+   * @return The status of the flush operation.
+   */
+  Status flush() override;
+
+  /**
+   * @brief  Get the storage type (Group, Dataset, Attribute) of the object at
+   * path
+   * @param path The path of the object in the file
+   * @return The StorageObjectType. May be Undefined if the object does not
+   * exist.
+   */
+  StorageObjectType getStorageObjectType(std::string path) const override;
+
+  /**
+   * @brief Reads a dataset or a slice of a dataset.
+   *
+   * The slice is defined by a hyperslab of `count` blocks of size `block`
+   * separated by `stride` starting at `start` for each dimension, like in
+   * HDF5.
+   *
+   * @param dataPath The path to the dataset within the file.
+   * @param start The starting indices for the slice (optional).
+   * @param count The number of blocks to read for each dimension (optional).
+   * @param stride The stride for each dimension (optional).
+   * @param block The block size for each dimension (optional).
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::runtime_error if the dataset does not exist or if the slice
+   * is not within the extent of the dataset.
+   */
+  DataBlockGeneric readDataset(const std::string& dataPath,
+                               const SizeArray& start = {},
+                               const SizeArray& count = {},
+                               const SizeArray& stride = {},
+                               const SizeArray& block = {}) override;
+
+  /**
+   * @brief Reads an arbitrary selection of a dataset defined by a list of
+   * indices per dimension.
+   * @param dataPath The path to the dataset within the file.
+   * @param selection One list of indices per dimension of the dataset. An
+   * empty list selects all indices along the dimension.
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::invalid_argument if the selection does not have one list per
+   * dimension.
+   * @throws std::runtime_error if the dataset does not exist or if an index is
+   * not within the extent of the dataset.
+   */
+  DataBlockGeneric readDatasetSelection(
+      const std::string& dataPath,
+      const std::vector<SizeArray>& selection) override;
+
+  /**
+   * @brief Reads an attribute and determines the data type
+   * @param dataPath The path to the attribute within the file.
+   * @return A DataGeneric structure containing the data and shape.
+   * @throws std::invalid_argument if the attribute does not exist.
+   */
+  DataBlockGeneric readAttribute(const std::string& dataPath) const override;
+
+  /**
+   * @brief Reads a reference attribute and returns the path to the referenced
+   * object.
+   * @param dataPath The path to the reference attribute within the file.
+   * @return The path to the referenced object.
+   * @throws std::invalid_argument if the attribute does not exist or is not a
+   * reference.
+   */
+  std::string readReferenceAttribute(
+      const std::string& dataPath) const override;
+
+  /**
+   * @brief Creates an attribute at a given location in the file. Existing
+   * attributes are overwritten.
+   * @param type The base data type of the attribute.
+   * @param data Pointer to the attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param size The size of the attribute (default is 1).
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const BaseDataType& type,
+                         const void* data,
+                         const std::string& path,
+                         const std::string& name,
+                         const SizeType& size = 1) override;
+
+  /**
+   * @brief Creates a string attribute at a given location in the file.
+   * @param data The string attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::string& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Creates an array of variable length strings attribute at a given
+   * location in the file.
+   * @param data The string array attribute data.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @param overwrite Overwrite the attribute if it already exists.
+   * @return The status of the attribute creation operation.
+   */
+  Status createAttribute(const std::vector<std::string>& data,
+                         const std::string& path,
+                         const std::string& name,
+                         const bool overwrite = false) override;
+
+  /**
+   * @brief Sets an object reference attribute for a given location in the
+   * file.
+   * @param referencePath The full path to the referenced group / dataset.
+   * @param path The location in the file to set the attribute.
+   * @param name The name of the attribute.
+   * @return The status of the attribute creation operation.
+   */
+  Status createReferenceAttribute(const std::string& referencePath,
+                                  const std::string& path,
+                                  const std::string& name) override;
+
+  /**
+   * @brief Creates a new group in the file. The parent group must exist.
+   * @param path The location in the file of the new group.
+   * @return The status of the group creation operation.
+   */
+  Status createGroup(const std::string& path) override;
+
+  /**
+   * @brief Creates a soft link to another location in the file.
+   * @param path The location in the file to the new link.
+   * @param reference The location in the file of the object that is being
+   * linked to.
+   * @return The status of the link creation operation.
+   */
+  Status createLink(const std::string& path,
+                    const std::string& reference) override;
+
+  /**
+   * @brief Creates a scalar dataset with a fixed-length string value.
+   * @param path The location in the file of the dataset.
+   * @param value The string value of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::string& value) override;
+
+  /**
+   * @brief Creates a dataset that holds an array of variable length strings.
+   * @param path The location in the file of the dataset.
+   * @param values The vector of string values of the dataset.
+   * @return The status of the dataset creation operation.
+   */
+  Status createStringDataSet(const std::string& path,
+                             const std::vector<std::string>& values) override;
+
+  /**
+   * @brief Creates a dataset that holds an array of references to groups
+   * within the file.
+   * @param path The location in the file of the new dataset.
+   * @param references The array of references.
+   * @return The status of the dataset creation operation.
+   */
+  Status createReferenceDataSet(
+      const std::string& path,
+      const std::vector<std::string>& references) override;
+
+  /**
+   * @brief Starts the recording process and flushes the file, such that
+   * readers see all objects created before recording.
+   * @return The status of the operation. Fails if the file is not open.
+   */
+  Status startRecording() override;
+
+  /**
+   * @brief Stops the recording process and flushes all data to disk.
+   * @return The status of the operation.
+   */
+  Status stopRecording() override;
+
+  /**
+   * @brief Returns true if the file is open for writing.
+   * @return True if objects can be added, false otherwise.
+   */
+  bool canModifyObjects() override;
+
+  /**
+   * @brief Creates an extendable dataset with the given configuration and
+   * path.
+   * @param config The configuration for the dataset, including type, shape,
+   * and chunking. Dimensions with chunking 0 use their size as chunk size.
+   * All dimensions can be extended by writes. Can also be a
+   * LinkArrayDataSetConfig to create a soft-link.
+   * @param path The location in the file of the new dataset.
+   * @return A pointer to the created dataset. Returns nullptr for links.
+   * @throws std::runtime_error if dataset or link creation fails.
+   */
+  std::unique_ptr<BaseRecordingData> createArrayDataSet(
+      const BaseArrayDataSetConfig& config, const std::string& path) override;
+
+  /**
+   * @brief Returns a pointer to a dataset at a given path.
+   * @param path The location in the file of the dataset.
+   * @return A shared pointer to the dataset, or nullptr if the file is not
+   * open or the dataset does not exist.
+   */
+  std::shared_ptr<BaseRecordingData> getDataSet(
+      const std::string& path) override;
+
+  /**
+   * @brief Checks whether a Dataset, Group, or Link already exists at the
+   * location in the file.
+   * @param path The location of the object in the file.
+   * @return Whether the object exists.
+   */
+  bool objectExists(const std::string& path) const override;
+
+  /**
+   * @brief Checks whether an Attribute exists at the location in the file.
+   * @param path The location of the attribute in the file.
+   * @return Whether the attribute exists.
+   */
+  bool attributeExists(const std::string& path) const override;
+
+  /**
+   * @brief Gets the list of storage objects (groups, datasets, attributes)
+   * inside a group.
+   *
+   * Objects are listed by name, followed by the attributes. Soft links are
+   * reported as StorageObjectType::Undefined.
+   *
+   * @param path The path to the group.
+   * @param objectType Define which types of storage object to look for.
+   * @return A vector of pairs of relative paths and their corresponding
+   * storage object types.
+   */
+  std::vector<std::pair<std::string, StorageObjectType>> getStorageObjects(
+      const std::string& path,
+      const StorageObjectType& objectType =
+          StorageObjectType::Undefined) const override;
+
+  /**
+   * @brief Streams the storage objects inside a group to a callback in the
+   * same order as getStorageObjects.
+   * @param path The path to the group.
+   * @param callback The function to call for each object.
+   * @param objectType Define which types of storage object to look for.
+   * @return Status::Failure if the path is not a group or dataset.
+   */
+  Status visitStorageObjects(const std::string& path,
+                             const StorageObjectCallback& callback,
+                             const StorageObjectType& objectType =
+                                 StorageObjectType::Undefined) const override;
+
+  /**
+   * @brief Returns the size of the dataset or attribute for each dimension.
+   * @param path The location of the dataset or attribute in the file
+   * @return The shape of the dataset or attribute. Empty for groups.
+   * @throws std::runtime_error if the object does not exist.
+   */
+  SizeArray getStorageObjectShape(const std::string& path) const override;
+
+  /**
+   * @brief Gets the chunking configuration of a dataset.
+   * @param path The path to the dataset.
+   * @return The shape of the chunks of the array, or an empty SizeArray if
+   * the path is not a dataset.
+   */
+  SizeArray getStorageObjectChunking(const std::string& path) const override;
+
+  /**
+   * @brief Gets the BaseDataType of a dataset or attribute.
+   * @param path The path to the dataset or attribute.
+   * @return The BaseDataType of the dataset or attribute. Object references
+   * are reported as BaseDataType::V_STR.
+   * @throws std::runtime_error if the object is a Group or does not exist.
+   */
+  BaseDataType getStorageObjectDataType(
+      const std::string& path) const override;
+
+  /**
+   * @brief Get the zlib compression level of new datasets
+   */
+  inline int getCompressionLevel() const { return m_compressionLevel; }
+
+protected:
+  /**
+   * @brief Creates a new group if it does not already exist.
+   * @param path The location of the group in the file.
+   * @return The status of the operation.
+   */
+  Status createGroupIfDoesNotExist(const std::string& path) override;
+
+private:
+  /**
+   * @brief Get the directory of an object in the store
+   * @param path The path of the object, with links resolved
+   */
+  std::filesystem::path getObjectDirectory(const std::string& path) const;
+
+  /**
+   * @brief Resolve a path to the path of the object it refers to, following
+   * soft links.
+   * @param path The path of the object
+   * @param followLinks Whether to resolve a link at the end of the path.
+   * Links in the parent path are always followed.
+   * @param depth The number of links followed so far
+   * @return The normalized path of the object, or an empty string if the
+   * object does not exist.
+   */
+  std::string resolvePath(const std::string& path,
+                          bool followLinks = true,
+                          int depth = 0) const;
+
+  /**
+   * @brief Get the type of an object from its directory
+   * @param path The path of the object, with links resolved
+   * @return Group, Dataset, or Undefined if there is no such object
+   */
+  StorageObjectType getObjectType(const std::string& path) const;
+
+  /**
+   * @brief Get the target of a link in a group
+   * @param group The path of the group, with links resolved
+   * @param name The name of the link
+   * @return The path of the target, or an empty string if there is no link
+   */
+  std::string findLink(const std::string& group,
+                       const std::string& name) const;
+
+  /**
+   * @brief Check that an object can be created at a path
+   * @param path The path of the new object
+   * @param parent The resolved path of the parent group (return value)
+   * @param name The name of the new object (return value)
+   * @return Status::Failure if the file is read-only, the parent group does
+   * not exist, or an object already exists at the path.
+   */
+  Status prepareNewObject(const std::string& path,
+                          std::string& parent,
+                          std::string& name);
+
+  /**
+   * @brief Find the attribute at a path
+   * @param path The path of the attribute
+   * @param value The JSON value of the attribute (return value)
+   * @param dtype The Zarr dtype of numeric and fixed-length string
+   * attributes, or an empty string (return value)
+   * @return False if the attribute does not exist.
+   */
+  bool findAttribute(const std::string& path,
+                     JsonValue& value,
+                     std::string& dtype) const;
+
+  /**
+   * @brief Add or replace an attribute of a group or dataset
+   * @param path The path of the group or dataset
+   * @param name The name of the attribute
+   * @param value The JSON value of the attribute
+   * @param dtype The Zarr dtype of the value, or an empty string for
+   * variable-length strings and references
+   * @param overwrite Whether to replace an existing attribute
+   * @return The status of the operation.
+   */
+  Status setAttribute(const std::string& path,
+                      const std::string& name,
+                      JsonValue value,
+                      const std::string& dtype,
+                      bool overwrite);
+
+  /**
+   * @brief Get the array of a dataset. Writers keep the arrays in memory,
+   * readers load the current metadata on every call.
+   * @param path The path of the dataset, with links resolved
+   * @return The array
+   * @throws std::runtime_error if there is no dataset at the path
+   */
+  std::shared_ptr<ZarrArray> getArray(const std::string& path) const;
+
+  /**
+   * @brief Create the directory and metadata of a new array
+   * @param path The path of the new dataset
+   * @param type The data type of the elements
+   * @param isReference Whether the array holds object references
+   * @param shape The shape of the array
+   * @param chunks The shape of the chunks
+   * @return The array, or nullptr if the array cannot be created
+   */
+  std::shared_ptr<ZarrArray> createArray(const std::string& path,
+                                         const BaseDataType& type,
+                                         bool isReference,
+                                         const SizeArray& shape,
+                                         const SizeArray& chunks);
+
+  /**
+   * @brief The zlib compression level of new datasets
+   */
+  int m_compressionLevel = 0;
+
+  /**
+   * @brief Whether the file was opened read-only
+   */
+  bool m_readOnly = false;
+
+  /**
+   * @brief The arrays of the datasets of a writer by their resolved path
+   */
+  mutable std::map<std::string, std::shared_ptr<ZarrArray>> m_arrays;
+
+  /**
+   * @brief Mutex protecting m_arrays
+   */
+  mutable std::mutex m_arraysMutex;
+
+  /**
+   * @brief The worker threads storing the chunks of the arrays
+   */
+  std::shared_ptr<ZarrWorkerPool> m_workerPool;
+};
+
+}  // namespace AQNWB::IO::Zarr
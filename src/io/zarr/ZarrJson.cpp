@@ -0,0 +1,574 @@
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "io/zarr/ZarrJson.hpp"
+
+using namespace AQNWB::IO::Zarr;
+
+namespace
+{
+/**
+ * @brief Maximum nesting depth of parsed documents
+ */
+constexpr int MaxDepth = 256;
+
+/**
+ * @brief Recursive descent parser for JSON text
+ */
+class JsonParser
+{
+public:
+  explicit JsonParser(std::string_view text)
+      : m_text(text)
+  {
+  }
+
+  JsonValue parseDocument()
+  {
+    JsonValue value = parseValue(0);
+    skipWhitespace();
+    if (m_pos != m_text.size()) {
+      fail("unexpected trailing characters");
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void fail(const std::string& message) const
+  {
+    throw std::runtime_error("Invalid JSON at position "
+                             + std::to_string(m_pos) + ": " + message);
+  }
+
+  void skipWhitespace()
+  {
+    while (m_pos < m_text.size()
+           && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t'
+               || m_text[m_pos] == '\n' || m_text[m_pos] == '\r'))
+    {
+      ++m_pos;
+    }
+  }
+
+  bool consume(std::string_view token)
+  {
+    if (m_text.substr(m_pos, token.size()) == token) {
+      m_pos += token.size();
+      return true;
+    }
+    return false;
+  }
+
+  JsonValue parseValue(int depth)
+  {
+    if (depth > MaxDepth) {
+      fail("maximum nesting depth exceeded");
+    }
+    skipWhitespace();
+    if (m_pos >= m_text.size()) {
+      fail("unexpected end of input");
+    }
+    char c = m_text[m_pos];
+    if (c == '{') {
+      return parseObject(depth);
+    } else if (c == '[') {
+      return parseArray(depth);
+    } else if (c == '"') {
+      return JsonValue::string(parseString());
+    } else if (consume("true")) {
+      return JsonValue::boolean(true);
+    } else if (consume("false")) {
+      return JsonValue::boolean(false);
+    } else if (consume("null")) {
+      return JsonValue();
+    } else if (consume("NaN")) {
+      // Not valid JSON, but written by Python's json module
+      return JsonValue::string("NaN");
+    } else if (consume("Infinity")) {
+      return JsonValue::string("Infinity");
+    } else if (consume("-Infinity")) {
+      return JsonValue::string("-Infinity");
+    }
+    return parseNumber();
+  }
+
+  JsonValue parseObject(int depth)
+  {
+    JsonValue result = JsonValue::object();
+    ++m_pos;  // '{'
+    skipWhitespace();
+    if (consume("}")) {
+      return result;
+    }
+    while (true) {
+      skipWhitespace();
+      if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+        fail("expected string key");
+      }
+      std::string key = parseString();
+      skipWhitespace();
+      if (!consume(":")) {
+        fail("expected ':'");
+      }
+      result.set(key, parseValue(depth + 1));
+      skipWhitespace();
+      if (consume("}")) {
+        return result;
+      }
+      if (!consume(",")) {
+        fail("expected ',' or '}'");
+      }
+    }
+  }
+
+  JsonValue parseArray(int depth)
+  {
+    JsonValue result = JsonValue::array();
+    ++m_pos;  // '['
+    skipWhitespace();
+    if (consume("]")) {
+      return result;
+    }
+    while (true) {
+      result.push(parseValue(depth + 1));
+      skipWhitespace();
+      if (consume("]")) {
+        return result;
+      }
+      if (!consume(",")) {
+        fail("expected ',' or ']'");
+      }
+    }
+  }
+
+  unsigned parseHex4()
+  {
+    if (m_pos + 4 > m_text.size()) {
+      fail("truncated unicode escape");
+    }
+    unsigned value = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = m_text[m_pos++];
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= static_cast<unsigned>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        value |= static_cast<unsigned>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        value |= static_cast<unsigned>(c - 'A' + 10);
+      } else {
+        fail("invalid unicode escape");
+      }
+    }
+    return value;
+  }
+
+  static void appendUtf8(std::string& out, unsigned codePoint)
+  {
+    if (codePoint < 0x80) {
+      out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      out += static_cast<char>(0xC0 | (codePoint >> 6));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+      out += static_cast<char>(0xE0 | (codePoint >> 12));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (codePoint >> 18));
+      out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  std::string parseString()
+  {
+    ++m_pos;  // '"'
+    std::string result;
+    while (true) {
+      if (m_pos >= m_text.size()) {
+        fail("unterminated string");
+      }
+      char c = m_text[m_pos++];
+      if (c == '"') {
+        return result;
+      }
+      if (c != '\\') {
+        result += c;
+        continue;
+      }
+      if (m_pos >= m_text.size()) {
+        fail("unterminated escape");
+      }
+      char e = m_text[m_pos++];
+      switch (e) {
+        case '"':
+        case '\\':
+        case '/':
+          result += e;
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u': {
+          unsigned codePoint = parseHex4();
+          if (codePoint >= 0xD800 && codePoint < 0xDC00 && consume("\\u")) {
+            unsigned low = parseHex4();
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          }
+          appendUtf8(result, codePoint);
+          break;
+        }
+        default:
+          fail("invalid escape");
+      }
+    }
+  }
+
+  JsonValue parseNumber()
+  {
+    size_t start = m_pos;
+    if (m_pos < m_text.size() && m_text[m_pos] == '-') {
+      ++m_pos;
+    }
+    while (m_pos < m_text.size()
+           && (std::isdigit(static_cast<unsigned char>(m_text[m_pos]))
+               || m_text[m_pos] == '.' || m_text[m_pos] == 'e'
+               || m_text[m_pos] == 'E' || m_text[m_pos] == '+'
+               || m_text[m_pos] == '-'))
+    {
+      ++m_pos;
+    }
+    if (m_pos == start) {
+      fail("unexpected character");
+    }
+    return JsonValue::number(std::string(m_text.substr(start, m_pos - start)));
+  }
+
+  std::string_view m_text;
+  size_t m_pos = 0;
+};
+
+/**
+ * @brief Append a string to JSON text as a quoted and escaped string
+ */
+void appendQuoted(std::string& out, const std::string& text)
+{
+  out += '"';
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          out += buffer;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+/**
+ * @brief Append a line break and indentation for pretty printing
+ */
+void appendIndent(std::string& out, int indent, int depth)
+{
+  if (indent >= 0) {
+    out += '\n';
+    out.append(static_cast<size_t>(indent * depth), ' ');
+  }
+}
+}  // namespace
+
+JsonValue JsonValue::string(std::string value)
+{
+  JsonValue result;
+  result.m_kind = Kind::String;
+  result.m_text = std::move(value);
+  return result;
+}
+
+JsonValue JsonValue::boolean(bool value)
+{
+  JsonValue result;
+  result.m_kind = Kind::Bool;
+  result.m_bool = value;
+  return result;
+}
+
+JsonValue JsonValue::number(std::string literal)
+{
+  JsonValue result;
+  result.m_kind = Kind::Number;
+  result.m_text = std::move(literal);
+  return result;
+}
+
+JsonValue JsonValue::array()
+{
+  JsonValue result;
+  result.m_kind = Kind::Array;
+  return result;
+}
+
+JsonValue JsonValue::object()
+{
+  JsonValue result;
+  result.m_kind = Kind::Object;
+  return result;
+}
+
+JsonValue JsonValue::fromInt(int64_t value)
+{
+  return number(std::to_string(value));
+}
+
+JsonValue JsonValue::fromUInt(uint64_t value)
+{
+  return number(std::to_string(value));
+}
+
+JsonValue JsonValue::fromDouble(double value, int digits)
+{
+  if (std::isnan(value)) {
+    return string("NaN");
+  }
+  if (std::isinf(value)) {
+    return string(value > 0 ? "Infinity" : "-Infinity");
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+  std::string literal(buffer);
+  // Mark the value as floating point to keep its type on reading
+  if (literal.find_first_of(".eE") == std::string::npos) {
+    literal += ".0";
+  }
+  return number(std::move(literal));
+}
+
+JsonValue JsonValue::parse(std::string_view text)
+{
+  return JsonParser(text).parseDocument();
+}
+
+std::string JsonValue::dump(int indent) const
+{
+  std::string out;
+  dump(out, indent, 0);
+  return out;
+}
+
+void JsonValue::dump(std::string& out, int indent, int depth) const
+{
+  switch (m_kind) {
+    case Kind::Null:
+      out += "null";
+      break;
+    case Kind::Bool:
+      out += m_bool ? "true" : "false";
+      break;
+    case Kind::Number:
+      out += m_text;
+      break;
+    case Kind::String:
+      appendQuoted(out, m_text);
+      break;
+    case Kind::Array:
+      out += '[';
+      for (size_t i = 0; i < m_elements.size(); ++i) {
+        out += (i > 0) ? (indent >= 0 ? "," : ", ") : "";
+        appendIndent(out, indent, depth + 1);
+        m_elements[i].dump(out, indent, depth + 1);
+      }
+      if (!m_elements.empty()) {
+        appendIndent(out, indent, depth);
+      }
+      out += ']';
+      break;
+    case Kind::Object:
+      out += '{';
+      for (size_t i = 0; i < m_members.size(); ++i) {
+        out += (i > 0) ? (indent >= 0 ? "," : ", ") : "";
+        appendIndent(out, indent, depth + 1);
+        appendQuoted(out, m_members[i].first);
+        out += ": ";
+        m_members[i].second.dump(out, indent, depth + 1);
+      }
+      if (!m_members.empty()) {
+        appendIndent(out, indent, depth);
+      }
+      out += '}';
+      break;
+  }
+}
+
+bool JsonValue::isInteger() const
+{
+  return m_kind == Kind::Number
+      && m_text.find_first_of(".eE") == std::string::npos;
+}
+
+int64_t JsonValue::toInt() const
+{
+  if (m_kind != Kind::Number) {
+    throw std::runtime_error("JSON value is not a number");
+  }
+  return isInteger() ? std::stoll(m_text)
+                     : static_cast<int64_t>(std::stod(m_text));
+}
+
+uint64_t JsonValue::toUInt() const
+{
+  if (m_kind != Kind::Number) {
+    throw std::runtime_error("JSON value is not a number");
+  }
+  return isInteger() ? std::stoull(m_text)
+                     : static_cast<uint64_t>(std::stod(m_text));
+}
+
+double JsonValue::toDouble() const
+{
+  if (m_kind == Kind::String) {
+    if (m_text == "NaN") {
+      return std::numeric_limits<double>::quiet_NaN();
+    } else if (m_text == "Infinity") {
+      return std::numeric_limits<double>::infinity();
+    } else if (m_text == "-Infinity") {
+      return -std::numeric_limits<double>::infinity();
+    }
+  }
+  if (m_kind != Kind::Number) {
+    throw std::runtime_error("JSON value is not a number");
+  }
+  return std::stod(m_text);
+}
+
+void JsonValue::push(JsonValue value)
+{
+  m_elements.push_back(std::move(value));
+}
+
+const JsonValue* JsonValue::find(std::string_view key) const
+{
+  for (const auto& member : m_members) {
+    if (member.first == key) {
+      return &member.second;
+    }
+  }
+  return nullptr;
+}
+
+void JsonValue::set(const std::string& key, JsonValue value)
+{
+  for (auto& member : m_members) {
+    if (member.first == key) {
+      member.second = std::move(value);
+      return;
+    }
+  }
+  m_members.emplace_back(key, std::move(value));
+}
+
+bool JsonValue::erase(std::string_view key)
+{
+  for (auto it = m_members.begin(); it != m_members.end(); ++it) {
+    if (it->first == key) {
+      m_members.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AQNWB::IO::Zarr::readFile(const std::filesystem::path& path,
+                               std::string& contents)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff size = file.tellg();
+  if (size < 0) {
+    return false;
+  }
+  contents.resize(static_cast<size_t>(size));
+  file.seekg(0, std::ios::beg);
+  file.read(contents.data(), size);
+  return static_cast<bool>(file);
+}
+
+bool AQNWB::IO::Zarr::writeFile(const std::filesystem::path& path,
+                                std::string_view contents)
+{
+  // hidden temporary files are ignored by Zarr readers
+  std::filesystem::path temporary = path;
+  temporary.replace_filename("." + path.filename().string() + ".tmp");
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+    file.write(contents.data(),
+               static_cast<std::streamsize>(contents.size()));
+    if (!file) {
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+JsonValue AQNWB::IO::Zarr::readJsonFile(const std::filesystem::path& path)
+{
+  std::string text;
+  if (!readFile(path, text)) {
+    throw std::runtime_error("Failed to read " + path.string());
+  }
+  try {
+    return JsonValue::parse(text);
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error("Invalid JSON in " + path.string() + ": "
+                             + e.what());
+  }
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*!
+ * \namespace AQNWB::IO::Zarr
+ * \brief Namespace for all components of the Zarr I/O backend
+ */
+namespace AQNWB::IO::Zarr
+{
+/**
+ * @brief A minimal JSON value used for the metadata of Zarr stores, i.e.,
+ * `.zgroup`, `.zarray`, and `.zattrs` files.
+ *
+ * Numbers keep their literal text, such that 64-bit integers are read and
+ * written without loss of precision. Objects keep the order of insertion.
+ */
+class JsonValue
+{
+public:
+  /**
+   * @brief The kind of a JSON value
+   */
+  enum class Kind
+  {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  /**
+   * @brief Construct a null value
+   */
+  JsonValue() = default;
+
+  /**
+   * @brief Construct a string value
+   */
+  static JsonValue string(std::string value);
+
+  /**
+   * @brief Construct a boolean value
+   */
+  static JsonValue boolean(bool value);
+
+  /**
+   * @brief Construct a number from its literal text, e.g., "1.5"
+   */
+  static JsonValue number(std::string literal);
+
+  /**
+   * @brief Construct an empty array
+   */
+  static JsonValue array();
+
+  /**
+   * @brief Construct an empty object
+   */
+  static JsonValue object();
+
+  /**
+   * @brief Construct a number from an integer
+   */
+  static JsonValue fromInt(int64_t value);
+
+  /**
+   * @brief Construct a number from an unsigned integer
+   */
+  static JsonValue fromUInt(uint64_t value);
+
+  /**
+   * @brief Construct a number from a floating point value. NaN and infinity
+   * are not valid JSON and are written as the strings "NaN", "Infinity",
+   * and "-Infinity" like in Zarr.
+   * @param value The value
+   * @param digits The number of significant digits to write
+   */
+  static JsonValue fromDouble(double value, int digits = 17);
+
+  /**
+   * @brief Parse a JSON document
+   * @param text The JSON text
+   * @return The parsed value
+   * @throws std::runtime_error if the text is not valid JSON
+   */
+  static JsonValue parse(std::string_view text);
+
+  /**
+   * @brief Serialize the value as JSON text
+   * @param indent The number of spaces to indent nested values, or -1 to
+   * write everything on a single line
+   * @return The JSON text
+   */
+  std::string dump(int indent = -1) const;
+
+  /**
+   * @brief Get the kind of the value
+   */
+  inline Kind getKind() const { return m_kind; }
+
+  /**
+   * @brief Check whether the value is a number that is written without
+   * fraction or exponent, i.e., an integer
+   */
+  bool isInteger() const;
+
+  /**
+   * @brief Get the value of a boolean
+   */
+  inline bool getBool() const { return m_bool; }
+
+  /**
+   * @brief Get the text of a string or the literal of a number
+   */
+  inline const std::string& getText() const { return m_text; }
+
+  /**
+   * @brief Get a number as a signed integer
+   */
+  int64_t toInt() const;
+
+  /**
+   * @brief Get a number as an unsigned integer
+   */
+  uint64_t toUInt() const;
+
+  /**
+   * @brief Get a number, or one of the strings "NaN", "Infinity", and
+   * "-Infinity", as a floating point value
+   */
+  double toDouble() const;
+
+  /**
+   * @brief Get the elements of an array
+   */
+  inline const std::vector<JsonValue>& getElements() const
+  {
+    return m_elements;
+  }
+
+  /**
+   * @brief Append an element to an array
+   */
+  void push(JsonValue value);
+
+  /**
+   * @brief Get the members of an object in the order of insertion
+   */
+  inline const std::vector<std::pair<std::string, JsonValue>>& getMembers()
+      const
+  {
+    return m_members;
+  }
+
+  /**
+   * @brief Find a member of an object
+   * @return The member or nullptr if the object has no member with the key
+   */
+  const JsonValue* find(std::string_view key) const;
+
+  /**
+   * @brief Set a member of an object, replacing an existing member with the
+   * same key
+   */
+  void set(const std::string& key, JsonValue value);
+
+  /**
+   * @brief Remove a member of an object
+   * @return Whether the member existed
+   */
+  bool erase(std::string_view key);
+
+private:
+  /**
+   * @brief Append the JSON text of the value to a string
+   */
+  void dump(std::string& out, int indent, int depth) const;
+
+  /**
+   * @brief The kind of the value
+   */
+  Kind m_kind = Kind::Null;
+
+  /**
+   * @brief The value of a boolean
+   */
+  bool m_bool = false;
+
+  /**
+   * @brief The text of a string or the literal of a number
+   */
+  std::string m_text;
+
+  /**
+   * @brief The elements of an array
+   */
+  std::vector<JsonValue> m_elements;
+
+  /**
+   * @brief The members of an object
+   */
+  std::vector<std::pair<std::string, JsonValue>> m_members;
+};
+
+/**
+ * @brief Read the contents of a file of the store
+ * @param path The path of the file
+ * @param contents The contents of the file (return value)
+ * @return False if the file does not exist or cannot be read
+ */
+bool readFile(const std::filesystem::path& path, std::string& contents);
+
+/**
+ * @brief Write a file of the store atomically, i.e., by writing to a
+ * temporary file that replaces the file, such that readers never see a
+ * partially written file.
+ * @param path The path of the file
+ * @param contents The contents to write
+ * @return False if the file cannot be written
+ */
+bool writeFile(const std::filesystem::path& path, std::string_view contents);
+
+/**
+ * @brief Read and parse a JSON file of the store
+ * @param path The path of the file
+ * @return The parsed value
+ * @throws std::runtime_error if the file cannot be read or is not valid JSON
+ */
+JsonValue readJsonFile(const std::filesystem::path& path);
+}  // namespace AQNWB::IO::Zarr
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "io/zarr/ZarrRecordingData.hpp"
+
+#include "Tracing.hpp"
+#include "io/memory/MemoryIO.hpp"
+
+using namespace AQNWB::IO;
+using namespace AQNWB::IO::Zarr;
+using AQNWB::IO::Memory::MemoryIO;
+
+ZarrRecordingData::ZarrRecordingData(std::shared_ptr<ZarrArray> array)
+    : m_array(std::move(array))
+{
+  m_shape = m_array->getShape();
+  m_position = SizeArray(m_shape.size(), 0);
+}
+
+ZarrRecordingData::~ZarrRecordingData() {}
+
+Status ZarrRecordingData::writeDataBlockImpl(const SizeArray& dataShape,
+                                             const SizeArray& positionOffset,
+                                             const BaseDataType& type,
+                                             const void* data)
+{
+  TraceScope trace("ZarrRecordingData::writeDataBlock", "io");
+  // check type. Strings should use the other variant of this function
+  Status status = Status::Failure;
+  bool extended = false;
+  if (MemoryIO::getTypeSize(type) == 0) {
+    std::cerr << "ZarrRecordingData::writeDataBlock called for string data, "
+                 "use ZarrRecordingData::writeDataBlock with a string array "
+                 "data input instead of void* data."
+              << std::endl;
+  } else if (MemoryIO::getTypeSize(m_array->getDataType()) == 0
+             || m_array->isReference())
+  {
+    std::cerr << "ZarrRecordingData::writeDataBlock numeric data for a "
+                 "non-numeric dataset"
+              << std::endl;
+  } else {
+    status = m_array->writeValues(
+        dataShape, positionOffset, type.type, data, extended);
+  }
+  if (status == Status::Success) {
+    finishWrite(dataShape, extended);
+  }
+  return status;
+}
+
+Status ZarrRecordingData::writeDataBlockImpl(
+    const SizeArray& dataShape,
+    const SizeArray& positionOffset,
+    const AQNWB::IO::BaseDataType& type,
+    const std::vector<std::string>& data)
+{
+  TraceScope trace("ZarrRecordingData::writeDataBlock", "io");
+  Status status = Status::Failure;
+  bool extended = false;
+  const BaseDataType& targetType = m_array->getDataType();
+  if (type.type != BaseDataType::Type::V_STR
+      && type.type != BaseDataType::Type::T_STR)
+  {
+    std::cerr
+        << "ZarrRecordingData::writeDataBlock non-string type for string data"
+        << std::endl;
+  } else if (MemoryIO::getTypeSize(targetType) != 0 || m_array->isReference())
+  {
+    std::cerr << "ZarrRecordingData::writeDataBlock string data for a "
+                 "non-string dataset"
+              << std::endl;
+  } else {
+    bool valid = true;
+    if (type.type == BaseDataType::Type::T_STR) {
+      for (const std::string& str : data) {
+        // String length exceeds the fixed length
+        valid = valid && (str.size() <= type.typeSize);
+      }
+    }
+    if (valid) {
+      status =
+          m_array->writeStrings(dataShape, positionOffset, data, extended);
+    }
+  }
+  if (status == Status::Success) {
+    finishWrite(dataShape, extended);
+  }
+  return status;
+}
+
+void ZarrRecordingData::finishWrite(const SizeArray& dataShape, bool extended)
+{
+  if (extended) {
+    m_shape = m_array->getShape();
+    recordExtend();
+  }
+
+  // Update position for simple extension
+  for (SizeType i = 0; i < dataShape.size(); ++i) {
+    m_position[i] += dataShape[i];
+  }
+}
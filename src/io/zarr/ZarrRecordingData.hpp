@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/BaseIO.hpp"
+#include "io/zarr/ZarrArray.hpp"
+
+namespace AQNWB::IO::Zarr
+{
+/**
+ * @brief Represents an array of a ZarrIO that can be extended indefinitely
+ * in blocks.
+ *
+ * Writes beyond the current shape of the array grow the array along all
+ * dimensions. Written chunks are stored to disk once a write starts in a
+ * later chunk along the first dimension, and on ZarrIO::flush.
+ */
+class ZarrRecordingData : public AQNWB::IO::BaseRecordingData
+{
+public:
+  /**
+   * @brief Constructs a ZarrRecordingData object.
+   * @param array The array to write to.
+   */
+  explicit ZarrRecordingData(std::shared_ptr<ZarrArray> array);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  ZarrRecordingData(const ZarrRecordingData&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  ZarrRecordingData& operator=(const ZarrRecordingData&) = delete;
+
+  /**
+   * @brief Destroys the ZarrRecordingData object.
+   */
+  ~ZarrRecordingData() override;
+
+  /**
+   * @brief Gets the array written to.
+   * @return A shared pointer to the array.
+   */
+  inline std::shared_ptr<ZarrArray> getArray() const { return m_array; }
+
+protected:
+  /**
+   * @brief Writes a block of data to the array.
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block.
+   * @param data A pointer to the data block.
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const void* data) override;
+
+  /**
+   * @brief Writes a block of string data (any number of dimensions).
+   * @param dataShape The size of the data block.
+   * @param positionOffset The position of the data block to write to.
+   * @param type The data type of the elements in the data block. Either
+   *             BaseDataType::Type::V_STR or BaseDataType::Type::T_STR
+   *             for variable and fixed-length strings repsetively.
+   * @param data Vector with the string data
+   * @return The status of the write operation.
+   */
+  Status writeDataBlockImpl(const SizeArray& dataShape,
+                            const SizeArray& positionOffset,
+                            const AQNWB::IO::BaseDataType& type,
+                            const std::vector<std::string>& data) override;
+
+private:
+  /**
+   * @brief Update the shape, position, and statistics after a write
+   * @param dataShape The size of the data block.
+   * @param extended Whether the array was extended by the write
+   */
+  void finishWrite(const SizeArray& dataShape, bool extended);
+
+  /**
+   * @brief The array to write to
+   */
+  std::shared_ptr<ZarrArray> m_array;
+};
+}  // namespace AQNWB::IO::Zarr
@@ -0,0 +1,63 @@
+#include <algorithm>
+
+#include "io/zarr/ZarrWorkerPool.hpp"
+
+using namespace AQNWB::IO::Zarr;
+
+ZarrWorkerPool::ZarrWorkerPool(SizeType numThreads)
+    : m_numThreads(numThreads)
+{
+  if (m_numThreads == 0) {
+    m_numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+ZarrWorkerPool::~ZarrWorkerPool()
+{
+  stop();
+}
+
+void ZarrWorkerPool::submit(std::function<void()> task)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_threads.empty()) {
+    m_stopping = false;
+    for (SizeType t = 0; t < m_numThreads; ++t) {
+      m_threads.emplace_back(&ZarrWorkerPool::run, this);
+    }
+  }
+  m_taskTaken.wait(lock, [this]() { return m_tasks.size() < getMaxQueued(); });
+  m_tasks.push_back(std::move(task));
+  m_taskAdded.notify_one();
+}
+
+void ZarrWorkerPool::stop()
+{
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    threads.swap(m_threads);
+  }
+  m_taskAdded.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void ZarrWorkerPool::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_taskAdded.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+    if (m_tasks.empty()) {
+      return;  // stopping
+    }
+    std::function<void()> task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    m_taskTaken.notify_one();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Types.hpp"
+
+using SizeType = AQNWB::Types::SizeType;
+
+namespace AQNWB::IO::Zarr
+{
+/**
+ * @brief A bounded pool of worker threads that encode and store the chunks
+ * of the arrays of a ZarrIO.
+ *
+ * The threads are started on the first task and kept until stop() is
+ * called, such that storing chunks does not create threads on every write.
+ * At most getMaxQueued() tasks wait for a thread. submit() blocks while the
+ * queue is full, which bounds the memory of chunks waiting to be stored
+ * when the storage is slower than the acquisition.
+ */
+class ZarrWorkerPool
+{
+public:
+  /**
+   * @brief Constructor. No threads are started until the first task.
+   * @param numThreads The number of worker threads, or 0 for one thread per
+   * core
+   */
+  explicit ZarrWorkerPool(SizeType numThreads = 0);
+
+  /**
+   * @brief Deleted copy constructor to prevent construction-copying.
+   */
+  ZarrWorkerPool(const ZarrWorkerPool&) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator to prevent copying.
+   */
+  ZarrWorkerPool& operator=(const ZarrWorkerPool&) = delete;
+
+  /**
+   * @brief Destructor. Runs the remaining tasks and joins the threads.
+   */
+  ~ZarrWorkerPool();
+
+  /**
+   * @brief Add a task to the queue, starting the threads if necessary.
+   * Blocks while the queue is full.
+   * @param task The task to run on a worker thread
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Run the remaining tasks and join the threads. The threads are
+   * started again by the next task. Must not be called concurrently with
+   * submit(), e.g., only after all arrays were flushed.
+   */
+  void stop();
+
+  /**
+   * @brief Get the number of worker threads
+   */
+  inline SizeType getNumThreads() const { return m_numThreads; }
+
+  /**
+   * @brief Get the maximum number of tasks waiting for a thread
+   */
+  inline SizeType getMaxQueued() const { return 2 * m_numThreads; }
+
+private:
+  /**
+   * @brief Run tasks until the pool is stopped and the queue is empty
+   */
+  void run();
+
+  /**
+   * @brief The number of worker threads
+   */
+  SizeType m_numThreads;
+
+  /**
+   * @brief The worker threads, empty until the first task
+   */
+  std::vector<std::thread> m_threads;
+
+  /**
+   * @brief The tasks waiting for a thread
+   */
+  std::deque<std::function<void()>> m_tasks;
+
+  /**
+   * @brief Whether the threads should exit once the queue is empty
+   */
+  bool m_stopping = false;
+
+  /**
+   * @brief Mutex protecting the queue and the threads
+   */
+  std::mutex m_mutex;
+
+  /**
+   * @brief Signaled when a task is added or the pool is stopped
+   */
+  std::condition_variable m_taskAdded;
+
+  /**
+   * @brief Signaled when a task is taken from the queue
+   */
+  std::condition_variable m_taskTaken;
+};
+}  // namespace AQNWB::IO::Zarr
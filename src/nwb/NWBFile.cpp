@@ -10,11 +10,13 @@
 #include "nwb/NWBFile.hpp"
 
 #include "Channel.hpp"
+#include "Tracing.hpp"
 #include "Utils.hpp"
 #include "io/BaseIO.hpp"
 #include "nwb/device/Device.hpp"
 #include "nwb/ecephys/ElectricalSeries.hpp"
 #include "nwb/ecephys/SpikeEventSeries.hpp"
+#include "nwb/epoch/TimeIntervals.hpp"
 #include "nwb/file/ElectrodeGroup.hpp"
 #include "nwb/misc/AnnotationSeries.hpp"
 #include "spec/NamespaceRegistry.hpp"
@@ -55,6 +57,7 @@ Status NWBFile::initialize(const std::string& identifierText,
                            const std::string& sessionStartTime,
                            const std::string& timestampsReferenceTime)
 {
+  TraceScope trace("NWBFile::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "NWBFile::initialize IO object has been deleted." << std::endl;
@@ -108,11 +111,6 @@ bool NWBFile::isInitialized() const
               << std::endl;
     return false;
   }
-  std::vector<std::pair<std::string, StorageObjectType>> existingGroupObjects =
-      ioPtr->getStorageObjects("/", StorageObjectType::Group);
-  if (existingGroupObjects.size() == 0) {
-    return false;
-  }
   // Define the set of required objects
   static const std::unordered_set<std::string> requiredObjects = {
       "acquisition",
@@ -125,13 +123,18 @@ bool NWBFile::isInitialized() const
   // Set to keep track of found objects
   std::unordered_set<std::string> foundObjects;
 
-  // Iterate over the existing objects and add to foundObjects if it's a
-  // required object
-  for (const auto& obj : existingGroupObjects) {
-    if (requiredObjects.find(obj.first) != requiredObjects.end()) {
-      foundObjects.insert(obj.first);
-    }
-  }
+  // Stream the groups at the root and add to foundObjects if it's a
+  // required object, stopping once all required objects have been found
+  ioPtr->visitStorageObjects(
+      "/",
+      [&foundObjects](const std::string& name, StorageObjectType)
+      {
+        if (requiredObjects.find(name) != requiredObjects.end()) {
+          foundObjects.insert(name);
+        }
+        return foundObjects.size() < requiredObjects.size();
+      },
+      StorageObjectType::Group);
 
   // Check if all required objects are found
   return (foundObjects.size() == requiredObjects.size());
@@ -407,6 +410,85 @@ Status NWBFile::createAnnotationSeries(
   return Status::Success;
 }
 
+Status NWBFile::createRecordingPauses(std::vector<SizeType>& containerIndexes)
+{
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    std::cerr << "NWBFile::createRecordingPauses IO object has been deleted."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  if (!ioPtr->canModifyObjects()) {
+    std::cerr
+        << "NWBFile::createRecordingPauses IO object cannot modify objects."
+        << std::endl;
+    return Status::Failure;
+  }
+
+  if (!ioPtr->objectExists(NWBFile::INTERVALS_PATH)) {
+    ioPtr->createGroup(NWBFile::INTERVALS_PATH);
+  }
+  auto pauses = RegisteredType::create<TimeIntervals>(
+      TimeIntervals::recordingPausesPath, ioPtr);
+  Status status = pauses->initialize("Pauses of the recording");
+  pauses->setRecordPauses(true);
+  containerIndexes.push_back(pauses->getRecordingObjectIndex());
+  return status;
+}
+
+Status NWBFile::restoreRecording(std::vector<SizeType>& containerIndexes)
+{
+  TraceScope trace("NWBFile::restoreRecording", "nwb");
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    std::cerr << "NWBFile::restoreRecording IO object has been deleted."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  if (!ioPtr->canModifyObjects()) {
+    std::cerr << "NWBFile::restoreRecording IO object cannot modify objects. "
+                 "Open the file with FileMode::ReadWrite."
+              << std::endl;
+    return Status::Failure;
+  }
+  if (!isInitialized()) {
+    std::cerr << "NWBFile::restoreRecording the file is not initialized."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  const std::string coreNamespace = AQNWB::SPEC::CORE::namespaceName;
+  std::unordered_map<std::string, std::string> found =
+      ioPtr->findTypes("/",
+                       {coreNamespace + "::ElectricalSeries",
+                        coreNamespace + "::SpikeEventSeries",
+                        coreNamespace + "::AnnotationSeries",
+                        coreNamespace + "::TimeIntervals"},
+                       IO::SearchMode::CONTINUE_ON_TYPE);
+  std::map<std::string, std::string> seriesPaths(found.begin(), found.end());
+
+  auto recordingObjects = ioPtr->getRecordingObjects();
+  Status status = Status::Success;
+  for (const auto& [path, typeName] : seriesPaths) {
+    std::shared_ptr<RegisteredType> series =
+        recordingObjects->getRecordingObject(path);
+    if (series == nullptr) {
+      series = RegisteredType::create(typeName, path, ioPtr);
+    }
+    if (series == nullptr) {
+      std::cerr << "NWBFile::restoreRecording failed to create " << typeName
+                << " at " << path << std::endl;
+      status = Status::Failure;
+      continue;
+    }
+    status = series->restoreRecordingState() && status;
+    containerIndexes.push_back(series->getRecordingObjectIndex());
+  }
+  return status;
+}
+
 void NWBFile::cacheSpecifications(const Types::NamespaceInfo& namespaceInfo)
 {
   auto ioPtr = getIO();
@@ -47,6 +47,8 @@ public:
   inline const static std::string GENERAL_PATH = "/general";
   /// @brief The path to the analysis group in the NWB file
   inline const static std::string ANALYSIS_PATH = "/analysis";
+  /// @brief The path to the intervals group in the NWB file
+  inline const static std::string INTERVALS_PATH = "/intervals";
 
   /** \brief Convenience factor method since the path is fixed to '/'
    * @param io A shared pointer to the IO object.
@@ -185,6 +187,42 @@ public:
   Status createAnnotationSeries(const std::vector<std::string>& recordingNames,
                                 std::vector<SizeType>& containerIndexes);
 
+  /** @brief Create the TimeIntervals table at
+   * TimeIntervals::recordingPausesPath that records the pauses of the
+   * recording (see IO::BaseIO::pauseRecording and
+   * TimeIntervals::setRecordPauses), such that readers see the gaps between
+   * the recorded epochs. Must be called before recording starts.
+   * The created object is automatically added to the I/O's RecordingObjects.
+   * @param containerIndexes This vector is updated with the index of the
+   * created container.
+   * @return Status The status of the object creation operation.
+   */
+  Status createRecordingPauses(std::vector<SizeType>& containerIndexes);
+
+  /**
+   * @brief Restore the recording objects of an existing file to continue
+   * recording into it, e.g., after the file was closed or after a crash.
+   *
+   * A recording paused via BaseIO::pauseRecording is continued via
+   * BaseIO::resumeRecording instead.
+   *
+   * Finds all ElectricalSeries, SpikeEventSeries, AnnotationSeries, and
+   * TimeIntervals in the file, reconstructs them via RegisteredType::create,
+   * and restores their recording state from the extents of their datasets
+   * (see RegisteredType::restoreRecordingState). The objects are added to the
+   * I/O's RecordingObjects such that recording continues by appending after
+   * the data already in the file, without rewriting or copying it. Objects
+   * that are already in the RecordingObjects are reused. The I/O must be
+   * opened with FileMode::ReadWrite and recording is started as usual via
+   * BaseIO::startRecording.
+   *
+   * @param containerIndexes This vector is updated with the indexes of the
+   * restored containers in the order of their paths.
+   * @return Status The status of the operation. Fails if the file is not
+   * initialized or cannot be modified.
+   */
+  Status restoreRecording(std::vector<SizeType>& containerIndexes);
+
   DEFINE_REGISTERED_FIELD(readElectrodesTable,
                           ElectrodesTable,
                           ElectrodesTable::electrodesTablePath,
@@ -2,6 +2,7 @@
 
 #include "RegisteredType.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 #include "io/ReadIO.hpp"
 #include "io/RecordingObjects.hpp"
@@ -19,6 +20,7 @@ RegisteredType::RegisteredType(const std::string& path,
                                std::shared_ptr<AQNWB::IO::BaseIO> io)
     : m_path(path)
     , m_io(io)
+    , m_recordingPaused(io ? io->getRecordingPausedFlag() : nullptr)
 {
 }
 
@@ -147,9 +149,30 @@ SizeType RegisteredType::registerRecordingObject()
 
 AQNWB::Types::Status RegisteredType::finalize()
 {
+  TraceScope trace("RegisteredType::finalize", "nwb");
   return AQNWB::Types::Status::Success;
 }
 
+AQNWB::Types::Status RegisteredType::restoreRecordingState()
+{
+  return AQNWB::Types::Status::Success;
+}
+
+AQNWB::Types::Status RegisteredType::recordingPaused(double)
+{
+  return AQNWB::Types::Status::Success;
+}
+
+AQNWB::Types::Status RegisteredType::recordingResumed(double)
+{
+  return AQNWB::Types::Status::Success;
+}
+
+bool RegisteredType::isRecordingPaused() const
+{
+  return m_recordingPaused != nullptr && *m_recordingPaused;
+}
+
 std::unordered_map<std::string, std::string> RegisteredType::findOwnedTypes(
     const std::unordered_set<std::string>& types,
     const IO::SearchMode& search_mode) const
@@ -4,8 +4,10 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Types.hpp"
 #include "Utils.hpp"
@@ -131,6 +133,51 @@ public:
    */
   virtual AQNWB::Types::Status finalize();
 
+  /**
+   * @brief Restore the in-memory recording state of an object read from an
+   * existing file, such that recording can continue where it stopped.
+   *
+   * Types that track their write position while recording, e.g., the number
+   * of samples written, override this method to reconstruct that state from
+   * the extents of their datasets. It is called by NWBFile::restoreRecording
+   * for objects created via RegisteredType::create. The default
+   * implementation does nothing and returns AQNWB::Types::Status::Success.
+   *
+   * @return AQNWB::Types::Status::Success if successful, otherwise
+   * AQNWB::Types::Status::Failure.
+   */
+  virtual AQNWB::Types::Status restoreRecordingState();
+
+  /**
+   * @brief Called by BaseIO::pauseRecording for all recording objects after
+   * writes have been suspended.
+   *
+   * Types that keep track of the recording epochs, e.g., TimeIntervals,
+   * override this method. The default implementation does nothing and returns
+   * AQNWB::Types::Status::Success.
+   *
+   * @param time The time of the pause in seconds
+   * @return AQNWB::Types::Status::Success if successful, otherwise
+   * AQNWB::Types::Status::Failure.
+   */
+  virtual AQNWB::Types::Status recordingPaused(double time);
+
+  /**
+   * @brief Called by BaseIO::resumeRecording for all recording objects
+   * before writes are accepted again.
+   *
+   * @param time The time at which recording resumes in seconds
+   * @return AQNWB::Types::Status::Success if successful, otherwise
+   * AQNWB::Types::Status::Failure.
+   */
+  virtual AQNWB::Types::Status recordingResumed(double time);
+
+  /**
+   * @brief Check whether writes are suspended because recording is paused.
+   * @return True if recording of the IO is paused, false otherwise.
+   */
+  bool isRecordingPaused() const;
+
   /**
    * @brief Get the cache of BaseRecordingData objects
    * @return A reference to the cache of BaseRecordingData objects
@@ -149,6 +196,7 @@ public:
   inline virtual void clearRecordingDataCache()
   {
     this->m_recordingDataCache.clear();
+    this->m_recordingDataSlots.clear();
   }
 
   /**
@@ -404,6 +452,59 @@ protected:
       const std::string& typeName,
       const std::string& typeNamespace);
 
+  /**
+   * @brief The class whose dataset fields use the slots declared via
+   * DEFINE_RECORDING_DATA_SLOTS. Redeclared by each subclass.
+   */
+  using RecordingDataSlotOwner = RegisteredType;
+
+  /**
+   * @brief The number of classes between the class and RegisteredType.
+   *
+   * The slots of the dataset fields of a class are stored at this index of
+   * m_recordingDataSlots, such that the fields of a class and its base
+   * classes never share a slot. Redeclared by each subclass.
+   */
+  static constexpr std::size_t recordingDataSlotDepth = 0;
+
+  /**
+   * @brief Get the BaseRecordingData object cached in a slot
+   * @param depth The recordingDataSlotDepth of the class of the field
+   * @param index The index of the field within its class
+   * @return The cached object, or nullptr if the slot is empty
+   */
+  inline std::shared_ptr<IO::BaseRecordingData> getRecordingDataSlot(
+      std::size_t depth, std::size_t index) const
+  {
+    if (depth >= m_recordingDataSlots.size()
+        || index >= m_recordingDataSlots[depth].size())
+    {
+      return nullptr;
+    }
+    return m_recordingDataSlots[depth][index];
+  }
+
+  /**
+   * @brief Cache a BaseRecordingData object in a slot
+   * @param depth The recordingDataSlotDepth of the class of the field
+   * @param index The index of the field within its class
+   * @param dataset The object to cache
+   */
+  inline void setRecordingDataSlot(
+      std::size_t depth,
+      std::size_t index,
+      std::shared_ptr<IO::BaseRecordingData> dataset)
+  {
+    if (depth >= m_recordingDataSlots.size()) {
+      m_recordingDataSlots.resize(depth + 1);
+    }
+    auto& classSlots = m_recordingDataSlots[depth];
+    if (index >= classSlots.size()) {
+      classSlots.resize(index + 1);
+    }
+    classSlots[index] = std::move(dataset);
+  }
+
   /**
    * @brief The path of the registered type.
    */
@@ -421,6 +522,13 @@ protected:
    */
   std::weak_ptr<IO::BaseIO> m_io;
 
+  /**
+   * @brief The pause flag of the IO object, see
+   * IO::BaseIO::getRecordingPausedFlag. Kept such that writes check for a
+   * pause without locking m_io. nullptr if the object was created without IO.
+   */
+  std::shared_ptr<const bool> m_recordingPaused;
+
   /**
    * @brief Cache for BaseRecordingData objects for datasets to retain recording
    * state.
@@ -435,12 +543,50 @@ protected:
    */
   std::unordered_map<std::string, std::shared_ptr<IO::BaseRecordingData>>
       m_recordingDataCache;
+
+  /**
+   * @brief Direct access to the entries of m_recordingDataCache of the
+   * dataset fields, indexed by [recordingDataSlotDepth][field index] of the
+   * class of the field.
+   *
+   * Allows the write functions generated by DEFINE_DATASET_FIELD to retrieve
+   * their dataset without building and hashing the path on every call. Each
+   * class of the hierarchy only takes as many slots as it defines fields.
+   */
+  std::vector<std::vector<std::shared_ptr<IO::BaseRecordingData>>>
+      m_recordingDataSlots;
 };
 
+/**
+ * @brief Macro to declare the recording data slots of the dataset fields of a
+ * class.
+ *
+ * The write functions generated by DEFINE_DATASET_FIELD cache their dataset
+ * in the slot [recordingDataSlotDepth][field index] of the object. The field
+ * index is the position of the field among the DEFINE_DATASET_FIELD of the
+ * class body, counted at compile time via ``__COUNTER__`` relative to the
+ * counter value recorded here. REGISTER_SUBCLASS declares the slots. Classes
+ * that define dataset fields without REGISTER_SUBCLASS, e.g., class
+ * templates, must use this macro before their first DEFINE_DATASET_FIELD.
+ *
+ * @param T The class type.
+ * @param BASE The base class of T, which must be a subclass of
+ * RegisteredType.
+ */
+#define DEFINE_RECORDING_DATA_SLOTS(T, BASE) \
+protected: \
+  using RecordingDataSlotOwner = T; \
+  static constexpr std::size_t recordingDataSlotDepth = \
+      BASE::recordingDataSlotDepth + 1; \
+  static constexpr int recordingDataSlotCounter = __COUNTER__; \
+public:
+
 /**
  * @brief Macro to register a subclass with the RegisteredType class registry.
  *
  * This macro defines:
+ * - The recording data slots of the dataset fields of the class (see
+ * DEFINE_RECORDING_DATA_SLOTS).
  * - A static method ``registerSubclass`` that triggers registration of the
  * subclass type when the subclass type is loaded.
  * - A static member ``registered_`` that ensures the registration occurs.
@@ -457,6 +603,7 @@ protected:
  */
 #define REGISTER_SUBCLASS_WITH_TYPENAME(T, BASE, NAMESPACE_VAR, TYPENAME) \
   friend class AQNWB::NWB::RegisteredType; /* base can call constructor */ \
+  DEFINE_RECORDING_DATA_SLOTS(T, BASE) \
 protected: \
   using BASE::BASE; /* inherit from immediate base */ \
 public: \
@@ -606,7 +753,9 @@ public: \
    * @brief Returns the dataset object for the ##writeName field. \
    * \
    * This functions modifies the m_recordingDataCache as a side effect \
-   * to retain the recording state. \
+   * to retain the recording state. Once cached, the dataset is returned \
+   * via its recording data slot without any path lookup. The slot index \
+   * is fixed at compile time (see DEFINE_RECORDING_DATA_SLOTS). \
    * \
    * @param reset If true, the dataset will be reset to the beginning \
    *        by creating a new BaseRecordingData object via getIO()->getDataSet \
@@ -618,11 +767,30 @@ public: \
   inline std::shared_ptr<AQNWB::IO::BaseRecordingData> writeName(bool reset = \
                                                                      false) \
   { \
+    static_assert( \
+        std::is_same_v<std::remove_reference_t<decltype(*this)>, \
+                       RecordingDataSlotOwner>, \
+        "DEFINE_DATASET_FIELD requires REGISTER_SUBCLASS or " \
+        "DEFINE_RECORDING_DATA_SLOTS in the same class"); \
+    constexpr int slotIndex = __COUNTER__ - recordingDataSlotCounter - 1; \
+    static_assert(slotIndex >= 0, \
+                  "DEFINE_DATASET_FIELD must follow REGISTER_SUBCLASS or " \
+                  "DEFINE_RECORDING_DATA_SLOTS"); \
+    constexpr std::size_t slotDepth = recordingDataSlotDepth; \
+    constexpr std::size_t slot = static_cast<std::size_t>(slotIndex); \
+    if (!reset) { \
+      /* Fast path: the dataset has been resolved before */ \
+      auto cached = this->getRecordingDataSlot(slotDepth, slot); \
+      if (cached) { \
+        return cached; \
+      } \
+    } \
     std::string fullPath = AQNWB::mergePaths(m_path, fieldPath); \
     if (!reset) { \
       /* Check if the dataset is already in the cache */ \
       auto it = m_recordingDataCache.find(fullPath); \
       if (it != m_recordingDataCache.end()) { \
+        this->setRecordingDataSlot(slotDepth, slot, it->second); \
         return it->second; \
       } \
     } \
@@ -636,6 +804,7 @@ public: \
     auto dataset = ioPtr->getDataSet(fullPath); \
     if (dataset) { \
       m_recordingDataCache[fullPath] = dataset; \
+      this->setRecordingDataSlot(slotDepth, slot, dataset); \
     } \
     return dataset; \
   }
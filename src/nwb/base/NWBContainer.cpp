@@ -1,5 +1,6 @@
 #include "NWBContainer.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -16,5 +17,6 @@ NWBContainer::NWBContainer(const std::string& path,
 
 Status NWBContainer::initialize()
 {
+  TraceScope trace("NWBContainer::initialize", "nwb");
   return AQNWB::NWB::Container::initialize();
 }
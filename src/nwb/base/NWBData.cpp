@@ -1,5 +1,6 @@
 #include "NWBData.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -15,6 +16,7 @@ NWBData::NWBData(const std::string& path, std::shared_ptr<AQNWB::IO::BaseIO> io)
 
 Status NWBData::initialize(const AQNWB::IO::BaseArrayDataSetConfig& dataConfig)
 {
+  TraceScope trace("NWBData::initialize", "nwb");
   return Data::initialize(dataConfig);
 }
 
@@ -60,6 +60,8 @@ protected:
 template<typename DTYPE = std::any>
 class NWBDataTyped : public NWBData
 {
+  DEFINE_RECORDING_DATA_SLOTS(NWBDataTyped, NWBData)
+
 public:
   /**
    * @brief Constructor.
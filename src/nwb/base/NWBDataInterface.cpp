@@ -1,5 +1,6 @@
 #include "NWBDataInterface.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -16,5 +17,6 @@ NWBDataInterface::NWBDataInterface(const std::string& path,
 
 Status NWBDataInterface::initialize()
 {
+  TraceScope trace("NWBDataInterface::initialize", "nwb");
   return NWBContainer::initialize();
 }
@@ -1,5 +1,6 @@
 #include "nwb/base/ProcessingModule.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -16,6 +17,7 @@ ProcessingModule::ProcessingModule(const std::string& path,
 
 Status ProcessingModule::initialize(const std::string& description)
 {
+  TraceScope trace("ProcessingModule::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "ProcessingModule::initialize IO object has been deleted."
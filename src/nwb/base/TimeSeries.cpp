@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
+#include <type_traits>
 
 #include "nwb/base/TimeSeries.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 #include "io/BaseIO.hpp"
 
@@ -94,6 +99,7 @@ Status TimeSeries::initialize(
     const float& startingTimeRate,
     const std::vector<std::string>& controlDescription)
 {
+  TraceScope trace("TimeSeries::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "TimeSeries::initialize: IO object is not valid." << std::endl;
@@ -240,6 +246,20 @@ Status TimeSeries::initialize(
     std::cerr << "Failed to create control dataset: " << e.what() << std::endl;
     status = Status::Failure;
   }
+
+  // resolve the datasets written while recording, such that the first write
+  // does not look them up by path
+  if (status == Status::Success) {
+    if (!dataConfig.isLink()) {
+      this->recordData();
+    }
+    if (startingTime < 0) {
+      this->recordTimestamps();
+    }
+    if (!controlDescription.empty()) {
+      this->recordControl();
+    }
+  }
   return status;
 }
 
@@ -249,6 +269,11 @@ Status TimeSeries::writeData(const SizeArray& dataShape,
                              const void* timestampsInput,
                              const void* controlInput)
 {
+  // reject writes while the recording is paused
+  if (isRecordingPaused()) {
+    return Status::Failure;
+  }
+
   // Write timestamps if they exist
   Status tsStatus = Status::Success;
   if (timestampsInput != nullptr) {
@@ -279,3 +304,310 @@ Status TimeSeries::writeData(const SizeArray& dataShape,
 
   return dataStatus && tsStatus;
 }
+
+std::pair<SizeType, SizeType> TimeSeries::findSampleRange(double t0,
+                                                          double t1) const
+{
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    throw std::runtime_error("TimeSeries::findSampleRange: IO object is not "
+                             "valid.");
+  }
+
+  auto dataWrapper = this->readData();
+  SizeArray dataShape = dataWrapper->getShape();
+  SizeType numSamples = dataShape.empty() ? 0 : dataShape[0];
+  if (numSamples == 0 || !(t0 < t1)) {
+    return {0, 0};
+  }
+
+  auto startingTimeWrapper = this->readStartingTime();
+  if (startingTimeWrapper->exists()) {
+    // Sample i is at time startingTime + i / rate
+    double startingTime = startingTimeWrapper->values().data[0];
+    double rate =
+        static_cast<double>(this->readStartingTimeRate()->values().data[0]);
+    auto indexOf = [&](double t) -> SizeType
+    {
+      double pos = std::ceil((t - startingTime) * rate);
+      if (pos <= 0) {
+        return 0;
+      }
+      if (pos >= static_cast<double>(numSamples)) {
+        return numSamples;
+      }
+      // Correct for rounding errors in the computation of pos
+      SizeType index = static_cast<SizeType>(pos);
+      if (startingTime + static_cast<double>(index - 1) / rate >= t) {
+        --index;
+      }
+      return index;
+    };
+    SizeType start = indexOf(t0);
+    return {start, std::max(start, indexOf(t1))};
+  }
+
+  if (!this->readTimestamps()->exists()) {
+    throw std::runtime_error("TimeSeries::findSampleRange: TimeSeries at "
+                             + m_path
+                             + " has neither starting_time nor timestamps.");
+  }
+  SizeType start = findTimestampIndex(t0, numSamples);
+  SizeType stop = std::max(start, findTimestampIndex(t1, numSamples));
+  return {start, stop};
+}
+
+SizeType TimeSeries::findTimestampIndex(double t, SizeType numSamples) const
+{
+  auto timestampsWrapper = this->readTimestamps();
+  SizeArray timestampsShape = timestampsWrapper->getShape();
+  numSamples = std::min(numSamples,
+                        timestampsShape.empty() ? 0 : timestampsShape[0]);
+  if (numSamples == 0) {
+    return 0;
+  }
+
+  // Load the sparse index of timestamps if needed
+  if (m_timestampsIndex.empty() || m_timestampsIndexSize != numSamples) {
+    SizeArray chunking = timestampsWrapper->getChunking();
+    m_timestampsIndexStride =
+        (chunking.empty() || chunking[0] == 0) ? 8192 : chunking[0];
+    SizeType indexSize =
+        (numSamples + m_timestampsIndexStride - 1) / m_timestampsIndexStride;
+    m_timestampsIndex = timestampsWrapper
+                            ->values(SizeArray {0},
+                                     SizeArray {indexSize},
+                                     SizeArray {m_timestampsIndexStride})
+                            .data;
+    m_timestampsIndexSize = numSamples;
+  }
+
+  // Find the block of timestamps containing the first timestamp >= t
+  auto it = std::lower_bound(
+      m_timestampsIndex.begin(), m_timestampsIndex.end(), t);
+  SizeType indexPos = static_cast<SizeType>(it - m_timestampsIndex.begin());
+  if (indexPos == 0) {
+    return 0;
+  }
+  SizeType blockStart = (indexPos - 1) * m_timestampsIndexStride;
+  SizeType blockStop =
+      std::min(indexPos * m_timestampsIndexStride, numSamples);
+
+  // Search the block, excluding the first timestamp which is known to be < t
+  std::vector<double> block =
+      timestampsWrapper
+          ->values(SizeArray {blockStart}, SizeArray {blockStop - blockStart})
+          .data;
+  auto blockIt = std::lower_bound(block.begin() + 1, block.end(), t);
+  return blockStart + static_cast<SizeType>(blockIt - block.begin());
+}
+
+AQNWB::IO::DataBlockGeneric TimeSeries::readByTime(double t0, double t1) const
+{
+  std::pair<SizeType, SizeType> range = findSampleRange(t0, t1);
+  auto dataWrapper = this->readData();
+  SizeArray shape = dataWrapper->getShape();
+  SizeArray start(shape.size(), 0);
+  SizeArray count = shape;
+  start[0] = range.first;
+  count[0] = range.second - range.first;
+  return dataWrapper->valuesGeneric(start, count);
+}
+
+namespace
+{
+/**
+ * @brief Convert a block of raw values of type ITYPE to physical units.
+ *
+ * Values of the output type are scaled in place and moved into out, such
+ * that no second buffer is allocated.
+ */
+template<typename ITYPE, typename OTYPE>
+void scaleRawBlock(AQNWB::IO::DataBlockGeneric& raw,
+                   std::vector<OTYPE>& out,
+                   SizeType numColumns,
+                   OTYPE conversion,
+                   OTYPE offset,
+                   const OTYPE* columnFactors)
+{
+  auto* values = std::any_cast<std::vector<ITYPE>>(&raw.data);
+  if (values == nullptr) {
+    throw std::runtime_error("TimeSeries::readDataScaled: unexpected data "
+                             "type");
+  }
+  SizeType numRows = (numColumns == 0) ? 0 : values->size() / numColumns;
+  if constexpr (std::is_same_v<ITYPE, OTYPE>) {
+    out = std::move(*values);
+    AQNWB::scaleToPhysicalUnits(out.data(),
+                                out.data(),
+                                numRows,
+                                numColumns,
+                                conversion,
+                                offset,
+                                columnFactors);
+  } else {
+    out.resize(values->size());
+    AQNWB::scaleToPhysicalUnits(values->data(),
+                                out.data(),
+                                numRows,
+                                numColumns,
+                                conversion,
+                                offset,
+                                columnFactors);
+  }
+}
+}  // namespace
+
+template<typename OTYPE>
+AQNWB::IO::DataBlock<OTYPE> TimeSeries::readDataScaled(
+    const SizeArray& start, const SizeArray& count) const
+{
+  static_assert(std::is_floating_point_v<OTYPE>,
+                "readDataScaled requires a floating point output type");
+
+  auto dataWrapper = this->readData();
+  IO::DataBlockGeneric raw = start.empty()
+      ? dataWrapper->valuesGeneric()
+      : dataWrapper->valuesGeneric(start, count);
+
+  auto conversionWrapper = this->readDataConversion();
+  auto offsetWrapper = this->readDataOffset();
+  OTYPE conversion = conversionWrapper->exists()
+      ? static_cast<OTYPE>(conversionWrapper->values().data[0])
+      : OTYPE {1};
+  OTYPE offset = offsetWrapper->exists()
+      ? static_cast<OTYPE>(offsetWrapper->values().data[0])
+      : OTYPE {0};
+
+  // Treat the data as [rows, columns] with the channels along dimension 1
+  // and fold the conversion into the factor of each channel once
+  SizeType numColumns = 1;
+  std::vector<OTYPE> channelScale;
+  if (raw.shape.size() > 1) {
+    numColumns = std::accumulate(raw.shape.begin() + 1,
+                                 raw.shape.end(),
+                                 SizeType {1},
+                                 std::multiplies<SizeType>());
+    if (raw.shape.size() == 2) {
+      SizeType channelStart = (start.size() > 1) ? start[1] : 0;
+      std::vector<float> factors =
+          readChannelScaling(channelStart, raw.shape[1]);
+      if (factors.size() == raw.shape[1]) {
+        if constexpr (std::is_same_v<OTYPE, float>) {
+          channelScale = std::move(factors);
+        } else {
+          channelScale.assign(factors.begin(), factors.end());
+        }
+        for (OTYPE& factor : channelScale) {
+          factor *= conversion;
+        }
+      }
+    }
+  }
+  const OTYPE* channelScalePtr =
+      channelScale.empty() ? nullptr : channelScale.data();
+
+  IO::DataBlock<OTYPE> result({}, raw.shape);
+  switch (raw.getBaseDataType().type) {
+    case IO::BaseDataType::T_U8:
+      scaleRawBlock<uint8_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_U16:
+      scaleRawBlock<uint16_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_U32:
+      scaleRawBlock<uint32_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_U64:
+      scaleRawBlock<uint64_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_I8:
+      scaleRawBlock<int8_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_I16:
+      scaleRawBlock<int16_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_I32:
+      scaleRawBlock<int32_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_I64:
+      scaleRawBlock<int64_t>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_F32:
+      scaleRawBlock<float>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    case IO::BaseDataType::T_F64:
+      scaleRawBlock<double>(
+          raw, result.data, numColumns, conversion, offset, channelScalePtr);
+      break;
+    default:
+      throw std::runtime_error("TimeSeries::readDataScaled: data at "
+                               + m_path + " is not numeric");
+  }
+  return result;
+}
+
+// Explicit template instantiation
+template AQNWB::IO::DataBlock<float> TimeSeries::readDataScaled<float>(
+    const SizeArray& start, const SizeArray& count) const;
+template AQNWB::IO::DataBlock<double> TimeSeries::readDataScaled<double>(
+    const SizeArray& start, const SizeArray& count) const;
+
+std::vector<float> TimeSeries::readChannelScaling(SizeType,
+                                                  SizeType) const
+{
+  return {};
+}
+
+void TimeSeries::clearTimestampsIndex() const
+{
+  m_timestampsIndex.clear();
+  m_timestampsIndexStride = 0;
+  m_timestampsIndexSize = 0;
+}
+
+Status TimeSeries::restoreRecordingState()
+{
+  TraceScope trace("TimeSeries::restoreRecordingState", "nwb");
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    std::cerr << "TimeSeries::restoreRecordingState: IO object is not valid."
+              << std::endl;
+    return Status::Failure;
+  }
+  std::string dataPath = AQNWB::mergePaths(m_path, "data");
+  if (!ioPtr->objectExists(dataPath)) {
+    std::cerr << "TimeSeries::restoreRecordingState: " << dataPath
+              << " does not exist." << std::endl;
+    return Status::Failure;
+  }
+  try {
+    m_dataType = ioPtr->getStorageObjectDataType(dataPath);
+  } catch (const std::runtime_error& e) {
+    std::cerr << "TimeSeries::restoreRecordingState: " << e.what()
+              << std::endl;
+    return Status::Failure;
+  }
+  clearTimestampsIndex();
+  return Status::Success;
+}
+
+SizeType TimeSeries::getRecordedDataLength() const
+{
+  auto ioPtr = getIO();
+  std::string dataPath = AQNWB::mergePaths(m_path, "data");
+  if (!ioPtr || !ioPtr->objectExists(dataPath)) {
+    return 0;
+  }
+  SizeArray shape = ioPtr->getStorageObjectShape(dataPath);
+  return shape.empty() ? 0 : shape[0];
+}
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Utils.hpp"
 #include "io/BaseIO.hpp"
@@ -120,6 +122,80 @@ public:
       const float& startingTimeRate = 1.0f,
       const std::vector<std::string>& controlDescription = {});
 
+  /**
+   * @brief Find the range of sample indices with times in [t0, t1).
+   *
+   * The sample times are computed from starting_time and its rate if
+   * available. Otherwise, the indices are resolved via binary search of the
+   * timestamps, which must be sorted in ascending order. To avoid loading the
+   * full timestamps, the search uses a sparse index holding every n-th
+   * timestamp (with n equal to the chunk size of the timestamps) that is
+   * loaded lazily on first use and cached for this object. Each query then
+   * only reads one block of n timestamps.
+   *
+   * @param t0 The start time in seconds (inclusive).
+   * @param t1 The stop time in seconds (exclusive).
+   * @return The pair [start, stop) of sample indices along the first
+   * dimension of data. The range is empty if no samples fall in [t0, t1).
+   * @throws std::runtime_error if the IO object is not valid or neither
+   * starting_time nor timestamps exist.
+   */
+  std::pair<SizeType, SizeType> findSampleRange(double t0, double t1) const;
+
+  /**
+   * @brief Read the data of all samples with times in [t0, t1).
+   *
+   * The sample indices are resolved via findSampleRange, and only the
+   * matching slice of data is read from the file.
+   *
+   * @param t0 The start time in seconds (inclusive).
+   * @param t1 The stop time in seconds (exclusive).
+   * @return A DataBlockGeneric with the selected slice of data along the
+   * first dimension and all elements along the remaining dimensions.
+   * @throws std::runtime_error if the sample range cannot be determined.
+   */
+  IO::DataBlockGeneric readByTime(double t0, double t1) const;
+
+  /**
+   * @brief Read the data converted to physical units.
+   *
+   * Reads the raw values and applies `data * conversion + offset` using the
+   * `conversion` and `offset` attributes of the data. For 2D data, the
+   * per-channel factors provided by readChannelScaling (e.g., the
+   * `channel_conversion` of an ElectricalSeries) are applied as well. The
+   * raw values are read first and then converted to OTYPE and scaled in a
+   * second loop. If the data is stored as OTYPE, the read buffer is scaled in
+   * place and returned.
+   *
+   * @tparam OTYPE The output type. Either float or double.
+   * @param start The starting indices of the slice to read. If empty, all
+   * data is read.
+   * @param count The number of elements to read along each dimension.
+   * @return A DataBlock with the values in the unit of the data.
+   * @throws std::runtime_error if the data is not numeric.
+   */
+  template<typename OTYPE = float>
+  IO::DataBlock<OTYPE> readDataScaled(const SizeArray& start = {},
+                                      const SizeArray& count = {}) const;
+
+  /**
+   * @brief Discard the cached sparse index of timestamps.
+   *
+   * The index is reloaded automatically when the number of timestamps
+   * changes, so this is only needed if existing timestamps were modified.
+   */
+  void clearTimestampsIndex() const;
+
+  /**
+   * @brief Restore the data type of a TimeSeries read from an existing file.
+   *
+   * Sets m_dataType from the data in the file, such that writeData can
+   * continue recording.
+   *
+   * @return Status::Failure if the data does not exist.
+   */
+  Status restoreRecordingState() override;
+
   /**
    * @brief Data type of the data.
    */
@@ -227,6 +303,30 @@ protected:
    */
   TimeSeries(const std::string& path, std::shared_ptr<IO::BaseIO> io);
 
+  /**
+   * @brief Read additional scale factors for a range of channels.
+   *
+   * Used by readDataScaled for 2D [time, channel] data. The base
+   * implementation applies no per-channel scaling.
+   *
+   * @param channelStart The index of the first channel
+   * @param numChannels The number of channels
+   * @return The factor of each channel, or an empty vector if no per-channel
+   * scaling applies.
+   */
+  virtual std::vector<float> readChannelScaling(SizeType channelStart,
+                                                SizeType numChannels) const;
+
+  /**
+   * @brief Get the extent of the data along the first dimension in the file.
+   *
+   * Used by restoreRecordingState of derived types to continue recording
+   * after the last sample in the file.
+   *
+   * @return The number of samples, or 0 if the data does not exist.
+   */
+  SizeType getRecordedDataLength() const;
+
 private:
   /**
    * @brief Convenience function for creating timestamp related attributes.
@@ -253,5 +353,30 @@ private:
                               const float& offset,
                               const std::string& unit,
                               const ContinuityType& continuity);
+
+  /**
+   * @brief Find the first sample index with a timestamp >= t.
+   * @param t The time in seconds.
+   * @param numSamples The number of samples in the series.
+   * @return The sample index, or numSamples if all timestamps are < t.
+   */
+  SizeType findTimestampIndex(double t, SizeType numSamples) const;
+
+  /**
+   * @brief Sparse index holding every m_timestampsIndexStride-th timestamp.
+   *
+   * Mutable to allow loading the index lazily in const read methods.
+   */
+  mutable std::vector<double> m_timestampsIndex;
+
+  /**
+   * @brief Distance between consecutive entries of m_timestampsIndex.
+   */
+  mutable SizeType m_timestampsIndexStride = 0;
+
+  /**
+   * @brief Number of timestamps at the time m_timestampsIndex was loaded.
+   */
+  mutable SizeType m_timestampsIndexSize = 0;
 };
 }  // namespace AQNWB::NWB
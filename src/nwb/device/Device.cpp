@@ -1,5 +1,7 @@
 #include "nwb/device/Device.hpp"
 
+#include "Tracing.hpp"
+
 using namespace AQNWB::NWB;
 
 // Device
@@ -18,6 +20,7 @@ Device::~Device() {}
 Status Device::initialize(const std::string& description,
                           const std::string& manufacturer)
 {
+  TraceScope trace("Device::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "Device::initialize IO object has been deleted." << std::endl;
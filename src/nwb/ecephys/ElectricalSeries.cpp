@@ -3,6 +3,7 @@
 
 #include "nwb/ecephys/ElectricalSeries.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 #include "nwb/file/ElectrodesTable.hpp"
 
@@ -31,6 +32,7 @@ Status ElectricalSeries::initialize(
     const float& resolution,
     const float& offset)
 {
+  TraceScope trace("ElectricalSeries::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "ElectricalSeries::initialize: IO object is not valid."
@@ -54,6 +56,7 @@ Status ElectricalSeries::initialize(
                                              offset);
 
   this->m_channelVector = channelVector;
+  m_conversionScales.clear();
 
   // get the number of electrodes from the electrode table
   std::string idPath =
@@ -145,6 +148,11 @@ Status ElectricalSeries::writeChannel(SizeType channelInd,
                                       const void* timestampsInput,
                                       const void* controlInput)
 {
+  // reject writes while the recording is paused
+  if (isRecordingPaused()) {
+    return Status::Failure;
+  }
+
   // get offsets and datashape
   SizeArray dataShape = {
       numSamples, 1};  // Note: schema has 1D and 3D but planning to deprecate
@@ -154,12 +162,20 @@ Status ElectricalSeries::writeChannel(SizeType channelInd,
   m_samplesRecorded[channelInd] += numSamples;
 
   // write channel data
+  Status status = Status::Success;
   if (channelInd == 0) {
-    return TimeSeries::writeData(
+    status = TimeSeries::writeData(
         dataShape, positionOffset, dataInput, timestampsInput, controlInput);
   } else {
-    return TimeSeries::writeData(dataShape, positionOffset, dataInput);
+    status = TimeSeries::writeData(dataShape, positionOffset, dataInput);
   }
+
+  // update the overview envelopes
+  if (status == Status::Success && m_overviewPyramid != nullptr) {
+    status = m_overviewPyramid->addChannelSamples(
+        channelInd, numSamples, dataInput);
+  }
+  return status;
 }
 
 Status ElectricalSeries::writeAllChannels(const SizeType& numSamples,
@@ -167,6 +183,11 @@ Status ElectricalSeries::writeAllChannels(const SizeType& numSamples,
                                           const void* timestampsInput,
                                           const void* controlInput)
 {
+  // reject writes while the recording is paused
+  if (isRecordingPaused()) {
+    return Status::Failure;
+  }
+
   // All channels must be at the same sample offset before calling this
   // function (i.e. m_samplesRecorded must be uniform across all channels).
   // This is always satisfied when writeAllChannels is called exclusively for
@@ -196,11 +217,109 @@ Status ElectricalSeries::writeAllChannels(const SizeType& numSamples,
     for (auto& count : m_samplesRecorded) {
       count += numSamples;
     }
+    if (m_overviewPyramid != nullptr) {
+      status = m_overviewPyramid->addSamples(numSamples, dataInput);
+    }
   }
 
   return status;
 }
 
+Status ElectricalSeries::writeChannel(SizeType channelInd,
+                                      const SizeType& numSamples,
+                                      const float* dataInput,
+                                      const IO::BaseDataType& storageType,
+                                      const void* timestampsInput,
+                                      const void* controlInput)
+{
+  if (!isSupportedStorageType(storageType, "writeChannel")) {
+    return Status::Failure;
+  }
+  if (channelInd >= m_channelVector.size()) {
+    std::cerr << "ElectricalSeries::writeChannel: invalid channel index "
+              << channelInd << std::endl;
+    return Status::Failure;
+  }
+  if (storageType == IO::BaseDataType::F32) {
+    return writeChannel(channelInd,
+                        numSamples,
+                        static_cast<const void*>(dataInput),
+                        timestampsInput,
+                        controlInput);
+  }
+
+  // scale, clamp and narrow in a single pass into the staging buffer
+  float bitVolts = m_channelVector[channelInd].getBitVolts();
+  m_conversionBuffer.resize(numSamples);
+  convertFloatToInt16(dataInput,
+                      m_conversionBuffer.data(),
+                      numSamples,
+                      1.0f / (32767.0f * bitVolts));
+  return writeChannel(channelInd,
+                      numSamples,
+                      static_cast<const void*>(m_conversionBuffer.data()),
+                      timestampsInput,
+                      controlInput);
+}
+
+Status ElectricalSeries::writeAllChannels(const SizeType& numSamples,
+                                          const float* dataInput,
+                                          const IO::BaseDataType& storageType,
+                                          const void* timestampsInput,
+                                          const void* controlInput)
+{
+  if (!isSupportedStorageType(storageType, "writeAllChannels")) {
+    return Status::Failure;
+  }
+  if (storageType == IO::BaseDataType::F32) {
+    return writeAllChannels(numSamples,
+                            static_cast<const void*>(dataInput),
+                            timestampsInput,
+                            controlInput);
+  }
+
+  // scale, clamp and narrow in a single pass into the staging buffer
+  SizeType numChannels = m_channelVector.size();
+  if (m_conversionScales.size() != numChannels) {
+    m_conversionScales.resize(numChannels);
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      m_conversionScales[ch] =
+          1.0f / (32767.0f * m_channelVector[ch].getBitVolts());
+    }
+  }
+  m_conversionBuffer.resize(numSamples * numChannels);
+  convertFloatToInt16Interleaved(dataInput,
+                                 m_conversionBuffer.data(),
+                                 numSamples,
+                                 numChannels,
+                                 m_conversionScales.data());
+  return writeAllChannels(numSamples,
+                          static_cast<const void*>(m_conversionBuffer.data()),
+                          timestampsInput,
+                          controlInput);
+}
+
+bool ElectricalSeries::isSupportedStorageType(
+    const IO::BaseDataType& storageType, const std::string& functionName) const
+{
+  if (!(storageType == this->m_dataType)) {
+    std::cerr << "ElectricalSeries::" << functionName
+              << ": the storage type does not match the data type of the "
+                 "series."
+              << std::endl;
+    return false;
+  }
+  if (!(storageType == IO::BaseDataType::I16)
+      && !(storageType == IO::BaseDataType::F32))
+  {
+    std::cerr << "ElectricalSeries::" << functionName
+              << ": float input can only be stored as int16 or float32."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
 bool ElectricalSeries::channelsAtSameSampleOffset() const
 {
   return m_samplesRecorded.empty()
@@ -209,3 +328,218 @@ bool ElectricalSeries::channelsAtSameSampleOffset() const
                             std::not_equal_to<SizeType>())
       == m_samplesRecorded.end();
 }
+
+Status ElectricalSeries::enableOverviewPyramid(
+    const OverviewPyramidConfig& config)
+{
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    std::cerr << "ElectricalSeries::enableOverviewPyramid: IO object is not "
+                 "valid."
+              << std::endl;
+    return Status::Failure;
+  }
+  if (m_channelVector.empty()
+      || !OverviewPyramid::isSupportedType(this->m_dataType))
+  {
+    std::cerr << "ElectricalSeries::enableOverviewPyramid: the series must "
+                 "be initialized with numeric data."
+              << std::endl;
+    return Status::Failure;
+  }
+  if (std::any_of(m_samplesRecorded.begin(),
+                  m_samplesRecorded.end(),
+                  [](SizeType count) { return count > 0; }))
+  {
+    std::cerr << "ElectricalSeries::enableOverviewPyramid: must be called "
+                 "before any data is written."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  Status status = OverviewPyramid::createDataSets(
+      *ioPtr, getPath(), m_channelVector.size(), config);
+  if (status != Status::Success) {
+    return status;
+  }
+  return createOverviewPyramid(config);
+}
+
+Status ElectricalSeries::createOverviewPyramid(
+    const OverviewPyramidConfig& config)
+{
+  // retrieve the datasets via the recording cache such that they are
+  // released together with the other datasets on stopRecording
+  auto getDataSet = [this](const std::string& path)
+  {
+    auto it = m_recordingDataCache.find(path);
+    if (it != m_recordingDataCache.end()) {
+      return it->second;
+    }
+    auto io = getIO();
+    if (!io) {
+      return std::shared_ptr<IO::BaseRecordingData>();
+    }
+    auto dataset = io->getDataSet(path);
+    if (dataset) {
+      m_recordingDataCache[path] = dataset;
+    }
+    return dataset;
+  };
+  m_overviewPyramid = std::make_unique<OverviewPyramid>(getPath(),
+                                                       m_channelVector.size(),
+                                                       this->m_dataType,
+                                                       config,
+                                                       getDataSet);
+  if (m_overviewPyramid->resolveDataSets() != Status::Success) {
+    m_overviewPyramid.reset();
+    return Status::Failure;
+  }
+  return Status::Success;
+}
+
+void ElectricalSeries::clearRecordingDataCache()
+{
+  TimeSeries::clearRecordingDataCache();
+  if (m_overviewPyramid != nullptr) {
+    m_overviewPyramid->releaseDataSets();
+  }
+}
+
+Status ElectricalSeries::finalize()
+{
+  TraceScope trace("ElectricalSeries::finalize", "nwb");
+  Status status = TimeSeries::finalize();
+  if (m_overviewPyramid != nullptr) {
+    status = status && m_overviewPyramid->writeTail();
+  }
+  return status;
+}
+
+Status ElectricalSeries::restoreRecordingState()
+{
+  TraceScope trace("ElectricalSeries::restoreRecordingState", "nwb");
+  Status status = TimeSeries::restoreRecordingState();
+  if (status != Status::Success) {
+    return status;
+  }
+
+  // reconstruct the channels from the electrodes and their conversion
+  std::vector<int> electrodeInds;
+  std::vector<float> channelConversions;
+  float samplingRate = 0.f;
+  try {
+    electrodeInds = readElectrodes()->values().data;
+    auto channelConversionWrapper = readChannelConversion();
+    if (channelConversionWrapper->exists()) {
+      channelConversions = channelConversionWrapper->values().data;
+    }
+    samplingRate = readSamplingRate();
+  } catch (const std::exception& e) {
+    std::cerr << "ElectricalSeries::restoreRecordingState: failed to read "
+                 "the electrodes or the sampling rate: "
+              << e.what() << std::endl;
+    return Status::Failure;
+  }
+  if (electrodeInds.empty()) {
+    std::cerr << "ElectricalSeries::restoreRecordingState: the series has no "
+                 "electrodes."
+              << std::endl;
+    return Status::Failure;
+  }
+
+  // NWB does not store the names and groups of the channels, so the
+  // channels are named by their index in the series. Without
+  // channel_conversion, the factor of each channel is 1 as in the schema.
+  m_channelVector.clear();
+  for (SizeType i = 0; i < electrodeInds.size(); ++i) {
+    const float conversion = 1e6f;
+    const float channelConversion =
+        (i < channelConversions.size()) ? channelConversions[i] : 1.f;
+    m_channelVector.emplace_back("ch" + std::to_string(i),
+                                 "",
+                                 0,
+                                 i,
+                                 static_cast<SizeType>(electrodeInds[i]),
+                                 conversion,
+                                 samplingRate,
+                                 channelConversion * conversion);
+  }
+  const SizeType numSamples = getRecordedDataLength();
+  m_samplesRecorded = SizeArray(m_channelVector.size(), numSamples);
+  m_conversionScales.clear();
+
+  // continue the overview pyramid if the series has one
+  m_overviewPyramid.reset();
+  OverviewPyramidConfig overviewConfig;
+  auto ioPtr = getIO();
+  if (ioPtr
+      && ioPtr->objectExists(
+          AQNWB::mergePaths(getPath(), OverviewPyramid::groupName)))
+  {
+    if (!OverviewPyramid::readConfig(*ioPtr, getPath(), overviewConfig)
+        || !OverviewPyramid::isSupportedType(this->m_dataType))
+    {
+      std::cerr << "ElectricalSeries::restoreRecordingState: the overview "
+                   "pyramid of "
+                << getPath() << " cannot be continued." << std::endl;
+      return Status::Failure;
+    }
+    if (createOverviewPyramid(overviewConfig) != Status::Success
+        || m_overviewPyramid->resume(*ioPtr, numSamples) != Status::Success)
+    {
+      m_overviewPyramid.reset();
+      return Status::Failure;
+    }
+  }
+  return Status::Success;
+}
+
+float ElectricalSeries::readSamplingRate() const
+{
+  auto rateWrapper = readStartingTimeRate();
+  if (rateWrapper->exists()) {
+    return rateWrapper->values().data[0];
+  }
+  auto timestampsWrapper = readTimestamps();
+  if (!timestampsWrapper->exists()) {
+    return 0.f;
+  }
+  SizeArray shape = timestampsWrapper->getShape();
+  const SizeType numTimestamps = shape.empty() ? 0 : shape[0];
+  if (numTimestamps < 2) {
+    return 0.f;
+  }
+  const double first =
+      timestampsWrapper->values(SizeArray {0}, SizeArray {1}).data[0];
+  const double last =
+      timestampsWrapper
+          ->values(SizeArray {numTimestamps - 1}, SizeArray {1})
+          .data[0];
+  if (!(last > first)) {
+    return 0.f;
+  }
+  return static_cast<float>(static_cast<double>(numTimestamps - 1)
+                            / (last - first));
+}
+
+OverviewBlock ElectricalSeries::readOverview(double t0,
+                                             double t1,
+                                             SizeType pixelWidth) const
+{
+  auto range = findSampleRange(t0, t1);
+  return OverviewPyramid::read(
+      getIO(), getPath(), range.first, range.second, pixelWidth);
+}
+
+std::vector<float> ElectricalSeries::readChannelScaling(
+    SizeType channelStart, SizeType numChannels) const
+{
+  auto channelConversionWrapper = readChannelConversion();
+  if (!channelConversionWrapper->exists()) {
+    return {};
+  }
+  return channelConversionWrapper
+      ->values(SizeArray {channelStart}, SizeArray {numChannels})
+      .data;
+}
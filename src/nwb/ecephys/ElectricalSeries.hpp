@@ -1,12 +1,15 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "Channel.hpp"
 #include "Utils.hpp"
 #include "io/BaseIO.hpp"
 #include "io/ReadIO.hpp"
 #include "nwb/base/TimeSeries.hpp"
+#include "nwb/ecephys/OverviewPyramid.hpp"
 #include "nwb/file/ElectrodesTable.hpp"
 #include "spec/core.hpp"
 
@@ -82,6 +85,34 @@ public:
                       const void* timestampsInput,
                       const void* controlInput = nullptr);
 
+  /**
+   * @brief Converts float samples of a channel to the storage type and writes
+   * them to the ElectricalSeries dataset.
+   *
+   * The samples are given in microvolts and are divided by the
+   * Channel::getBitVolts of the channel, then clamped and rounded to the
+   * storage type in a single vectorized pass into a staging buffer that is
+   * reused across calls. This is equivalent to, but avoids the temporary
+   * buffers of, calling transformToInt16 followed by writeChannel.
+   *
+   * @param channelInd The channel index within the ElectricalSeries
+   * @param numSamples The number of samples to write (length in time).
+   * @param dataInput The samples in microvolts.
+   * @param storageType The data type the series was initialized with. Must
+   * be BaseDataType::I16, or BaseDataType::F32 in which case the samples are
+   * written unchanged.
+   * @param timestampsInput A pointer to the timestamps block.
+   * @param controlInput A pointer to the control block data (optional)
+   * @return The status of the write operation. Failure if storageType does
+   * not match the data type of the series or is not supported.
+   */
+  Status writeChannel(SizeType channelInd,
+                      const SizeType& numSamples,
+                      const float* dataInput,
+                      const IO::BaseDataType& storageType,
+                      const void* timestampsInput,
+                      const void* controlInput = nullptr);
+
   /**
    * @brief Writes a block of multichannel samples to an ElectricalSeries
    * dataset in a single operation.
@@ -119,6 +150,31 @@ public:
                           const void* timestampsInput = nullptr,
                           const void* controlInput = nullptr);
 
+  /**
+   * @brief Converts interleaved float samples of all channels to the storage
+   * type and writes them in a single operation.
+   *
+   * Same as writeAllChannels, but the samples are given in microvolts and are
+   * converted as described for the float overload of writeChannel using the
+   * Channel::getBitVolts of each channel.
+   *
+   * @param numSamples The number of time samples (rows) to write.
+   * @param dataInput The interleaved samples in microvolts with shape
+   *                  `[numSamples, numChannels]`.
+   * @param storageType The data type the series was initialized with. Must
+   * be BaseDataType::I16, or BaseDataType::F32 in which case the samples are
+   * written unchanged.
+   * @param timestampsInput A pointer to the timestamps array (see
+   *                        writeAllChannels).
+   * @param controlInput A pointer to the control array (optional).
+   * @return The status of the write operation.
+   */
+  Status writeAllChannels(const SizeType& numSamples,
+                          const float* dataInput,
+                          const IO::BaseDataType& storageType,
+                          const void* timestampsInput = nullptr,
+                          const void* controlInput = nullptr);
+
   /**
    * @brief Checks if all channels are at the same sample offset, i.e. if every
    * channel has the same number of samples recorded.
@@ -127,6 +183,74 @@ public:
    */
   bool channelsAtSameSampleOffset() const;
 
+  /**
+   * @brief Enable computing a min/max overview pyramid of the data while
+   * recording.
+   *
+   * Creates the `overview` group with one dataset per statistic and
+   * decimation level. The envelopes are updated by writeChannel and
+   * writeAllChannels and the incomplete bins at the end of the recording are
+   * written on finalize. Must be called after initialize and before any data
+   * is written.
+   *
+   * The pyramid is disabled by default because the `overview` group is not
+   * part of the NWB schema. NWB validators and inspectors report it as an
+   * undeclared group of the ElectricalSeries, and tools other than AqNWB
+   * ignore it. Only enable it for files that are read with readOverview or
+   * where such reports are acceptable.
+   *
+   * @param config The decimation levels and options of the pyramid
+   * @return The status of the operation
+   */
+  Status enableOverviewPyramid(const OverviewPyramidConfig& config = {});
+
+  /**
+   * @brief Write the incomplete bins of the overview pyramid, if enabled.
+   * @return The status of the operation
+   */
+  Status finalize() override;
+
+  /**
+   * @brief Clear the cached datasets, including the datasets of the overview
+   * pyramid.
+   */
+  void clearRecordingDataCache() override;
+
+  /**
+   * @brief Restore the recording state of an ElectricalSeries read from an
+   * existing file.
+   *
+   * The channels are reconstructed from the electrodes and the
+   * channel_conversion in the file, with a conversion of 1e6 such that
+   * Channel::getBitVolts matches the channel_conversion. Since NWB does not
+   * store channel names, the channels are named "ch<i>" by their index in
+   * the series. The sampling rate is read from starting_time, or estimated
+   * from the first and last timestamps, and is 0 if there are fewer than two
+   * timestamps. All channels continue writing after the last sample of the
+   * data, i.e., samples of channels that were not written before a crash
+   * remain unset. An overview pyramid in the file is continued (see
+   * OverviewPyramid::resume).
+   *
+   * @return The status of the operation. Fails if the series has an
+   * overview pyramid that cannot be continued.
+   */
+  Status restoreRecordingState() override;
+
+  /**
+   * @brief Read the min/max envelope of a time range for display.
+   *
+   * Selects the coarsest level of the overview pyramid that still provides
+   * at least pixelWidth bins for the time range and falls back to the raw
+   * data if no level is fine enough. Time is resolved to samples via
+   * findSampleRange.
+   *
+   * @param t0 The start time of the range (inclusive)
+   * @param t1 The stop time of the range (exclusive)
+   * @param pixelWidth The number of pixels the range is drawn on
+   * @return The envelope of the range in the units of the raw data
+   */
+  OverviewBlock readOverview(double t0, double t1, SizeType pixelWidth) const;
+
   /**
    * @brief Channel group that this time series is associated with.
    */
@@ -166,10 +290,62 @@ public:
       The electrodes table retrieved from the object referenced in the 
       `electrodes / table` attribute.)
 
+protected:
+  /**
+   * @brief Read the channel_conversion of a range of channels.
+   *
+   * Used by readDataScaled to convert the data to volts.
+   *
+   * @param channelStart The index of the first channel
+   * @param numChannels The number of channels
+   * @return The channel_conversion of each channel, or an empty vector if
+   * channel_conversion does not exist.
+   */
+  std::vector<float> readChannelScaling(SizeType channelStart,
+                                        SizeType numChannels) const override;
+
 private:
+  /**
+   * @brief Create the overview pyramid for the datasets in the file and
+   * resolve its datasets
+   * @param config The configuration of the pyramid
+   * @return The status of the operation
+   */
+  Status createOverviewPyramid(const OverviewPyramidConfig& config);
+
+  /**
+   * @brief Read the sampling rate from starting_time or the timestamps
+   * @return The sampling rate in Hz, or 0 if it cannot be determined
+   */
+  float readSamplingRate() const;
+
   /**
    * @brief The number of samples already written per channel.
    */
   SizeArray m_samplesRecorded;
+
+  /**
+   * @brief The overview pyramid updated while recording, if enabled.
+   */
+  std::unique_ptr<OverviewPyramid> m_overviewPyramid;
+
+  /**
+   * @brief Staging buffer for converting float input to the storage type.
+   */
+  std::vector<int16_t> m_conversionBuffer;
+
+  /**
+   * @brief Factor converting the float input of each channel to int16.
+   */
+  std::vector<float> m_conversionScales;
+
+  /**
+   * @brief Check that float input can be converted to the given storage type
+   * @param storageType The requested storage type
+   * @param functionName Name of the calling function for error messages
+   * @return True if the conversion is supported
+   */
+  bool isSupportedStorageType(const IO::BaseDataType& storageType,
+                              const std::string& functionName) const;
 };
 }  // namespace AQNWB::NWB
@@ -0,0 +1,599 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+#include "nwb/ecephys/OverviewPyramid.hpp"
+
+#include "Utils.hpp"
+
+using namespace AQNWB::NWB;
+
+namespace
+{
+/**
+ * @brief Names of the statistics stored per level, in the order of the
+ * datasets of a level
+ */
+const std::array<const char*, 3> statisticNames = {"min", "max", "mean"};
+}  // namespace
+
+// OverviewPyramid
+
+const std::string OverviewPyramid::groupName = "overview";
+
+/** Constructor */
+OverviewPyramid::OverviewPyramid(const std::string& seriesPath,
+                                 SizeType numChannels,
+                                 const IO::BaseDataType& dataType,
+                                 const OverviewPyramidConfig& config,
+                                 DataSetGetter getDataSet)
+    : m_seriesPath(seriesPath)
+    , m_numChannels(numChannels)
+    , m_dataType(dataType)
+    , m_config(config)
+    , m_getDataSet(std::move(getDataSet))
+    , m_partialBins(config.decimations.size(), std::vector<Bin>(numChannels))
+    , m_pendingBins(config.decimations.size(),
+                    std::vector<std::vector<Bin>>(numChannels))
+    , m_binsWritten(config.decimations.size(), 0)
+{
+}
+
+Status OverviewPyramid::resolveDataSets()
+{
+  const SizeType numStatistics = getNumStatistics();
+  m_dataSets.assign(m_config.decimations.size() * numStatistics, nullptr);
+  for (SizeType level = 0; level < m_config.decimations.size(); ++level) {
+    for (SizeType s = 0; s < numStatistics; ++s) {
+      std::string path = getDataSetPath(
+          m_seriesPath, statisticNames[s], m_config.decimations[level]);
+      auto dataset = m_getDataSet(path);
+      if (dataset == nullptr) {
+        std::cerr << "OverviewPyramid::resolveDataSets: " << path
+                  << " does not exist" << std::endl;
+        m_dataSets.clear();
+        return Status::Failure;
+      }
+      m_dataSets[level * numStatistics + s] = std::move(dataset);
+    }
+  }
+  return Status::Success;
+}
+
+void OverviewPyramid::releaseDataSets()
+{
+  m_dataSets.clear();
+}
+
+bool OverviewPyramid::isValidConfig(const OverviewPyramidConfig& config)
+{
+  if (config.decimations.empty() || config.decimations[0] < 2
+      || config.chunkSize == 0)
+  {
+    return false;
+  }
+  for (SizeType i = 1; i < config.decimations.size(); ++i) {
+    if (config.decimations[i] <= config.decimations[i - 1]
+        || config.decimations[i] % config.decimations[i - 1] != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool OverviewPyramid::isSupportedType(const IO::BaseDataType& dataType)
+{
+  return dataType.type != IO::BaseDataType::T_STR
+      && dataType.type != IO::BaseDataType::V_STR;
+}
+
+std::string OverviewPyramid::getDataSetPath(const std::string& seriesPath,
+                                            const std::string& statistic,
+                                            SizeType decimation)
+{
+  return AQNWB::mergePaths(
+      AQNWB::mergePaths(seriesPath, groupName),
+      statistic + "_" + std::to_string(decimation));
+}
+
+Status OverviewPyramid::createDataSets(IO::BaseIO& io,
+                                       const std::string& seriesPath,
+                                       SizeType numChannels,
+                                       const OverviewPyramidConfig& config)
+{
+  if (!isValidConfig(config) || numChannels == 0) {
+    std::cerr << "OverviewPyramid::createDataSets: invalid configuration for "
+              << seriesPath << std::endl;
+    return Status::Failure;
+  }
+
+  std::string groupPath = AQNWB::mergePaths(seriesPath, groupName);
+  if (io.createGroup(groupPath) != Status::Success) {
+    return Status::Failure;
+  }
+  std::vector<uint64_t> decimations(config.decimations.begin(),
+                                    config.decimations.end());
+  Status status = io.createAttribute(IO::BaseDataType::U64,
+                                     decimations.data(),
+                                     groupPath,
+                                     "decimations",
+                                     decimations.size());
+
+  std::vector<std::string> statistics = {"min", "max"};
+  if (config.computeMean) {
+    statistics.push_back("mean");
+  }
+  IO::ArrayDataSetConfig dataConfig(IO::BaseDataType::F32,
+                                    SizeArray {0, numChannels},
+                                    SizeArray {config.chunkSize, numChannels});
+  try {
+    for (SizeType decimation : config.decimations) {
+      for (const auto& statistic : statistics) {
+        io.createArrayDataSet(
+            dataConfig, getDataSetPath(seriesPath, statistic, decimation));
+      }
+    }
+  } catch (const std::runtime_error& e) {
+    std::cerr << "Failed to create overview datasets: " << e.what()
+              << std::endl;
+    return Status::Failure;
+  }
+  return status;
+}
+
+Status OverviewPyramid::addChannelSamples(SizeType channel,
+                                          SizeType numSamples,
+                                          const void* data)
+{
+  if (channel >= m_numChannels) {
+    std::cerr << "OverviewPyramid::addChannelSamples: channel index "
+              << channel << " is out of range" << std::endl;
+    return Status::Failure;
+  }
+  addRaw(channel, numSamples, data, 0, 1);
+  return writeReadyRows();
+}
+
+Status OverviewPyramid::addSamples(SizeType numSamples, const void* data)
+{
+  for (SizeType channel = 0; channel < m_numChannels; ++channel) {
+    addRaw(channel, numSamples, data, channel, m_numChannels);
+  }
+  return writeReadyRows();
+}
+
+template<typename T>
+void OverviewPyramid::addValues(SizeType channel,
+                                SizeType numSamples,
+                                const T* data,
+                                SizeType stride)
+{
+  const SizeType decimation = m_config.decimations[0];
+  Bin& bin = m_partialBins[0][channel];
+  for (SizeType i = 0; i < numSamples; ++i) {
+    bin.add(static_cast<float>(data[i * stride]));
+    if (bin.count == decimation) {
+      pushBin(0, channel, bin);
+      bin = Bin();
+    }
+  }
+}
+
+void OverviewPyramid::addRaw(SizeType channel,
+                             SizeType numSamples,
+                             const void* data,
+                             SizeType offset,
+                             SizeType stride)
+{
+  switch (m_dataType.type) {
+    case IO::BaseDataType::T_U8:
+      addValues(channel,
+                numSamples,
+                static_cast<const uint8_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_U16:
+      addValues(channel,
+                numSamples,
+                static_cast<const uint16_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_U32:
+      addValues(channel,
+                numSamples,
+                static_cast<const uint32_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_U64:
+      addValues(channel,
+                numSamples,
+                static_cast<const uint64_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_I8:
+      addValues(channel,
+                numSamples,
+                static_cast<const int8_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_I16:
+      addValues(channel,
+                numSamples,
+                static_cast<const int16_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_I32:
+      addValues(channel,
+                numSamples,
+                static_cast<const int32_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_I64:
+      addValues(channel,
+                numSamples,
+                static_cast<const int64_t*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_F32:
+      addValues(channel,
+                numSamples,
+                static_cast<const float*>(data) + offset,
+                stride);
+      break;
+    case IO::BaseDataType::T_F64:
+      addValues(channel,
+                numSamples,
+                static_cast<const double*>(data) + offset,
+                stride);
+      break;
+    default:
+      break;
+  }
+}
+
+void OverviewPyramid::pushBin(SizeType level, SizeType channel, const Bin& bin)
+{
+  m_pendingBins[level][channel].push_back(bin);
+
+  // propagate the completed bin to the next coarser level
+  SizeType nextLevel = level + 1;
+  if (nextLevel < m_config.decimations.size()) {
+    Bin& next = m_partialBins[nextLevel][channel];
+    next.merge(bin);
+    if (next.count == m_config.decimations[nextLevel]) {
+      Bin completed = next;
+      next = Bin();
+      pushBin(nextLevel, channel, completed);
+    }
+  }
+}
+
+Status OverviewPyramid::writeReadyRows()
+{
+  Status status = Status::Success;
+  for (SizeType level = 0; level < m_config.decimations.size(); ++level) {
+    auto& pending = m_pendingBins[level];
+    SizeType numRows = pending[0].size();
+    for (const auto& channelBins : pending) {
+      numRows = std::min(numRows, static_cast<SizeType>(channelBins.size()));
+    }
+    if (numRows == 0) {
+      continue;
+    }
+
+    // collect the rows in [numRows, numChannels] order
+    m_rowBins.resize(numRows * m_numChannels);
+    for (SizeType ch = 0; ch < m_numChannels; ++ch) {
+      for (SizeType row = 0; row < numRows; ++row) {
+        m_rowBins[row * m_numChannels + ch] = pending[ch][row];
+      }
+      pending[ch].erase(
+          pending[ch].begin(),
+          pending[ch].begin() + static_cast<std::ptrdiff_t>(numRows));
+    }
+
+    Status writeStatus = writeRows(level, m_binsWritten[level], numRows);
+    m_binsWritten[level] += numRows;
+    status = status && writeStatus;
+  }
+  return status;
+}
+
+Status OverviewPyramid::resume(IO::BaseIO& io, SizeType numSamples)
+{
+  // Bins are kept up to the last complete bin of the coarsest level that
+  // is stored for all levels. The last stored row of a level may be the
+  // incomplete tail of a previous writeTail.
+  SizeType keptSamples = numSamples;
+  for (SizeType level = 0; level < m_config.decimations.size(); ++level) {
+    const SizeType decimation = m_config.decimations[level];
+    const std::string path = getDataSetPath(m_seriesPath, "min", decimation);
+    if (!io.objectExists(path)) {
+      std::cerr << "OverviewPyramid::resume: " << path << " does not exist"
+                << std::endl;
+      return Status::Failure;
+    }
+    SizeArray shape = io.getStorageObjectShape(path);
+    if (shape.size() != 2 || shape[1] != m_numChannels) {
+      std::cerr << "OverviewPyramid::resume: " << path
+                << " does not match the number of channels" << std::endl;
+      return Status::Failure;
+    }
+    const SizeType completeRows = (shape[0] > 0) ? shape[0] - 1 : 0;
+    keptSamples = std::min(keptSamples, completeRows * decimation);
+  }
+  const SizeType coarsest = m_config.decimations.back();
+  const SizeType replayStart = (keptSamples / coarsest) * coarsest;
+  for (SizeType level = 0; level < m_config.decimations.size(); ++level) {
+    m_binsWritten[level] = replayStart / m_config.decimations[level];
+  }
+
+  // bin the raw samples after the kept bins again, one coarse bin at a time
+  const std::string dataPath = AQNWB::mergePaths(m_seriesPath, "data");
+  const SizeArray dataShape = io.getStorageObjectShape(dataPath);
+  const SizeType rank = dataShape.size();
+  if (rank == 0 || rank > 2 || (rank == 2 && dataShape[1] != m_numChannels)) {
+    std::cerr << "OverviewPyramid::resume: the shape of " << dataPath
+              << " does not match the pyramid" << std::endl;
+    return Status::Failure;
+  }
+  numSamples = std::min(numSamples, dataShape[0]);
+  Status status = Status::Success;
+  for (SizeType start = replayStart; start < numSamples; start += coarsest) {
+    const SizeType count = std::min(coarsest, numSamples - start);
+    SizeArray offset = {start};
+    SizeArray blockShape = {count};
+    if (rank == 2) {
+      offset.push_back(0);
+      blockShape.push_back(m_numChannels);
+    }
+    IO::DataBlockGeneric raw;
+    try {
+      raw = io.readDataset(dataPath, offset, blockShape);
+    } catch (const std::exception& e) {
+      std::cerr << "OverviewPyramid::resume: " << e.what() << std::endl;
+      return Status::Failure;
+    }
+    bool numeric = true;
+    std::visit(
+        [&](const auto& data)
+        {
+          using VectorType = std::decay_t<decltype(data)>;
+          if constexpr (std::is_same_v<VectorType, std::monostate>) {
+            numeric = false;
+          } else if constexpr (std::is_same_v<typename VectorType::value_type,
+                                              std::string>)
+          {
+            numeric = false;
+          } else {
+            for (SizeType ch = 0; ch < m_numChannels; ++ch) {
+              addValues(ch, count, data.data() + ch, m_numChannels);
+            }
+          }
+        },
+        raw.as_variant());
+    if (!numeric) {
+      std::cerr << "OverviewPyramid::resume: unsupported data type of "
+                << dataPath << std::endl;
+      return Status::Failure;
+    }
+    status = status && writeReadyRows();
+  }
+  return status;
+}
+
+Status OverviewPyramid::writeTail()
+{
+  Status status = Status::Success;
+  std::vector<Bin> tail(m_numChannels);
+  for (SizeType level = 0; level < m_config.decimations.size(); ++level) {
+    // the incomplete bin of a level includes the incomplete bins of all
+    // finer levels
+    for (SizeType ch = 0; ch < m_numChannels; ++ch) {
+      tail[ch].merge(m_partialBins[level][ch]);
+    }
+
+    const auto& pending = m_pendingBins[level];
+    SizeType numRows = 0;
+    for (SizeType ch = 0; ch < m_numChannels; ++ch) {
+      SizeType channelRows =
+          pending[ch].size() + ((tail[ch].count > 0) ? 1 : 0);
+      numRows = std::max(numRows, channelRows);
+    }
+    if (numRows == 0) {
+      continue;
+    }
+
+    // bins with a count of 0 are written as NaN
+    m_rowBins.assign(numRows * m_numChannels, Bin());
+    for (SizeType ch = 0; ch < m_numChannels; ++ch) {
+      for (SizeType row = 0; row < pending[ch].size(); ++row) {
+        m_rowBins[row * m_numChannels + ch] = pending[ch][row];
+      }
+      if (tail[ch].count > 0) {
+        m_rowBins[pending[ch].size() * m_numChannels + ch] = tail[ch];
+      }
+    }
+
+    Status writeStatus = writeRows(level, m_binsWritten[level], numRows);
+    status = status && writeStatus;
+  }
+  return status;
+}
+
+Status OverviewPyramid::writeRows(SizeType level,
+                                  SizeType rowOffset,
+                                  SizeType numRows)
+{
+  if (m_dataSets.empty() && resolveDataSets() != Status::Success) {
+    return Status::Failure;
+  }
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const SizeType numValues = numRows * m_numChannels;
+  const SizeType numStatistics = getNumStatistics();
+  Status status = Status::Success;
+  for (SizeType s = 0; s < numStatistics; ++s) {
+    m_values.resize(numValues);
+    for (SizeType i = 0; i < numValues; ++i) {
+      const Bin& bin = m_rowBins[i];
+      if (bin.count == 0) {
+        m_values[i] = nan;
+      } else if (s == 0) {
+        m_values[i] = bin.min;
+      } else if (s == 1) {
+        m_values[i] = bin.max;
+      } else {
+        m_values[i] =
+            static_cast<float>(bin.sum / static_cast<double>(bin.count));
+      }
+    }
+    Status writeStatus =
+        m_dataSets[level * numStatistics + s]->writeDataBlock(
+            SizeArray {numRows, m_numChannels},
+            SizeArray {rowOffset, 0},
+            IO::BaseDataType::F32,
+            m_values.data());
+    status = status && writeStatus;
+  }
+  return status;
+}
+
+bool OverviewPyramid::readConfig(IO::BaseIO& io,
+                                 const std::string& seriesPath,
+                                 OverviewPyramidConfig& config)
+{
+  std::string attributePath =
+      AQNWB::mergePaths(AQNWB::mergePaths(seriesPath, groupName),
+                        "decimations");
+  if (!io.attributeExists(attributePath)) {
+    return false;
+  }
+  auto decimations =
+      IO::DataBlock<uint64_t>::fromGeneric(io.readAttribute(attributePath));
+  config.decimations =
+      SizeArray(decimations.data.begin(), decimations.data.end());
+  if (config.decimations.empty()) {
+    return false;
+  }
+  const SizeType finest = config.decimations[0];
+  config.computeMean =
+      io.objectExists(getDataSetPath(seriesPath, "mean", finest));
+  SizeArray chunking =
+      io.getStorageObjectChunking(getDataSetPath(seriesPath, "min", finest));
+  if (!chunking.empty() && chunking[0] > 0) {
+    config.chunkSize = chunking[0];
+  }
+  return isValidConfig(config);
+}
+
+SizeArray OverviewPyramid::readDecimations(
+    const std::shared_ptr<IO::BaseIO>& io, const std::string& seriesPath)
+{
+  std::string attributePath =
+      AQNWB::mergePaths(AQNWB::mergePaths(seriesPath, groupName),
+                        "decimations");
+  if (io == nullptr || !io->attributeExists(attributePath)) {
+    return {};
+  }
+  auto decimations =
+      IO::DataBlock<uint64_t>::fromGeneric(io->readAttribute(attributePath));
+  return SizeArray(decimations.data.begin(), decimations.data.end());
+}
+
+OverviewBlock OverviewPyramid::read(const std::shared_ptr<IO::BaseIO>& io,
+                                    const std::string& seriesPath,
+                                    SizeType startSample,
+                                    SizeType stopSample,
+                                    SizeType pixelWidth)
+{
+  if (io == nullptr) {
+    throw std::runtime_error("OverviewPyramid::read: IO object is not valid");
+  }
+  stopSample = std::max(startSample, stopSample);
+  SizeType numSamples = stopSample - startSample;
+  pixelWidth = std::max(pixelWidth, static_cast<SizeType>(1));
+
+  // select the coarsest level that still provides pixelWidth bins
+  SizeType decimation = 1;
+  for (SizeType d : readDecimations(io, seriesPath)) {
+    if (numSamples / d >= pixelWidth) {
+      decimation = std::max(decimation, d);
+    }
+  }
+
+  OverviewBlock result;
+  result.decimation = decimation;
+
+  if (decimation == 1) {
+    // read the raw samples
+    std::string dataPath = AQNWB::mergePaths(seriesPath, "data");
+    SizeArray shape = io->getStorageObjectShape(dataPath);
+    SizeType numChannels = (shape.size() > 1) ? shape[1] : 1;
+    SizeType stop = std::min(stopSample, shape.empty() ? 0 : shape[0]);
+    SizeType start = std::min(startSample, stop);
+    SizeArray offset = {start};
+    SizeArray count = {stop - start};
+    if (shape.size() > 1) {
+      offset.push_back(0);
+      count.push_back(numChannels);
+    }
+    auto raw = io->readDataset(dataPath, offset, count);
+
+    std::vector<float> values;
+    std::visit(
+        [&values](const auto& data)
+        {
+          using VectorType = std::decay_t<decltype(data)>;
+          if constexpr (std::is_same_v<VectorType, std::monostate>) {
+            throw std::runtime_error(
+                "OverviewPyramid::read: unsupported data type");
+          } else if constexpr (std::is_same_v<typename VectorType::value_type,
+                                              std::string>)
+          {
+            throw std::runtime_error(
+                "OverviewPyramid::read: unsupported data type");
+          } else {
+            values.assign(data.begin(), data.end());
+          }
+        },
+        raw.as_variant());
+
+    result.startSample = start;
+    result.shape = SizeArray {stop - start, numChannels};
+    result.min = values;
+    result.max = values;
+    result.mean = std::move(values);
+    return result;
+  }
+
+  auto readStatistic = [&](const std::string& statistic,
+                           std::vector<float>& values)
+  {
+    std::string path = getDataSetPath(seriesPath, statistic, decimation);
+    if (!io->objectExists(path)) {
+      return;
+    }
+    SizeArray shape = io->getStorageObjectShape(path);
+    SizeType binStop =
+        std::min((stopSample + decimation - 1) / decimation, shape[0]);
+    SizeType binStart = std::min(startSample / decimation, binStop);
+    auto block = IO::DataBlock<float>::fromGeneric(
+        io->readDataset(path,
+                        SizeArray {binStart, 0},
+                        SizeArray {binStop - binStart, shape[1]}));
+    values = std::move(block.data);
+    result.shape = block.shape;
+    result.startSample = binStart * decimation;
+  };
+
+  readStatistic("min", result.min);
+  readStatistic("max", result.max);
+  readStatistic("mean", result.mean);
+  return result;
+}
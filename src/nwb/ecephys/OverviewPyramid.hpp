@@ -0,0 +1,366 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "io/BaseIO.hpp"
+#include "io/ReadIO.hpp"
+
+namespace AQNWB::NWB
+{
+
+/**
+ * @brief Configuration of an OverviewPyramid
+ */
+struct OverviewPyramidConfig
+{
+  /**
+   * @brief Number of samples per bin for each level of the pyramid.
+   *
+   * Must be strictly increasing and each value must be a multiple of the
+   * previous value.
+   */
+  SizeArray decimations = {16, 64, 256, 1024, 4096, 16384, 65536};
+
+  /**
+   * @brief Whether to also compute and store the mean of each bin
+   */
+  bool computeMean = false;
+
+  /**
+   * @brief Chunk size (in number of bins) of the overview datasets
+   */
+  SizeType chunkSize = 1024;
+};
+
+/**
+ * @brief Envelope of a range of samples returned by OverviewPyramid::read
+ */
+struct OverviewBlock
+{
+  /**
+   * @brief Number of samples per bin. 1 indicates that the raw samples were
+   * read since no level of the pyramid was coarse enough.
+   */
+  SizeType decimation = 0;
+
+  /**
+   * @brief Index of the first sample of the first bin
+   */
+  SizeType startSample = 0;
+
+  /**
+   * @brief Shape [numBins, numChannels] of the min, max, and mean values
+   */
+  SizeArray shape;
+
+  /**
+   * @brief Minimum of each bin in row-major order
+   */
+  std::vector<float> min;
+
+  /**
+   * @brief Maximum of each bin in row-major order
+   */
+  std::vector<float> max;
+
+  /**
+   * @brief Mean of each bin in row-major order. Empty if the mean was not
+   * stored.
+   */
+  std::vector<float> mean;
+};
+
+/**
+ * @brief Multi-resolution min/max (and optionally mean) envelopes of a 2D
+ * [time, channel] dataset computed while the data is being recorded.
+ *
+ * The pyramid bins the samples of each channel at a series of decimation
+ * levels. Each level is stored in the `overview` group of the series as
+ * datasets `min_<decimation>`, `max_<decimation>` and optionally
+ * `mean_<decimation>` of shape [numBins, numChannels]. Envelopes are stored
+ * in the same (unscaled) units as the raw data. Completed bins are written as
+ * soon as they are available for all channels. Incomplete bins at the end of
+ * the recording are written by writeTail. The `overview` group is not
+ * declared by the NWB schema (see ElectricalSeries::enableOverviewPyramid).
+ */
+class OverviewPyramid
+{
+public:
+  /**
+   * @brief Function used to retrieve the datasets to write the envelopes to
+   */
+  using DataSetGetter =
+      std::function<std::shared_ptr<IO::BaseRecordingData>(const std::string&)>;
+
+  /**
+   * @brief Name of the group storing the pyramid within the series
+   */
+  static const std::string groupName;
+
+  /**
+   * @brief Constructor
+   * @param seriesPath The path of the series the pyramid belongs to
+   * @param numChannels The number of channels of the series
+   * @param dataType The data type of the raw data passed to addSamples
+   * @param config The configuration of the pyramid
+   * @param getDataSet Function returning the dataset for a given path
+   */
+  OverviewPyramid(const std::string& seriesPath,
+                  SizeType numChannels,
+                  const IO::BaseDataType& dataType,
+                  const OverviewPyramidConfig& config,
+                  DataSetGetter getDataSet);
+
+  /**
+   * @brief Create the group and datasets of the pyramid in the file
+   * @param io The IO object to use
+   * @param seriesPath The path of the series the pyramid belongs to
+   * @param numChannels The number of channels of the series
+   * @param config The configuration of the pyramid
+   * @return The status of the operation
+   */
+  static Status createDataSets(IO::BaseIO& io,
+                               const std::string& seriesPath,
+                               SizeType numChannels,
+                               const OverviewPyramidConfig& config);
+
+  /**
+   * @brief Check whether the configuration is valid
+   */
+  static bool isValidConfig(const OverviewPyramidConfig& config);
+
+  /**
+   * @brief Check whether raw data of the given type can be binned
+   */
+  static bool isSupportedType(const IO::BaseDataType& dataType);
+
+  /**
+   * @brief Add consecutive samples of a single channel
+   * @param channel The index of the channel
+   * @param numSamples The number of samples
+   * @param data Pointer to numSamples values of the raw data type
+   * @return The status of writing completed bins
+   */
+  Status addChannelSamples(SizeType channel,
+                           SizeType numSamples,
+                           const void* data);
+
+  /**
+   * @brief Add consecutive samples of all channels
+   * @param numSamples The number of samples
+   * @param data Pointer to interleaved [numSamples, numChannels] values of
+   * the raw data type
+   * @return The status of writing completed bins
+   */
+  Status addSamples(SizeType numSamples, const void* data);
+
+  /**
+   * @brief Resolve the datasets of all levels via the DataSetGetter, such
+   * that writing bins does not look up the datasets by path.
+   * @return The status of the operation. Fails if a dataset does not exist.
+   */
+  Status resolveDataSets();
+
+  /**
+   * @brief Release the datasets of all levels, e.g., when the recording
+   * stops. They are resolved again by the next write.
+   */
+  void releaseDataSets();
+
+  /**
+   * @brief Continue a pyramid stored in the file after numSamples samples
+   * of the raw data were recorded, e.g., after reopening the file.
+   *
+   * Bins that start before the last complete bin of the coarsest level
+   * are kept as stored. The raw samples after it are read back and binned
+   * again, such that the incomplete bins and bins that were not written
+   * before a crash are restored. Must be called on a new pyramid before
+   * any samples are added.
+   * @param io The IO object to read the raw data and the stored bins from
+   * @param numSamples The number of samples of the raw data
+   * @return The status of the operation. Fails if the stored datasets do not
+   * match the configuration or the raw data cannot be read.
+   */
+  Status resume(IO::BaseIO& io, SizeType numSamples);
+
+  /**
+   * @brief Write the incomplete bins at the end of each level.
+   *
+   * The tail is written after the completed bins without advancing the
+   * write position, such that it is overwritten once the bins complete.
+   * This method may therefore be called several times during a recording.
+   * Missing values (e.g., for channels that are behind) are set to NaN.
+   * @return The status of the operation
+   */
+  Status writeTail();
+
+  /**
+   * @brief Read the envelope of a range of samples at the coarsest level
+   * providing at least pixelWidth bins.
+   *
+   * If no level is fine enough, the raw samples are read instead and
+   * returned as min, max, and mean with a decimation of 1.
+   * @param io The IO object to read from
+   * @param seriesPath The path of the series
+   * @param startSample The first sample of the range
+   * @param stopSample One past the last sample of the range
+   * @param pixelWidth The number of pixels the range is drawn on
+   * @return The envelope of the range
+   */
+  static OverviewBlock read(const std::shared_ptr<IO::BaseIO>& io,
+                            const std::string& seriesPath,
+                            SizeType startSample,
+                            SizeType stopSample,
+                            SizeType pixelWidth);
+
+  /**
+   * @brief Read the configuration of the pyramid stored for a series
+   * @param io The IO object to read from
+   * @param seriesPath The path of the series
+   * @param config The decimations, whether the mean is stored, and the
+   * chunk size of the stored pyramid (return value)
+   * @return False if no pyramid exists or its configuration is invalid
+   */
+  static bool readConfig(IO::BaseIO& io,
+                         const std::string& seriesPath,
+                         OverviewPyramidConfig& config);
+
+  /**
+   * @brief Read the decimations of the levels stored for a series
+   * @return The decimations, or an empty array if no pyramid exists
+   */
+  static SizeArray readDecimations(const std::shared_ptr<IO::BaseIO>& io,
+                                   const std::string& seriesPath);
+
+  /**
+   * @brief Get the path of an overview dataset
+   * @param seriesPath The path of the series
+   * @param statistic One of "min", "max", or "mean"
+   * @param decimation The decimation of the level
+   */
+  static std::string getDataSetPath(const std::string& seriesPath,
+                                    const std::string& statistic,
+                                    SizeType decimation);
+
+private:
+  /**
+   * @brief Running statistics of one bin
+   */
+  struct Bin
+  {
+    float min = 0.0f;
+    float max = 0.0f;
+    double sum = 0.0;
+    SizeType count = 0;
+
+    inline void add(float value)
+    {
+      min = (count == 0 || value < min) ? value : min;
+      max = (count == 0 || value > max) ? value : max;
+      sum += static_cast<double>(value);
+      ++count;
+    }
+
+    inline void merge(const Bin& other)
+    {
+      if (other.count == 0) {
+        return;
+      }
+      min = (count == 0 || other.min < min) ? other.min : min;
+      max = (count == 0 || other.max > max) ? other.max : max;
+      sum += other.sum;
+      count += other.count;
+    }
+  };
+
+  /**
+   * @brief Add numSamples values of a channel spaced stride elements apart
+   */
+  template<typename T>
+  void addValues(SizeType channel,
+                 SizeType numSamples,
+                 const T* data,
+                 SizeType stride);
+
+  /**
+   * @brief Dispatch addValues on the raw data type
+   * @param channel The index of the channel
+   * @param numSamples The number of samples
+   * @param data Pointer to the raw data
+   * @param offset Index of the first value of the channel in data
+   * @param stride Number of values between consecutive samples in data
+   */
+  void addRaw(SizeType channel,
+              SizeType numSamples,
+              const void* data,
+              SizeType offset,
+              SizeType stride);
+
+  /**
+   * @brief Add a completed bin to a level and propagate it to the next level
+   */
+  void pushBin(SizeType level, SizeType channel, const Bin& bin);
+
+  /**
+   * @brief Write all bins that are complete for all channels
+   */
+  Status writeReadyRows();
+
+  /**
+   * @brief Write the first numRows rows of m_rowBins to a level
+   */
+  Status writeRows(SizeType level, SizeType rowOffset, SizeType numRows);
+
+  /**
+   * @brief Get the number of statistics stored per level
+   */
+  inline SizeType getNumStatistics() const
+  {
+    return m_config.computeMean ? 3 : 2;
+  }
+
+  std::string m_seriesPath;
+  SizeType m_numChannels;
+  IO::BaseDataType m_dataType;
+  OverviewPyramidConfig m_config;
+  DataSetGetter m_getDataSet;
+
+  /**
+   * @brief The incomplete bin of each [level][channel]
+   */
+  std::vector<std::vector<Bin>> m_partialBins;
+
+  /**
+   * @brief Completed bins of each [level][channel] not yet written. Written
+   * bins are erased from the front, which keeps the capacity for the next
+   * bins.
+   */
+  std::vector<std::vector<std::vector<Bin>>> m_pendingBins;
+
+  /**
+   * @brief The min, max, and mean datasets of each level, stored at index
+   * level * getNumStatistics() + statistic
+   */
+  std::vector<std::shared_ptr<IO::BaseRecordingData>> m_dataSets;
+
+  /**
+   * @brief Staging buffer for the [numRows, numChannels] bins to write
+   */
+  std::vector<Bin> m_rowBins;
+
+  /**
+   * @brief Staging buffer for the values of one statistic of m_rowBins
+   */
+  std::vector<float> m_values;
+
+  /**
+   * @brief Number of bins written for each level
+   */
+  SizeArray m_binsWritten;
+};
+
+}  // namespace AQNWB::NWB
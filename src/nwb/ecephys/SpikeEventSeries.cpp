@@ -1,5 +1,7 @@
 #include "nwb/ecephys/SpikeEventSeries.hpp"
 
+#include "Tracing.hpp"
+
 using namespace AQNWB::NWB;
 
 // SpikeEventSeries
@@ -24,9 +26,14 @@ Status SpikeEventSeries::initialize(
     const float& resolution,
     const float& offset)
 {
+  TraceScope trace("SpikeEventSeries::initialize", "nwb");
   auto esInitStatus = ElectricalSeries::initialize(
       dataConfig, channelVector, description, conversion, resolution, offset);
   this->m_eventsRecorded = 0;
+  // resolve the dataset written by writeSpike
+  if (esInitStatus == Status::Success && !dataConfig.isLink()) {
+    this->recordData();
+  }
   return esInitStatus;
 }
 
@@ -36,6 +43,11 @@ Status SpikeEventSeries::writeSpike(const SizeType& numSamples,
                                     const void* timestampsInput,
                                     const void* controlInput)
 {
+  // reject writes while the recording is paused
+  if (isRecordingPaused()) {
+    return Status::Failure;
+  }
+
   // get offsets and datashape
   SizeArray dataShape;
   SizeArray positionOffset;
@@ -52,3 +64,11 @@ Status SpikeEventSeries::writeSpike(const SizeType& numSamples,
   return writeData(
       dataShape, positionOffset, dataInput, timestampsInput, controlInput);
 }
+
+Status SpikeEventSeries::restoreRecordingState()
+{
+  TraceScope trace("SpikeEventSeries::restoreRecordingState", "nwb");
+  Status status = ElectricalSeries::restoreRecordingState();
+  this->m_eventsRecorded = getRecordedDataLength();
+  return status;
+}
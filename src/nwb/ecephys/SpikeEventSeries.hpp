@@ -81,6 +81,13 @@ public:
                     const void* timestampsInput,
                     const void* controlInput = nullptr);
 
+  /**
+   * @brief Restore the recording state of a SpikeEventSeries read from an
+   * existing file, continuing after the last event in the file.
+   * @return The status of the operation
+   */
+  Status restoreRecordingState() override;
+
   DEFINE_DATASET_FIELD(readData, recordData, std::any, "data", Spike waveforms)
 
   DEFINE_ATTRIBUTE_FIELD(readDataUnit,
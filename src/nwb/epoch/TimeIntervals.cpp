@@ -0,0 +1,132 @@
+#include <cmath>
+#include <limits>
+
+#include "nwb/epoch/TimeIntervals.hpp"
+
+#include "Tracing.hpp"
+#include "Utils.hpp"
+
+using namespace AQNWB::NWB;
+
+// TimeIntervals
+// Initialize the static registered_ member to trigger registration
+REGISTER_SUBCLASS_IMPL(TimeIntervals)
+
+/** Constructor */
+TimeIntervals::TimeIntervals(const std::string& path,
+                             std::shared_ptr<IO::BaseIO> io)
+    : DynamicTable(path, io)
+    , m_startTimeVectorData(
+          VectorData::create(AQNWB::mergePaths(path, "start_time"), io))
+    , m_stopTimeVectorData(
+          VectorData::create(AQNWB::mergePaths(path, "stop_time"), io))
+    , m_intervalsRecorded(0)
+    , m_recordPauses(false)
+    , m_pauseOpen(false)
+{
+}
+
+/** Destructor */
+TimeIntervals::~TimeIntervals() {}
+
+/** Initialization function*/
+Status TimeIntervals::initialize(const std::string& description,
+                                 SizeType chunkSize)
+{
+  TraceScope trace("TimeIntervals::initialize", "nwb");
+  Status tableStatus = DynamicTable::initialize(description);
+
+  IO::ArrayDataSetConfig idConfig(
+      IO::BaseDataType::I32, SizeArray {0}, SizeArray {chunkSize});
+  Status idStatus = m_rowElementIdentifiers->initialize(idConfig);
+
+  IO::ArrayDataSetConfig timeConfig(
+      IO::BaseDataType::F64, SizeArray {0}, SizeArray {chunkSize});
+  Status startStatus = m_startTimeVectorData->initialize(
+      timeConfig, "Start time of epoch, in seconds.");
+  Status stopStatus = m_stopTimeVectorData->initialize(
+      timeConfig, "Stop time of epoch, in seconds.");
+
+  // the column names are written by DynamicTable::finalize
+  addColumnName(m_startTimeVectorData->getName());
+  addColumnName(m_stopTimeVectorData->getName());
+  m_intervalsRecorded = 0;
+  m_pauseOpen = false;
+
+  return tableStatus && idStatus && startStatus && stopStatus;
+}
+
+Status TimeIntervals::writeTime(const std::shared_ptr<VectorData>& column,
+                                SizeType row,
+                                double time)
+{
+  return column->recordData()->writeDataBlock(
+      SizeArray {1}, SizeArray {row}, IO::BaseDataType::F64, &time);
+}
+
+Status TimeIntervals::addInterval(double startTime, double stopTime)
+{
+  const SizeType row = m_intervalsRecorded;
+  const int id = static_cast<int>(row);
+  Status idStatus = m_rowElementIdentifiers->recordData()->writeDataBlock(
+      SizeArray {1}, SizeArray {row}, IO::BaseDataType::I32, &id);
+  Status startStatus = writeTime(m_startTimeVectorData, row, startTime);
+  Status stopStatus = writeTime(m_stopTimeVectorData, row, stopTime);
+  m_intervalsRecorded += 1;
+  m_pauseOpen = false;
+  return idStatus && startStatus && stopStatus;
+}
+
+Status TimeIntervals::restoreRecordingState()
+{
+  TraceScope trace("TimeIntervals::restoreRecordingState", "nwb");
+  auto ioPtr = getIO();
+  if (!ioPtr) {
+    std::cerr << "TimeIntervals::restoreRecordingState IO object has been "
+                 "deleted."
+              << std::endl;
+    return Status::Failure;
+  }
+  const std::string startTimePath = m_startTimeVectorData->getPath();
+  if (!ioPtr->objectExists(startTimePath)) {
+    std::cerr << "TimeIntervals::restoreRecordingState: " << startTimePath
+              << " does not exist." << std::endl;
+    return Status::Failure;
+  }
+  SizeArray shape = ioPtr->getStorageObjectShape(startTimePath);
+  m_intervalsRecorded = shape.empty() ? 0 : shape[0];
+  m_recordPauses = (m_path == recordingPausesPath);
+
+  // A pause without a stop time was not ended, e.g., due to a crash
+  m_pauseOpen = false;
+  const std::string stopTimePath = m_stopTimeVectorData->getPath();
+  if (m_recordPauses && m_intervalsRecorded > 0
+      && ioPtr->objectExists(stopTimePath))
+  {
+    auto lastStopTime = IO::DataBlock<double>::fromGeneric(ioPtr->readDataset(
+        stopTimePath, SizeArray {m_intervalsRecorded - 1}, SizeArray {1}));
+    m_pauseOpen =
+        !lastStopTime.data.empty() && std::isnan(lastStopTime.data[0]);
+  }
+  return Status::Success;
+}
+
+Status TimeIntervals::recordingPaused(double time)
+{
+  if (!m_recordPauses) {
+    return Status::Success;
+  }
+  Status status =
+      addInterval(time, std::numeric_limits<double>::quiet_NaN());
+  m_pauseOpen = true;
+  return status;
+}
+
+Status TimeIntervals::recordingResumed(double time)
+{
+  if (!m_recordPauses || !m_pauseOpen) {
+    return Status::Success;
+  }
+  m_pauseOpen = false;
+  return writeTime(m_stopTimeVectorData, m_intervalsRecorded - 1, time);
+}
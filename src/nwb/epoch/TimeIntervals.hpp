@@ -0,0 +1,166 @@
+#pragma once
+
+#include <string>
+
+#include "io/BaseIO.hpp"
+#include "nwb/hdmf/table/DynamicTable.hpp"
+#include "nwb/hdmf/table/VectorData.hpp"
+#include "spec/core.hpp"
+
+namespace AQNWB::NWB
+{
+/**
+ * @brief A table of time intervals, e.g., epochs or trials, with a start and
+ * stop time per row.
+ *
+ * Rows are appended while recording via addInterval. A table with
+ * setRecordPauses enabled, e.g., the one created by
+ * NWBFile::createRecordingPauses, additionally records the pauses of the
+ * recording (see IO::BaseIO::pauseRecording): a row is added with the time
+ * of the pause and a stop time of NaN, and the stop time is set when the
+ * recording resumes.
+ * The start and stop times are stored as float64, which the schema allows for
+ * float32 columns.
+ */
+class TimeIntervals : public DynamicTable
+{
+public:
+  // Register the TimeIntervals as a subclass of DynamicTable
+  REGISTER_SUBCLASS(TimeIntervals,
+                    DynamicTable,
+                    AQNWB::SPEC::CORE::namespaceName)
+
+protected:
+  /**
+   * @brief Constructor.
+   * @param path The location of the table in the file.
+   * @param io A shared pointer to the IO object.
+   */
+  TimeIntervals(const std::string& path, std::shared_ptr<IO::BaseIO> io);
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  ~TimeIntervals() override;
+
+  /**
+   * @brief Initializes the TimeIntervals by creating NWB related attributes
+   * and the extendable id, start_time, and stop_time columns.
+   * @param description The description of the table.
+   * @param chunkSize The chunk size of the columns.
+   * @return Status::Success if successful, otherwise Status::Failure.
+   */
+  Status initialize(const std::string& description,
+                    SizeType chunkSize = 64);
+
+  /**
+   * @brief Appends an interval to the table.
+   * @param startTime The start time of the interval in seconds.
+   * @param stopTime The stop time of the interval in seconds.
+   * @return Status::Success if successful, otherwise Status::Failure.
+   */
+  Status addInterval(double startTime, double stopTime);
+
+  /**
+   * @brief Get the number of intervals in the table.
+   * @return The number of rows written or restored.
+   */
+  inline SizeType getNumIntervals() const { return m_intervalsRecorded; }
+
+  /**
+   * @brief Set whether the table records the pauses of the recording via
+   * recordingPaused and recordingResumed.
+   * @param recordPauses True to add a row for each pause.
+   */
+  inline void setRecordPauses(bool recordPauses)
+  {
+    m_recordPauses = recordPauses;
+  }
+
+  /**
+   * @brief Check whether the table records the pauses of the recording.
+   * @return True if a row is added for each pause, false otherwise.
+   */
+  inline bool getRecordPauses() const { return m_recordPauses; }
+
+  /**
+   * @brief Restore the number of rows from the extent of the start_time
+   * column, such that new intervals are appended after the existing rows.
+   *
+   * Pauses are recorded if this is the table at recordingPausesPath. If the
+   * last pause has no stop time, e.g., after a crash while paused, it is
+   * ended by the next call to recordingResumed.
+   * @return The status of the operation
+   */
+  Status restoreRecordingState() override;
+
+  /**
+   * @brief Records the start of a pause if the table records pauses.
+   * @param time The time of the pause in seconds
+   * @return The status of the operation
+   */
+  Status recordingPaused(double time) override;
+
+  /**
+   * @brief Records the end of the current pause if the table records pauses.
+   * @param time The time at which recording resumes in seconds
+   * @return The status of the operation
+   */
+  Status recordingResumed(double time) override;
+
+  /**
+   * @brief The path to the TimeIntervals that records the pauses of the
+   * recording.
+   */
+  inline const static std::string recordingPausesPath =
+      "/intervals/recording_pauses";
+
+  DEFINE_REGISTERED_FIELD(readStartTimeColumn,
+                          VectorDataTyped<double>,
+                          "start_time",
+                          "Start time of epoch, in seconds.")
+
+  DEFINE_REGISTERED_FIELD(readStopTimeColumn,
+                          VectorDataTyped<double>,
+                          "stop_time",
+                          "Stop time of epoch, in seconds.")
+
+private:
+  /**
+   * @brief Write a value of a time column at a row.
+   * @param column The start_time or stop_time column.
+   * @param row The index of the row.
+   * @param time The time in seconds.
+   * @return The status of the operation
+   */
+  Status writeTime(const std::shared_ptr<VectorData>& column,
+                   SizeType row,
+                   double time);
+
+  /**
+   * @brief The start time column for write
+   */
+  std::shared_ptr<VectorData> m_startTimeVectorData;
+
+  /**
+   * @brief The stop time column for write
+   */
+  std::shared_ptr<VectorData> m_stopTimeVectorData;
+
+  /**
+   * @brief The number of rows in the table
+   */
+  SizeType m_intervalsRecorded;
+
+  /**
+   * @brief Whether the table records the pauses of the recording
+   */
+  bool m_recordPauses;
+
+  /**
+   * @brief Whether the last row is a pause that has not ended yet
+   */
+  bool m_pauseOpen;
+};
+}  // namespace AQNWB::NWB
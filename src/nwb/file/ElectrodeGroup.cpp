@@ -1,5 +1,6 @@
 #include "nwb/file/ElectrodeGroup.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -22,6 +23,7 @@ Status ElectrodeGroup::initialize(const std::string& description,
                                   const std::string& location,
                                   const std::shared_ptr<Device>& device)
 {
+  TraceScope trace("ElectrodeGroup::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "ElectrodeGroup::initialize: IO object is not valid."
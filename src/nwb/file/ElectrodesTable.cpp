@@ -1,6 +1,7 @@
 #include "nwb/file/ElectrodesTable.hpp"
 
 #include "Channel.hpp"
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -41,6 +42,7 @@ ElectrodesTable::~ElectrodesTable() {}
 /** Initialization function*/
 Status ElectrodesTable::initialize(const std::string& description)
 {
+  TraceScope trace("ElectrodesTable::initialize", "nwb");
   // create group
   DynamicTable::initialize(description);
   // IO::BaseDataType vstrType(IO::BaseDataType::Type::V_STR,
@@ -79,6 +81,7 @@ void ElectrodesTable::addElectrodes(const std::vector<Channel>& channelsInput)
 
 Status ElectrodesTable::finalize()
 {
+  TraceScope trace("ElectrodesTable::finalize", "nwb");
   Status status = Status::Success;
   // Check if new values have been added for the columns and update them
   // Updated electrode numbers
@@ -1,5 +1,7 @@
 #include "nwb/hdmf/base/Container.hpp"
 
+#include "Tracing.hpp"
+
 using namespace AQNWB::NWB;
 
 // Container
@@ -19,6 +21,7 @@ Container::~Container() {}
 /** Initialize */
 Status Container::initialize()
 {
+  TraceScope trace("Container::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "Container::initialize IO object has been deleted."
@@ -1,5 +1,7 @@
 #include "nwb/hdmf/base/Data.hpp"
 
+#include "Tracing.hpp"
+
 using namespace AQNWB::NWB;
 
 // Register the base Data class
@@ -13,6 +15,7 @@ Data::Data(const std::string& path, std::shared_ptr<AQNWB::IO::BaseIO> io)
 
 Status Data::initialize(const IO::BaseArrayDataSetConfig& dataConfig)
 {
+  TraceScope trace("Data::initialize", "nwb");
   auto ioPtr = getIO();
   if (ioPtr == nullptr) {
     std::cerr << "IO object has been deleted. Can't initialize Data: " << m_path
@@ -81,6 +81,7 @@ template<typename DTYPE = std::any>
 class DataTyped : public Data
 {
   friend class AQNWB::NWB::RegisteredType; /* base can call constructor */
+  DEFINE_RECORDING_DATA_SLOTS(DataTyped, Data)
 
 protected:
   /**
@@ -1,5 +1,6 @@
 #include "nwb/hdmf/table/DynamicTable.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -38,6 +39,7 @@ DynamicTable::~DynamicTable() {}
 /** Initialization function*/
 Status DynamicTable::initialize(const std::string& description)
 {
+  TraceScope trace("DynamicTable::initialize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "DynamicTable::initialize IO object has been deleted."
@@ -146,6 +148,7 @@ Status DynamicTable::addReferenceColumn(const std::string& name,
 
 Status DynamicTable::finalize()
 {
+  TraceScope trace("DynamicTable::finalize", "nwb");
   auto ioPtr = getIO();
   if (!ioPtr) {
     std::cerr << "DynamicTable::finalize IO object has been deleted."
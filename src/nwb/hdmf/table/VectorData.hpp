@@ -125,6 +125,7 @@ template<typename DTYPE = std::any>
 class VectorDataTyped : public VectorData
 {
   friend class AQNWB::NWB::RegisteredType; /* base can call constructor */
+  DEFINE_RECORDING_DATA_SLOTS(VectorDataTyped, VectorData)
 
 protected:
   /**
@@ -1,5 +1,6 @@
 #include "nwb/misc/AnnotationSeries.hpp"
 
+#include "Tracing.hpp"
 #include "Utils.hpp"
 
 using namespace AQNWB::NWB;
@@ -24,6 +25,7 @@ Status AnnotationSeries::initialize(
     const std::string& comments,
     const IO::BaseArrayDataSetConfig& dataConfig)
 {
+  TraceScope trace("AnnotationSeries::initialize", "nwb");
   auto tsInitStatus = TimeSeries::initialize(
       dataConfig,
       "n/a",  // unit fixed to "n/a"
@@ -32,6 +34,10 @@ Status AnnotationSeries::initialize(
       1.0f,  // conversion fixed to 1.0, since unit is n/a
       -1.0f,  // resolution fixed to -1.0
       0.0f);  // offset fixed to 0.0, since unit is n/a
+  // resolve the dataset written by writeAnnotation
+  if (tsInitStatus == Status::Success && !dataConfig.isLink()) {
+    this->recordData();
+  }
   return tsInitStatus;
 }
 
@@ -41,6 +47,11 @@ Status AnnotationSeries::writeAnnotation(
     const void* timestampsInput,
     const void* controlInput)
 {
+  // reject writes while the recording is paused
+  if (isRecordingPaused()) {
+    return Status::Failure;
+  }
+
   SizeArray dataShape = {numSamples};
   SizeArray positionOffset = {this->m_samplesRecorded};
 
@@ -67,3 +78,11 @@ Status AnnotationSeries::writeAnnotation(
 
   return dataStatus && tsStatus;
 }
+
+Status AnnotationSeries::restoreRecordingState()
+{
+  TraceScope trace("AnnotationSeries::restoreRecordingState", "nwb");
+  Status status = TimeSeries::restoreRecordingState();
+  m_samplesRecorded = getRecordedDataLength();
+  return status;
+}
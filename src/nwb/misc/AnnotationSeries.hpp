@@ -62,6 +62,13 @@ public:
                          const void* timestampsInput,
                          const void* controlInput = nullptr);
 
+  /**
+   * @brief Restore the recording state of an AnnotationSeries read from an
+   * existing file, continuing after the last annotation in the file.
+   * @return The status of the operation
+   */
+  Status restoreRecordingState() override;
+
   DEFINE_DATASET_FIELD(readData,
                        recordData,
                        std::string,
@@ -0,0 +1,103 @@
+#include <cstdlib>
+#include <new>
+
+#include "testAllocationCounter.hpp"
+
+namespace
+{
+/**
+ * @brief Number of allocations of the thread
+ */
+thread_local std::uint64_t threadAllocationCount = 0;
+
+/**
+ * @brief Number of bytes allocated by the thread
+ */
+thread_local std::uint64_t threadAllocatedBytes = 0;
+
+void* countedAllocate(std::size_t size) noexcept
+{
+  ++threadAllocationCount;
+  threadAllocatedBytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+}  // namespace
+
+AllocationCounter::AllocationCounter()
+    : m_startCount(threadAllocationCount)
+    , m_startBytes(threadAllocatedBytes)
+{
+}
+
+std::uint64_t AllocationCounter::getCount() const
+{
+  return threadAllocationCount - m_startCount;
+}
+
+std::uint64_t AllocationCounter::getBytes() const
+{
+  return threadAllocatedBytes - m_startBytes;
+}
+
+void AllocationCounter::reset()
+{
+  m_startCount = threadAllocationCount;
+  m_startBytes = threadAllocatedBytes;
+}
+
+// Replacements of the global allocation functions. The aligned variants are
+// not replaced and therefore not counted.
+
+void* operator new(std::size_t size)
+{
+  void* ptr = countedAllocate(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
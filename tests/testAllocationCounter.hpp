@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Counts the heap allocations of the current thread within a scope.
+ *
+ * The test and benchmark executables link testAllocationCounter.cpp, which
+ * replaces the global `operator new` and `operator new[]` to count
+ * allocations and allocated bytes per thread. An AllocationCounter takes a
+ * snapshot of the counts on construction, such that getCount() and
+ * getBytes() return the allocations made on this thread since then.
+ * Allocations of the HDF5 C library via `malloc` are not counted.
+ *
+ * Example:
+ * @code
+ * AllocationCounter counter;
+ * series->writeAllChannels(numSamples, data, timestamps);
+ * REQUIRE(counter.getCount() == 0);
+ * @endcode
+ */
+class AllocationCounter
+{
+public:
+  /**
+   * @brief Start counting the allocations of the current thread
+   */
+  AllocationCounter();
+
+  /**
+   * @brief Get the number of allocations on this thread since construction
+   * or the last reset
+   */
+  std::uint64_t getCount() const;
+
+  /**
+   * @brief Get the number of bytes allocated on this thread since
+   * construction or the last reset
+   */
+  std::uint64_t getBytes() const;
+
+  /**
+   * @brief Restart counting from the current state
+   */
+  void reset();
+
+private:
+  /**
+   * @brief Allocation count of the thread at construction or the last reset
+   */
+  std::uint64_t m_startCount;
+
+  /**
+   * @brief Allocated bytes of the thread at construction or the last reset
+   */
+  std::uint64_t m_startBytes;
+};
@@ -0,0 +1,262 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "Utils.hpp"
+#include "io/BaseIO.hpp"
+#include "io/RecordingObjects.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "nwb/ecephys/SpikeEventSeries.hpp"
+#include "nwb/misc/AnnotationSeries.hpp"
+#include "testAllocationCounter.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+
+namespace
+{
+/**
+ * @brief Number of writes before allocations are counted, e.g., to let
+ * staging buffers grow to their final size
+ */
+constexpr int WarmUpWrites = 2;
+
+/**
+ * @brief Number of writes whose allocations are counted
+ */
+constexpr int CountedWrites = 10;
+
+/**
+ * @brief Get a recording object of the given type by its index
+ */
+template<typename T>
+std::shared_ptr<T> getRecordingObject(std::shared_ptr<BaseIO> io,
+                                      SizeType index)
+{
+  return std::dynamic_pointer_cast<T>(
+      io->getRecordingObjects()->getRecordingObject(index));
+}
+}  // namespace
+
+TEST_CASE("AllocationCounter", "[allocations]")
+{
+  SECTION("counts allocations in scope")
+  {
+    AllocationCounter counter;
+    REQUIRE(counter.getCount() == 0);
+    auto value = std::make_unique<std::vector<int>>(100);
+    REQUIRE(counter.getCount() == 2);
+    REQUIRE(counter.getBytes() >= 100 * sizeof(int));
+    counter.reset();
+    REQUIRE(counter.getCount() == 0);
+    REQUIRE(counter.getBytes() == 0);
+  }
+}
+
+TEST_CASE("steady-state recording does not allocate", "[allocations]")
+{
+  std::string path = getTestFilePath("testAllocations.nwb");
+  std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+  io->open();
+  auto nwbFile = NWB::NWBFile::create(io);
+  nwbFile->initialize(generateUuid());
+  const SizeType numChannels = 4;
+  auto mockArrays = getMockChannelArrays(numChannels, 1);
+  auto electrodesTable = nwbFile->createElectrodesTable(mockArrays);
+
+  std::vector<SizeType> esIndexes;
+  nwbFile->createElectricalSeries(mockArrays,
+                                  getMockChannelArrayNames("esdata", 1),
+                                  BaseDataType::I16,
+                                  esIndexes);
+  std::vector<SizeType> overviewIndexes;
+  nwbFile->createElectricalSeries(mockArrays,
+                                  getMockChannelArrayNames("esoverview", 1),
+                                  BaseDataType::I16,
+                                  overviewIndexes);
+  NWB::OverviewPyramidConfig overviewConfig;
+  overviewConfig.decimations = {4, 16};
+  overviewConfig.computeMean = true;
+  overviewConfig.chunkSize = 16;
+  REQUIRE(getRecordingObject<NWB::ElectricalSeries>(io, overviewIndexes[0])
+              ->enableOverviewPyramid(overviewConfig)
+          == Status::Success);
+  std::vector<SizeType> sesIndexes;
+  nwbFile->createSpikeEventSeries(mockArrays,
+                                  getMockChannelArrayNames("sesdata", 1),
+                                  BaseDataType::F32,
+                                  sesIndexes);
+  std::vector<SizeType> asIndexes;
+  nwbFile->createAnnotationSeries({"annotations"}, asIndexes);
+  REQUIRE(io->startRecording() == Status::Success);
+
+  const SizeType numSamples = 64;
+  std::vector<double> timestamps(numSamples, 0.5);
+
+  SECTION("ElectricalSeries::writeAllChannels")
+  {
+    auto series = getRecordingObject<NWB::ElectricalSeries>(io, esIndexes[0]);
+    REQUIRE(series != nullptr);
+    std::vector<std::int16_t> data(numSamples * numChannels, 1);
+    std::vector<float> dataFloat(numSamples * numChannels, 1.0f);
+    for (int i = 0; i < WarmUpWrites; ++i) {
+      series->writeAllChannels(numSamples, data.data(), timestamps.data());
+      series->writeAllChannels(numSamples, dataFloat.data(), timestamps.data());
+    }
+
+    Status status = Status::Success;
+    AllocationCounter counter;
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status
+          && series->writeAllChannels(
+              numSamples, data.data(), timestamps.data());
+    }
+    std::uint64_t allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+
+    counter.reset();
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status
+          && series->writeAllChannels(
+              numSamples, dataFloat.data(), timestamps.data());
+    }
+    allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("ElectricalSeries::writeChannel")
+  {
+    auto series = getRecordingObject<NWB::ElectricalSeries>(io, esIndexes[0]);
+    REQUIRE(series != nullptr);
+    std::vector<std::int16_t> data(numSamples, 1);
+    std::vector<float> dataFloat(numSamples, 1.0f);
+    auto writeAll = [&](const auto& samples)
+    {
+      Status status = Status::Success;
+      for (SizeType c = 0; c < numChannels; ++c) {
+        status = status
+            && series->writeChannel(
+                c, numSamples, samples.data(), timestamps.data());
+      }
+      return status;
+    };
+    for (int i = 0; i < WarmUpWrites; ++i) {
+      writeAll(data);
+      writeAll(dataFloat);
+    }
+
+    Status status = Status::Success;
+    AllocationCounter counter;
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status && writeAll(data);
+    }
+    std::uint64_t allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+
+    counter.reset();
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status && writeAll(dataFloat);
+    }
+    allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("ElectricalSeries with an overview pyramid")
+  {
+    auto series =
+        getRecordingObject<NWB::ElectricalSeries>(io, overviewIndexes[0]);
+    REQUIRE(series != nullptr);
+    std::vector<std::int16_t> data(numSamples * numChannels, 1);
+    auto writeEach = [&]()
+    {
+      Status status = Status::Success;
+      for (SizeType c = 0; c < numChannels; ++c) {
+        status = status
+            && series->writeChannel(
+                c, numSamples, data.data(), timestamps.data());
+      }
+      return status;
+    };
+    for (int i = 0; i < WarmUpWrites; ++i) {
+      series->writeAllChannels(numSamples, data.data(), timestamps.data());
+      writeEach();
+    }
+
+    Status status = Status::Success;
+    AllocationCounter counter;
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status
+          && series->writeAllChannels(
+              numSamples, data.data(), timestamps.data());
+    }
+    std::uint64_t allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+
+    counter.reset();
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status && writeEach();
+    }
+    allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("SpikeEventSeries::writeSpike")
+  {
+    auto series =
+        getRecordingObject<NWB::SpikeEventSeries>(io, sesIndexes[0]);
+    REQUIRE(series != nullptr);
+    const SizeType numEventSamples = 32;
+    std::vector<float> data(numEventSamples * numChannels, 1.0f);
+    double timestamp = 0.5;
+    for (int i = 0; i < WarmUpWrites; ++i) {
+      series->writeSpike(numEventSamples, numChannels, data.data(), &timestamp);
+    }
+
+    Status status = Status::Success;
+    AllocationCounter counter;
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status
+          && series->writeSpike(
+              numEventSamples, numChannels, data.data(), &timestamp);
+    }
+    std::uint64_t allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("AnnotationSeries::writeAnnotation")
+  {
+    auto series = getRecordingObject<NWB::AnnotationSeries>(io, asIndexes[0]);
+    REQUIRE(series != nullptr);
+    const SizeType numAnnotations = 3;
+    std::vector<std::string> annotations = {"start", "stimulus", "stop"};
+    for (int i = 0; i < WarmUpWrites; ++i) {
+      series->writeAnnotation(numAnnotations, annotations, timestamps.data());
+    }
+
+    Status status = Status::Success;
+    AllocationCounter counter;
+    for (int i = 0; i < CountedWrites; ++i) {
+      status = status
+          && series->writeAnnotation(
+              numAnnotations, annotations, timestamps.data());
+    }
+    std::uint64_t allocations = counter.getCount();
+    REQUIRE(status == Status::Success);
+    REQUIRE(allocations == 0);
+  }
+
+  io->stopRecording();
+  io->close();
+}
@@ -0,0 +1,205 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "Types.hpp"
+#include "io/ChunkCache.hpp"
+#include "io/ReadIO.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using namespace AQNWB::IO;
+
+namespace
+{
+std::shared_ptr<const ChunkCache::Buffer> makeBuffer(SizeType numBytes)
+{
+  return std::make_shared<ChunkCache::Buffer>(numBytes, 0);
+}
+}  // namespace
+
+TEST_CASE("ChunkCache", "[chunkcache]")
+{
+  SECTION("disabled by default")
+  {
+    ChunkCache cache;
+    REQUIRE_FALSE(cache.isEnabled());
+    cache.put("/data", SizeArray {0}, makeBuffer(8));
+    REQUIRE(cache.get("/data", SizeArray {0}) == nullptr);
+    REQUIRE(cache.getStats().numChunks == 0);
+    REQUIRE(cache.getStats().misses == 1);
+  }
+
+  SECTION("hits and misses are counted")
+  {
+    ChunkCache cache(1024);
+    REQUIRE(cache.isEnabled());
+    REQUIRE(cache.get("/data", SizeArray {0, 0}) == nullptr);
+    cache.put("/data", SizeArray {0, 0}, makeBuffer(16));
+    REQUIRE(cache.get("/data", SizeArray {0, 0}) != nullptr);
+    REQUIRE(cache.get("/data", SizeArray {0, 1}) == nullptr);
+    REQUIRE(cache.get("/other", SizeArray {0, 0}) == nullptr);
+
+    ChunkCacheStats stats = cache.getStats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 3);
+    REQUIRE(stats.numChunks == 1);
+    REQUIRE(stats.numBytes == 16);
+    REQUIRE(stats.hitRate() == Catch::Approx(0.25));
+
+    cache.resetStats();
+    stats = cache.getStats();
+    REQUIRE(stats.hits == 0);
+    REQUIRE(stats.misses == 0);
+    REQUIRE(stats.numChunks == 1);
+  }
+
+  SECTION("least recently used chunks are evicted")
+  {
+    ChunkCache cache(32);
+    cache.put("/data", SizeArray {0}, makeBuffer(16));
+    cache.put("/data", SizeArray {1}, makeBuffer(16));
+    // touch chunk 0 so that chunk 1 becomes the least recently used
+    REQUIRE(cache.get("/data", SizeArray {0}) != nullptr);
+    cache.put("/data", SizeArray {2}, makeBuffer(16));
+
+    REQUIRE(cache.get("/data", SizeArray {0}) != nullptr);
+    REQUIRE(cache.get("/data", SizeArray {1}) == nullptr);
+    REQUIRE(cache.get("/data", SizeArray {2}) != nullptr);
+    REQUIRE(cache.getStats().evictions == 1);
+    REQUIRE(cache.getStats().numBytes == 32);
+
+    // chunks larger than the budget are not cached
+    cache.put("/data", SizeArray {3}, makeBuffer(64));
+    REQUIRE(cache.get("/data", SizeArray {3}) == nullptr);
+    REQUIRE(cache.getStats().numChunks == 2);
+
+    // shrinking the budget evicts chunks
+    cache.setMaxBytes(16);
+    REQUIRE(cache.getStats().numChunks == 1);
+    REQUIRE(cache.getStats().numBytes == 16);
+  }
+
+  SECTION("replace, invalidate, and clear")
+  {
+    ChunkCache cache(1024);
+    cache.put("/a", SizeArray {0}, makeBuffer(8));
+    cache.put("/a", SizeArray {0}, makeBuffer(4));
+    REQUIRE(cache.getStats().numChunks == 1);
+    REQUIRE(cache.getStats().numBytes == 4);
+
+    cache.put("/a", SizeArray {1}, makeBuffer(4));
+    cache.put("/b", SizeArray {0}, makeBuffer(4));
+    cache.invalidate("/a");
+    REQUIRE(cache.getStats().numChunks == 1);
+    REQUIRE(cache.get("/a", SizeArray {1}) == nullptr);
+    REQUIRE(cache.get("/b", SizeArray {0}) != nullptr);
+
+    cache.clear();
+    REQUIRE(cache.getStats().numChunks == 0);
+    REQUIRE(cache.getStats().numBytes == 0);
+  }
+}
+
+TEST_CASE("HDF5IO reads via the chunk cache", "[chunkcache][hdf5io]")
+{
+  std::string filePath = getTestFilePath("testChunkCache.h5");
+  std::string dataPath = "/data";
+  const SizeType numRows = 10, numCols = 6;
+  std::vector<int32_t> testData(numRows * numCols);
+  for (SizeType i = 0; i < testData.size(); ++i) {
+    testData[i] = static_cast<int32_t>(i);
+  }
+
+  // Write a 10x6 dataset with 4x4 chunks
+  {
+    auto io = std::make_shared<HDF5::HDF5IO>(filePath);
+    io->open(FileMode::Overwrite);
+    ArrayDataSetConfig config(
+        BaseDataType::I32, SizeArray {0, numCols}, SizeArray {4, 4});
+    auto dataset = io->createArrayDataSet(config, dataPath);
+    REQUIRE(dataset != nullptr);
+    REQUIRE(dataset->writeDataBlock(SizeArray {numRows, numCols},
+                                    SizeArray {0, 0},
+                                    BaseDataType::I32,
+                                    testData.data())
+            == Status::Success);
+    io->close();
+  }
+
+  auto io = std::make_shared<HDF5::HDF5IO>(filePath);
+  io->open(FileMode::ReadOnly);
+  auto cache = io->getChunkCache();
+  REQUIRE(cache != nullptr);
+  cache->setMaxBytes(1 << 20);
+
+  auto readBlock = [&](const SizeArray& start, const SizeArray& count)
+  {
+    auto block = DataBlock<int32_t>::fromGeneric(
+        io->readDataset(dataPath, start, count));
+    std::vector<int32_t> expected;
+    for (SizeType r = start[0]; r < start[0] + count[0]; ++r) {
+      for (SizeType c = start[1]; c < start[1] + count[1]; ++c) {
+        expected.push_back(testData[r * numCols + c]);
+      }
+    }
+    REQUIRE(block.shape == count);
+    REQUIRE(block.data == expected);
+  };
+
+  SECTION("overlapping reads are served from the cache")
+  {
+    // rows 1-5 and cols 2-5 touch the 4 chunks (0,0), (0,1), (1,0), (1,1)
+    readBlock(SizeArray {1, 2}, SizeArray {5, 4});
+    ChunkCacheStats stats = cache->getStats();
+    // chunks (0,1) and (1,1) are clipped by the 6 columns of the dataset and
+    // are therefore read directly without going through the cache
+    REQUIRE(stats.hits == 0);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.numChunks == 2);
+    REQUIRE(stats.numBytes == 2 * 16 * sizeof(int32_t));
+
+    readBlock(SizeArray {0, 0}, SizeArray {8, 3});
+    stats = cache->getStats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 2);
+
+    // reading the full dataset touches the partial edge chunks as well
+    auto full = DataBlock<int32_t>::fromGeneric(io->readDataset(dataPath));
+    REQUIRE(full.shape == SizeArray {numRows, numCols});
+    REQUIRE(full.data == testData);
+  }
+
+  SECTION("the cache is shared across ReadDataWrapper objects")
+  {
+    ReadDataWrapper<StorageObjectType::Dataset, int32_t> wrapperA(io,
+                                                                  dataPath);
+    ReadDataWrapper<StorageObjectType::Dataset, int32_t> wrapperB(io,
+                                                                  dataPath);
+    auto blockA = wrapperA.values(SizeArray {0, 0}, SizeArray {4, 4});
+    REQUIRE(blockA.data.size() == 16);
+    auto blockB = wrapperB.values(SizeArray {2, 1}, SizeArray {2, 2});
+    REQUIRE(blockB.data == std::vector<int32_t> {13, 14, 19, 20});
+    REQUIRE(cache->getStats().hits == 1);
+    REQUIRE(cache->getStats().misses == 1);
+  }
+
+  SECTION("strided reads bypass the cache")
+  {
+    auto block = DataBlock<int32_t>::fromGeneric(io->readDataset(
+        dataPath, SizeArray {0, 0}, SizeArray {2, 2}, SizeArray {2, 2}));
+    REQUIRE(block.data == std::vector<int32_t> {0, 2, 12, 14});
+    REQUIRE(cache->getStats().misses == 0);
+  }
+
+  SECTION("closing the file clears the cache")
+  {
+    readBlock(SizeArray {0, 0}, SizeArray {4, 4});
+    REQUIRE(cache->getStats().numChunks == 1);
+    io->close();
+    REQUIRE(cache->getStats().numChunks == 0);
+  }
+
+  io->close();
+}
@@ -2,6 +2,7 @@
 #include <array>
 
 #include <H5Cpp.h>
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
@@ -321,6 +322,308 @@ TEST_CASE("ElectricalSeries", "[ecephys]")
     io->close();
   }
 
+  SECTION("test overview pyramid")
+  {
+    std::string path = getTestFilePath("ElectricalSeriesOverview.h5");
+    std::vector<std::vector<float>> rampData(numChannels,
+                                             std::vector<float>(numSamples));
+    std::vector<double> timestamps(numSamples);
+    for (SizeType i = 0; i < numSamples; ++i) {
+      timestamps[i] = static_cast<double>(i);
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        rampData[ch][i] = static_cast<float>(i + 1000 * ch);
+      }
+    }
+
+    {
+      auto [io, es, elecTable] = createTestElectricalSeries(path);
+      NWB::OverviewPyramidConfig config;
+      config.decimations = {4, 16};
+      config.computeMean = true;
+      REQUIRE(es->enableOverviewPyramid(config) == Status::Success);
+      REQUIRE(io->objectExists(dataPath + "/overview/min_4"));
+      REQUIRE(io->objectExists(dataPath + "/overview/mean_16"));
+
+      // invalid configurations are rejected
+      NWB::OverviewPyramidConfig badConfig;
+      badConfig.decimations = {4, 6};
+      REQUIRE_FALSE(NWB::OverviewPyramid::isValidConfig(badConfig));
+
+      // write channel 0 completely before channel 1 so that bins are only
+      // written once they are complete for all channels
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        for (SizeType i = 0; i < numSamples; i += bufferSize) {
+          REQUIRE(es->writeChannel(ch,
+                                   bufferSize,
+                                   rampData[ch].data() + i,
+                                   timestamps.data() + i)
+                  == Status::Success);
+        }
+        SizeArray shape =
+            io->getStorageObjectShape(dataPath + "/overview/max_4");
+        REQUIRE(shape[0] == ((ch == 0) ? 0 : numSamples / 4));
+      }
+      // the incomplete last bin of the coarse level is written on finalize
+      REQUIRE(io->stopRecording() == Status::Success);
+      io->close();
+    }
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    REQUIRE(NWB::OverviewPyramid::readDecimations(readio, dataPath)
+            == SizeArray {4, 16});
+    REQUIRE(readio->getStorageObjectShape(dataPath + "/overview/min_16")
+            == SizeArray {7, numChannels});
+
+    // 100 samples on 20 pixels selects the decimation of 4
+    auto block = NWB::OverviewPyramid::read(readio, dataPath, 0, 100, 20);
+    REQUIRE(block.decimation == 4);
+    REQUIRE(block.startSample == 0);
+    REQUIRE(block.shape == SizeArray {25, numChannels});
+    for (SizeType bin = 0; bin < 25; ++bin) {
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        float first = static_cast<float>(4 * bin + 1000 * ch);
+        SizeType index = bin * numChannels + ch;
+        REQUIRE(block.min[index] == Catch::Approx(first));
+        REQUIRE(block.max[index] == Catch::Approx(first + 3.0f));
+        REQUIRE(block.mean[index] == Catch::Approx(first + 1.5f));
+      }
+    }
+
+    // 100 samples on 5 pixels selects the decimation of 16 incl. the tail
+    block = NWB::OverviewPyramid::read(readio, dataPath, 0, 100, 5);
+    REQUIRE(block.decimation == 16);
+    REQUIRE(block.shape == SizeArray {7, numChannels});
+    REQUIRE(block.min[6 * numChannels] == Catch::Approx(96.0f));
+    REQUIRE(block.max[6 * numChannels + 1] == Catch::Approx(1099.0f));
+    REQUIRE(block.mean[6 * numChannels] == Catch::Approx(97.5f));
+
+    // ranges are extended to whole bins
+    block = NWB::OverviewPyramid::read(readio, dataPath, 10, 30, 4);
+    REQUIRE(block.decimation == 4);
+    REQUIRE(block.startSample == 8);
+    REQUIRE(block.shape == SizeArray {6, numChannels});
+
+    // short ranges fall back to the raw data
+    auto es = NWB::RegisteredType::create<NWB::ElectricalSeries>(dataPath,
+                                                                 readio);
+    block = es->readOverview(10.0, 20.0, 50);
+    REQUIRE(block.decimation == 1);
+    REQUIRE(block.startSample == 10);
+    REQUIRE(block.shape == SizeArray {10, numChannels});
+    REQUIRE(block.min[0] == Catch::Approx(10.0f));
+    REQUIRE(block.max[1] == Catch::Approx(1010.0f));
+
+    // time ranges are resolved via the timestamps
+    block = es->readOverview(16.0, 80.0, 4);
+    REQUIRE(block.decimation == 16);
+    REQUIRE(block.startSample == 16);
+    REQUIRE(block.shape == SizeArray {4, numChannels});
+    REQUIRE(block.min[0] == Catch::Approx(16.0f));
+
+    readio->close();
+  }
+
+  SECTION("test resuming the overview pyramid")
+  {
+    std::string path = getTestFilePath("ElectricalSeriesOverviewResume.h5");
+    std::vector<std::vector<float>> rampData(numChannels,
+                                             std::vector<float>(numSamples));
+    std::vector<double> timestamps(numSamples);
+    for (SizeType i = 0; i < numSamples; ++i) {
+      timestamps[i] = static_cast<double>(i);
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        rampData[ch][i] = static_cast<float>(i + 1000 * ch);
+      }
+    }
+    // the first segment ends within a bin of both levels
+    constexpr SizeType firstSamples = 42;
+
+    {
+      auto [io, es, elecTable] = createTestElectricalSeries(path);
+      NWB::OverviewPyramidConfig config;
+      config.decimations = {4, 16};
+      config.computeMean = true;
+      REQUIRE(es->enableOverviewPyramid(config) == Status::Success);
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        REQUIRE(es->writeChannel(
+                    ch, firstSamples, rampData[ch].data(), timestamps.data())
+                == Status::Success);
+      }
+      REQUIRE(es->finalize() == Status::Success);
+      io->close();
+    }
+
+    {
+      std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+      REQUIRE(io->open(FileMode::ReadWrite) == Status::Success);
+      auto es = NWB::ElectricalSeries::create(dataPath, io);
+      REQUIRE(es->restoreRecordingState() == Status::Success);
+      REQUIRE(es->m_channelVector.size() == numChannels);
+      REQUIRE(es->m_channelVector[0].getSamplingRate()
+              == Catch::Approx(1.0f));
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        REQUIRE(es->writeChannel(ch,
+                                 numSamples - firstSamples,
+                                 rampData[ch].data() + firstSamples,
+                                 timestamps.data() + firstSamples)
+                == Status::Success);
+      }
+      REQUIRE(es->finalize() == Status::Success);
+      io->close();
+    }
+
+    // the envelopes match those of an uninterrupted recording
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    REQUIRE(readio->getStorageObjectShape(dataPath + "/overview/min_16")
+            == SizeArray {7, numChannels});
+    auto block = NWB::OverviewPyramid::read(readio, dataPath, 0, 100, 20);
+    REQUIRE(block.decimation == 4);
+    REQUIRE(block.shape == SizeArray {25, numChannels});
+    for (SizeType bin = 0; bin < 25; ++bin) {
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        float first = static_cast<float>(4 * bin + 1000 * ch);
+        SizeType index = bin * numChannels + ch;
+        REQUIRE(block.min[index] == Catch::Approx(first));
+        REQUIRE(block.max[index] == Catch::Approx(first + 3.0f));
+        REQUIRE(block.mean[index] == Catch::Approx(first + 1.5f));
+      }
+    }
+    block = NWB::OverviewPyramid::read(readio, dataPath, 0, 100, 5);
+    REQUIRE(block.decimation == 16);
+    REQUIRE(block.min[2 * numChannels] == Catch::Approx(32.0f));
+    REQUIRE(block.max[2 * numChannels] == Catch::Approx(47.0f));
+    REQUIRE(block.mean[6 * numChannels] == Catch::Approx(97.5f));
+    readio->close();
+  }
+
+  SECTION("test writing float input converted to int16")
+  {
+    std::string path = getTestFilePath("ElectricalSeriesFloatInput.h5");
+    std::string channelPath = "/esdata_channels";
+    std::string allChannelsPath = "/esdata_all_channels";
+    std::vector<float> interleaved(numSamples * numChannels);
+    for (SizeType i = 0; i < numSamples; ++i) {
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        interleaved[i * numChannels + ch] = mockData[ch][i];
+      }
+    }
+
+    {
+      auto [io, es, elecTable] = createTestElectricalSeries(path);
+      IO::ArrayDataSetConfig config(BaseDataType::I16,
+                                    SizeArray {0, numChannels},
+                                    SizeArray {bufferSize, numChannels});
+      auto channelEs = NWB::ElectricalSeries::create(channelPath, io);
+      channelEs->initialize(config, mockArrays[0], "no description");
+      auto allChannelsEs = NWB::ElectricalSeries::create(allChannelsPath, io);
+      allChannelsEs->initialize(config, mockArrays[0], "no description");
+
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        REQUIRE(channelEs->writeChannel(ch,
+                                        numSamples,
+                                        mockData[ch].data(),
+                                        BaseDataType::I16,
+                                        mockTimestamps.data())
+                == Status::Success);
+      }
+      REQUIRE(allChannelsEs->writeAllChannels(numSamples,
+                                              interleaved.data(),
+                                              BaseDataType::I16,
+                                              mockTimestamps.data())
+              == Status::Success);
+
+      // the storage type must match the data type of the series
+      REQUIRE(channelEs->writeChannel(0,
+                                      numSamples,
+                                      mockData[0].data(),
+                                      BaseDataType::F32,
+                                      mockTimestamps.data())
+              == Status::Failure);
+      REQUIRE(allChannelsEs->writeAllChannels(
+                  numSamples, interleaved.data(), BaseDataType::I32)
+              == Status::Failure);
+      io->close();
+    }
+
+    // both paths match transformToInt16 with the bitVolts of each channel
+    std::vector<int16_t> expected(numSamples * numChannels);
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      std::unique_ptr<int16_t[]> channelData = transformToInt16(
+          numSamples, mockArrays[0][ch].getBitVolts(), mockData[ch].data());
+      for (SizeType i = 0; i < numSamples; ++i) {
+        expected[i * numChannels + ch] = channelData[i];
+      }
+    }
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    for (const auto& seriesPath : {channelPath, allChannelsPath}) {
+      auto data = IO::DataBlock<int16_t>::fromGeneric(
+          readio->readDataset(seriesPath + "/data"));
+      REQUIRE(data.shape == SizeArray {numSamples, numChannels});
+      REQUIRE(data.data == expected);
+    }
+    readio->close();
+  }
+
+  SECTION("test reading data in physical units")
+  {
+    std::string path = getTestFilePath("ElectricalSeriesScaled.h5");
+    std::string scaledPath = "/esdata_int16";
+    std::vector<int16_t> rawData(numSamples * numChannels);
+    for (SizeType i = 0; i < rawData.size(); ++i) {
+      rawData[i] = static_cast<int16_t>(static_cast<int>(i) - 50);
+    }
+
+    {
+      auto [io, es, elecTable] = createTestElectricalSeries(path);
+      auto scaledEs = NWB::ElectricalSeries::create(scaledPath, io);
+      IO::ArrayDataSetConfig config(BaseDataType::I16,
+                                    SizeArray {0, numChannels},
+                                    SizeArray {numSamples, numChannels});
+      scaledEs->initialize(
+          config, mockArrays[0], "no description", 0.5f, -1.0f, 2.0f);
+      scaledEs->recordData()->writeDataBlock(
+          SizeArray {numSamples, numChannels},
+          SizeArray {0, 0},
+          BaseDataType::I16,
+          rawData.data());
+      io->close();
+    }
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    auto es = NWB::RegisteredType::create<NWB::ElectricalSeries>(scaledPath,
+                                                                 readio);
+    std::vector<float> channelConversion =
+        es->readChannelConversion()->values().data;
+    REQUIRE(channelConversion.size() == numChannels);
+
+    // all data as float32
+    auto scaled = es->readDataScaled();
+    REQUIRE(scaled.shape == SizeArray {numSamples, numChannels});
+    for (SizeType i = 0; i < rawData.size(); ++i) {
+      float expected = static_cast<float>(rawData[i]) * 0.5f
+              * channelConversion[i % numChannels]
+          + 2.0f;
+      REQUIRE(scaled.data[i] == Catch::Approx(expected));
+    }
+
+    // a slice of the second channel as float64
+    auto scaledSlice =
+        es->readDataScaled<double>(SizeArray {10, 1}, SizeArray {5, 1});
+    REQUIRE(scaledSlice.shape == SizeArray {5, 1});
+    for (SizeType i = 0; i < 5; ++i) {
+      double expected =
+          static_cast<double>(rawData[(10 + i) * numChannels + 1]) * 0.5
+              * static_cast<double>(channelConversion[1])
+          + 2.0;
+      REQUIRE(scaledSlice.data[i] == Catch::Approx(expected));
+    }
+    readio->close();
+  }
+
   SECTION("test writing electrodes")
   {
     std::vector<Types::ChannelVector> mockArraysElectrodes =
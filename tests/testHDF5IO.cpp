@@ -3,6 +3,7 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <vector>
 
@@ -288,6 +289,65 @@ TEST_CASE("getStorageObjects", "[hdf5io]")
             != groupContent.end());
   }
 
+  SECTION("stream objects to a callback")
+  {
+    hdf5io.createGroup("/streamGroup");
+    for (int i = 0; i < 5; ++i) {
+      hdf5io.createGroup("/streamGroup/group" + std::to_string(i));
+    }
+    IO::ArrayDataSetConfig config {
+        BaseDataType::I32, SizeArray {0}, SizeArray {1}};
+    hdf5io.createArrayDataSet(config, "/streamGroup/dataset");
+    hdf5io.createLink("/streamGroup/link", "/streamGroup/group0");
+    int attrData = 45;
+    hdf5io.createAttribute(
+        BaseDataType::I32, &attrData, "/streamGroup", "attr1");
+
+    // the streamed objects match getStorageObjects
+    std::vector<std::pair<std::string, StorageObjectType>> visited;
+    auto collect = [&visited](const std::string& name, StorageObjectType type)
+    {
+      visited.emplace_back(name, type);
+      return true;
+    };
+    REQUIRE(hdf5io.visitStorageObjects("/streamGroup", collect)
+            == Status::Success);
+    REQUIRE(visited == hdf5io.getStorageObjects("/streamGroup"));
+    REQUIRE(visited.size() == 8);
+    REQUIRE(std::find(visited.begin(),
+                      visited.end(),
+                      std::make_pair(std::string("link"),
+                                     StorageObjectType::Undefined))
+            != visited.end());
+
+    // filter by type and stop early
+    std::vector<std::string> groups;
+    REQUIRE(hdf5io.visitStorageObjects(
+                "/streamGroup",
+                [&groups](const std::string& name, StorageObjectType type)
+                {
+                  REQUIRE(type == StorageObjectType::Group);
+                  groups.push_back(name);
+                  return groups.size() < 2;
+                },
+                StorageObjectType::Group)
+            == Status::Success);
+    REQUIRE(groups == std::vector<std::string> {"group0", "group1"});
+
+    // exceptions thrown by the callback are propagated
+    REQUIRE_THROWS_AS(hdf5io.visitStorageObjects(
+                          "/streamGroup",
+                          [](const std::string&, StorageObjectType) -> bool
+                          { throw std::runtime_error("stop"); }),
+                      std::runtime_error);
+
+    // invalid paths
+    visited.clear();
+    REQUIRE(hdf5io.visitStorageObjects("/invalid/path", collect)
+            == Status::Failure);
+    REQUIRE(visited.empty());
+  }
+
   // close file
   hdf5io.close();
 }
@@ -2096,6 +2156,167 @@ TEST_CASE("HDF5IO; read dataset subset", "[hdf5io]")
   }
 }
 
+TEST_CASE("HDF5IO; read dataset selection", "[hdf5io]")
+{
+  // Set up test data
+  std::string filePath = getTestFilePath("ReadDatasetSelection.h5");
+  std::string dataPath = "/2DDataSelection";
+  std::vector<int32_t> testData2D;
+  std::shared_ptr<IO::HDF5::HDF5IO> hdf5io =
+      getHDF5IOWithInt32TestData2D(filePath, dataPath, testData2D);
+
+  SECTION("all rows and a subset of columns")
+  {
+    auto readData = hdf5io->readDatasetSelection(dataPath, {{}, {0, 2}});
+    auto readDataTyped = DataBlock<int32_t>::fromGeneric(readData);
+    REQUIRE(readData.shape == SizeArray {3, 2});
+    REQUIRE(readDataTyped.data == std::vector<int32_t> {1, 3, 4, 6, 7, 9});
+  }
+
+  SECTION("index lists along both dimensions")
+  {
+    auto readData = hdf5io->readDatasetSelection(dataPath, {{0, 2}, {1, 2}});
+    auto readDataTyped = DataBlock<int32_t>::fromGeneric(readData);
+    REQUIRE(readData.shape == SizeArray {2, 2});
+    REQUIRE(readDataTyped.data == std::vector<int32_t> {2, 3, 8, 9});
+  }
+
+  SECTION("unsorted and repeated indices keep the requested order")
+  {
+    auto readData =
+        hdf5io->readDatasetSelection(dataPath, {{2, 0}, {2, 0, 2}});
+    auto readDataTyped = DataBlock<int32_t>::fromGeneric(readData);
+    REQUIRE(readData.shape == SizeArray {2, 3});
+    REQUIRE(readDataTyped.data == std::vector<int32_t> {9, 7, 9, 3, 1, 3});
+  }
+
+  SECTION("read via ReadDataWrapper")
+  {
+    IO::ReadDataWrapper<StorageObjectType::Dataset, int32_t> wrapper(hdf5io,
+                                                                     dataPath);
+    auto readData = wrapper.valuesSelection({{1}, {}});
+    REQUIRE(readData.shape == SizeArray {1, 3});
+    REQUIRE(readData.data == std::vector<int32_t> {4, 5, 6});
+  }
+
+  SECTION("invalid selections")
+  {
+    REQUIRE_THROWS_AS(hdf5io->readDatasetSelection(dataPath, {{0}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(hdf5io->readDatasetSelection(dataPath, {{0}, {3}}),
+                      std::runtime_error);
+  }
+
+  hdf5io->close();
+}
+
+TEST_CASE("HDF5IO; findTypes via type index", "[hdf5io]")
+{
+  std::string filename = getTestFilePath("test_findTypesIndex.h5");
+  IO::HDF5::HDF5IO io(filename);
+  io.open(FileMode::Overwrite);
+
+  auto createTypedGroup = [&io](const std::string& path,
+                                const std::string& type)
+  {
+    io.createGroup(path);
+    io.createAttribute("core", path, "namespace");
+    io.createAttribute(type, path, "neurodata_type");
+  };
+  io.createAttribute("core", "/", "namespace");
+  io.createAttribute("NWBFile", "/", "neurodata_type");
+  createTypedGroup("/acquisition", "Container");
+  createTypedGroup("/acquisition/ts1", "TimeSeries");
+  createTypedGroup("/acquisition/ts1/inner", "TimeSeries");
+  createTypedGroup("/acquisition-other", "TimeSeries");
+  io.createGroup("/general");
+  createTypedGroup("/general/device", "Device");
+  io.createLink("/general/link", "/acquisition/ts1");
+
+  // the index must give the same results as the generic recursive search
+  std::vector<std::string> startPaths = {
+      "/", "/acquisition", "/acquisition/", "/general", "/general/link"};
+  std::vector<std::unordered_set<std::string>> typeSets = {
+      {}, {"core::TimeSeries"}, {"core::Device", "core::NWBFile"}};
+  for (const auto& startPath : startPaths) {
+    for (const auto& types : typeSets) {
+      for (auto mode : {IO::SearchMode::STOP_ON_TYPE,
+                        IO::SearchMode::CONTINUE_ON_TYPE})
+      {
+        for (bool exclude : {false, true}) {
+          REQUIRE(io.findTypes(startPath, types, mode, exclude)
+                  == io.BaseIO::findTypes(startPath, types, mode, exclude));
+        }
+      }
+    }
+  }
+
+  auto result = io.findTypes("/", {}, IO::SearchMode::STOP_ON_TYPE, true);
+  REQUIRE(result.size() == 3);
+  REQUIRE(result["/acquisition-other"] == "core::TimeSeries");
+  REQUIRE(io.getFullTypeName("/acquisition/ts1/") == "core::TimeSeries");
+  REQUIRE_THROWS(io.getFullTypeName("/general"));
+
+  // creating objects invalidates the index
+  createTypedGroup("/general/device2", "Device");
+  result = io.findTypes(
+      "/general", {"core::Device"}, IO::SearchMode::CONTINUE_ON_TYPE);
+  REQUIRE(result.size() == 2);
+  REQUIRE(io.getFullTypeName("/general/device2") == "core::Device");
+
+  io.close();
+}
+
+TEST_CASE("HDF5IO; memory-mapped reads", "[hdf5io]")
+{
+  std::string filename = getTestFilePath("test_mapDataset.h5");
+  IO::HDF5::HDF5IO io(filename);
+  io.open(FileMode::Overwrite);
+
+  std::vector<float> values(12);
+  std::iota(values.begin(), values.end(), 0.5f);
+  IO::HDF5::HDF5ArrayDataSetConfig config(
+      IO::BaseDataType::F32, SizeArray {4, 3}, SizeArray {0, 0});
+  config.setContiguous(true);
+  auto dataset = io.createArrayDataSet(config, "/contiguous");
+  REQUIRE(dataset != nullptr);
+  REQUIRE(io.isMappable("/contiguous"));
+
+  // data written after creation is visible through the mapping
+  dataset->writeDataBlock(
+      SizeArray {4, 3}, SizeArray {0, 0}, IO::BaseDataType::F32, values.data());
+  auto mapped = io.mapDataset<float>("/contiguous");
+  REQUIRE(mapped.getShape() == SizeArray {4, 3});
+  REQUIRE(mapped.size() == 12);
+  REQUIRE(std::vector<float>(mapped.begin(), mapped.end()) == values);
+  auto view = mapped.as_multi_array<2>();
+  REQUIRE(view[2][1] == Catch::Approx(values[7]));
+  REQUIRE(mapped.toDataBlock().data == values);
+
+  // the mapping must match the regular read path
+  auto readData = DataBlock<float>::fromGeneric(io.readDataset("/contiguous"));
+  REQUIRE(readData.data == values);
+
+  // chunked datasets, wrong types, and missing paths are not mapped
+  IO::ArrayDataSetConfig chunkedConfig(
+      IO::BaseDataType::F32, SizeArray {0}, SizeArray {4});
+  io.createArrayDataSet(chunkedConfig, "/chunked");
+  REQUIRE_FALSE(io.isMappable("/chunked"));
+  REQUIRE_FALSE(io.isMappable("/missing"));
+  REQUIRE_THROWS_AS(io.mapDataset<float>("/chunked"), std::runtime_error);
+  REQUIRE_THROWS_AS(io.mapDataset<int32_t>("/contiguous"), std::runtime_error);
+  REQUIRE_THROWS_AS(io.mapDataset<float>("/missing"), std::runtime_error);
+
+  // contiguous datasets cannot be extended or filtered
+  IO::HDF5::HDF5ArrayDataSetConfig extendable(
+      IO::BaseDataType::F32, SizeArray {0}, SizeArray {4});
+  extendable.setContiguous(true);
+  REQUIRE_THROWS_AS(io.createArrayDataSet(extendable, "/extendable"),
+                    std::runtime_error);
+
+  io.close();
+}
+
 TEST_CASE("Test HDF5IO createArrayDataSet with LinkArrayDataSetConfig",
           "[hdf5io]")
 {
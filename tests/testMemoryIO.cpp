@@ -0,0 +1,405 @@
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "Utils.hpp"
+#include "io/BaseIO.hpp"
+#include "io/RecordingObjects.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "io/memory/MemoryIO.hpp"
+#include "io/memory/MemoryRecordingData.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using IO::Memory::MemoryIO;
+
+TEST_CASE("open - memory file modes", "[memoryio]")
+{
+  MemoryIO io("test_open_modes");
+
+  SECTION("ReadWrite and ReadOnly require existing contents")
+  {
+    REQUIRE(io.open(FileMode::ReadWrite) == Status::Failure);
+    REQUIRE(io.open(FileMode::ReadOnly) == Status::Failure);
+    REQUIRE(io.isOpen() == false);
+  }
+
+  SECTION("contents are kept on close and discarded on overwrite")
+  {
+    REQUIRE(io.open() == Status::Success);
+    REQUIRE(io.open() == Status::Failure);
+    REQUIRE(io.createGroup("/group") == Status::Success);
+    REQUIRE(io.close() == Status::Success);
+    REQUIRE(io.objectExists("/group") == false);
+
+    REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+    REQUIRE(io.objectExists("/group"));
+    REQUIRE(io.canModifyObjects() == false);
+    REQUIRE(io.createGroup("/other") == Status::Failure);
+    io.close();
+
+    REQUIRE(io.open() == Status::Success);
+    REQUIRE(io.objectExists("/group"));
+    io.close();
+
+    REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+    REQUIRE(io.objectExists("/group") == false);
+    io.close();
+  }
+}
+
+TEST_CASE("groups and attributes", "[memoryio]")
+{
+  MemoryIO io("test_attributes");
+  io.open();
+  REQUIRE(io.createGroup("/data") == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Failure);
+  REQUIRE(io.createGroup("/missing/child") == Status::Failure);
+  REQUIRE(io.getStorageObjectType("/data") == StorageObjectType::Group);
+
+  SECTION("numeric attributes")
+  {
+    std::vector<int32_t> values = {1, 2, 3};
+    REQUIRE(
+        io.createAttribute(BaseDataType::I32, values.data(), "/data", "a", 3)
+        == Status::Success);
+    auto block = IO::DataBlock<int32_t>::fromGeneric(
+        io.readAttribute("/data/a"));
+    REQUIRE(block.data == values);
+    REQUIRE(block.shape == SizeArray {3});
+    REQUIRE(io.getStorageObjectType("/data/a")
+            == StorageObjectType::Attribute);
+    REQUIRE(io.getStorageObjectDataType("/data/a") == BaseDataType::I32);
+
+    double scalar = 2.5;
+    REQUIRE(io.createAttribute(BaseDataType::F64, &scalar, "/data", "a", 1)
+            == Status::Success);
+    auto scalarBlock =
+        IO::DataBlock<double>::fromGeneric(io.readAttribute("/data/a"));
+    REQUIRE(scalarBlock.shape.empty());
+    REQUIRE(scalarBlock.data[0] == Catch::Approx(2.5));
+  }
+
+  SECTION("string attributes")
+  {
+    REQUIRE(io.createAttribute("text", "/data", "s") == Status::Success);
+    REQUIRE(io.createAttribute("other", "/data", "s", false)
+            == Status::Failure);
+    std::vector<std::string> strings = {"x", "yy"};
+    REQUIRE(io.createAttribute(strings, "/data", "v") == Status::Success);
+
+    auto block =
+        IO::DataBlock<std::string>::fromGeneric(io.readAttribute("/data/s"));
+    REQUIRE(block.data == std::vector<std::string> {"text"});
+    REQUIRE(block.shape.empty());
+    auto vectorBlock =
+        IO::DataBlock<std::string>::fromGeneric(io.readAttribute("/data/v"));
+    REQUIRE(vectorBlock.data == strings);
+    REQUIRE(vectorBlock.shape == SizeArray {2});
+    REQUIRE_THROWS_AS(io.readAttribute("/data/missing"),
+                      std::invalid_argument);
+  }
+
+  SECTION("listing objects")
+  {
+    io.createGroup("/data/child");
+    io.createAttribute("text", "/data", "s");
+    auto objects = io.getStorageObjects("/data");
+    REQUIRE(objects.size() == 2);
+    REQUIRE(objects[0].first == "child");
+    REQUIRE(objects[0].second == StorageObjectType::Group);
+    REQUIRE(objects[1].first == "s");
+    REQUIRE(objects[1].second == StorageObjectType::Attribute);
+    REQUIRE(io.getStorageObjects("/data", StorageObjectType::Attribute).size()
+            == 1);
+  }
+  io.close();
+}
+
+TEST_CASE("array datasets", "[memoryio]")
+{
+  MemoryIO io("test_datasets");
+  io.open();
+
+  SECTION("write and read hyperslabs")
+  {
+    IO::ArrayDataSetConfig config(
+        BaseDataType::I32, SizeArray {0, 4}, SizeArray {2, 4});
+    auto dataset = io.createArrayDataSet(config, "/data");
+    REQUIRE(dataset != nullptr);
+    std::vector<int32_t> values(12);
+    std::iota(values.begin(), values.end(), 0);
+    REQUIRE(dataset->writeDataBlock(SizeArray {3, 4},
+                                    SizeArray {0, 0},
+                                    BaseDataType::I32,
+                                    values.data())
+            == Status::Success);
+    REQUIRE(io.getStorageObjectShape("/data") == SizeArray {3, 4});
+    REQUIRE(io.getStorageObjectChunking("/data") == SizeArray {2, 4});
+
+    auto all = IO::DataBlock<int32_t>::fromGeneric(io.readDataset("/data"));
+    REQUIRE(all.data == values);
+    REQUIRE(all.shape == SizeArray {3, 4});
+
+    auto slab = IO::DataBlock<int32_t>::fromGeneric(io.readDataset(
+        "/data", SizeArray {1, 0}, SizeArray {2, 2}, SizeArray {1, 2}));
+    REQUIRE(slab.shape == SizeArray {2, 2});
+    REQUIRE(slab.data == std::vector<int32_t> {4, 6, 8, 10});
+
+    auto selection = IO::DataBlock<int32_t>::fromGeneric(
+        io.readDatasetSelection("/data", {{2, 0}, {3}}));
+    REQUIRE(selection.shape == SizeArray {2, 1});
+    REQUIRE(selection.data == std::vector<int32_t> {11, 3});
+
+    REQUIRE_THROWS_AS(
+        io.readDataset("/data", SizeArray {2, 0}, SizeArray {2, 1}),
+        std::runtime_error);
+    REQUIRE_THROWS_AS(io.readDatasetSelection("/data", {{5}, {0}}),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(io.readDataset("/missing"), std::runtime_error);
+  }
+
+  SECTION("extend datasets and convert types")
+  {
+    IO::ArrayDataSetConfig config(
+        BaseDataType::I16, SizeArray {0, 2}, SizeArray {4, 0});
+    auto dataset = io.createArrayDataSet(config, "/data");
+    std::vector<float> values = {1.4f, -2.6f, 1e6f, -1e6f};
+    REQUIRE(dataset->writeDataBlock(SizeArray {2, 2},
+                                    SizeArray {0, 0},
+                                    BaseDataType::F32,
+                                    values.data())
+            == Status::Success);
+    REQUIRE(dataset->writeDataBlock(SizeArray {1, 2},
+                                    SizeArray {2, 0},
+                                    BaseDataType::F32,
+                                    values.data())
+            == Status::Success);
+
+    auto block = IO::DataBlock<int16_t>::fromGeneric(io.readDataset("/data"));
+    REQUIRE(block.shape == SizeArray {3, 2});
+    REQUIRE(block.data
+            == std::vector<int16_t> {1,
+                                     -2,
+                                     std::numeric_limits<int16_t>::max(),
+                                     std::numeric_limits<int16_t>::min(),
+                                     1,
+                                     -2});
+
+    // the second dimension was created with a fixed size
+    REQUIRE(dataset->writeDataBlock(SizeArray {1, 3},
+                                    SizeArray {0, 0},
+                                    BaseDataType::F32,
+                                    values.data())
+            == Status::Failure);
+  }
+
+  SECTION("string datasets")
+  {
+    std::vector<std::string> strings = {"a", "bb", "ccc"};
+    REQUIRE(io.createStringDataSet("/strings", strings) == Status::Success);
+    REQUIRE(io.createStringDataSet("/scalar", "value") == Status::Success);
+    auto block =
+        IO::DataBlock<std::string>::fromGeneric(io.readDataset("/strings"));
+    REQUIRE(block.data == strings);
+    auto scalar =
+        IO::DataBlock<std::string>::fromGeneric(io.readDataset("/scalar"));
+    REQUIRE(scalar.data == std::vector<std::string> {"value"});
+    REQUIRE(scalar.shape.empty());
+
+    auto dataset = io.getDataSet("/strings");
+    REQUIRE(dataset != nullptr);
+    std::vector<std::string> appended = {"dddd"};
+    REQUIRE(dataset->writeDataBlock(
+                SizeArray {1}, SizeArray {3}, BaseDataType::V_STR, appended)
+            == Status::Success);
+    REQUIRE(io.getStorageObjectShape("/strings") == SizeArray {4});
+  }
+
+  SECTION("invalid configurations")
+  {
+    IO::ArrayDataSetConfig config(
+        BaseDataType::I32, SizeArray {}, SizeArray {});
+    REQUIRE_THROWS_AS(io.createArrayDataSet(config, "/empty"),
+                      std::runtime_error);
+    IO::ArrayDataSetConfig valid(
+        BaseDataType::I32, SizeArray {1}, SizeArray {1});
+    REQUIRE_THROWS_AS(io.createArrayDataSet(valid, "/missing/data"),
+                      std::runtime_error);
+  }
+  io.close();
+}
+
+TEST_CASE("extend datasets for block writes", "[memoryio]")
+{
+  IO::Memory::MemoryObject dataset;
+  dataset.kind = IO::Memory::MemoryObject::Kind::Dataset;
+  dataset.dataType = BaseDataType::I32;
+  dataset.shape = SizeArray {2, 2};
+  dataset.chunking = SizeArray {4, 0};
+  bool extended = false;
+
+  SECTION("values are kept at their indices")
+  {
+    dataset.values.resize(4 * sizeof(int32_t));
+    REQUIRE(dataset.extendForBlock(
+                SizeArray {1, 2}, SizeArray {1, 0}, true, extended)
+            == Status::Success);
+    REQUIRE_FALSE(extended);
+    REQUIRE(dataset.extendForBlock(
+                SizeArray {3, 2}, SizeArray {2, 0}, true, extended)
+            == Status::Success);
+    REQUIRE(extended);
+    REQUIRE(dataset.shape == SizeArray {5, 2});
+    REQUIRE(dataset.values.size() == 10 * sizeof(int32_t));
+  }
+
+  SECTION("only the shape changes when discarding values")
+  {
+    REQUIRE(dataset.extendForBlock(
+                SizeArray {3, 2}, SizeArray {2, 0}, false, extended)
+            == Status::Success);
+    REQUIRE(extended);
+    REQUIRE(dataset.shape == SizeArray {5, 2});
+    REQUIRE(dataset.values.empty());
+  }
+
+  SECTION("invalid blocks leave the dataset unchanged")
+  {
+    // the second dimension was created with a fixed size
+    REQUIRE(dataset.extendForBlock(
+                SizeArray {3, 3}, SizeArray {2, 0}, false, extended)
+            == Status::Failure);
+    REQUIRE(
+        dataset.extendForBlock(SizeArray {1}, SizeArray {0}, false, extended)
+        == Status::Failure);
+    REQUIRE_FALSE(extended);
+    REQUIRE(dataset.shape == SizeArray {2, 2});
+  }
+}
+
+TEST_CASE("links and references", "[memoryio]")
+{
+  MemoryIO io("test_links");
+  io.open();
+  io.createGroup("/group");
+  io.createStringDataSet("/group/data", std::vector<std::string> {"x"});
+
+  REQUIRE(io.createLink("/link", "/group") == Status::Success);
+  REQUIRE(io.createLink("/broken", "/missing") == Status::Failure);
+  REQUIRE(io.objectExists("/link"));
+  REQUIRE(io.objectExists("/link/data"));
+  REQUIRE(io.getStorageObjectType("/link") == StorageObjectType::Group);
+  auto block =
+      IO::DataBlock<std::string>::fromGeneric(io.readDataset("/link/data"));
+  REQUIRE(block.data == std::vector<std::string> {"x"});
+
+  // soft links are listed as Undefined like in HDF5IO
+  auto objects = io.getStorageObjects("/", StorageObjectType::Undefined);
+  REQUIRE(objects.size() == 2);
+  REQUIRE(objects[1].first == "link");
+  REQUIRE(objects[1].second == StorageObjectType::Undefined);
+
+  REQUIRE(io.createReferenceAttribute("/group/data", "/group", "ref")
+          == Status::Success);
+  REQUIRE(io.readReferenceAttribute("/group/ref") == "/group/data");
+  REQUIRE_THROWS_AS(io.readReferenceAttribute("/group/missing"),
+                    std::invalid_argument);
+
+  REQUIRE(io.createReferenceDataSet("/refs", {"/group", "/group/data"})
+          == Status::Success);
+  REQUIRE(io.createReferenceDataSet("/badrefs", {"/missing"})
+          == Status::Failure);
+  auto refs = IO::DataBlock<std::string>::fromGeneric(io.readDataset("/refs"));
+  REQUIRE(refs.data == std::vector<std::string> {"/group", "/group/data"});
+  io.close();
+}
+
+TEST_CASE("record and export an NWB file", "[memoryio]")
+{
+  std::shared_ptr<BaseIO> io = createIO("Memory", "test_memory_nwb");
+  REQUIRE(std::dynamic_pointer_cast<MemoryIO>(io) != nullptr);
+  REQUIRE(io->open() == Status::Success);
+  auto nwbFile = NWB::NWBFile::create(io);
+  REQUIRE(nwbFile->initialize(generateUuid()) == Status::Success);
+  const SizeType numChannels = 3;
+  auto mockArrays = getMockChannelArrays(numChannels, 1);
+  nwbFile->createElectrodesTable(mockArrays);
+  std::vector<SizeType> esIndexes;
+  REQUIRE(nwbFile->createElectricalSeries(mockArrays,
+                                          getMockChannelArrayNames("esdata", 1),
+                                          BaseDataType::F32,
+                                          esIndexes)
+          == Status::Success);
+  REQUIRE(io->startRecording() == Status::Success);
+
+  const SizeType numSamples = 100;
+  auto mockData = getMockData2D(numSamples, numChannels);
+  auto timestamps = getMockTimestamps(numSamples, 1);
+  auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+      io->getRecordingObjects()->getRecordingObject(esIndexes[0]));
+  REQUIRE(series != nullptr);
+  for (SizeType ch = 0; ch < numChannels; ++ch) {
+    REQUIRE(series->writeChannel(
+                ch, numSamples, mockData[ch].data(), timestamps.data())
+            == Status::Success);
+  }
+  io->stopRecording();
+
+  const std::string dataPath = "/acquisition/esdata0/data";
+  auto data = IO::DataBlock<float>::fromGeneric(io->readDataset(dataPath));
+  REQUIRE(data.shape == SizeArray {numSamples, numChannels});
+  for (SizeType i = 0; i < numSamples; ++i) {
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(data.data[i * numChannels + ch]
+              == Catch::Approx(mockData[ch][i]));
+    }
+  }
+
+  SECTION("find types")
+  {
+    auto types = io->findTypes(
+        "/", {"core::ElectricalSeries"}, SearchMode::CONTINUE_ON_TYPE);
+    REQUIRE(types.size() == 1);
+    REQUIRE(types["/acquisition/esdata0"] == "core::ElectricalSeries");
+  }
+
+  SECTION("export to HDF5")
+  {
+    auto memoryIO = std::dynamic_pointer_cast<MemoryIO>(io);
+    REQUIRE(memoryIO->getDataBytes()
+            >= numSamples * numChannels * sizeof(float));
+    std::string path = getTestFilePath("testMemoryIOExport.nwb");
+    {
+      IO::HDF5::HDF5IO hdf5io(path);
+      REQUIRE(hdf5io.open(FileMode::Overwrite) == Status::Success);
+      REQUIRE(memoryIO->exportTo(hdf5io) == Status::Success);
+      hdf5io.close();
+    }
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    auto exported =
+        IO::DataBlock<float>::fromGeneric(readio->readDataset(dataPath));
+    REQUIRE(exported.shape == data.shape);
+    REQUIRE(exported.data == data.data);
+    REQUIRE(readio->getStorageObjectChunking(dataPath)
+            == io->getStorageObjectChunking(dataPath));
+    auto readFile = NWB::RegisteredType::create<NWB::NWBFile>("/", readio);
+    REQUIRE(readFile != nullptr);
+    auto types = readio->findTypes(
+        "/", {"core::ElectricalSeries"}, SearchMode::CONTINUE_ON_TYPE);
+    REQUIRE(types.size() == 1);
+    readio->close();
+  }
+  io->close();
+}
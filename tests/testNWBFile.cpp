@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "Utils.hpp"
@@ -410,6 +411,140 @@ TEST_CASE("createAnnotationSeries", "[nwb]")
   io->stopRecording();
 }
 
+TEST_CASE("restoreRecording", "[nwb]")
+{
+  std::string filename = getTestFilePath("restoreRecording.nwb");
+  const SizeType numChannels = 3;
+  const SizeType numSamples = 10;
+  std::vector<Types::ChannelVector> mockArrays =
+      getMockChannelArrays(numChannels, 1);
+  std::vector<std::vector<float>> mockData =
+      getMockData2D(2 * numSamples, numChannels);
+  std::vector<double> mockTimestamps = getMockTimestamps(2 * numSamples, 1);
+  const SizeType numSpikeSamples = 5;
+  std::vector<float> spike(numChannels * numSpikeSamples);
+  std::iota(spike.begin(), spike.end(), 1.0f);
+  std::vector<std::string> annotations = {"first", "second"};
+
+  // record the first segment, e.g., before a pause or a crash
+  {
+    std::shared_ptr<IO::HDF5::HDF5IO> io =
+        std::make_shared<IO::HDF5::HDF5IO>(filename);
+    io->open();
+    auto nwbfile = NWB::NWBFile::create(io);
+    nwbfile->initialize(generateUuid());
+    nwbfile->createElectrodesTable(mockArrays);
+    std::vector<SizeType> containerIndices;
+    REQUIRE(nwbfile->createElectricalSeries(mockArrays,
+                                            getMockChannelArrayNames("esdata",
+                                                                     1),
+                                            BaseDataType::F32,
+                                            containerIndices)
+            == Status::Success);
+    REQUIRE(
+        nwbfile->createSpikeEventSeries(mockArrays,
+                                        getMockChannelArrayNames("spikedata",
+                                                                 1),
+                                        BaseDataType::F32,
+                                        containerIndices)
+        == Status::Success);
+    REQUIRE(nwbfile->createAnnotationSeries({"annotations"}, containerIndices)
+            == Status::Success);
+    REQUIRE(io->startRecording() == Status::Success);
+
+    auto recordingObjects = io->getRecordingObjects();
+    auto es = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        recordingObjects->getRecordingObject(containerIndices[0]));
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(es->writeChannel(
+                  ch, numSamples, mockData[ch].data(), mockTimestamps.data())
+              == Status::Success);
+    }
+    auto ses = std::dynamic_pointer_cast<NWB::SpikeEventSeries>(
+        recordingObjects->getRecordingObject(containerIndices[1]));
+    REQUIRE(ses->writeSpike(numSpikeSamples,
+                            numChannels,
+                            spike.data(),
+                            &mockTimestamps[0])
+            == Status::Success);
+    REQUIRE(IO::writeAnnotationSeriesData(recordingObjects,
+                                          containerIndices[2],
+                                          1,
+                                          {annotations[0]},
+                                          mockTimestamps.data())
+            == Status::Success);
+    io->stopRecording();
+    io->close();
+  }
+
+  // reopen the file and continue appending to all series
+  {
+    std::shared_ptr<IO::HDF5::HDF5IO> io =
+        std::make_shared<IO::HDF5::HDF5IO>(filename);
+    REQUIRE(io->open(IO::FileMode::ReadWrite) == Status::Success);
+    auto nwbfile = NWB::NWBFile::create(io);
+    std::vector<SizeType> containerIndices;
+    REQUIRE(nwbfile->restoreRecording(containerIndices) == Status::Success);
+    REQUIRE(containerIndices.size() == 3);
+    REQUIRE(io->startRecording() == Status::Success);
+
+    // the series are restored in the order of their paths
+    auto recordingObjects = io->getRecordingObjects();
+    auto annotationSeries = std::dynamic_pointer_cast<NWB::AnnotationSeries>(
+        recordingObjects->getRecordingObject(containerIndices[0]));
+    auto es = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        recordingObjects->getRecordingObject(containerIndices[1]));
+    auto ses = std::dynamic_pointer_cast<NWB::SpikeEventSeries>(
+        recordingObjects->getRecordingObject(containerIndices[2]));
+    REQUIRE(annotationSeries != nullptr);
+    REQUIRE(es != nullptr);
+    REQUIRE(ses != nullptr);
+    REQUIRE(es->m_channelVector.size() == numChannels);
+    // the sampling rate is estimated from the timestamps
+    REQUIRE(es->m_channelVector[0].getSamplingRate()
+            == Catch::Approx(1.0f).epsilon(0.01));
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(es->writeChannel(ch,
+                               numSamples,
+                               mockData[ch].data() + numSamples,
+                               mockTimestamps.data() + numSamples)
+              == Status::Success);
+    }
+    REQUIRE(ses->writeSpike(numSpikeSamples,
+                            numChannels,
+                            spike.data(),
+                            &mockTimestamps[1])
+            == Status::Success);
+    REQUIRE(annotationSeries->writeAnnotation(
+                1, {annotations[1]}, &mockTimestamps[1])
+            == Status::Success);
+    io->stopRecording();
+    io->close();
+  }
+
+  std::shared_ptr<IO::HDF5::HDF5IO> readio =
+      std::make_shared<IO::HDF5::HDF5IO>(filename);
+  REQUIRE(readio->open(IO::FileMode::ReadOnly) == Status::Success);
+  auto data = IO::DataBlock<float>::fromGeneric(
+      readio->readDataset("/acquisition/esdata0/data"));
+  REQUIRE(data.shape == SizeArray {2 * numSamples, numChannels});
+  for (SizeType i = 0; i < 2 * numSamples; ++i) {
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(data.data[i * numChannels + ch]
+              == Catch::Approx(mockData[ch][i]));
+    }
+  }
+  auto timestamps = IO::DataBlock<double>::fromGeneric(
+      readio->readDataset("/acquisition/esdata0/timestamps"));
+  REQUIRE(timestamps.data == mockTimestamps);
+  REQUIRE(readio->getStorageObjectShape("/acquisition/spikedata0/data")
+          == SizeArray {2, numChannels, numSpikeSamples});
+  auto readAnnotations = IO::DataBlock<std::string>::fromGeneric(
+      readio->readDataset("/acquisition/annotations/data"));
+  REQUIRE(readAnnotations.data == annotations);
+  readio->close();
+}
+
 TEST_CASE("setCanModifyObjectsMode", "[nwb]")
 {
   std::string filename = getTestFilePath("testCanModifyObjectsMode.nwb");
@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "Utils.hpp"
+#include "io/BaseIO.hpp"
+#include "io/RecordingObjects.hpp"
+#include "io/null/NullIO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using IO::Null::NullIO;
+
+TEST_CASE("structure and attributes", "[nullio]")
+{
+  NullIO io("test_structure");
+  REQUIRE(io.open(FileMode::ReadWrite) == Status::Failure);
+  REQUIRE(io.open() == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Failure);
+  REQUIRE(io.createGroup("/missing/child") == Status::Failure);
+  REQUIRE(io.getStorageObjectType("/data/") == StorageObjectType::Group);
+
+  std::vector<int32_t> values = {1, 2, 3};
+  REQUIRE(io.createAttribute(BaseDataType::I32, values.data(), "/data", "a", 3)
+          == Status::Success);
+  REQUIRE(io.createAttribute("text", "/data", "s") == Status::Success);
+  REQUIRE(io.createAttribute("other", "/data", "s", false) == Status::Failure);
+  REQUIRE(io.getAttributeBytesWritten() == 3 * sizeof(int32_t) + 4);
+
+  // values are discarded and read as default values in the original shape
+  auto block = IO::DataBlock<int32_t>::fromGeneric(io.readAttribute("/data/a"));
+  REQUIRE(block.shape == SizeArray {3});
+  REQUIRE(block.data == std::vector<int32_t> {0, 0, 0});
+  REQUIRE(io.getStorageObjectDataType("/data/s") == BaseDataType::V_STR);
+  REQUIRE_THROWS_AS(io.readAttribute("/data/missing"), std::invalid_argument);
+
+  io.createGroup("/data/child");
+  io.createGroup("/data/child/grandchild");
+  auto objects = io.getStorageObjects("/data");
+  REQUIRE(objects.size() == 3);
+  REQUIRE(objects[0].first == "child");
+  REQUIRE(objects[0].second == StorageObjectType::Group);
+  REQUIRE(objects[1].first == "a");
+  REQUIRE(objects[1].second == StorageObjectType::Attribute);
+  REQUIRE(io.getStorageObjects("/data", StorageObjectType::Group).size() == 1);
+
+  REQUIRE(io.createLink("/link", "/data") == Status::Success);
+  REQUIRE(io.getStorageObjectType("/link") == StorageObjectType::Group);
+  REQUIRE(io.createReferenceAttribute("/data/child", "/data", "ref")
+          == Status::Success);
+  REQUIRE(io.readReferenceAttribute("/data/ref") == "/data/child");
+
+  // the structure is kept on close and discarded on overwrite
+  io.close();
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  REQUIRE(io.objectExists("/data/child"));
+  REQUIRE(io.createGroup("/other") == Status::Failure);
+  io.close();
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  REQUIRE(io.objectExists("/data") == false);
+  io.close();
+}
+
+TEST_CASE("datasets track shapes and count bytes", "[nullio]")
+{
+  NullIO io("test_datasets");
+  io.open();
+
+  IO::ArrayDataSetConfig config(
+      BaseDataType::I16, SizeArray {0, 4}, SizeArray {8, 0});
+  auto dataset = io.createArrayDataSet(config, "/data");
+  REQUIRE(dataset != nullptr);
+  std::vector<int16_t> values(12);
+  REQUIRE(dataset->writeDataBlock(SizeArray {3, 4},
+                                  SizeArray {0, 0},
+                                  BaseDataType::I16,
+                                  values.data())
+          == Status::Success);
+  REQUIRE(dataset->writeDataBlock(SizeArray {2, 4},
+                                  SizeArray {3, 0},
+                                  BaseDataType::I16,
+                                  values.data())
+          == Status::Success);
+  REQUIRE(io.getStorageObjectShape("/data") == SizeArray {5, 4});
+  REQUIRE(io.getStorageObjectChunking("/data") == SizeArray {8, 4});
+  REQUIRE(io.getNumWrites() == 2);
+  REQUIRE(io.getDataBytesWritten() == 20 * sizeof(int16_t));
+
+  // the second dimension was created with a fixed size
+  REQUIRE(dataset->writeDataBlock(SizeArray {1, 5},
+                                  SizeArray {0, 0},
+                                  BaseDataType::I16,
+                                  values.data())
+          == Status::Failure);
+  REQUIRE(io.getNumWrites() == 2);
+
+  auto slab = IO::DataBlock<int16_t>::fromGeneric(
+      io.readDataset("/data", SizeArray {1, 0}, SizeArray {2, 2}));
+  REQUIRE(slab.shape == SizeArray {2, 2});
+  REQUIRE(slab.data == std::vector<int16_t>(4, 0));
+  auto selection = IO::DataBlock<int16_t>::fromGeneric(
+      io.readDatasetSelection("/data", {{}, {3, 1}}));
+  REQUIRE(selection.shape == SizeArray {5, 2});
+  REQUIRE_THROWS_AS(io.readDataset("/data", SizeArray {4, 0}, SizeArray {2, 1}),
+                    std::runtime_error);
+
+  std::vector<std::string> strings = {"a", "bb"};
+  REQUIRE(io.createStringDataSet("/strings", strings) == Status::Success);
+  auto stringData = io.getDataSet("/strings");
+  REQUIRE(stringData->writeDataBlock(
+              SizeArray {1}, SizeArray {2}, BaseDataType::V_STR, strings)
+          == Status::Success);
+  REQUIRE(io.getStorageObjectShape("/strings") == SizeArray {3});
+  REQUIRE(io.getDataBytesWritten() == 20 * sizeof(int16_t) + 4);
+
+  io.resetCounters();
+  REQUIRE(io.getNumWrites() == 0);
+  REQUIRE(io.getDataBytesWritten() == 0);
+  io.close();
+}
+
+TEST_CASE("record an NWB file", "[nullio]")
+{
+  std::shared_ptr<BaseIO> io = createIO("Null", "test_null_nwb");
+  auto nullIO = std::dynamic_pointer_cast<NullIO>(io);
+  REQUIRE(nullIO != nullptr);
+  REQUIRE(io->open() == Status::Success);
+  auto nwbFile = NWB::NWBFile::create(io);
+  REQUIRE(nwbFile->initialize(generateUuid()) == Status::Success);
+  REQUIRE(nwbFile->isInitialized());
+  const SizeType numChannels = 4;
+  auto mockArrays = getMockChannelArrays(numChannels, 2);
+  nwbFile->createElectrodesTable(mockArrays);
+  std::vector<SizeType> esIndexes;
+  REQUIRE(nwbFile->createElectricalSeries(mockArrays,
+                                          getMockChannelArrayNames("esdata", 2),
+                                          BaseDataType::I16,
+                                          esIndexes)
+          == Status::Success);
+  REQUIRE(io->startRecording() == Status::Success);
+  nullIO->resetCounters();
+
+  const SizeType numSamples = 100;
+  auto mockData = getMockData2D(numSamples, numChannels);
+  auto timestamps = getMockTimestamps(numSamples, 1);
+  auto recordingObjects = io->getRecordingObjects();
+  for (SizeType index : esIndexes) {
+    auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        recordingObjects->getRecordingObject(index));
+    REQUIRE(series != nullptr);
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(series->writeChannel(
+                  ch, numSamples, mockData[ch].data(), timestamps.data())
+              == Status::Success);
+    }
+  }
+  REQUIRE(io->stopRecording() == Status::Success);
+
+  REQUIRE(io->getStorageObjectShape("/acquisition/esdata0/data")
+          == SizeArray {numSamples, numChannels});
+  REQUIRE(io->getStorageObjectShape("/acquisition/esdata1/timestamps")
+          == SizeArray {numSamples});
+  REQUIRE(nullIO->getNumWrites() > 0);
+  REQUIRE(nullIO->getDataBytesWritten()
+          >= 2 * numSamples * numChannels * sizeof(int16_t));
+  io->close();
+}
@@ -0,0 +1,247 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "Utils.hpp"
+#include "io/BaseIO.hpp"
+#include "io/RecordingObjects.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "io/raw/RawCaptureIO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using IO::Raw::PackOptions;
+using IO::Raw::RawCaptureIO;
+
+namespace
+{
+/**
+ * @brief Get the path of a test capture, removing the capture of a previous
+ * run. getTestFilePath only removes files.
+ */
+std::string getTestCapturePath(const std::string& name)
+{
+  std::filesystem::remove_all(std::filesystem::current_path() / "data" / name);
+  return getTestFilePath(name);
+}
+
+/**
+ * @brief Write blocks of 5 rows of 4 int32 values to a dataset
+ */
+void writeBlocks(BaseRecordingData& dataset, SizeType firstBlock, SizeType n)
+{
+  for (SizeType b = firstBlock; b < firstBlock + n; ++b) {
+    std::vector<int32_t> values(20);
+    std::iota(values.begin(), values.end(), static_cast<int32_t>(b * 20));
+    REQUIRE(dataset.writeDataBlock(
+                {5, 4}, {b * 5, 0}, BaseDataType::I32, values.data())
+            == Status::Success);
+  }
+}
+
+/**
+ * @brief Check that a dataset holds the values written by writeBlocks
+ */
+void checkBlocks(BaseIO& io, const std::string& path, SizeType numBlocks)
+{
+  auto data = IO::DataBlock<int16_t>::fromGeneric(io.readDataset(path));
+  REQUIRE(data.shape == SizeArray {numBlocks * 5, 4});
+  for (SizeType i = 0; i < data.data.size(); ++i) {
+    REQUIRE(data.data[i] == static_cast<int16_t>(i));
+  }
+}
+}  // namespace
+
+TEST_CASE("open - raw capture modes", "[rawcapture]")
+{
+  std::string path = getTestCapturePath("testRawCaptureOpen.nwb.raw");
+  RawCaptureIO io(path);
+  REQUIRE(io.open(FileMode::ReadWrite) == Status::Failure);
+  REQUIRE(io.open() == Status::Success);
+  REQUIRE(std::filesystem::exists(path + "/manifest.json"));
+  REQUIRE(io.createGroup("/group") == Status::Success);
+  io.close();
+
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  REQUIRE(io.getStorageObjectType("/group") == StorageObjectType::Group);
+  REQUIRE(io.createGroup("/other") == Status::Failure);
+  io.close();
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  REQUIRE(io.objectExists("/group") == false);
+  io.close();
+
+  // directories that are not captures are never overwritten
+  std::string other = getTestCapturePath("testRawCaptureOther");
+  std::filesystem::create_directories(other);
+  std::ofstream(other + "/keep.txt") << "data";
+  RawCaptureIO otherIO(other);
+  REQUIRE(otherIO.open(FileMode::Overwrite) == Status::Failure);
+  REQUIRE(std::filesystem::exists(other + "/keep.txt"));
+}
+
+TEST_CASE("record and read a raw capture", "[rawcapture]")
+{
+  std::string path = getTestCapturePath("testRawCaptureRecord.nwb.raw");
+  RawCaptureIO io(path);
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Success);
+  double rate = 30000.0;
+  REQUIRE(io.createAttribute(BaseDataType::F64, &rate, "/data", "rate")
+          == Status::Success);
+  REQUIRE(io.createStringDataSet("/data/names",
+                                 std::vector<std::string> {"a", "b"})
+          == Status::Success);
+
+  // values are converted to the type of the dataset on read
+  auto dataset = io.createArrayDataSet(
+      IO::ArrayDataSetConfig(BaseDataType::I16, {0, 4}, {8, 4}),
+      "/data/values");
+  REQUIRE(dataset != nullptr);
+  writeBlocks(*dataset, 0, 3);
+  REQUIRE(io.getStorageObjectShape("/data/values") == SizeArray {15, 4});
+  checkBlocks(io, "/data/values", 3);
+  auto row = IO::DataBlock<int16_t>::fromGeneric(
+      io.readDataset("/data/values", {7, 0}, {1, 4}));
+  REQUIRE(row.data == std::vector<int16_t> {28, 29, 30, 31});
+
+  auto events = io.createArrayDataSet(
+      IO::ArrayDataSetConfig(BaseDataType::V_STR, {0}, {4}), "/data/events");
+  REQUIRE(events->writeDataBlock(
+              {3}, {0}, BaseDataType::V_STR, {"start", "", "stop"})
+          == Status::Success);
+  std::vector<std::string> last = {"end"};
+  REQUIRE(io.getDataSet("/data/events")
+              ->writeDataBlock({1}, {3}, BaseDataType::V_STR, last)
+          == Status::Success);
+  io.close();
+  REQUIRE(std::filesystem::exists(path + "/data/0.raw"));
+
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  checkBlocks(io, "/data/values", 3);
+  auto strings = IO::DataBlock<std::string>::fromGeneric(
+      io.readDataset("/data/events"));
+  REQUIRE(strings.data
+          == std::vector<std::string> {"start", "", "stop", "end"});
+  auto names = IO::DataBlock<std::string>::fromGeneric(
+      io.readDataset("/data/names"));
+  REQUIRE(names.data == std::vector<std::string> {"a", "b"});
+  auto readRate =
+      IO::DataBlock<double>::fromGeneric(io.readAttribute("/data/rate"));
+  REQUIRE(readRate.data[0] == Catch::Approx(rate));
+  REQUIRE(io.getStorageObjectChunking("/data/values") == SizeArray {8, 4});
+  io.close();
+}
+
+TEST_CASE("reopen a raw capture after a crash", "[rawcapture]")
+{
+  std::string path = getTestCapturePath("testRawCaptureCrash.nwb.raw");
+  const std::string manifest = path + "/manifest.json";
+  const std::string savedManifest = path + "/manifest.saved";
+  {
+    RawCaptureIO io(path);
+    REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+    auto dataset = io.createArrayDataSet(
+        IO::ArrayDataSetConfig(BaseDataType::I16, {0, 4}, {8, 4}), "/values");
+    writeBlocks(*dataset, 0, 2);
+    REQUIRE(io.flush() == Status::Success);
+    std::filesystem::copy_file(manifest, savedManifest);
+    writeBlocks(*dataset, 2, 1);
+    io.close();
+  }
+
+  // Simulate a crash after the last flush that left a partial record
+  std::filesystem::rename(savedManifest, manifest);
+  std::ofstream(path + "/data/0.raw", std::ios::binary | std::ios::app)
+      << "RCRD\x03";
+
+  RawCaptureIO io(path);
+  REQUIRE(io.open(FileMode::ReadWrite) == Status::Success);
+  REQUIRE(io.getStorageObjectShape("/values") == SizeArray {15, 4});
+  auto dataset = io.getDataSet("/values");
+  writeBlocks(*dataset, 3, 1);
+  io.close();
+
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  checkBlocks(io, "/values", 4);
+  io.close();
+}
+
+TEST_CASE("pack a raw capture into an NWB file", "[rawcapture]")
+{
+  std::string path = getTestCapturePath("testRawCapturePack.nwb.raw");
+  const SizeType numChannels = 5;
+  const SizeType numSamples = 1000;
+  auto mockData = getMockData2D(numSamples, numChannels);
+  {
+    std::shared_ptr<BaseIO> io = createIO("RawCapture", path);
+    REQUIRE(std::dynamic_pointer_cast<RawCaptureIO>(io) != nullptr);
+    REQUIRE(io->open(FileMode::Overwrite) == Status::Success);
+    auto nwbFile = NWB::NWBFile::create(io);
+    REQUIRE(nwbFile->initialize(generateUuid()) == Status::Success);
+    auto mockArrays = getMockChannelArrays(numChannels, 1);
+    nwbFile->createElectrodesTable(mockArrays);
+    std::vector<SizeType> esIndexes;
+    REQUIRE(
+        nwbFile->createElectricalSeries(mockArrays,
+                                        getMockChannelArrayNames("esdata", 1),
+                                        BaseDataType::F32,
+                                        esIndexes)
+        == Status::Success);
+    REQUIRE(io->startRecording() == Status::Success);
+
+    auto timestamps = getMockTimestamps(numSamples, 1);
+    auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        io->getRecordingObjects()->getRecordingObject(esIndexes[0]));
+    REQUIRE(series != nullptr);
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(series->writeChannel(
+                  ch, numSamples, mockData[ch].data(), timestamps.data())
+              == Status::Success);
+    }
+    REQUIRE(io->stopRecording() == Status::Success);
+    io->close();
+  }
+
+  RawCaptureIO capture(path);
+  REQUIRE(capture.open(FileMode::ReadOnly) == Status::Success);
+  for (unsigned int level : {0u, 4u}) {
+    std::string nwbPath = getTestFilePath("testRawCapturePack"
+                                          + std::to_string(level) + ".nwb");
+    PackOptions options;
+    options.chunkRows = 64;
+    options.compressionLevel = level;
+    options.numThreads = 3;
+    REQUIRE(capture.pack(nwbPath, options) == Status::Success);
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", nwbPath);
+    REQUIRE(readio->open(FileMode::ReadOnly) == Status::Success);
+    const std::string dataPath = "/acquisition/esdata0/data";
+    REQUIRE(readio->getStorageObjectChunking(dataPath)[0] == 64);
+    auto data =
+        IO::DataBlock<float>::fromGeneric(readio->readDataset(dataPath));
+    REQUIRE(data.shape == SizeArray {numSamples, numChannels});
+    for (SizeType i = 0; i < numSamples; ++i) {
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        REQUIRE(data.data[i * numChannels + ch]
+                == Catch::Approx(mockData[ch][i]));
+      }
+    }
+    auto readFile = NWB::RegisteredType::create<NWB::NWBFile>("/", readio);
+    REQUIRE(readFile != nullptr);
+    auto types = readio->findTypes(
+        "/", {"core::ElectricalSeries"}, SearchMode::CONTINUE_ON_TYPE);
+    REQUIRE(types.size() == 1);
+    readio->close();
+  }
+  capture.close();
+}
@@ -299,8 +299,9 @@ TEST_CASE("RecordingObjects recording workflow tests", "[recording]")
                                     BaseDataType::I16,
                                     contIdx);
     REQUIRE(recordingObjects->size() == 12);
+    // the series resolve their data and timestamps datasets in initialize
     std::vector<SizeType> expextedCacheSize = {
-        0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 2, 2};
+        0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 4, 4};
     // Confirm that the recording data caches are as expected
     for (SizeType i = 0; i < recordingObjects->size(); ++i) {
       auto obj = recordingObjects->getRecordingObject(i);
@@ -335,4 +336,63 @@ TEST_CASE("RecordingObjects recording workflow tests", "[recording]")
     // cleanup
     io->close();
   }
+
+  // --------------------------------------------------------------
+  //   SECTION 4 – bulk registration
+  //   --------------------------------------------------------------
+  SECTION("bulk registration and lookup")
+  {
+    const std::string path = getTestFilePath("recObjectsWorkflow_4.h5");
+    std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+    io->open();
+    auto recordingObjects = io->getRecordingObjects();
+    REQUIRE(recordingObjects != nullptr);
+
+    // many series, with a duplicate object and a duplicate path
+    const SizeType numSeries = 1000;
+    std::vector<std::shared_ptr<NWB::RegisteredType>> series;
+    for (SizeType i = 0; i < numSeries; ++i) {
+      series.push_back(std::make_shared<FaultyTimeSeries>(
+          "/acquisition/unit" + std::to_string(i), io));
+    }
+    series.push_back(series[5]);
+    auto samePath =
+        std::make_shared<FaultyTimeSeries>("/acquisition/unit7", io);
+    series.push_back(samePath);
+
+    std::vector<SizeType> indexes =
+        recordingObjects->addRecordingObjects(series);
+    REQUIRE(indexes.size() == numSeries + 2);
+    REQUIRE(recordingObjects->size() == numSeries + 1);
+    for (SizeType i = 0; i < numSeries; ++i) {
+      REQUIRE(indexes[i] == i);
+      REQUIRE(recordingObjects->getRecordingIndex(series[i]) == i);
+    }
+    REQUIRE(indexes[numSeries] == 5);
+    REQUIRE(indexes[numSeries + 1] == numSeries);
+    REQUIRE(recordingObjects->getRecordingIndex(samePath) == numSeries);
+
+    // lookup by path returns the object added first
+    REQUIRE(recordingObjects->getRecordingObject("/acquisition/unit7")
+            == series[7]);
+    REQUIRE(recordingObjects->getRecordingObject("/acquisition/unit999")
+            == series[999]);
+    REQUIRE(recordingObjects->getRecordingObject("/acquisition/missing")
+            == nullptr);
+
+    // adding again returns the existing indexes
+    auto again = recordingObjects->addRecordingObjects({series[0], series[1]});
+    REQUIRE(again == std::vector<SizeType> {0, 1});
+    REQUIRE(recordingObjects->size() == numSeries + 1);
+
+    // clearing also clears the lookup tables
+    recordingObjects->clear();
+    REQUIRE(recordingObjects->getRecordingObject("/acquisition/unit7")
+            == nullptr);
+    REQUIRE(recordingObjects->getRecordingIndex(series[7])
+            == std::numeric_limits<SizeType>::max());
+    REQUIRE(recordingObjects->addRecordingObject(series[7]) == 0);
+
+    io->close();
+  }
 }
@@ -1,5 +1,6 @@
 
 #include <H5Cpp.h>
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
@@ -11,6 +12,8 @@
 #include "io/hdf5/HDF5IO.hpp"
 #include "io/nwbio_utils.hpp"
 #include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "nwb/epoch/TimeIntervals.hpp"
 #include "nwb/file/ElectrodesTable.hpp"
 #include "testUtils.hpp"
 
@@ -151,3 +154,84 @@ TEST_CASE("writeContinuousData", "[recording]")
                  Catch::Matchers::Approx(mockTimestamps).margin(tolerance));
   }
 }
+
+TEST_CASE("pauseRecording", "[recording]")
+{
+  SizeType numChannels = 4;
+  SizeType numSamples = 30;
+  std::vector<Types::ChannelVector> mockRecordingArrays =
+      getMockChannelArrays(numChannels, 1);
+  std::vector<std::vector<float>> mockData =
+      getMockData2D(numSamples, numChannels);
+  std::vector<double> mockTimestamps = getMockTimestamps(numSamples, 1);
+
+  std::string path = getTestFilePath("testPauseRecording.nwb");
+  std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+  io->open();
+  auto nwbfile = NWB::NWBFile::create(io);
+  nwbfile->initialize(generateUuid());
+  nwbfile->createElectrodesTable(mockRecordingArrays);
+  std::vector<SizeType> containerIndexes;
+  REQUIRE(nwbfile->createElectricalSeries(mockRecordingArrays,
+                                          getMockChannelArrayNames("esdata",
+                                                                   1),
+                                          BaseDataType::F32,
+                                          containerIndexes)
+          == Status::Success);
+  REQUIRE(nwbfile->createRecordingPauses(containerIndexes) == Status::Success);
+  REQUIRE(io->startRecording() == Status::Success);
+
+  auto recordingObjects = io->getRecordingObjects();
+  auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+      recordingObjects->getRecordingObject(containerIndexes[0]));
+  auto writeSamples = [&](SizeType start, SizeType count)
+  {
+    Status status = Status::Success;
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      status = series->writeChannel(ch,
+                                    count,
+                                    mockData[ch].data() + start,
+                                    mockTimestamps.data() + start)
+          && status;
+    }
+    return status;
+  };
+
+  // writes are rejected while paused and continue where they stopped
+  REQUIRE(writeSamples(0, 10) == Status::Success);
+  REQUIRE(io->pauseRecording(mockTimestamps[10]) == Status::Success);
+  REQUIRE(io->isRecordingPaused());
+  REQUIRE(io->isOpen());
+  REQUIRE(io->pauseRecording(mockTimestamps[10]) == Status::Failure);
+  REQUIRE(writeSamples(10, 10) == Status::Failure);
+  REQUIRE(series->writeAllChannels(
+              10, mockData[0].data(), BaseDataType::F32, &mockTimestamps[0])
+          == Status::Failure);
+  REQUIRE(io->resumeRecording(mockTimestamps[20]) == Status::Success);
+  REQUIRE(io->resumeRecording(mockTimestamps[20]) == Status::Failure);
+  REQUIRE(writeSamples(20, 10) == Status::Success);
+  io->stopRecording();
+  io->close();
+
+  std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+  readio->open(FileMode::ReadOnly);
+  auto data = IO::DataBlock<float>::fromGeneric(
+      readio->readDataset("/acquisition/esdata0/data"));
+  REQUIRE(data.shape == SizeArray {20, numChannels});
+  for (SizeType i = 0; i < 20; ++i) {
+    SizeType sample = (i < 10) ? i : i + 10;
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(data.data[i * numChannels + ch]
+              == Catch::Approx(mockData[ch][sample]));
+    }
+  }
+
+  // the pause is recorded as an interval
+  auto pauses = NWB::RegisteredType::create<NWB::TimeIntervals>(
+      NWB::TimeIntervals::recordingPausesPath, readio);
+  auto startTimes = pauses->readStartTimeColumn()->readData()->values().data;
+  auto stopTimes = pauses->readStopTimeColumn()->readData()->values().data;
+  REQUIRE(startTimes == std::vector<double> {mockTimestamps[10]});
+  REQUIRE(stopTimes == std::vector<double> {mockTimestamps[20]});
+  readio->close();
+}
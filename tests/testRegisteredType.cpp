@@ -35,6 +35,8 @@ public:
   virtual std::string getTypeName() const override { return "TestFieldType"; }
   virtual std::string getNamespace() const override { return "test"; }
 
+  DEFINE_RECORDING_DATA_SLOTS(TestFieldType, RegisteredType)
+
   DEFINE_ATTRIBUTE_FIELD(testAttribute,
                          int32_t,
                          "test_attr",
@@ -43,6 +45,24 @@ public:
       testDataset, recordDataset, float, "test_dataset", "Test dataset field")
 };
 
+// Test class with a field in addition to the fields of its base class
+class TestDerivedFieldType : public TestFieldType
+{
+public:
+  TestDerivedFieldType(const std::string& path, std::shared_ptr<IO::BaseIO> io)
+      : TestFieldType(path, io)
+  {
+  }
+
+  DEFINE_RECORDING_DATA_SLOTS(TestDerivedFieldType, TestFieldType)
+
+  DEFINE_DATASET_FIELD(otherDataset,
+                       recordOtherDataset,
+                       float,
+                       "other_dataset",
+                       "Test dataset field of the subclass")
+};
+
 TEST_CASE("RegisterType", "[base]")
 {
   SECTION("test that the registry is working")
@@ -428,6 +448,29 @@ TEST_CASE("RegisterType", "[base]")
     auto dataset4 = testInstance->recordDataset(true);
     REQUIRE(dataset4.get() != dataset1.get());
     REQUIRE(dataset4->getPosition() != dataset1->getPosition());
+    // subsequent calls return the new object
+    REQUIRE(testInstance->recordDataset().get() == dataset4.get());
+
+    // other instances of the same type have their own cache
+    auto otherInstance = std::make_shared<TestFieldType>(examplePath, io);
+    auto otherDataset = otherInstance->recordDataset();
+    REQUIRE(otherDataset != nullptr);
+    REQUIRE(otherDataset.get() != dataset4.get());
+    REQUIRE(otherInstance->recordDataset().get() == otherDataset.get());
+    REQUIRE(testInstance->recordDataset().get() == dataset4.get());
+
+    // the fields of a class and its base class use separate slots
+    io->createArrayDataSet(datasetConfig, examplePath + "/other_dataset");
+    auto derivedInstance =
+        std::make_shared<TestDerivedFieldType>(examplePath, io);
+    auto derivedDataset = derivedInstance->recordDataset();
+    auto derivedOtherDataset = derivedInstance->recordOtherDataset();
+    REQUIRE(derivedDataset != nullptr);
+    REQUIRE(derivedOtherDataset != nullptr);
+    REQUIRE(derivedOtherDataset.get() != derivedDataset.get());
+    REQUIRE(derivedInstance->recordDataset().get() == derivedDataset.get());
+    REQUIRE(derivedInstance->recordOtherDataset().get()
+            == derivedOtherDataset.get());
 
     // Write some more data to overwrite the previous data
     dataset4->writeDataBlock(
@@ -0,0 +1,118 @@
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "io/hdf5/HDF5IO.hpp"
+#include "nwb/epoch/TimeIntervals.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+
+TEST_CASE("TimeIntervals", "[table]")
+{
+  SECTION("test TimeIntervals is registered as a subclass of RegisteredType")
+  {
+    auto registry = AQNWB::NWB::RegisteredType::getRegistry();
+    REQUIRE(registry.find("core::TimeIntervals") != registry.end());
+  }
+
+  SECTION("test adding and reading intervals")
+  {
+    std::string path = getTestFilePath("testTimeIntervals.h5");
+    std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+    io->open();
+
+    auto epochs = NWB::TimeIntervals::create("/epochs", io);
+    REQUIRE(epochs->initialize("Test epochs", 2) == Status::Success);
+    REQUIRE(epochs->addInterval(0.0, 1.5) == Status::Success);
+    REQUIRE(epochs->addInterval(2.0, 3.5) == Status::Success);
+    REQUIRE(epochs->addInterval(4.0, 4.25) == Status::Success);
+    REQUIRE(epochs->getNumIntervals() == 3);
+    REQUIRE(epochs->finalize() == Status::Success);
+
+    auto readColNames = epochs->readColNames()->values().data;
+    REQUIRE(readColNames
+            == std::vector<std::string> {"start_time", "stop_time"});
+    auto startTimes = epochs->readStartTimeColumn()->readData()->values().data;
+    auto stopTimes = epochs->readStopTimeColumn()->readData()->values().data;
+    REQUIRE(startTimes == std::vector<double> {0.0, 2.0, 4.0});
+    REQUIRE(stopTimes == std::vector<double> {1.5, 3.5, 4.25});
+    auto ids = epochs->readIdColumn()->readData()->values().data;
+    REQUIRE(ids == std::vector<int> {0, 1, 2});
+
+    // appending continues after the rows in the file
+    auto restored = NWB::TimeIntervals::create("/epochs", io);
+    REQUIRE(restored->restoreRecordingState() == Status::Success);
+    REQUIRE(restored->getNumIntervals() == 3);
+    io->close();
+  }
+
+  SECTION("test recording pauses")
+  {
+    std::string path = getTestFilePath("testTimeIntervalsPauses.h5");
+    std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+    io->open();
+
+    // only tables with setRecordPauses enabled record the pauses
+    io->createGroup("/intervals");
+    auto epochs = NWB::TimeIntervals::create("/epochs", io);
+    REQUIRE(epochs->initialize("Test epochs") == Status::Success);
+    auto pauses = NWB::TimeIntervals::create(
+        NWB::TimeIntervals::recordingPausesPath, io);
+    REQUIRE(pauses->initialize("Test pauses") == Status::Success);
+    REQUIRE(pauses->getRecordPauses() == false);
+    pauses->setRecordPauses(true);
+
+    REQUIRE(epochs->recordingPaused(1.0) == Status::Success);
+    REQUIRE(pauses->recordingPaused(1.0) == Status::Success);
+    REQUIRE(epochs->getNumIntervals() == 0);
+    REQUIRE(pauses->getNumIntervals() == 1);
+    auto stopTimes = pauses->readStopTimeColumn()->readData()->values().data;
+    REQUIRE(std::isnan(stopTimes[0]));
+
+    REQUIRE(pauses->recordingResumed(2.5) == Status::Success);
+    REQUIRE(pauses->recordingPaused(4.0) == Status::Success);
+    REQUIRE(pauses->recordingResumed(4.5) == Status::Success);
+    // resuming twice does not change the last pause
+    REQUIRE(pauses->recordingResumed(5.0) == Status::Success);
+
+    auto startTimes = pauses->readStartTimeColumn()->readData()->values().data;
+    stopTimes = pauses->readStopTimeColumn()->readData()->values().data;
+    REQUIRE(startTimes == std::vector<double> {1.0, 4.0});
+    REQUIRE(stopTimes == std::vector<double> {2.5, 4.5});
+    io->close();
+  }
+
+  SECTION("test restoring a pause that was not ended")
+  {
+    std::string path = getTestFilePath("testTimeIntervalsOpenPause.h5");
+    std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+    io->open();
+    io->createGroup("/intervals");
+    auto pauses = NWB::TimeIntervals::create(
+        NWB::TimeIntervals::recordingPausesPath, io);
+    REQUIRE(pauses->initialize("Test pauses") == Status::Success);
+    pauses->setRecordPauses(true);
+    REQUIRE(pauses->recordingPaused(1.0) == Status::Success);
+    auto epochs = NWB::TimeIntervals::create("/epochs", io);
+    REQUIRE(epochs->initialize("Test epochs") == Status::Success);
+    REQUIRE(epochs->addInterval(0.0, 1.0) == Status::Success);
+
+    // pauses are recorded only by the table at recordingPausesPath, and the
+    // pause without a stop time is ended on resume
+    auto restoredEpochs = NWB::TimeIntervals::create("/epochs", io);
+    REQUIRE(restoredEpochs->restoreRecordingState() == Status::Success);
+    REQUIRE(restoredEpochs->getRecordPauses() == false);
+    auto restored = NWB::TimeIntervals::create(
+        NWB::TimeIntervals::recordingPausesPath, io);
+    REQUIRE(restored->restoreRecordingState() == Status::Success);
+    REQUIRE(restored->getRecordPauses());
+    REQUIRE(restored->getNumIntervals() == 1);
+    REQUIRE(restored->recordingResumed(3.0) == Status::Success);
+
+    auto stopTimes =
+        restored->readStopTimeColumn()->readData()->values().data;
+    REQUIRE(stopTimes == std::vector<double> {3.0});
+    io->close();
+  }
+}
@@ -344,6 +344,110 @@ TEST_CASE("TimeSeries", "[base]")
   }
 }
 
+TEST_CASE("TimeSeries; readByTime", "[base]")
+{
+  SizeType numSamples = 20;
+  std::string dataPath = "/tsdata";
+  std::vector<float> data(numSamples);
+  std::vector<double> timestamps(numSamples);
+  for (SizeType i = 0; i < numSamples; ++i) {
+    data[i] = static_cast<float>(i);
+    // non-uniform but sorted timestamps: 0.0, 0.5, 1.5, 3.0, ...
+    timestamps[i] = 0.25 * static_cast<double>(i * (i + 1));
+  }
+
+  SECTION("resolve indices from timestamps")
+  {
+    std::string path = getTestFilePath("testTimeSeriesReadByTimestamps.h5");
+    {
+      std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+      io->open();
+      auto ts = NWB::TimeSeries::create(dataPath, io);
+      // use small chunks so the sparse timestamps index has several entries
+      IO::ArrayDataSetConfig config(
+          BaseDataType::F32, SizeArray {0}, SizeArray {4});
+      ts->initialize(config, "volts");
+      REQUIRE(ts->writeData(SizeArray {numSamples},
+                            SizeArray {0},
+                            data.data(),
+                            timestamps.data())
+              == Status::Success);
+      io->close();
+    }
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    auto ts = NWB::RegisteredType::create<NWB::TimeSeries>(dataPath, readio);
+
+    // every timestamp must map to its own index
+    for (SizeType i = 0; i < numSamples; ++i) {
+      auto range = ts->findSampleRange(timestamps[i], timestamps[i] + 1e-9);
+      REQUIRE(range.first == i);
+      REQUIRE(range.second == i + 1);
+    }
+
+    // t0 between samples 5 (7.5) and 6 (10.5); t1 equal to sample 10 (27.5)
+    auto block = IO::DataBlock<float>::fromGeneric(ts->readByTime(8.0, 27.5));
+    REQUIRE(block.shape == SizeArray {4});
+    REQUIRE(block.data == std::vector<float> {6, 7, 8, 9});
+
+    // ranges before, after, and across all samples
+    REQUIRE(ts->findSampleRange(-5.0, -1.0)
+            == std::make_pair(SizeType(0), SizeType(0)));
+    REQUIRE(ts->findSampleRange(1000.0, 2000.0)
+            == std::make_pair(numSamples, numSamples));
+    REQUIRE(ts->findSampleRange(-1.0, 1000.0)
+            == std::make_pair(SizeType(0), numSamples));
+    REQUIRE(ts->findSampleRange(5.0, 5.0).second
+            == ts->findSampleRange(5.0, 5.0).first);
+    auto empty = IO::DataBlock<float>::fromGeneric(ts->readByTime(2.0, 2.5));
+    REQUIRE(empty.data.empty());
+
+    readio->close();
+  }
+
+  SECTION("resolve indices from starting_time and rate")
+  {
+    std::string path = getTestFilePath("testTimeSeriesReadByStartingTime.h5");
+    {
+      std::shared_ptr<BaseIO> io = createIO("HDF5", path);
+      io->open();
+      auto ts = NWB::TimeSeries::create(dataPath, io);
+      IO::ArrayDataSetConfig config(
+          BaseDataType::F32, SizeArray {0}, SizeArray {4});
+      ts->initialize(config,
+                     "volts",
+                     "no description",
+                     "no comments",
+                     1.0f,
+                     -1.0f,
+                     0.0f,
+                     NWB::TimeSeries::Continuous,
+                     10.0,  // starting time
+                     10.0f);  // rate in Hz
+      REQUIRE(ts->writeData(SizeArray {numSamples}, SizeArray {0}, data.data())
+              == Status::Success);
+      io->close();
+    }
+
+    std::shared_ptr<BaseIO> readio = createIO("HDF5", path);
+    readio->open(FileMode::ReadOnly);
+    auto ts = NWB::RegisteredType::create<NWB::TimeSeries>(dataPath, readio);
+
+    // samples are at 10.0, 10.1, ..., 11.9
+    auto block = IO::DataBlock<float>::fromGeneric(ts->readByTime(10.3, 10.65));
+    REQUIRE(block.data == std::vector<float> {3, 4, 5, 6});
+    REQUIRE(ts->findSampleRange(0.0, 10.0)
+            == std::make_pair(SizeType(0), SizeType(0)));
+    REQUIRE(ts->findSampleRange(11.95, 20.0)
+            == std::make_pair(numSamples, numSamples));
+    REQUIRE(ts->findSampleRange(0.0, 20.0)
+            == std::make_pair(SizeType(0), numSamples));
+
+    readio->close();
+  }
+}
+
 TEST_CASE("LinkArrayDataSetConfig for TimeSeries data", "[base][link]")
 {
   // Prepare common test data
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Tracing.hpp"
+#include "Types.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+
+namespace
+{
+/**
+ * @brief Count the non-overlapping occurrences of a substring
+ */
+SizeType countOccurrences(const std::string& text, const std::string& pattern)
+{
+  SizeType count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + pattern.size()))
+  {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST_CASE("Tracer", "[tracing]")
+{
+  Tracer::setEnabled(false);
+  Tracer::clear();
+  SizeType defaultMaxEvents = Tracer::getMaxEventsPerThread();
+
+  SECTION("nothing is recorded while disabled")
+  {
+    REQUIRE_FALSE(Tracer::isEnabled());
+    {
+      TraceScope trace("disabled", "test");
+    }
+    REQUIRE(Tracer::getNumEvents() == 0);
+  }
+
+  SECTION("events are recorded per thread and exported")
+  {
+    Tracer::setEnabled(true);
+    {
+      TraceScope trace("main", "test");
+    }
+    const SizeType numThreads = 4;
+    const SizeType eventsPerThread = 5000;
+    std::vector<std::thread> threads;
+    for (SizeType i = 0; i < numThreads; ++i) {
+      threads.emplace_back(
+          [eventsPerThread]()
+          {
+            for (SizeType j = 0; j < eventsPerThread; ++j) {
+              TraceScope trace("worker", "test");
+            }
+          });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    Tracer::setEnabled(false);
+
+    REQUIRE(Tracer::getNumEvents() == 1 + numThreads * eventsPerThread);
+    REQUIRE(Tracer::getNumDroppedEvents() == 0);
+
+    std::string json = Tracer::toChromeTraceJSON();
+    REQUIRE(json.find("\"traceEvents\": [") != std::string::npos);
+    REQUIRE(countOccurrences(json, "\"ph\": \"X\"")
+            == 1 + numThreads * eventsPerThread);
+    REQUIRE(countOccurrences(json, "\"name\": \"main\"") == 1);
+    REQUIRE(countOccurrences(json, "\"name\": \"worker\", \"cat\": \"test\"")
+            == numThreads * eventsPerThread);
+
+    // every worker thread has its own tid
+    std::vector<std::string> tids;
+    std::istringstream lines(json);
+    std::string line;
+    while (std::getline(lines, line)) {
+      auto pos = line.find("\"tid\": ");
+      if (pos == std::string::npos) {
+        continue;
+      }
+      std::string tid = line.substr(pos, line.find('}', pos) - pos);
+      if (std::find(tids.begin(), tids.end(), tid) == tids.end()) {
+        tids.push_back(tid);
+      }
+    }
+    REQUIRE(tids.size() == 1 + numThreads);
+
+    Tracer::clear();
+    REQUIRE(Tracer::getNumEvents() == 0);
+    REQUIRE(Tracer::toChromeTraceJSON().find("\"ph\"") == std::string::npos);
+  }
+
+  SECTION("events beyond the per-thread limit are dropped")
+  {
+    Tracer::setMaxEventsPerThread(10);
+    Tracer::setEnabled(true);
+    for (int i = 0; i < 25; ++i) {
+      TraceScope trace("limited", "test");
+    }
+    Tracer::setEnabled(false);
+    REQUIRE(Tracer::getNumEvents() == 10);
+    REQUIRE(Tracer::getNumDroppedEvents() == 15);
+    Tracer::clear();
+    REQUIRE(Tracer::getNumDroppedEvents() == 0);
+  }
+
+  SECTION("IO operations are traced")
+  {
+    std::string path = getTestFilePath("testTracing.h5");
+    std::string tracePath = getTestFilePath("testTracing.json");
+    Tracer::setEnabled(true);
+    {
+      IO::HDF5::HDF5IO hdf5io(path);
+      hdf5io.open();
+      IO::ArrayDataSetConfig config {
+          IO::BaseDataType::I32, SizeArray {0}, SizeArray {1}};
+      auto dataset = hdf5io.createArrayDataSet(config, "/data");
+      std::vector<int> data = {1, 2, 3};
+      REQUIRE(dataset->writeDataBlock(
+                  SizeArray {3}, SizeArray {0}, IO::BaseDataType::I32, &data[0])
+              == Status::Success);
+      hdf5io.flush();
+      hdf5io.close();
+    }
+    Tracer::setEnabled(false);
+
+    REQUIRE(Tracer::writeChromeTrace(tracePath) == Status::Success);
+    std::ifstream file(tracePath);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string json = contents.str();
+    REQUIRE(json.find("\"name\": \"HDF5IO::open\", \"cat\": \"io\"")
+            != std::string::npos);
+    REQUIRE(json.find("\"name\": \"HDF5IO::createArrayDataSet\"")
+            != std::string::npos);
+    REQUIRE(json.find("\"name\": \"HDF5RecordingData::writeDataBlock\"")
+            != std::string::npos);
+    REQUIRE(json.find("\"name\": \"HDF5IO::flush\"") != std::string::npos);
+  }
+
+  Tracer::setEnabled(false);
+  Tracer::setMaxEventsPerThread(defaultMaxEvents);
+  Tracer::clear();
+}
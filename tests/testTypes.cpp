@@ -156,3 +156,97 @@ TEST_CASE("Test SizeTypeNotSet constant", "[Types]")
     REQUIRE(index != Types::SizeTypeNotSet);
   }
 }
+
+TEST_CASE("Test SizeArray", "[Types]")
+{
+  using SizeArray = Types::SizeArray;
+
+  SECTION("shapes are stored inline")
+  {
+    SizeArray shape = {10, 4, 2, 1};
+    REQUIRE(shape.size() == 4);
+    REQUIRE(shape.isInline());
+    REQUIRE(shape.capacity() == Types::SizeArrayInlineCapacity);
+
+    SizeArray copy = shape;
+    REQUIRE(copy.isInline());
+    REQUIRE(copy == shape);
+
+    SizeArray moved = std::move(copy);
+    REQUIRE(moved.isInline());
+    REQUIRE(moved == shape);
+  }
+
+  SECTION("long arrays are moved to the heap")
+  {
+    SizeArray values;
+    for (Types::SizeType i = 0; i < 100; ++i) {
+      values.push_back(i);
+    }
+    REQUIRE(values.size() == 100);
+    REQUIRE_FALSE(values.isInline());
+    REQUIRE(values[0] == 0);
+    REQUIRE(values.back() == 99);
+
+    const Types::SizeType* data = values.data();
+    SizeArray moved = std::move(values);
+    REQUIRE(moved.data() == data);
+    REQUIRE(values.empty());
+    REQUIRE(values.isInline());
+
+    SizeArray copy = moved;
+    REQUIRE(copy == moved);
+    REQUIRE(copy.data() != moved.data());
+
+    moved.resize(3);
+    moved.shrink_to_fit();
+    REQUIRE(moved.isInline());
+    REQUIRE(moved == SizeArray {0, 1, 2});
+  }
+
+  SECTION("constructors match std::vector")
+  {
+    REQUIRE(SizeArray(3) == SizeArray {0, 0, 0});
+    REQUIRE(SizeArray(2, 7) == SizeArray {7, 7});
+    REQUIRE(SizeArray {3}.size() == 1);
+    std::vector<int> ints = {1, 2, 3};
+    REQUIRE(SizeArray(ints.begin(), ints.end()) == SizeArray {1, 2, 3});
+  }
+
+  SECTION("conversion from and to std::vector")
+  {
+    std::vector<Types::SizeType> vec = {5, 6, 7};
+    SizeArray arr = vec;
+    REQUIRE(arr == SizeArray {5, 6, 7});
+    REQUIRE(arr == vec);
+    std::vector<Types::SizeType> back = arr;
+    REQUIRE(back == vec);
+  }
+
+  SECTION("insert and erase")
+  {
+    SizeArray arr = {1, 4};
+    arr.insert(arr.begin() + 1, {2, 3});
+    REQUIRE(arr == SizeArray {1, 2, 3, 4});
+    arr.insert(arr.begin(), arr.begin(), arr.end());
+    REQUIRE(arr == SizeArray {1, 2, 3, 4, 1, 2, 3, 4});
+    arr.insert(arr.end(), 2, arr[0]);
+    REQUIRE(arr == SizeArray {1, 2, 3, 4, 1, 2, 3, 4, 1, 1});
+    REQUIRE_FALSE(arr.isInline());
+    arr.erase(arr.begin() + 4, arr.end());
+    REQUIRE(arr == SizeArray {1, 2, 3, 4});
+    arr.erase(arr.begin());
+    REQUIRE(arr == SizeArray {2, 3, 4});
+  }
+
+  SECTION("comparison and bounds checking")
+  {
+    SizeArray a = {1, 2};
+    SizeArray b = {1, 3};
+    REQUIRE(a < b);
+    REQUIRE(a != b);
+    REQUIRE(SizeArray {1} < a);
+    REQUIRE(a.at(1) == 2);
+    REQUIRE_THROWS_AS(a.at(2), std::out_of_range);
+  }
+}
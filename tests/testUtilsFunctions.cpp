@@ -1,5 +1,11 @@
+#include <cmath>
 #include <ctime>
+#include <limits>
+#include <random>
 #include <regex>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include "testUtils.hpp"
 
@@ -211,4 +217,174 @@ TEST_CASE("Test endian conversion", "[utils]")
   } else {
     REQUIRE(converted == 0x3412);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Test float to int16 conversion kernels", "[utils]")
+{
+  // reference implementation of the original scalar conversion
+  auto reference = [](float value)
+  {
+    auto maxVal = static_cast<double>(0x7fff);
+    auto clampedValue =
+        std::clamp(maxVal * static_cast<double>(value), -maxVal, maxVal);
+    return static_cast<int16_t>(std::round(clampedValue));
+  };
+
+  // random values incl. out of range values, special values, and values
+  // close to halfway cases. The size is not a multiple of the vector width
+  // to also cover the scalar tail.
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+  std::vector<float> input(1003);
+  for (float& value : input) {
+    value = dist(rng);
+  }
+  std::vector<float> specialValues = {0.0f,
+                                      -0.0f,
+                                      1.0f,
+                                      -1.0f,
+                                      1e-6f,
+                                      -1e-6f,
+                                      std::numeric_limits<float>::infinity(),
+                                      -std::numeric_limits<float>::infinity(),
+                                      std::numeric_limits<float>::max(),
+                                      std::numeric_limits<float>::lowest()};
+  std::copy(specialValues.begin(), specialValues.end(), input.begin());
+  for (int k = 0; k < 100; ++k) {
+    input[20 + static_cast<SizeType>(k)] =
+        static_cast<float>((k - 50 + 0.5) / 32767.0);
+  }
+
+  std::vector<int16_t> expected(input.size());
+  std::transform(input.begin(), input.end(), expected.begin(), reference);
+
+  int maxLevel = static_cast<int>(AQNWB::getSupportedSimdLevel());
+  for (int level = 0; level <= maxLevel; ++level) {
+    auto simdLevel = static_cast<AQNWB::SimdLevel>(level);
+    INFO("SIMD level " << AQNWB::getSimdLevelName(simdLevel));
+
+    std::vector<int16_t> output(input.size());
+    AQNWB::convertFloatToInt16(
+        input.data(), output.data(), input.size(), 1.0f, simdLevel);
+    REQUIRE(output == expected);
+
+    // scaling is applied in single precision before the conversion
+    float scale = 1.0f / (32767.0f * 0.195f);
+    std::vector<float> scaled(input.size());
+    std::transform(input.begin(),
+                   input.end(),
+                   scaled.begin(),
+                   [scale](float value) { return value * scale; });
+    std::vector<int16_t> expectedScaled(input.size());
+    std::transform(
+        scaled.begin(), scaled.end(), expectedScaled.begin(), reference);
+    AQNWB::convertFloatToInt16(
+        input.data(), output.data(), input.size(), scale, simdLevel);
+    REQUIRE(output == expectedScaled);
+
+    // NaN is converted to -32767
+    std::vector<float> nans(17, std::numeric_limits<float>::quiet_NaN());
+    std::vector<int16_t> nanOutput(nans.size());
+    AQNWB::convertFloatToInt16(
+        nans.data(), nanOutput.data(), nans.size(), 1.0f, simdLevel);
+    REQUIRE(nanOutput == std::vector<int16_t>(nans.size(), -32767));
+  }
+
+  // unsupported levels are rejected
+  if (maxLevel < static_cast<int>(AQNWB::SimdLevel::AVX512)) {
+    std::vector<int16_t> output(input.size());
+    REQUIRE_THROWS_AS(AQNWB::convertFloatToInt16(input.data(),
+                                                 output.data(),
+                                                 input.size(),
+                                                 1.0f,
+                                                 AQNWB::SimdLevel::AVX512),
+                      std::invalid_argument);
+  }
+
+  // the Utils wrappers match the kernels
+  std::vector<int16_t> output(input.size());
+  AQNWB::convertFloatToInt16LE(input.data(), output.data(), input.size());
+  REQUIRE(output == expected);
+  std::unique_ptr<int16_t[]> transformed =
+      AQNWB::transformToInt16(input.size(), 2.0f, input.data());
+  AQNWB::transformToInt16(input.size(), 2.0f, input.data(), output.data());
+  REQUIRE(std::equal(output.begin(), output.end(), transformed.get()));
+}
+
+TEST_CASE("Test interleaved float to int16 conversion", "[utils]")
+{
+  // narrow rows use the repeated scale pattern and wide rows (more channels
+  // than the pattern) are converted row by row. The numbers of channels are
+  // not multiples of the vector width to also cover the scalar tails.
+  constexpr SizeType numRows = 37;
+  for (SizeType numChannels : {SizeType {3}, SizeType {17}, SizeType {300}}) {
+    INFO("channels " << numChannels);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<float> input(numRows * numChannels);
+    for (float& value : input) {
+      value = dist(rng);
+    }
+    std::uniform_real_distribution<float> scaleDist(0.0002f, 0.02f);
+    std::vector<float> separateScales(numChannels);
+    for (float& scale : separateScales) {
+      scale = scaleDist(rng);
+    }
+
+    // separate and uniform channel scales give the same result as the
+    // single-channel scalar conversion on every SIMD level
+    int maxLevel = static_cast<int>(AQNWB::getSupportedSimdLevel());
+    for (const std::vector<float>& scales :
+         {separateScales, std::vector<float>(numChannels, 0.001f)})
+    {
+      std::vector<int16_t> expected(input.size());
+      for (SizeType i = 0; i < input.size(); ++i) {
+        AQNWB::convertFloatToInt16(&input[i],
+                                   &expected[i],
+                                   1,
+                                   scales[i % numChannels],
+                                   AQNWB::SimdLevel::Scalar);
+      }
+      for (int level = 0; level <= maxLevel; ++level) {
+        auto simdLevel = static_cast<AQNWB::SimdLevel>(level);
+        INFO("SIMD level " << AQNWB::getSimdLevelName(simdLevel));
+        std::vector<int16_t> output(input.size());
+        AQNWB::convertFloatToInt16Interleaved(input.data(),
+                                              output.data(),
+                                              numRows,
+                                              numChannels,
+                                              scales.data(),
+                                              simdLevel);
+        REQUIRE(output == expected);
+      }
+      std::vector<int16_t> output(input.size());
+      AQNWB::convertFloatToInt16Interleaved(
+          input.data(), output.data(), numRows, numChannels, scales.data());
+      REQUIRE(output == expected);
+    }
+  }
+}
+
+TEST_CASE("Benchmark float to int16 conversion kernels",
+          "[utils][.benchmark]")
+{
+  // 1M samples per call, i.e., samples/s = 1e6 / mean time per call
+  constexpr SizeType numSamples = 1 << 20;
+  std::vector<float> input(numSamples);
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (float& value : input) {
+    value = dist(rng);
+  }
+  std::vector<int16_t> output(numSamples);
+
+  int maxLevel = static_cast<int>(AQNWB::getSupportedSimdLevel());
+  for (int level = 0; level <= maxLevel; ++level) {
+    auto simdLevel = static_cast<AQNWB::SimdLevel>(level);
+    BENCHMARK(AQNWB::getSimdLevelName(simdLevel) + " (1M samples)")
+    {
+      AQNWB::convertFloatToInt16(
+          input.data(), output.data(), numSamples, 1.0f, simdLevel);
+      return output[0];
+    };
+  }
+}
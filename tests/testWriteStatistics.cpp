@@ -0,0 +1,176 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "io/RecordingObjects.hpp"
+#include "io/WriteStatistics.hpp"
+#include "io/hdf5/HDF5IO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using namespace AQNWB::IO;
+
+TEST_CASE("LatencyHistogram", "[instrumentation]")
+{
+  SECTION("empty histogram")
+  {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.min() == 0);
+    REQUIRE(histogram.max() == 0);
+    REQUIRE(histogram.percentile(50.0) == 0);
+    REQUIRE(histogram.mean() == Catch::Approx(0.0));
+  }
+
+  SECTION("small values are exact")
+  {
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 50; ++i) {
+      histogram.record(i);
+    }
+    REQUIRE(histogram.count() == 50);
+    REQUIRE(histogram.min() == 1);
+    REQUIRE(histogram.max() == 50);
+    REQUIRE(histogram.percentile(50.0) == 25);
+    REQUIRE(histogram.percentile(100.0) == 50);
+    REQUIRE(histogram.mean() == Catch::Approx(25.5));
+  }
+
+  SECTION("large values have bounded relative error")
+  {
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 100000; ++i) {
+      histogram.record(i * 1000);
+    }
+    REQUIRE(histogram.max() == 100000000);
+    const std::vector<double> percentiles = {50.0, 99.0, 99.9};
+    for (double p : percentiles) {
+      double expected = p / 100.0 * 100000.0 * 1000.0;
+      double actual = static_cast<double>(histogram.percentile(p));
+      REQUIRE(actual >= expected);
+      REQUIRE(actual <= expected * (1.0 + 1.0 / 32.0));
+    }
+    REQUIRE(histogram.percentile(100.0) == histogram.max());
+  }
+
+  SECTION("merge and clear")
+  {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(10);
+    b.record(1000000);
+    b.record(5);
+    a.merge(b);
+    REQUIRE(a.count() == 3);
+    REQUIRE(a.min() == 5);
+    REQUIRE(a.max() == 1000000);
+    a.clear();
+    REQUIRE(a.count() == 0);
+    REQUIRE(a.percentile(99.0) == 0);
+  }
+}
+
+TEST_CASE("WriteStatistics", "[instrumentation]")
+{
+  SECTION("recording and JSON export")
+  {
+    WriteStatistics statistics;
+    statistics.recordWrite("/data", 1000, 64, true);
+    statistics.recordWrite("/data", 3000, 64, false);
+    statistics.recordExtend("/data");
+    statistics.recordFlush("/data", 500);
+    statistics.recordFileFlush(2000);
+
+    DatasetWriteStats stats = statistics.getDatasetStats("/data");
+    REQUIRE(stats.calls == 2);
+    REQUIRE(stats.bytes == 64);
+    REQUIRE(stats.failures == 1);
+    REQUIRE(stats.extends == 1);
+    REQUIRE(stats.flushes == 1);
+    REQUIRE(stats.writeLatency.count() == 2);
+    REQUIRE(stats.writeLatency.max() == 3000);
+    REQUIRE(statistics.getFileStats().flushes == 1);
+    REQUIRE(statistics.getDatasetStats("/missing").calls == 0);
+
+    std::string json = statistics.toJSON();
+    REQUIRE(json.rfind("{\"enabled\": false", 0) == 0);
+    REQUIRE(json.find("\"/data\": {") != std::string::npos);
+    REQUIRE(json.find("\"calls\": 2, \"bytes\": 64, \"extends\": 1, "
+                      "\"flushes\": 1, \"failures\": 1")
+            != std::string::npos);
+    REQUIRE(json.find("\"p99.9\": ") != std::string::npos);
+
+    statistics.reset();
+    REQUIRE(statistics.getAllDatasetStats().empty());
+    REQUIRE(statistics.getFileStats().flushes == 0);
+  }
+
+  SECTION("instrumentation of the write path")
+  {
+    std::string path = getTestFilePath("testWriteStatistics.nwb");
+    std::shared_ptr<BaseIO> io = std::make_shared<HDF5::HDF5IO>(path);
+    io->open();
+    auto statistics = io->getWriteStatistics();
+    REQUIRE(statistics != nullptr);
+    REQUIRE_FALSE(statistics->isEnabled());
+    statistics->setEnabled(true);
+    REQUIRE(statistics->isEnabled() == WriteStatistics::isCompiledIn());
+
+    auto nwbFile = NWB::NWBFile::create(io);
+    nwbFile->initialize(generateUuid());
+    auto mockArrays = getMockChannelArrays(2, 1);
+    auto electrodesTable = nwbFile->createElectrodesTable(mockArrays);
+    electrodesTable->finalize();
+    std::vector<SizeType> containerIndexes;
+    nwbFile->createElectricalSeries(mockArrays,
+                                    getMockChannelArrayNames("esdata", 1),
+                                    BaseDataType::F32,
+                                    containerIndexes);
+    REQUIRE(containerIndexes.size() == 1);
+
+    auto recordingObjects = io->getRecordingObjects();
+    auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        recordingObjects->getRecordingObject(containerIndexes[0]));
+    REQUIRE(series != nullptr);
+    io->startRecording();
+
+    const SizeType numSamples = 100;
+    std::vector<float> data(numSamples * 2, 1.0f);
+    std::vector<double> timestamps(numSamples, 0.5);
+    for (int block = 0; block < 3; ++block) {
+      series->writeAllChannels(numSamples, data.data(), timestamps.data());
+    }
+    io->flush();
+
+    std::string dataPath = series->getPath() + "/data";
+    DatasetWriteStats dataStats = statistics->getDatasetStats(dataPath);
+    auto objectStats =
+        recordingObjects->getWriteStatistics(containerIndexes[0]);
+    if (WriteStatistics::isCompiledIn()) {
+      REQUIRE(dataStats.calls == 3);
+      REQUIRE(dataStats.bytes == 3 * numSamples * 2 * sizeof(float));
+      REQUIRE(dataStats.extends == 3);
+      REQUIRE(dataStats.failures == 0);
+      REQUIRE(dataStats.writeLatency.count() == 3);
+      REQUIRE(dataStats.writeLatency.max() > 0);
+      REQUIRE(statistics->getFileStats().flushes >= 1);
+
+      REQUIRE(objectStats.count(dataPath) == 1);
+      REQUIRE(objectStats[dataPath].calls == 3);
+      std::string timestampsPath = series->getPath() + "/timestamps";
+      REQUIRE(objectStats.count(timestampsPath) == 1);
+      REQUIRE(objectStats[timestampsPath].bytes
+              == 3 * numSamples * sizeof(double));
+    } else {
+      // no instrumentation code in the write path
+      REQUIRE(dataStats.calls == 0);
+      REQUIRE(statistics->getAllDatasetStats().empty());
+      REQUIRE(objectStats[dataPath].calls == 0);
+    }
+
+    io->stopRecording();
+    io->close();
+  }
+}
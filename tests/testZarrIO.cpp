@@ -0,0 +1,329 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Types.hpp"
+#include "Utils.hpp"
+#include "io/BaseIO.hpp"
+#include "io/RecordingObjects.hpp"
+#include "io/zarr/ZarrIO.hpp"
+#include "nwb/NWBFile.hpp"
+#include "nwb/ecephys/ElectricalSeries.hpp"
+#include "testUtils.hpp"
+
+using namespace AQNWB;
+using IO::Zarr::ZarrIO;
+
+namespace
+{
+/**
+ * @brief Get the path of a test store, removing the store of a previous run.
+ * getTestFilePath only removes files.
+ */
+std::string getTestStorePath(const std::string& name)
+{
+  std::filesystem::remove_all(std::filesystem::current_path() / "data" / name);
+  return getTestFilePath(name);
+}
+}  // namespace
+
+TEST_CASE("open - zarr store modes", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrOpen.nwb.zarr");
+  ZarrIO io(path);
+  REQUIRE(io.open(FileMode::ReadWrite) == Status::Failure);
+  REQUIRE(io.open() == Status::Success);
+  REQUIRE(std::filesystem::exists(path + "/.zgroup"));
+  REQUIRE(io.createGroup("/group") == Status::Success);
+  io.close();
+
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  REQUIRE(io.getStorageObjectType("/group") == StorageObjectType::Group);
+  REQUIRE(io.createGroup("/other") == Status::Failure);
+  io.close();
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  REQUIRE(io.objectExists("/group") == false);
+  io.close();
+
+  // directories that are not Zarr stores are never overwritten
+  std::string other = getTestStorePath("testZarrOther");
+  std::filesystem::create_directories(other);
+  std::ofstream(other + "/keep.txt") << "data";
+  ZarrIO otherIO(other);
+  REQUIRE(otherIO.open(FileMode::Overwrite) == Status::Failure);
+  REQUIRE(std::filesystem::exists(other + "/keep.txt"));
+}
+
+TEST_CASE("groups, attributes, and links", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrAttributes.nwb.zarr");
+  ZarrIO io(path);
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Success);
+  REQUIRE(io.createGroup("/data") == Status::Failure);
+  REQUIRE(io.createGroup("/missing/child") == Status::Failure);
+  REQUIRE(io.createGroup("/data/child") == Status::Success);
+
+  std::vector<int32_t> values = {1, -2, 3};
+  REQUIRE(io.createAttribute(BaseDataType::I32, values.data(), "/data", "a", 3)
+          == Status::Success);
+  float scale = 0.1f;
+  REQUIRE(io.createAttribute(BaseDataType::F32, &scale, "/data", "scale")
+          == Status::Success);
+  REQUIRE(io.createAttribute("text", "/data", "s") == Status::Success);
+  REQUIRE(io.createAttribute("other", "/data", "s", false) == Status::Failure);
+  REQUIRE(io.createAttribute(std::vector<std::string> {"x", "y"}, "/data", "v")
+          == Status::Success);
+  REQUIRE(io.createLink("/link", "/data") == Status::Success);
+  REQUIRE(io.createLink("/broken", "/missing") == Status::Failure);
+  REQUIRE(io.createReferenceAttribute("/data/child", "/data", "ref")
+          == Status::Success);
+  io.close();
+
+  // attributes keep their exact types when read back
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  auto ints = IO::DataBlock<int32_t>::fromGeneric(io.readAttribute("/data/a"));
+  REQUIRE(ints.shape == SizeArray {3});
+  REQUIRE(ints.data == values);
+  auto floats =
+      IO::DataBlock<float>::fromGeneric(io.readAttribute("/data/scale"));
+  REQUIRE(floats.shape.empty());
+  REQUIRE(floats.data[0] == Catch::Approx(scale));
+  auto text =
+      IO::DataBlock<std::string>::fromGeneric(io.readAttribute("/data/s"));
+  REQUIRE(text.data[0] == "text");
+  REQUIRE(io.getStorageObjectShape("/data/v") == SizeArray {2});
+  REQUIRE(io.getStorageObjectDataType("/data/v") == BaseDataType::V_STR);
+  REQUIRE(io.readReferenceAttribute("/data/ref") == "/data/child");
+  REQUIRE_THROWS_AS(io.readReferenceAttribute("/data/s"),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(io.readAttribute("/data/missing"), std::invalid_argument);
+
+  // links are followed and listed as Undefined
+  REQUIRE(io.getStorageObjectType("/link") == StorageObjectType::Group);
+  REQUIRE(io.attributeExists("/link/scale"));
+  REQUIRE(io.objectExists("/link/child"));
+  auto objects = io.getStorageObjects("/");
+  REQUIRE(objects.size() == 2);
+  REQUIRE(objects[0].first == "data");
+  REQUIRE(objects[0].second == StorageObjectType::Group);
+  REQUIRE(objects[1].first == "link");
+  REQUIRE(objects[1].second == StorageObjectType::Undefined);
+  auto attributes =
+      io.getStorageObjects("/data", StorageObjectType::Attribute);
+  REQUIRE(attributes.size() == 5);
+  REQUIRE(attributes[0].first == "a");
+  io.close();
+}
+
+TEST_CASE("chunked array datasets", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrDatasets.nwb.zarr");
+  // compressed chunks if zlib is available
+  ZarrIO io(path, 4);
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+
+  IO::ArrayDataSetConfig config(
+      BaseDataType::I32, SizeArray {0, 4}, SizeArray {3, 0});
+  auto dataset = io.createArrayDataSet(config, "/data");
+  REQUIRE(dataset != nullptr);
+  std::vector<int32_t> values(20);
+  std::iota(values.begin(), values.end(), 0);
+  REQUIRE(dataset->writeDataBlock(SizeArray {2, 4},
+                                  SizeArray {0, 0},
+                                  BaseDataType::I32,
+                                  values.data())
+          == Status::Success);
+  // int16 data is converted to the type of the dataset
+  std::vector<int16_t> more = {8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  REQUIRE(dataset->writeDataBlock(SizeArray {3, 4},
+                                  SizeArray {2, 0},
+                                  BaseDataType::I16,
+                                  more.data())
+          == Status::Success);
+  REQUIRE(io.getStorageObjectShape("/data") == SizeArray {5, 4});
+  REQUIRE(io.getStorageObjectChunking("/data") == SizeArray {3, 4});
+  REQUIRE(io.flush() == Status::Success);
+  REQUIRE(std::filesystem::exists(path + "/data/0.0"));
+  REQUIRE(std::filesystem::exists(path + "/data/1.0"));
+
+  auto all = IO::DataBlock<int32_t>::fromGeneric(io.readDataset("/data"));
+  REQUIRE(all.shape == SizeArray {5, 4});
+  REQUIRE(all.data == values);
+  auto slab = IO::DataBlock<int32_t>::fromGeneric(
+      io.readDataset("/data", SizeArray {1, 1}, SizeArray {3, 2}));
+  REQUIRE(slab.data == std::vector<int32_t> {5, 6, 9, 10, 13, 14});
+  auto selection = IO::DataBlock<int32_t>::fromGeneric(
+      io.readDatasetSelection("/data", {{4, 0}, {3}}));
+  REQUIRE(selection.data == std::vector<int32_t> {19, 3});
+  REQUIRE_THROWS_AS(io.readDataset("/data", SizeArray {4, 0}, SizeArray {2, 1}),
+                    std::runtime_error);
+  REQUIRE_THROWS_AS(io.readDataset("/missing"), std::runtime_error);
+
+  std::vector<std::string> strings = {"a", "bb", "ccc"};
+  REQUIRE(io.createStringDataSet("/strings", strings) == Status::Success);
+  REQUIRE(io.createStringDataSet("/scalar", "value") == Status::Success);
+  REQUIRE(io.createReferenceDataSet("/refs", {"/data", "/strings"})
+          == Status::Success);
+  io.close();
+
+  REQUIRE(io.open(FileMode::ReadOnly) == Status::Success);
+  auto readStrings =
+      IO::DataBlock<std::string>::fromGeneric(io.readDataset("/strings"));
+  REQUIRE(readStrings.data == strings);
+  auto scalar =
+      IO::DataBlock<std::string>::fromGeneric(io.readDataset("/scalar"));
+  REQUIRE(scalar.shape.empty());
+  REQUIRE(scalar.data == std::vector<std::string> {"value"});
+  auto refs = IO::DataBlock<std::string>::fromGeneric(io.readDataset("/refs"));
+  REQUIRE(refs.data == std::vector<std::string> {"/data", "/strings"});
+  REQUIRE(io.getStorageObjectDataType("/data") == BaseDataType::I32);
+  auto reread = IO::DataBlock<int32_t>::fromGeneric(io.readDataset("/data"));
+  REQUIRE(reread.data == values);
+  io.close();
+}
+
+TEST_CASE("background chunk stores", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrChunkStores.nwb.zarr");
+  ZarrIO io(path);
+  REQUIRE(io.open(FileMode::Overwrite) == Status::Success);
+  IO::ArrayDataSetConfig config(
+      BaseDataType::I16, SizeArray {0}, SizeArray {2});
+  auto dataset = io.createArrayDataSet(config, "/data");
+
+  // every write starts a new chunk and hands the previous one to the pool
+  std::vector<int16_t> values(64);
+  std::iota(values.begin(), values.end(), int16_t {0});
+  for (SizeType i = 0; i < values.size(); i += 2) {
+    REQUIRE(dataset->writeDataBlock(SizeArray {2},
+                                    SizeArray {i},
+                                    BaseDataType::I16,
+                                    values.data() + i)
+            == Status::Success);
+  }
+  // reading an evicted chunk waits for its store
+  auto first = IO::DataBlock<int16_t>::fromGeneric(
+      io.readDataset("/data", SizeArray {0}, SizeArray {2}));
+  REQUIRE(first.data == std::vector<int16_t> {0, 1});
+  REQUIRE(io.flush() == Status::Success);
+  REQUIRE(std::filesystem::exists(path + "/data/31"));
+  io.close();
+
+  // chunks that cannot be decoded are never overwritten
+  {
+    std::ofstream chunk(path + "/data/1", std::ios::binary | std::ios::trunc);
+    chunk << "corrupt";
+  }
+  REQUIRE(io.open(FileMode::ReadWrite) == Status::Success);
+  auto reopened = io.getDataSet("/data");
+  REQUIRE(reopened->writeDataBlock(
+              SizeArray {1}, SizeArray {2}, BaseDataType::I16, values.data())
+          == Status::Failure);
+  REQUIRE(reopened->writeDataBlock(
+              SizeArray {1}, SizeArray {4}, BaseDataType::I16, values.data())
+          == Status::Success);
+  io.close();
+  std::ifstream chunk(path + "/data/1", std::ios::binary);
+  std::string contents((std::istreambuf_iterator<char>(chunk)),
+                       std::istreambuf_iterator<char>());
+  REQUIRE(contents == "corrupt");
+}
+
+TEST_CASE("live reads of flushed data", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrLive.nwb.zarr");
+  ZarrIO writer(path);
+  REQUIRE(writer.open(FileMode::Overwrite) == Status::Success);
+  IO::ArrayDataSetConfig config(
+      BaseDataType::F64, SizeArray {0}, SizeArray {4});
+  auto dataset = writer.createArrayDataSet(config, "/data");
+  REQUIRE(writer.startRecording() == Status::Success);
+
+  ZarrIO reader(path);
+  REQUIRE(reader.open(FileMode::ReadOnly) == Status::Success);
+  REQUIRE(reader.getStorageObjectShape("/data") == SizeArray {0});
+
+  std::vector<double> values = {0.5, 1.5, 2.5, 3.5, 4.5, 5.5};
+  REQUIRE(dataset->writeDataBlock(
+              SizeArray {3}, SizeArray {0}, BaseDataType::F64, values.data())
+          == Status::Success);
+  REQUIRE(writer.flush() == Status::Success);
+  REQUIRE(reader.getStorageObjectShape("/data") == SizeArray {3});
+
+  REQUIRE(dataset->writeDataBlock(SizeArray {3},
+                                  SizeArray {3},
+                                  BaseDataType::F64,
+                                  values.data() + 3)
+          == Status::Success);
+  REQUIRE(writer.flush() == Status::Success);
+  auto data = IO::DataBlock<double>::fromGeneric(reader.readDataset("/data"));
+  REQUIRE(data.data == values);
+  reader.close();
+  writer.close();
+}
+
+TEST_CASE("record and read an NWB Zarr store", "[zarrio]")
+{
+  std::string path = getTestStorePath("testZarrNWB.nwb.zarr");
+  {
+    std::shared_ptr<BaseIO> io = createIO("Zarr", path);
+    REQUIRE(std::dynamic_pointer_cast<ZarrIO>(io) != nullptr);
+    REQUIRE(io->open(FileMode::Overwrite) == Status::Success);
+    auto nwbFile = NWB::NWBFile::create(io);
+    REQUIRE(nwbFile->initialize(generateUuid()) == Status::Success);
+    const SizeType numChannels = 3;
+    auto mockArrays = getMockChannelArrays(numChannels, 1);
+    nwbFile->createElectrodesTable(mockArrays);
+    std::vector<SizeType> esIndexes;
+    REQUIRE(
+        nwbFile->createElectricalSeries(mockArrays,
+                                        getMockChannelArrayNames("esdata", 1),
+                                        BaseDataType::F32,
+                                        esIndexes)
+        == Status::Success);
+    REQUIRE(io->startRecording() == Status::Success);
+
+    const SizeType numSamples = 100;
+    auto mockData = getMockData2D(numSamples, numChannels);
+    auto timestamps = getMockTimestamps(numSamples, 1);
+    auto series = std::dynamic_pointer_cast<NWB::ElectricalSeries>(
+        io->getRecordingObjects()->getRecordingObject(esIndexes[0]));
+    REQUIRE(series != nullptr);
+    for (SizeType ch = 0; ch < numChannels; ++ch) {
+      REQUIRE(series->writeChannel(
+                  ch, numSamples, mockData[ch].data(), timestamps.data())
+              == Status::Success);
+    }
+    REQUIRE(io->stopRecording() == Status::Success);
+    io->close();
+
+    std::shared_ptr<BaseIO> readio = createIO("Zarr", path);
+    REQUIRE(readio->open(FileMode::ReadOnly) == Status::Success);
+    const std::string dataPath = "/acquisition/esdata0/data";
+    auto data =
+        IO::DataBlock<float>::fromGeneric(readio->readDataset(dataPath));
+    REQUIRE(data.shape == SizeArray {numSamples, numChannels});
+    for (SizeType i = 0; i < numSamples; ++i) {
+      for (SizeType ch = 0; ch < numChannels; ++ch) {
+        REQUIRE(data.data[i * numChannels + ch]
+                == Catch::Approx(mockData[ch][i]));
+      }
+    }
+    auto readFile = NWB::RegisteredType::create<NWB::NWBFile>("/", readio);
+    REQUIRE(readFile != nullptr);
+    auto types = readio->findTypes(
+        "/", {"core::ElectricalSeries"}, SearchMode::CONTINUE_ON_TYPE);
+    REQUIRE(types.size() == 1);
+    REQUIRE(types["/acquisition/esdata0"] == "core::ElectricalSeries");
+    readio->close();
+  }
+}
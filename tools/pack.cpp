@@ -0,0 +1,127 @@
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "io/raw/RawCaptureIO.hpp"
+
+using namespace AQNWB;
+using IO::FileMode;
+using IO::Raw::PackOptions;
+using IO::Raw::RawCaptureIO;
+
+namespace
+{
+void printUsage(const char* programName)
+{
+  std::cout
+      << "Usage: " << programName << " [options] CAPTURE_DIR OUTPUT.nwb\n\n"
+      << "Converts a raw capture recorded with RawCaptureIO into an NWB\n"
+      << "file in HDF5. Existing output files are overwritten.\n\n"
+      << "Options:\n"
+      << "  --chunk-rows N      elements per chunk along the first dimension\n"
+      << "                      of recorded datasets (default: as recorded)\n"
+      << "  --compression L     gzip level 0-9, 0 to disable (default 4)\n"
+      << "  --no-shuffle        disable the shuffle filter\n"
+      << "  --threads N         worker threads, 0 for one per core\n"
+      << "                      (default 0)\n"
+      << "  --help              show this message\n";
+}
+
+SizeType toSize(const std::string& text)
+{
+  return static_cast<SizeType>(std::stoull(text));
+}
+
+/**
+ * @brief Parse the command line
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @param options The pack options (return value)
+ * @return The capture directory and the output file
+ */
+std::vector<std::string> parseOptions(int argc,
+                                      char* argv[],
+                                      PackOptions& options)
+{
+  std::map<std::string, std::function<void(const std::string&)>> parsers = {
+      {"--chunk-rows",
+       [&](const std::string& v) { options.chunkRows = toSize(v); }},
+      {"--compression",
+       [&](const std::string& v)
+       {
+         options.compressionLevel = static_cast<unsigned int>(toSize(v));
+         if (options.compressionLevel > 9) {
+           throw std::invalid_argument("invalid compression level '" + v
+                                       + "'");
+         }
+       }},
+      {"--threads",
+       [&](const std::string& v) { options.numThreads = toSize(v); }}};
+
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    }
+    if (arg == "--no-shuffle") {
+      options.shuffle = false;
+      continue;
+    }
+    if (arg.rfind("--", 0) != 0) {
+      paths.push_back(arg);
+      continue;
+    }
+    auto parser = parsers.find(arg);
+    if (parser == parsers.end()) {
+      throw std::invalid_argument("unknown option '" + arg + "'");
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("missing value for '" + arg + "'");
+    }
+    parser->second(argv[++i]);
+  }
+  if (paths.size() != 2) {
+    throw std::invalid_argument("expected a capture directory and an output "
+                                "file");
+  }
+  return paths;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  PackOptions options;
+  std::vector<std::string> paths;
+  try {
+    paths = parseOptions(argc, argv, options);
+  } catch (const std::exception& e) {
+    std::cerr << "aqnwb_pack: " << e.what() << "\n\n";
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  // HDF5 reports expected lookups of missing objects on stderr
+  H5::Exception::dontPrint();
+
+  RawCaptureIO capture(paths[0]);
+  if (capture.open(FileMode::ReadOnly) != Status::Success) {
+    std::cerr << "aqnwb_pack: " << paths[0] << " is not a raw capture"
+              << std::endl;
+    return 1;
+  }
+  Status status = capture.pack(paths[1], options);
+  capture.close();
+  if (status != Status::Success) {
+    std::cerr << "aqnwb_pack: failed to write " << paths[1] << std::endl;
+    return 1;
+  }
+  return 0;
+}